@@ -8,10 +8,23 @@
 #include "platform/platform_task.h"
 #include "platform/platform_time.h"
 #include "os_mutex.h"
+#include "paged_list.h"
+#include "group_volume.h"
+#include "telemetry.h"
+#include "zone_list.h"
 #include "ui.h"
+#include "ui_browse.h"
+#include "ui_group_volume.h"
+#include "ui_queue.h"
+#include "volume_sync.h"
 
 #ifdef ESP_PLATFORM
 #include "display_sleep.h"
+#include "haptics.h"
+#include "platform_display_idf.h"
+#include "pm_locks.h"
+#include "wifi_manager.h"
+#include "esp_system.h"
 #endif
 
 #include <ctype.h>
@@ -27,16 +40,25 @@ static bool fetch_knob_config(void);
 static void apply_knob_config(const rk_cfg_t *cfg);
 static void check_config_sha(const char *new_sha);
 static void check_zones_sha(const char *new_sha);
+static void sync_zone_list(void);
 static void check_charging_state_change(void);
+static void service_queue_request(void);
+static void service_browse_requests(void);
+static void copy_json_string(cJSON *obj, const char *key, char *out, size_t len);
+static void service_telemetry(bool bridge_ok);
 
 #define MAX_LINE 128
 #define MAX_ZONE_NAME 64
-#define MAX_ZONES 64
+#define MAX_ZONES ZONE_LIST_MAX
 #define POLL_DELAY_AWAKE_CHARGING_MS 2000   // 2 seconds when charging and display on
 #define POLL_DELAY_AWAKE_BATTERY_MS 5000   // 5 seconds on battery to save power
 #define POLL_DELAY_SLEEPING_MS 30000       // 30 seconds when display is sleeping
 #define POLL_DELAY_SLEEPING_STOPPED_MS 60000  // 60 seconds when sleeping AND zone stopped
 #define POLL_DELAY_BRIDGE_ERROR_MS 10000   // 10 seconds when bridge unreachable
+#define VOLUME_SYNC_TIMEOUT_MS 4000        // Trust polled volume again if the bridge never echoes our seq
+#define WAKE_REFRESH_TIMEOUT_MS 1500       // Stop holding volume turns for the post-wake poll
+#define TELEMETRY_SAMPLE_MS (60 * 1000)       // One device telemetry sample a minute
+#define TELEMETRY_FLUSH_MS (15 * 60 * 1000)   // Batch POST every 15 minutes unless something changed
 
 // Special zone picker options (not actual zones)
 #define ZONE_ID_BACK "__back__"
@@ -52,16 +74,16 @@ struct now_playing_state {
     float volume_step;
     int seek_position;
     int length;
+    bool has_volume_seq;  // Bridge echoes the last vol_abs "seq" it applied
+    uint32_t volume_seq;
+    int output_count;     // Grouped zone members (0/1 = not grouped)
+    uint32_t wake_gen;    // s_wake.gen when this poll started
+    group_output_t outputs[GROUP_VOLUME_MAX_OUTPUTS];
     char image_key[128];  // For tracking album artwork changes
     char config_sha[9];   // Config SHA for change detection
     char zones_sha[9];    // Zones SHA for zone list change detection
 };
 
-struct zone_entry {
-    char id[MAX_ZONE_NAME];
-    char name[MAX_ZONE_NAME];
-};
-
 // Device operational state for safe volume control
 typedef enum {
     DEVICE_STATE_BOOT,        // Hardware ready, no network
@@ -84,8 +106,7 @@ static const char* device_state_name(device_state_t state) {
 
 struct bridge_state {
     rk_cfg_t cfg;
-    struct zone_entry zones[MAX_ZONES];
-    int zone_count;
+    zone_list_t zones;  // Full /zones fetch, then deltas since zones.sha
     char zone_label[MAX_ZONE_NAME];
     bool zone_resolved;
     bool net_connected;
@@ -103,11 +124,16 @@ static float s_last_known_volume = 0.0f;   // Cached volume for optimistic UI up
 static float s_last_known_volume_min = -80.0f;  // Cached volume min for clamping
 static float s_last_known_volume_max = 0.0f;    // Cached volume max for clamping
 static float s_last_known_volume_step = 1.0f;  // Cached volume step
+static bool s_volume_known = false;             // A poll has filled the cache above
+static volume_sync_t s_volume_sync;         // Holds optimistic volume until the bridge confirms it
+static group_volume_t s_group_volume;       // Per-output state for grouped zones
 static bool s_bridge_verified = false;  // True after bridge found AND responded successfully
 static uint32_t s_last_mdns_check_ms = 0;  // Timestamp of last mDNS check
 static bool s_last_charging_state = true;  // Track charging state for config reapply
 static bool s_last_is_playing = false;     // Track play state for extended sleep polling
 static char s_last_zones_sha[9] = {0};     // Track zones SHA for zone list change detection
+static telemetry_t s_telemetry;            // Device samples awaiting POST /telemetry (poll thread only)
+static bool s_telemetry_legacy_pending;    // Bridge lacks /telemetry: put battery on the next poll
 #define MDNS_RECHECK_INTERVAL_MS (3600 * 1000)  // Re-check mDNS every hour if bridge stops responding
 
 // Bridge connection retry tracking (mirrors WiFi retry pattern)
@@ -117,6 +143,35 @@ static int s_bridge_fail_count = 0;
 static int s_mdns_fail_count = 0;
 static char s_device_ip[16] = {0};  // Device IP for recovery messages
 
+// Display wake from sleep: the cached state may be a poll interval (30-60s) old, so the
+// next poll runs at once and volume turns wait for it (guarded by s_state_lock)
+static struct {
+    bool pending;
+    uint32_t gen;       // Bumped per wake; only a poll started after it completes the refresh
+    uint64_t start_ms;
+    int held_steps;     // Turns made before the fresh volume arrived
+} s_wake;
+
+// Queue page request from the UI (one slot, latest wins; guarded by s_state_lock)
+static struct {
+    bool pending;
+    uint32_t generation;
+    int page;
+} s_queue_req;
+
+// Browse requests from the UI (guarded by s_state_lock). One page slot (latest wins);
+// thumbnails are a small ring so only rows that are on screen get fetched.
+#define BROWSE_THUMB_REQUESTS 3
+static struct {
+    bool pending;
+    uint32_t generation;
+    int page;
+    char level[PAGED_LIST_ID_LEN];
+    char cursor[PAGED_LIST_CURSOR_LEN];
+    char thumbs[BROWSE_THUMB_REQUESTS][PAGED_LIST_ID_LEN];
+    int thumb_next;
+} s_browse_req;
+
 static void lock_state(void) {
     os_mutex_lock(&s_state_lock);
 }
@@ -127,7 +182,7 @@ static void unlock_state(void) {
 
 static bool fetch_now_playing(struct now_playing_state *state);
 static bool refresh_zone_label(bool prefer_zone_id);
-static void parse_zones_from_response(const char *resp);
+static bool select_zone_from_list(bool prefer_zone_id);
 static const char *extract_json_string(const char *start, const char *key, char *out, size_t len);
 static bool send_control_json(const char *json);
 static void default_now_playing(struct now_playing_state *state);
@@ -145,6 +200,15 @@ static void post_ui_status_copy(bool *status_copy);
 static void post_ui_zone_name_copy(char *name_copy);
 static void reset_bridge_fail_count(void);
 static void increment_bridge_fail_count(void);
+static void send_volume_steps(int steps);
+
+// Haptic clamp prediction follows the same cached volume as the optimistic UI
+static void publish_haptic_volume(void) {
+#ifdef ESP_PLATFORM
+    haptics_set_volume(s_last_known_volume, s_last_known_volume_min, s_last_known_volume_max,
+                       s_last_known_volume_step);
+#endif
+}
 
 static void ui_update_cb(void *arg) {
     struct now_playing_state *state = arg;
@@ -152,13 +216,58 @@ static void ui_update_cb(void *arg) {
         LOGI("ui_update_cb: state is NULL!");
         return;
     }
+    // Ignore polled volumes that predate our last vol_abs (no snap-back mid-turn)
+    if (s_force_artwork_refresh) {
+        volume_sync_reset_pending(&s_volume_sync);  // New zone: nothing pending, same seq counter
+        group_volume_init(&s_group_volume, VOLUME_SYNC_TIMEOUT_MS);
+    }
+    lock_state();
+    uint64_t now_ms = platform_millis();
+    state->volume = volume_sync_reconcile(&s_volume_sync, state->volume, state->has_volume_seq, state->volume_seq,
+                                          state->volume_step * 0.5f, now_ms);
+    group_volume_update(&s_group_volume, state->outputs, state->output_count, state->has_volume_seq,
+                        state->volume_seq, now_ms);
+    bool grouped = group_volume_active(&s_group_volume);
+    if (grouped) {
+        // The main arc follows the first member (what group steps move), on its own scale:
+        // members of a group can have different ranges than the zone reports
+        const group_output_t *primary = &s_group_volume.outputs[0];
+        state->volume = primary->volume;
+        state->volume_min = primary->volume_min;
+        state->volume_max = primary->volume_max;
+        state->volume_step = primary->volume_step;
+    }
+    unlock_state();
+    if (grouped) {
+        ui_group_volume_refresh(s_group_volume.outputs, s_group_volume.count);
+    } else {
+        ui_group_volume_hide();
+    }
+
     // Cache volume for optimistic UI updates
     s_last_known_volume = state->volume;
     s_last_known_volume_min = state->volume_min;
     s_last_known_volume_max = state->volume_max;
     s_last_known_volume_step = state->volume_step;
+    s_volume_known = true;
+    publish_haptic_volume();
     ui_update(state->line1, state->line2, state->is_playing, state->volume, state->volume_min, state->volume_max, state->volume_step, state->seek_position, state->length);
 
+    // First poll after a wake: turns held meanwhile now apply to the fresh volume
+    lock_state();
+    bool wake_done = s_wake.pending && state->wake_gen == s_wake.gen;
+    int held_steps = s_wake.held_steps;
+    if (wake_done) {
+        s_wake.pending = false;
+        s_wake.held_steps = 0;
+        LOGI("Wake refresh: fresh state after %lu ms (%d held steps)",
+             (unsigned long)(now_ms - s_wake.start_ms), held_steps);
+    }
+    unlock_state();
+    if (wake_done && held_steps != 0) {
+        send_volume_steps(held_steps);
+    }
+
     // Update artwork if image_key changed or forced refresh
     static char last_image_key[128] = "";
     bool force_refresh = s_force_artwork_refresh;
@@ -235,6 +344,9 @@ static void default_now_playing(struct now_playing_state *state) {
     state->volume_step = 0.0f;
     state->seek_position = 0;
     state->length = 0;
+    state->has_volume_seq = false;
+    state->volume_seq = 0;
+    state->output_count = 0;
     state->image_key[0] = '\0';
     state->config_sha[0] = '\0';
     state->zones_sha[0] = '\0';
@@ -315,6 +427,11 @@ static void wait_for_poll_interval(void) {
     }
     uint64_t start = platform_millis();
     while (s_running) {
+        // List pages are served without cutting the now_playing interval short
+        if (s_queue_req.pending) {
+            service_queue_request();
+        }
+        service_browse_requests();
         if (s_trigger_poll) {
             s_trigger_poll = false;
             break;
@@ -389,6 +506,18 @@ static void maybe_update_bridge_base(void) {
     }
 }
 
+// cJSON parse with the CPU at full speed (browse and queue pages run to several KB)
+static cJSON *parse_json(const char *text) {
+#ifdef ESP_PLATFORM
+    pm_work_begin(PM_WORK_NETWORK);
+#endif
+    cJSON *json = cJSON_Parse(text);
+#ifdef ESP_PLATFORM
+    pm_work_end(PM_WORK_NETWORK);
+#endif
+    return json;
+}
+
 static bool fetch_now_playing(struct now_playing_state *state) {
     if (!state) {
         return false;
@@ -405,25 +534,30 @@ static bool fetch_now_playing(struct now_playing_state *state) {
         return false;
     }
 
-    // Get battery status for reporting to bridge
-    int battery_level = platform_battery_get_level();
-    bool battery_charging = platform_battery_is_charging();
-
-    // Get knob ID for config_sha lookup
-    char knob_id[16];
-    platform_http_get_knob_id(knob_id, sizeof(knob_id));
-
+    // Stable per zone: the knob is identified by its X-Knob-Id header and device state
+    // goes out through service_telemetry(). Bridges without /telemetry get the battery
+    // here, only after it changed.
     char url[384];
-    snprintf(url, sizeof(url), "%s/now_playing?zone_id=%s&battery_level=%d&battery_charging=%d&knob_id=%s",
-             bridge_base, zone_id, battery_level, battery_charging ? 1 : 0, knob_id);
+    int url_len = snprintf(url, sizeof(url), "%s/now_playing?zone_id=%s", bridge_base, zone_id);
+    bool legacy_battery = s_telemetry_legacy_pending && s_telemetry.has_last_sent &&
+                          url_len > 0 && (size_t)url_len < sizeof(url);
+    if (legacy_battery) {
+        snprintf(url + url_len, sizeof(url) - url_len, "&battery_level=%d&battery_charging=%d",
+                 s_telemetry.last_sent.battery_level, s_telemetry.last_sent.charging ? 1 : 0);
+    }
 
     char *resp = NULL;
     size_t resp_len = 0;
+    uint64_t start_ms = platform_millis();
     int ret = platform_http_get(url, &resp, &resp_len);
     if (ret != 0 || !resp) {
         platform_http_free(resp);
         return false;
     }
+    telemetry_note_latency(&s_telemetry, (uint32_t)(platform_millis() - start_ms));
+    if (legacy_battery) {
+        s_telemetry_legacy_pending = false;
+    }
 
     if (strstr(resp, "\"error\"") || resp_len == 0) {
         platform_http_free(resp);
@@ -476,6 +610,16 @@ static bool fetch_now_playing(struct now_playing_state *state) {
         }
     }
 
+    state->has_volume_seq = false;
+    const char *vol_seq_key = strstr(resp, "\"volume_seq\"");
+    if (vol_seq_key) {
+        const char *colon = strchr(vol_seq_key, ':');
+        if (colon) {
+            state->volume_seq = (uint32_t)strtoul(colon + 1, NULL, 10);
+            state->has_volume_seq = true;
+        }
+    }
+
     const char *seek_key = strstr(resp, "\"seek_position\"");
     if (seek_key) {
         const char *colon = strchr(seek_key, ':');
@@ -491,6 +635,31 @@ static bool fetch_now_playing(struct now_playing_state *state) {
         }
     }
 
+    // Grouped zones list their member outputs (keys chosen not to collide with the
+    // top-level fields found by strstr above)
+    state->output_count = 0;
+    if (strstr(resp, "\"outputs\"")) {
+        cJSON *json = parse_json(resp);
+        cJSON *outputs = json ? cJSON_GetObjectItem(json, "outputs") : NULL;
+        cJSON *out;
+        cJSON_ArrayForEach(out, outputs) {
+            if (state->output_count >= GROUP_VOLUME_MAX_OUTPUTS) break;
+            cJSON *vol = cJSON_GetObjectItem(out, "vol");
+            if (!cJSON_IsNumber(vol)) continue;  // Fixed-volume output: nothing to trim
+            group_output_t *o = &state->outputs[state->output_count++];
+            copy_json_string(out, "output_id", o->id, sizeof(o->id));
+            copy_json_string(out, "display_name", o->name, sizeof(o->name));
+            cJSON *vmin = cJSON_GetObjectItem(out, "vol_min");
+            cJSON *vmax = cJSON_GetObjectItem(out, "vol_max");
+            cJSON *vstep = cJSON_GetObjectItem(out, "vol_step");
+            o->volume = (float)vol->valuedouble;
+            o->volume_min = cJSON_IsNumber(vmin) ? (float)vmin->valuedouble : state->volume_min;
+            o->volume_max = cJSON_IsNumber(vmax) ? (float)vmax->valuedouble : state->volume_max;
+            o->volume_step = cJSON_IsNumber(vstep) && vstep->valuedouble > 0 ? (float)vstep->valuedouble : 1.0f;
+        }
+        cJSON_Delete(json);
+    }
+
     // Parse image_key for album artwork
     const char *image_key = strstr(resp, "\"image_key\"");
     if (image_key) {
@@ -542,7 +711,6 @@ static bool refresh_zone_label(bool prefer_zone_id) {
 
     char *resp = NULL;
     size_t resp_len = 0;
-    bool success = false;
 
     if (platform_http_get(url, &resp, &resp_len) != 0 || !resp) {
         LOGI("refresh_zone_label: HTTP request failed");
@@ -551,16 +719,28 @@ static bool refresh_zone_label(bool prefer_zone_id) {
     }
 
     LOGI("refresh_zone_label: Received %zu bytes", resp_len);
-    parse_zones_from_response(resp);
+    lock_state();
+    zone_list_parse_full(&s_state.zones, resp);
+    unlock_state();
+    platform_http_free(resp);
+    return select_zone_from_list(prefer_zone_id);
+}
 
+// Resolve the selected zone against s_state.zones. Flash is only written when the
+// selected zone id actually changes (first zone picked, or the saved one disappeared).
+static bool select_zone_from_list(bool prefer_zone_id) {
     char zone_label_copy[MAX_ZONE_NAME] = {0};
+    char prev_zone_id[sizeof(s_state.cfg.zone_id)];
+    bool success = false;
     lock_state();
-    LOGI("refresh_zone_label: Parsed %d zones", s_state.zone_count);
-    if (s_state.zone_count > 0) {
+    LOGI("Zone list: %d zones", s_state.zones.count);
+    strncpy(prev_zone_id, s_state.cfg.zone_id, sizeof(prev_zone_id) - 1);
+    prev_zone_id[sizeof(prev_zone_id) - 1] = '\0';
+    if (s_state.zones.count > 0) {
         bool found = false;
         bool should_sync = false;
-        for (int i = 0; i < s_state.zone_count; ++i) {
-            struct zone_entry *entry = &s_state.zones[i];
+        for (int i = 0; i < s_state.zones.count; ++i) {
+            zone_list_entry_t *entry = &s_state.zones.zones[i];
             if (prefer_zone_id && s_state.cfg.zone_id[0] && strcmp(entry->id, s_state.cfg.zone_id) == 0) {
                 strncpy(s_state.zone_label, entry->name, sizeof(s_state.zone_label) - 1);
                 s_state.zone_label[sizeof(s_state.zone_label) - 1] = '\0';
@@ -580,8 +760,8 @@ static bool refresh_zone_label(bool prefer_zone_id) {
                 break;
             }
         }
-        if (!found && s_state.zone_count > 0) {
-            struct zone_entry *entry = &s_state.zones[0];
+        if (!found && s_state.zones.count > 0) {
+            zone_list_entry_t *entry = &s_state.zones.zones[0];
             strncpy(s_state.cfg.zone_id, entry->id, sizeof(s_state.cfg.zone_id) - 1);
             s_state.cfg.zone_id[sizeof(s_state.cfg.zone_id) - 1] = '\0';
             strncpy(s_state.zone_label, entry->name, sizeof(s_state.zone_label) - 1);
@@ -597,12 +777,14 @@ static bool refresh_zone_label(bool prefer_zone_id) {
         }
         success = should_sync && zone_label_copy[0] != '\0';
     }
+    bool zone_changed = strcmp(prev_zone_id, s_state.cfg.zone_id) != 0;
     unlock_state();
 
-    platform_http_free(resp);
     if (success) {
         LOGI("refresh_zone_label: Selected zone '%s', posting to UI", zone_label_copy);
-        platform_storage_save(&s_state.cfg);
+        if (zone_changed) {
+            platform_storage_save(&s_state.cfg);
+        }
         post_ui_zone_name(zone_label_copy);
     } else {
         LOGI("refresh_zone_label: No zone selected (success=false)");
@@ -610,35 +792,6 @@ static bool refresh_zone_label(bool prefer_zone_id) {
     return success;
 }
 
-static void parse_zones_from_response(const char *resp) {
-    if (!resp) {
-        return;
-    }
-    lock_state();
-    s_state.zone_count = 0;
-    const char *cursor = resp;
-    while (s_state.zone_count < MAX_ZONES && (cursor = strstr(cursor, "\"zone_id\""))) {
-        char id[MAX_ZONE_NAME] = {0};
-        char name[MAX_ZONE_NAME] = {0};
-        const char *next = extract_json_string(cursor, "\"zone_id\"", id, sizeof(id));
-        if (!next) {
-            break;
-        }
-        const char *after_name = extract_json_string(next, "\"zone_name\"", name, sizeof(name));
-        if (!after_name) {
-            cursor = next;
-            continue;
-        }
-        strncpy(s_state.zones[s_state.zone_count].id, id, sizeof(s_state.zones[0].id) - 1);
-        strncpy(s_state.zones[s_state.zone_count].name, name, sizeof(s_state.zones[0].name) - 1);
-        s_state.zones[s_state.zone_count].id[sizeof(s_state.zones[0].id) - 1] = '\0';
-        s_state.zones[s_state.zone_count].name[sizeof(s_state.zones[0].name) - 1] = '\0';
-        s_state.zone_count++;
-        cursor = after_name;
-    }
-    unlock_state();
-}
-
 static const char *extract_json_string(const char *start, const char *key, char *out, size_t len) {
     const char *key_pos = strstr(start, key);
     if (!key_pos) {
@@ -696,9 +849,65 @@ static bool send_control_json(const char *json) {
     return true;
 }
 
+static void sample_telemetry(telemetry_sample_t *sample) {
+    memset(sample, 0, sizeof(*sample));
+    sample->uptime_s = (uint32_t)(platform_millis() / 1000);
+    sample->battery_level = (int8_t)platform_battery_get_level();
+    sample->charging = platform_battery_is_charging();
+#ifdef ESP_PLATFORM
+    sample->rssi = (int8_t)wifi_mgr_get_rssi();
+    sample->free_heap_kb = (uint16_t)(esp_get_free_heap_size() / 1024);
+    sample->display_state = (uint8_t)display_get_state();
+    sample->apl = platform_display_get_apl();
+    sample->panel_load = platform_display_get_panel_load();
+    sample->cpu_boost = pm_locks_boost_pct();
+#else
+    sample->display_state = platform_display_is_sleeping() ? 3 : 0;  // Same values as display_state_t
+#endif
+}
+
+// Sample on a fixed cadence (independent of the poll rate) and POST the batch when the
+// flush interval passes or the battery/charging state changed
+static void service_telemetry(bool bridge_ok) {
+    uint64_t now_ms = platform_millis();
+    if (telemetry_sample_due(&s_telemetry, now_ms)) {
+        telemetry_sample_t sample;
+        sample_telemetry(&sample);
+        telemetry_add_sample(&s_telemetry, &sample, now_ms);
+    }
+    if (!bridge_ok || !telemetry_flush_due(&s_telemetry, now_ms)) {
+        return;
+    }
+
+    static char body[1280];  // 16 samples of ~50 bytes plus the field header
+    if (telemetry_encode(&s_telemetry, body, sizeof(body)) < 0) {
+        LOGW("Telemetry batch too large; dropping %d samples", s_telemetry.count);
+        telemetry_flushed(&s_telemetry, now_ms);
+        return;
+    }
+    char url[256];
+    lock_state();
+    snprintf(url, sizeof(url), "%s/telemetry", s_state.cfg.bridge_base);
+    unlock_state();
+
+    char *resp = NULL;
+    int ret = platform_http_post_json(url, body, &resp, NULL);
+    if (ret != 0) {
+        telemetry_flush_failed(&s_telemetry, now_ms);
+    } else {
+        if (!resp || !strstr(resp, "\"ok\":true")) {
+            // Older bridge: it still reads battery from the now_playing query
+            s_telemetry_legacy_pending = true;
+        }
+        telemetry_flushed(&s_telemetry, now_ms);
+    }
+    platform_http_free(resp);
+}
+
 static void bridge_poll_thread(void *arg) {
     (void)arg;
     LOGI("Bridge poll thread started");
+    telemetry_init(&s_telemetry, TELEMETRY_SAMPLE_MS, TELEMETRY_FLUSH_MS, platform_millis());
     struct now_playing_state state;
     default_now_playing(&state);
     while (s_running) {
@@ -723,9 +932,24 @@ static void bridge_poll_thread(void *arg) {
         if (!s_state.zone_resolved) {
             refresh_zone_label(true);
         }
+        lock_state();
+        uint32_t wake_gen = s_wake.gen;
+        unlock_state();
         bool ok = fetch_now_playing(&state);
+        state.wake_gen = wake_gen;
         post_ui_status(ok);
 
+        if (!ok) {
+            // Bridge unreachable: held turns would fail too, so don't replay them later
+            lock_state();
+            if (s_wake.pending && s_wake.gen == wake_gen) {
+                LOGW("Wake refresh failed; dropping %d held steps", s_wake.held_steps);
+                s_wake.pending = false;
+                s_wake.held_steps = 0;
+            }
+            unlock_state();
+        }
+
         // Track play state for extended sleep polling
         if (ok) {
             s_last_is_playing = state.is_playing;
@@ -739,6 +963,7 @@ static void bridge_poll_thread(void *arg) {
 
         // Always check charging state (works in AP mode too)
         check_charging_state_change();
+        service_telemetry(ok);
 
         // Handle bridge connection status (mirrors WiFi retry pattern)
         if (ok) {
@@ -857,6 +1082,8 @@ void bridge_client_start(const rk_cfg_t *cfg) {
         return;
     }
     platform_task_init();
+    volume_sync_init(&s_volume_sync, VOLUME_SYNC_TIMEOUT_MS);
+    group_volume_init(&s_group_volume, VOLUME_SYNC_TIMEOUT_MS);
     lock_state();
     s_state.cfg = *cfg;
     strncpy(s_state.zone_label, cfg->zone_id[0] ? cfg->zone_id : "Tap here to select zone", sizeof(s_state.zone_label) - 1);
@@ -874,6 +1101,35 @@ void bridge_client_start(const rk_cfg_t *cfg) {
     platform_task_start(bridge_poll_thread, NULL);
 }
 
+// Grouped zone: move every member by `steps` of its own step in one vol_group request.
+// The zone's own volume (first member) is tracked too so the main arc doesn't snap back.
+static void send_group_volume_steps(int steps) {
+    char body[1024];
+    lock_state();
+    uint64_t now_ms = platform_millis();
+    uint32_t seq = volume_sync_next_seq(&s_volume_sync);
+    bool changed = group_volume_step(&s_group_volume, steps, s_state.cfg.zone_id, seq, now_ms, body, sizeof(body));
+    float primary = s_group_volume.outputs[0].volume;
+    float primary_step = s_group_volume.outputs[0].volume_step;
+    if (changed) {
+        s_last_known_volume = primary;
+        volume_sync_expect(&s_volume_sync, seq, primary, now_ms);
+    }
+    unlock_state();
+    if (!changed) {
+        return;  // All members at their limits
+    }
+    publish_haptic_volume();
+
+    ui_show_volume_change(primary, primary_step);
+    ui_group_volume_show(s_group_volume.outputs, s_group_volume.count);
+    if (!send_control_json(body)) {
+        volume_sync_command_failed(&s_volume_sync, seq);
+        group_volume_command_failed(&s_group_volume, seq);
+        post_ui_message("Volume change failed");
+    }
+}
+
 void bridge_client_handle_input(ui_input_event_t event) {
     if (ui_is_zone_picker_visible()) {
         if (event == UI_INPUT_VOL_UP) {
@@ -917,8 +1173,8 @@ void bridge_client_handle_input(ui_input_event_t event) {
             bool updated = false;
             lock_state();
             // Find the zone by ID to get its name
-            for (int i = 0; i < s_state.zone_count; ++i) {
-                struct zone_entry *entry = &s_state.zones[i];
+            for (int i = 0; i < s_state.zones.count; ++i) {
+                zone_list_entry_t *entry = &s_state.zones.zones[i];
                 if (strcmp(entry->id, selected_id) == 0) {
                     LOGI("Zone picker: switching to zone '%s' (id=%s)", entry->name, entry->id);
                     strncpy(s_state.cfg.zone_id, entry->id, sizeof(s_state.cfg.zone_id) - 1);
@@ -974,11 +1230,11 @@ void bridge_client_handle_input(ui_input_event_t event) {
         count++;
 
         lock_state();
-        if (s_state.zone_count > 0) {
-            for (int i = 0; i < s_state.zone_count && count < MAX_ZONES + 2; ++i) {
-                names[count] = s_state.zones[i].name;
-                ids[count] = s_state.zones[i].id;
-                if (strcmp(s_state.zones[i].id, s_state.cfg.zone_id) == 0) {
+        if (s_state.zones.count > 0) {
+            for (int i = 0; i < s_state.zones.count && count < MAX_ZONES + 2; ++i) {
+                names[count] = s_state.zones.zones[i].name;
+                ids[count] = s_state.zones.zones[i].id;
+                if (strcmp(s_state.zones.zones[i].id, s_state.cfg.zone_id) == 0) {
                     selected = count;
                 }
                 count++;
@@ -998,33 +1254,47 @@ void bridge_client_handle_input(ui_input_event_t event) {
     char body[256];
     switch (event) {
     case UI_INPUT_VOL_DOWN: {
+        if (group_volume_active(&s_group_volume)) {
+            send_group_volume_steps(-1);
+            break;
+        }
         lock_state();
         float predicted_down = s_last_known_volume - s_last_known_volume_step;
         if (predicted_down < s_last_known_volume_min) {
             predicted_down = s_last_known_volume_min;
         }
         s_last_known_volume = predicted_down;
-        snprintf(body, sizeof(body), "{\"zone_id\":\"%s\",\"action\":\"vol_abs\",\"value\":%.10g}",
-            s_state.cfg.zone_id, predicted_down);
+        uint32_t seq = volume_sync_local_change(&s_volume_sync, predicted_down, platform_millis());
+        snprintf(body, sizeof(body), "{\"zone_id\":\"%s\",\"action\":\"vol_abs\",\"value\":%.10g,\"seq\":%lu}",
+            s_state.cfg.zone_id, predicted_down, (unsigned long)seq);
         unlock_state();
+        publish_haptic_volume();
         ui_show_volume_change(predicted_down, s_last_known_volume_step);
         if (!send_control_json(body)) {
+            volume_sync_command_failed(&s_volume_sync, seq);
             post_ui_message("Volume change failed");
         }
         break;
     }
     case UI_INPUT_VOL_UP: {
+        if (group_volume_active(&s_group_volume)) {
+            send_group_volume_steps(1);
+            break;
+        }
         lock_state();
         float predicted_up = s_last_known_volume + s_last_known_volume_step;
         if (predicted_up > s_last_known_volume_max) {
             predicted_up = s_last_known_volume_max;
         }
         s_last_known_volume = predicted_up;
-        snprintf(body, sizeof(body), "{\"zone_id\":\"%s\",\"action\":\"vol_abs\",\"value\":%.10g}",
-            s_state.cfg.zone_id, predicted_up);
+        uint32_t seq = volume_sync_local_change(&s_volume_sync, predicted_up, platform_millis());
+        snprintf(body, sizeof(body), "{\"zone_id\":\"%s\",\"action\":\"vol_abs\",\"value\":%.10g,\"seq\":%lu}",
+            s_state.cfg.zone_id, predicted_up, (unsigned long)seq);
         unlock_state();
+        publish_haptic_volume();
         ui_show_volume_change(predicted_up, s_last_known_volume_step);
         if (!send_control_json(body)) {
+            volume_sync_command_failed(&s_volume_sync, seq);
             post_ui_message("Volume change failed");
         }
         break;
@@ -1086,11 +1356,36 @@ void bridge_client_handle_volume_rotation(int ticks) {
     } else {
         step_multiplier = 1;  // Slow rotation (fine-grained control)
     }
+    int steps = ticks > 0 ? step_multiplier : -step_multiplier;
+
+    // Just woke: hold the turn until the refresh poll lands instead of moving a stale volume
+    lock_state();
+    if (s_wake.pending) {
+        if (platform_millis() - s_wake.start_ms < WAKE_REFRESH_TIMEOUT_MS) {
+            s_wake.held_steps += steps;
+            unlock_state();
+            return;
+        }
+        LOGW("Wake refresh slow; applying %d held steps to cached volume", s_wake.held_steps);
+        steps += s_wake.held_steps;
+        s_wake.pending = false;
+        s_wake.held_steps = 0;
+    }
+    unlock_state();
+
+    send_volume_steps(steps);
+}
+
+// Moves the zone by `steps` of its own step in one vol_abs (or vol_group) request
+static void send_volume_steps(int steps) {
+    if (group_volume_active(&s_group_volume)) {
+        send_group_volume_steps(steps);
+        return;
+    }
 
     // Calculate optimistic new volume with clamping (inside lock for consistency)
     lock_state();
-    float delta = step_multiplier * s_last_known_volume_step;
-    float predicted_vol = s_last_known_volume + (ticks > 0 ? delta : -delta);
+    float predicted_vol = s_last_known_volume + steps * s_last_known_volume_step;
     if (predicted_vol < s_last_known_volume_min) {
         predicted_vol = s_last_known_volume_min;
     }
@@ -1100,21 +1395,65 @@ void bridge_client_handle_volume_rotation(int ticks) {
 
     // Update cached volume immediately for next rotation (optimistic tracking)
     s_last_known_volume = predicted_vol;
+    uint32_t seq = volume_sync_local_change(&s_volume_sync, predicted_vol, platform_millis());
 
     // Send volume request to Roon (absolute value for exact match with optimistic UI)
     char body[256];
-    snprintf(body, sizeof(body), "{\"zone_id\":\"%s\",\"action\":\"vol_abs\",\"value\":%.1f}",
-        s_state.cfg.zone_id, predicted_vol);
+    snprintf(body, sizeof(body), "{\"zone_id\":\"%s\",\"action\":\"vol_abs\",\"value\":%.1f,\"seq\":%lu}",
+        s_state.cfg.zone_id, predicted_vol, (unsigned long)seq);
     unlock_state();
+    publish_haptic_volume();
 
     // Show volume overlay immediately with predicted value (optimistic UI)
     ui_show_volume_change(predicted_vol, s_last_known_volume_step);
 
     if (!send_control_json(body)) {
+        volume_sync_command_failed(&s_volume_sync, seq);
         post_ui_message("Volume change failed");
     }
 }
 
+bool bridge_client_handle_volume_steps(int steps) {
+    lock_state();
+    bool ready = s_device_state == DEVICE_STATE_OPERATIONAL && s_volume_known;
+    unlock_state();
+    if (!ready) {
+        return false;
+    }
+    if (steps != 0) {
+        send_volume_steps(steps);
+    }
+    return true;
+}
+
+// Scrub mode (ui.c) throttles these; position is absolute
+bool bridge_client_seek(int position) {
+    char body[160];
+    lock_state();
+    snprintf(body, sizeof(body), "{\"zone_id\":\"%s\",\"action\":\"seek\",\"position\":%d}",
+             s_state.cfg.zone_id, position);
+    unlock_state();
+    return send_control_json(body);
+}
+
+void bridge_client_wake_refresh(void) {
+    lock_state();
+    // Before OPERATIONAL the poll loop is already on its fast startup path
+    bool operational = (s_device_state == DEVICE_STATE_OPERATIONAL);
+    if (operational) {
+        if (!s_wake.pending) {
+            s_wake.held_steps = 0;
+            s_wake.start_ms = platform_millis();
+        }
+        s_wake.gen++;
+        s_wake.pending = true;
+    }
+    unlock_state();
+    if (operational && s_network_ready) {
+        s_trigger_poll = true;  // Cut the sleeping poll interval short
+    }
+}
+
 void bridge_client_set_network_ready(bool ready) {
     s_network_ready = ready;
 
@@ -1160,11 +1499,374 @@ const char* bridge_client_get_artwork_url(char *url_buf, size_t buf_len, int wid
 
 bool bridge_client_is_ready_for_art_mode(void) {
     lock_state();
-    bool ready = s_state.zone_count > 0;
+    bool ready = s_state.zones.count > 0;
     unlock_state();
     return ready;
 }
 
+// ============================================================================
+// Up-next queue paging
+// ============================================================================
+
+// Result handed to the UI thread (freed by the callback)
+struct queue_page_result {
+    uint32_t generation;
+    int page;
+    int total;
+    int count;
+    bool ok;
+    paged_list_item_t items[PAGED_LIST_PAGE_SIZE];
+};
+
+static void ui_queue_page_cb(void *arg) {
+    struct queue_page_result *res = arg;
+    if (!res) return;
+    ui_queue_page_loaded(res->generation, res->page, res->total, res->items, res->count, res->ok);
+    free(res);
+}
+
+static void copy_json_string(cJSON *obj, const char *key, char *out, size_t len) {
+    cJSON *item = cJSON_GetObjectItem(obj, key);
+    if (cJSON_IsString(item) && item->valuestring) {
+        strncpy(out, item->valuestring, len - 1);
+        out[len - 1] = '\0';
+    } else if (cJSON_IsNumber(item)) {
+        snprintf(out, len, "%.0f", item->valuedouble);  // Roon queue ids are numeric
+    } else {
+        out[0] = '\0';
+    }
+}
+
+// Poll thread: fetch the requested page of GET /queue?zone_id=&offset=&limit=
+static void service_queue_request(void) {
+    lock_state();
+    if (!s_queue_req.pending) {
+        unlock_state();
+        return;
+    }
+    s_queue_req.pending = false;
+    uint32_t generation = s_queue_req.generation;
+    int page = s_queue_req.page;
+    char bridge_base[sizeof(s_state.cfg.bridge_base)];
+    char zone_id[sizeof(s_state.cfg.zone_id)];
+    strncpy(bridge_base, s_state.cfg.bridge_base, sizeof(bridge_base) - 1);
+    bridge_base[sizeof(bridge_base) - 1] = '\0';
+    strncpy(zone_id, s_state.cfg.zone_id, sizeof(zone_id) - 1);
+    zone_id[sizeof(zone_id) - 1] = '\0';
+    unlock_state();
+
+    struct queue_page_result *res = calloc(1, sizeof(*res));
+    if (!res) return;
+    res->generation = generation;
+    res->page = page;
+
+    if (bridge_base[0] && zone_id[0]) {
+        char url[384];
+        snprintf(url, sizeof(url), "%s/queue?zone_id=%s&offset=%d&limit=%d",
+                 bridge_base, zone_id, page * PAGED_LIST_PAGE_SIZE, PAGED_LIST_PAGE_SIZE);
+        uint64_t start = platform_millis();
+        char *resp = NULL;
+        size_t resp_len = 0;
+        if (platform_http_get(url, &resp, &resp_len) == 0 && resp && resp_len > 0) {
+            cJSON *json = parse_json(resp);
+            cJSON *items = json ? cJSON_GetObjectItem(json, "items") : NULL;
+            cJSON *total = json ? cJSON_GetObjectItem(json, "total") : NULL;
+            if (cJSON_IsArray(items) && cJSON_IsNumber(total)) {
+                res->total = total->valueint;
+                cJSON *it;
+                cJSON_ArrayForEach(it, items) {
+                    if (res->count >= PAGED_LIST_PAGE_SIZE) break;
+                    paged_list_item_t *dst = &res->items[res->count++];
+                    copy_json_string(it, "queue_item_id", dst->id, sizeof(dst->id));
+                    copy_json_string(it, "title", dst->line1, sizeof(dst->line1));
+                    copy_json_string(it, "subtitle", dst->line2, sizeof(dst->line2));
+                }
+                res->ok = true;
+            } else {
+                LOGW("Queue page %d: unexpected response", page);
+            }
+            cJSON_Delete(json);
+        }
+        platform_http_free(resp);
+        LOGI("Queue page %d: %d/%d items in %ums", page, res->count, res->total,
+             (unsigned)(platform_millis() - start));
+    }
+    platform_task_post_to_ui(ui_queue_page_cb, res);
+}
+
+void bridge_client_request_queue_page(uint32_t generation, int page) {
+    lock_state();
+    s_queue_req.generation = generation;
+    s_queue_req.page = page;
+    s_queue_req.pending = true;
+    unlock_state();
+}
+
+bool bridge_client_queue_play_from(const char *queue_item_id) {
+    if (!queue_item_id || !queue_item_id[0]) {
+        return false;
+    }
+    char body[256];
+    lock_state();
+    snprintf(body, sizeof(body), "{\"zone_id\":\"%s\",\"action\":\"play_from_here\",\"queue_item_id\":\"%s\"}",
+             s_state.cfg.zone_id, queue_item_id);
+    unlock_state();
+    return send_control_json(body);
+}
+
+// ============================================================================
+// Library browse
+// ============================================================================
+
+struct browse_page_result {
+    uint32_t generation;
+    int page;
+    int total;
+    int count;
+    bool ok;
+    char title[PAGED_LIST_TEXT_LEN];
+    char next_cursor[PAGED_LIST_CURSOR_LEN];
+    paged_list_item_t items[PAGED_LIST_PAGE_SIZE];
+};
+
+struct browse_thumb_result {
+    char key[PAGED_LIST_ID_LEN];
+    uint8_t *pixels;
+    size_t len;
+};
+
+static void ui_browse_page_cb(void *arg) {
+    struct browse_page_result *res = arg;
+    if (!res) return;
+    ui_browse_page_loaded(res->generation, res->page, res->total, res->title, res->items, res->count,
+                          res->next_cursor, res->ok);
+    free(res);
+}
+
+static void ui_browse_thumb_cb(void *arg) {
+    struct browse_thumb_result *res = arg;
+    if (!res) return;
+    ui_browse_thumb_loaded(res->key, res->pixels, res->len);  // Takes ownership of pixels
+    free(res);
+}
+
+// Copy bridge_base/zone_id under the lock; false if either is unset
+static bool copy_bridge_target(char *bridge_base, size_t base_len, char *zone_id, size_t zone_len) {
+    lock_state();
+    strncpy(bridge_base, s_state.cfg.bridge_base, base_len - 1);
+    bridge_base[base_len - 1] = '\0';
+    strncpy(zone_id, s_state.cfg.zone_id, zone_len - 1);
+    zone_id[zone_len - 1] = '\0';
+    unlock_state();
+    return bridge_base[0] && zone_id[0];
+}
+
+// Percent-encode a bridge-issued token (level, cursor, image key) for a query string.
+// Browse cursors are opaque and often base64, so '+', '/' and '=' must survive intact.
+// Returns false if it doesn't fit.
+static bool url_encode_param(const char *src, char *dst, size_t len) {
+    static const char hex[] = "0123456789ABCDEF";
+    size_t pos = 0;
+    for (const unsigned char *p = (const unsigned char *)src; *p; p++) {
+        bool plain = (*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z') || (*p >= '0' && *p <= '9') ||
+                     *p == '-' || *p == '_' || *p == '.' || *p == '~';
+        size_t need = plain ? 1 : 3;
+        if (pos + need >= len) {
+            return false;
+        }
+        if (plain) {
+            dst[pos++] = (char)*p;
+        } else {
+            dst[pos++] = '%';
+            dst[pos++] = hex[*p >> 4];
+            dst[pos++] = hex[*p & 0x0F];
+        }
+    }
+    dst[pos] = '\0';
+    return true;
+}
+
+// GET /browse?zone_id=&level=&cursor=&limit= -> {title, items[], next_cursor, total?}
+static void fetch_browse_page(uint32_t generation, int page, const char *level, const char *cursor) {
+    struct browse_page_result *res = calloc(1, sizeof(*res));
+    if (!res) return;
+    res->generation = generation;
+    res->page = page;
+    res->total = -1;
+
+    char bridge_base[sizeof(s_state.cfg.bridge_base)];
+    char zone_id[sizeof(s_state.cfg.zone_id)];
+    char level_enc[PAGED_LIST_ID_LEN * 3];
+    char cursor_enc[PAGED_LIST_CURSOR_LEN * 3];
+    char url[512];
+    bool url_ok = copy_bridge_target(bridge_base, sizeof(bridge_base), zone_id, sizeof(zone_id)) &&
+                  url_encode_param(level, level_enc, sizeof(level_enc)) &&
+                  url_encode_param(cursor, cursor_enc, sizeof(cursor_enc));
+    if (url_ok) {
+        int n = snprintf(url, sizeof(url), "%s/browse?zone_id=%s&level=%s&cursor=%s&limit=%d", bridge_base,
+                         zone_id, level_enc, cursor_enc, PAGED_LIST_PAGE_SIZE);
+        url_ok = n > 0 && (size_t)n < sizeof(url);
+        if (!url_ok) {
+            LOGW("Browse page %d: URL too long", page);
+        }
+    }
+    if (url_ok) {
+        uint64_t start = platform_millis();
+        char *resp = NULL;
+        size_t resp_len = 0;
+        if (platform_http_get(url, &resp, &resp_len) == 0 && resp && resp_len > 0) {
+            cJSON *json = parse_json(resp);
+            cJSON *items = json ? cJSON_GetObjectItem(json, "items") : NULL;
+            if (cJSON_IsArray(items)) {
+                cJSON *total = cJSON_GetObjectItem(json, "total");
+                if (cJSON_IsNumber(total)) {
+                    res->total = total->valueint;
+                }
+                copy_json_string(json, "title", res->title, sizeof(res->title));
+                copy_json_string(json, "next_cursor", res->next_cursor, sizeof(res->next_cursor));
+                const char *next = cJSON_GetStringValue(cJSON_GetObjectItem(json, "next_cursor"));
+                if (next && strlen(next) >= sizeof(res->next_cursor)) {
+                    // A truncated opaque cursor would fetch the wrong page
+                    LOGW("Browse page %d: next_cursor too long, list ends here", page);
+                    res->next_cursor[0] = '\0';
+                }
+                cJSON *it;
+                cJSON_ArrayForEach(it, items) {
+                    if (res->count >= PAGED_LIST_PAGE_SIZE) break;
+                    paged_list_item_t *dst = &res->items[res->count++];
+                    copy_json_string(it, "item_key", dst->id, sizeof(dst->id));
+                    copy_json_string(it, "title", dst->line1, sizeof(dst->line1));
+                    copy_json_string(it, "subtitle", dst->line2, sizeof(dst->line2));
+                    copy_json_string(it, "image_key", dst->image_key, sizeof(dst->image_key));
+                    cJSON *hint = cJSON_GetObjectItem(it, "hint");
+                    if (cJSON_IsString(hint) && strcmp(hint->valuestring, "list") == 0) {
+                        dst->flags |= PAGED_LIST_ITEM_CONTAINER;
+                    }
+                }
+                res->ok = true;
+            } else {
+                LOGW("Browse page %d: unexpected response", page);
+            }
+            cJSON_Delete(json);
+        }
+        platform_http_free(resp);
+        LOGI("Browse page %d (%s): %d items in %ums", page, level[0] ? level : "root", res->count,
+             (unsigned)(platform_millis() - start));
+    }
+    platform_task_post_to_ui(ui_browse_page_cb, res);
+}
+
+// GET /browse/image?image_key=&width=&height=&format=rgb565 (same raw format as artwork)
+static void fetch_browse_thumb(const char *image_key) {
+    char bridge_base[sizeof(s_state.cfg.bridge_base)];
+    char zone_id[sizeof(s_state.cfg.zone_id)];
+    if (!copy_bridge_target(bridge_base, sizeof(bridge_base), zone_id, sizeof(zone_id))) {
+        return;
+    }
+    char key_enc[PAGED_LIST_ID_LEN * 3];
+    char url[512];
+    if (!url_encode_param(image_key, key_enc, sizeof(key_enc))) {
+        return;
+    }
+    int n = snprintf(url, sizeof(url), "%s/browse/image?image_key=%s&width=%d&height=%d&format=rgb565",
+                     bridge_base, key_enc, BROWSE_THUMB_SIZE, BROWSE_THUMB_SIZE);
+    if (n <= 0 || (size_t)n >= sizeof(url)) {
+        LOGW("Browse thumb %s: URL too long", image_key);
+        return;
+    }
+    char *resp = NULL;
+    size_t resp_len = 0;
+    const size_t expected = BROWSE_THUMB_SIZE * BROWSE_THUMB_SIZE * 2;
+    if (platform_http_get_image(url, &resp, &resp_len) != 0 || resp_len != expected) {
+        LOGW("Browse thumb %s: fetch failed (%zu bytes)", image_key, resp_len);
+        platform_http_free(resp);
+        return;
+    }
+    struct browse_thumb_result *res = calloc(1, sizeof(*res));
+    if (!res) {
+        platform_http_free(resp);
+        return;
+    }
+    strncpy(res->key, image_key, sizeof(res->key) - 1);
+    res->pixels = (uint8_t *)resp;  // platform_http_free() is free()
+    res->len = resp_len;
+    platform_task_post_to_ui(ui_browse_thumb_cb, res);
+}
+
+// Poll thread: pages first (they gate navigation), then at most one thumbnail per pass
+static void service_browse_requests(void) {
+    uint32_t generation = 0;
+    int page = -1;
+    char level[PAGED_LIST_ID_LEN] = {0};
+    char cursor[PAGED_LIST_CURSOR_LEN] = {0};
+    char thumb[PAGED_LIST_ID_LEN] = {0};
+
+    lock_state();
+    if (s_browse_req.pending) {
+        s_browse_req.pending = false;
+        generation = s_browse_req.generation;
+        page = s_browse_req.page;
+        memcpy(level, s_browse_req.level, sizeof(level));
+        memcpy(cursor, s_browse_req.cursor, sizeof(cursor));
+    } else {
+        for (int i = 0; i < BROWSE_THUMB_REQUESTS; i++) {
+            if (s_browse_req.thumbs[i][0]) {
+                memcpy(thumb, s_browse_req.thumbs[i], sizeof(thumb));
+                s_browse_req.thumbs[i][0] = '\0';
+                break;
+            }
+        }
+    }
+    unlock_state();
+
+    if (page >= 0) {
+        fetch_browse_page(generation, page, level, cursor);
+    } else if (thumb[0]) {
+        fetch_browse_thumb(thumb);
+    }
+}
+
+void bridge_client_request_browse_page(uint32_t generation, const char *level_key, const char *cursor, int page) {
+    lock_state();
+    s_browse_req.generation = generation;
+    s_browse_req.page = page;
+    strncpy(s_browse_req.level, level_key ? level_key : "", sizeof(s_browse_req.level) - 1);
+    s_browse_req.level[sizeof(s_browse_req.level) - 1] = '\0';
+    strncpy(s_browse_req.cursor, cursor ? cursor : "", sizeof(s_browse_req.cursor) - 1);
+    s_browse_req.cursor[sizeof(s_browse_req.cursor) - 1] = '\0';
+    s_browse_req.pending = true;
+    unlock_state();
+}
+
+void bridge_client_request_browse_thumb(const char *image_key) {
+    if (!image_key || !image_key[0]) return;
+    lock_state();
+    for (int i = 0; i < BROWSE_THUMB_REQUESTS; i++) {
+        if (strcmp(s_browse_req.thumbs[i], image_key) == 0) {
+            unlock_state();
+            return;
+        }
+    }
+    // Overwrite the oldest request: rows scrolled off screen aren't worth fetching
+    char *slot = s_browse_req.thumbs[s_browse_req.thumb_next];
+    strncpy(slot, image_key, PAGED_LIST_ID_LEN - 1);
+    slot[PAGED_LIST_ID_LEN - 1] = '\0';
+    s_browse_req.thumb_next = (s_browse_req.thumb_next + 1) % BROWSE_THUMB_REQUESTS;
+    unlock_state();
+}
+
+bool bridge_client_browse_play(const char *item_key) {
+    if (!item_key || !item_key[0]) {
+        return false;
+    }
+    char body[256];
+    lock_state();
+    snprintf(body, sizeof(body), "{\"zone_id\":\"%s\",\"action\":\"browse_play\",\"item_key\":\"%s\"}",
+             s_state.cfg.zone_id, item_key);
+    unlock_state();
+    return send_control_json(body);
+}
+
 // Bridge retry tracking functions
 static void reset_bridge_fail_count(void) {
     s_bridge_fail_count = 0;
@@ -1209,6 +1911,17 @@ bool bridge_client_get_bridge_url(char *buf, size_t len) {
     return has_bridge;
 }
 
+bool bridge_client_get_zone_id(char *buf, size_t len) {
+    if (!buf || len == 0) {
+        return false;
+    }
+    lock_state();
+    strncpy(buf, s_state.cfg.zone_id, len - 1);
+    buf[len - 1] = '\0';
+    unlock_state();
+    return buf[0] != '\0';
+}
+
 bool bridge_client_is_bridge_connected(void) {
     return s_last_net_ok;
 }
@@ -1301,8 +2014,74 @@ static void check_zones_sha(const char *new_sha) {
         strncpy(s_last_zones_sha, new_sha, sizeof(s_last_zones_sha) - 1);
         s_last_zones_sha[sizeof(s_last_zones_sha) - 1] = '\0';
 
-        // Re-fetch zones from bridge
+        sync_zone_list();
+    }
+}
+
+// Ask for "changes since" the sha our list matches and apply them in place. Falls back to
+// a full fetch when the list sha is unknown or the bridge can't answer with a delta.
+static void sync_zone_list(void) {
+    lock_state();
+    char bridge_base[sizeof(s_state.cfg.bridge_base)];
+    char since[ZONE_LIST_SHA_LEN];
+    strncpy(bridge_base, s_state.cfg.bridge_base, sizeof(bridge_base) - 1);
+    bridge_base[sizeof(bridge_base) - 1] = '\0';
+    memcpy(since, s_state.zones.sha, sizeof(since));
+    unlock_state();
+    if (!since[0] || bridge_base[0] == '\0') {
+        refresh_zone_label(true);
+        return;
+    }
+
+    char knob_id[16];
+    platform_http_get_knob_id(knob_id, sizeof(knob_id));
+    char url[256];
+    snprintf(url, sizeof(url), "%s/zones?knob_id=%s&since=%s", bridge_base, knob_id, since);
+
+    char *resp = NULL;
+    size_t resp_len = 0;
+    if (platform_http_get(url, &resp, &resp_len) != 0 || !resp) {
+        platform_http_free(resp);
+        return;  // zones_sha still differs; retried on the next poll
+    }
+
+    zone_list_delta_t delta;
+    bool is_delta = zone_list_is_delta(resp);
+    bool applied = false;
+    bool selected_gone = false;
+    char label_copy[MAX_ZONE_NAME] = {0};
+    lock_state();
+    if (!is_delta) {
+        zone_list_parse_full(&s_state.zones, resp);  // Older bridge: ignores "since"
+    } else if (zone_list_apply_delta(&s_state.zones, resp, &delta)) {
+        applied = true;
+        int sel = zone_list_find(&s_state.zones, s_state.cfg.zone_id);
+        selected_gone = (sel < 0);
+        if (sel >= 0 && strcmp(s_state.zone_label, s_state.zones.zones[sel].name) != 0) {
+            strncpy(s_state.zone_label, s_state.zones.zones[sel].name, sizeof(s_state.zone_label) - 1);
+            s_state.zone_label[sizeof(s_state.zone_label) - 1] = '\0';
+            strncpy(label_copy, s_state.zone_label, sizeof(label_copy) - 1);
+        }
+    }
+    unlock_state();
+    platform_http_free(resp);
+
+    if (!is_delta) {
+        LOGI("Zone sync: full list (%zu bytes)", resp_len);
+        select_zone_from_list(true);
+        return;
+    }
+    if (!applied) {
+        LOGW("Zone sync: delta since %s rejected, refetching full list", since);
         refresh_zone_label(true);
+        return;
+    }
+    LOGI("Zone sync: delta %zu bytes, +%d ~%d -%d (%d unchanged)", resp_len, delta.added, delta.renamed,
+         delta.removed, delta.unchanged);
+    if (selected_gone) {
+        select_zone_from_list(true);  // Picks a new zone and saves it
+    } else if (label_copy[0]) {
+        post_ui_zone_name(label_copy);  // Selected zone renamed: label only, no flash write
     }
 }
 
@@ -1337,7 +2116,7 @@ static bool fetch_knob_config(void) {
     }
 
     // Parse JSON response using cJSON
-    cJSON *root = cJSON_Parse(resp);
+    cJSON *root = parse_json(resp);
     platform_http_free(resp);
 
     if (!root) {
@@ -4,11 +4,15 @@
 #include "ui.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 void bridge_client_start(const rk_cfg_t *cfg);
 void bridge_client_handle_input(ui_input_event_t event);
 void bridge_client_handle_volume_rotation(int ticks);  // Velocity-sensitive volume control
+bool bridge_client_handle_volume_steps(int steps);     // Exact step count; false until volume is known
+bool bridge_client_seek(int position);  // Absolute seek in seek_position units (seconds)
 void bridge_client_set_network_ready(bool ready);
+void bridge_client_wake_refresh(void);  // Display woke: poll now, hold volume turns until fresh
 const char* bridge_client_get_artwork_url(char *url_buf, size_t buf_len, int width, int height);
 bool bridge_client_is_ready_for_art_mode(void);
 
@@ -17,5 +21,17 @@ void bridge_client_set_device_ip(const char *ip);  // Call when WiFi gets IP
 int bridge_client_get_bridge_retry_count(void);    // Current retry attempt (0 = connected)
 int bridge_client_get_bridge_retry_max(void);      // Max retries before showing recovery info
 bool bridge_client_get_bridge_url(char *buf, size_t len);  // Get configured bridge URL
+bool bridge_client_get_zone_id(char *buf, size_t len);     // Get selected zone id
 bool bridge_client_is_bridge_connected(void);      // True if bridge is responding
 bool bridge_client_is_bridge_mdns(void);           // True if bridge was discovered via mDNS (persisted)
+
+// Up-next queue (ui_queue.c). Pages are fetched on the poll thread; only the latest
+// request is kept. Results arrive via ui_queue_page_loaded() on the UI thread.
+void bridge_client_request_queue_page(uint32_t generation, int page);
+bool bridge_client_queue_play_from(const char *queue_item_id);  // "Play from here"
+
+// Library browse (ui_browse.c). Pages and thumbnails are fetched on the poll thread;
+// results arrive via ui_browse_page_loaded() / ui_browse_thumb_loaded() on the UI thread.
+void bridge_client_request_browse_page(uint32_t generation, const char *level_key, const char *cursor, int page);
+void bridge_client_request_browse_thumb(const char *image_key);
+bool bridge_client_browse_play(const char *item_key);
@@ -0,0 +1,84 @@
+#include "browse_model.h"
+
+#include <string.h>
+
+static void copy_str(char *dst, size_t len, const char *src) {
+    strncpy(dst, src ? src : "", len - 1);
+    dst[len - 1] = '\0';
+}
+
+void browse_model_init(browse_model_t *model, const char *root_title) {
+    uint32_t next_generation = model->next_generation;
+    memset(model, 0, sizeof(*model));
+    model->next_generation = next_generation;
+    model->depth = 1;
+    copy_str(model->stack[0].title, sizeof(model->stack[0].title), root_title);
+}
+
+browse_crumb_t *browse_model_crumb(browse_model_t *model) {
+    return &model->stack[model->depth - 1];
+}
+
+browse_level_t *browse_model_level(browse_model_t *model, bool *was_cached) {
+    browse_crumb_t *crumb = browse_model_crumb(model);
+    browse_level_t *victim = &model->levels[0];
+
+    for (int i = 0; i < BROWSE_LEVEL_CACHE; i++) {
+        browse_level_t *lvl = &model->levels[i];
+        if (lvl->used && strcmp(lvl->key, crumb->key) == 0) {
+            lvl->last_used = ++model->clock;
+            model->hits++;
+            if (was_cached) *was_cached = true;
+            return lvl;
+        }
+        if (!lvl->used) {
+            if (victim->used) victim = lvl;
+        } else if (victim->used && lvl->last_used < victim->last_used) {
+            victim = lvl;
+        }
+    }
+
+    // Miss: recycle the least recently used level (an evicted ancestor is simply
+    // refetched when the user backs out to it)
+    model->misses++;
+    memset(victim, 0, sizeof(*victim));
+    victim->used = true;
+    copy_str(victim->key, sizeof(victim->key), crumb->key);
+    copy_str(victim->title, sizeof(victim->title), crumb->title);
+    victim->last_used = ++model->clock;
+    victim->list.generation = model->next_generation;
+    paged_list_reset(&victim->list);  // Bumps to a generation no other level has used
+    model->next_generation = victim->list.generation;
+    paged_list_set_cursor_mode(&victim->list, true);
+    if (was_cached) *was_cached = false;
+    return victim;
+}
+
+browse_level_t *browse_model_find_generation(browse_model_t *model, uint32_t generation) {
+    for (int i = 0; i < BROWSE_LEVEL_CACHE; i++) {
+        browse_level_t *lvl = &model->levels[i];
+        if (lvl->used && lvl->list.generation == generation) {
+            return lvl;
+        }
+    }
+    return NULL;
+}
+
+bool browse_model_push(browse_model_t *model, const char *key, const char *title) {
+    if (model->depth >= BROWSE_MAX_DEPTH || !key || !key[0]) {
+        return false;
+    }
+    browse_crumb_t *crumb = &model->stack[model->depth++];
+    copy_str(crumb->key, sizeof(crumb->key), key);
+    copy_str(crumb->title, sizeof(crumb->title), title);
+    crumb->selected = 0;
+    return true;
+}
+
+bool browse_model_pop(browse_model_t *model) {
+    if (model->depth <= 1) {
+        return false;
+    }
+    model->depth--;
+    return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+// Library browse navigation state: a breadcrumb stack plus an LRU cache of visited levels.
+// Each level owns a cursor-mode paged_list, so going back to a cached level is instant
+// (no fetch) and keeps its pages. Portable, UI thread only.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "paged_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BROWSE_MAX_DEPTH 8       // Root + 7 levels (e.g. Library > Artists > Albums > Tracks)
+#define BROWSE_LEVEL_CACHE 4     // Levels kept in memory (~21KB each)
+#define BROWSE_KEY_LEN PAGED_LIST_ID_LEN
+
+typedef struct {
+    bool used;
+    char key[BROWSE_KEY_LEN];    // "" = root
+    char title[PAGED_LIST_TEXT_LEN];
+    uint32_t last_used;
+    paged_list_t list;
+} browse_level_t;
+
+typedef struct {
+    char key[BROWSE_KEY_LEN];
+    char title[PAGED_LIST_TEXT_LEN];
+    int selected;
+} browse_crumb_t;
+
+typedef struct {
+    browse_level_t levels[BROWSE_LEVEL_CACHE];
+    browse_crumb_t stack[BROWSE_MAX_DEPTH];
+    int depth;                   // Crumbs on the stack; current level = stack[depth - 1]
+    uint32_t clock;
+    uint32_t next_generation;    // Unique per level instance so responses find their level
+    uint32_t hits;               // Level cache statistics
+    uint32_t misses;
+} browse_model_t;
+
+// Start at the root level
+void browse_model_init(browse_model_t *model, const char *root_title);
+
+// Current crumb (never NULL after init)
+browse_crumb_t *browse_model_crumb(browse_model_t *model);
+
+// Cached level for the current crumb, creating (and evicting LRU) if needed.
+// *was_cached tells whether the level's pages survived from an earlier visit.
+browse_level_t *browse_model_level(browse_model_t *model, bool *was_cached);
+
+// Level whose list has the given generation (for routing fetch results), or NULL
+browse_level_t *browse_model_find_generation(browse_model_t *model, uint32_t generation);
+
+// Descend into `key`; false at max depth
+bool browse_model_push(browse_model_t *model, const char *key, const char *title);
+
+// Go up one level; false at the root
+bool browse_model_pop(browse_model_t *model);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,269 @@
+#include "chip_link.h"
+
+#include <string.h>
+
+enum {
+    DEC_HUNT = 0,
+    DEC_TYPE,
+    DEC_LEN_LO,
+    DEC_LEN_HI,
+    DEC_PAYLOAD,
+    DEC_CRC,
+    DEC_END,
+};
+
+// Field tags (shared numbering; each message uses its own subset)
+enum {
+    TAG_SSID = 1,
+    TAG_PASS,
+    TAG_BRIDGE,
+    TAG_ZONE,
+    TAG_INTERVAL,
+    TAG_SEQ = 16,
+    TAG_PLAYING,
+    TAG_VOLUME,        // Volumes are centi-units (i32) so both chips agree exactly
+    TAG_VOLUME_MIN,
+    TAG_VOLUME_MAX,
+    TAG_VOLUME_STEP,
+    TAG_SEEK,
+    TAG_LENGTH,
+    TAG_LINE1,
+    TAG_LINE2,
+};
+
+// ============================================================================
+// Framing
+// ============================================================================
+
+// CRC-8, polynomial 0x07 (ATM); bitwise - frames are short and the table would cost 256 bytes
+uint8_t chip_link_crc8(const uint8_t *data, size_t len, uint8_t crc) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t chip_link_encode(uint8_t type, const uint8_t *payload, size_t len, uint8_t *out, size_t cap) {
+    if (len > CHIP_LINK_MAX_PAYLOAD || cap < len + CHIP_LINK_OVERHEAD) {
+        return 0;
+    }
+    out[0] = CHIP_LINK_START;
+    out[1] = type;
+    out[2] = (uint8_t)(len & 0xFF);
+    out[3] = (uint8_t)(len >> 8);
+    if (len > 0) {
+        memcpy(out + 4, payload, len);
+    }
+    out[4 + len] = chip_link_crc8(out + 1, len + 3, 0);
+    out[5 + len] = CHIP_LINK_END;
+    return len + CHIP_LINK_OVERHEAD;
+}
+
+void chip_link_decoder_init(chip_link_decoder_t *d) {
+    memset(d, 0, sizeof(*d));
+    d->state = DEC_HUNT;
+}
+
+bool chip_link_feed(chip_link_decoder_t *d, uint8_t byte) {
+    switch (d->state) {
+    case DEC_HUNT:
+        if (byte == CHIP_LINK_START) {
+            d->state = DEC_TYPE;
+        }
+        return false;
+    case DEC_TYPE:
+        d->type = byte;
+        d->crc = chip_link_crc8(&byte, 1, 0);
+        d->state = DEC_LEN_LO;
+        return false;
+    case DEC_LEN_LO:
+        d->len = byte;
+        d->crc = chip_link_crc8(&byte, 1, d->crc);
+        d->state = DEC_LEN_HI;
+        return false;
+    case DEC_LEN_HI:
+        d->len |= (uint16_t)(byte << 8);
+        d->crc = chip_link_crc8(&byte, 1, d->crc);
+        if (d->len > CHIP_LINK_MAX_PAYLOAD) {
+            d->framing_errors++;
+            d->state = byte == CHIP_LINK_START ? DEC_TYPE : DEC_HUNT;
+            return false;
+        }
+        d->pos = 0;
+        d->state = d->len > 0 ? DEC_PAYLOAD : DEC_CRC;
+        return false;
+    case DEC_PAYLOAD:
+        d->payload[d->pos++] = byte;
+        d->crc = chip_link_crc8(&byte, 1, d->crc);
+        if (d->pos == d->len) {
+            d->state = DEC_CRC;
+        }
+        return false;
+    case DEC_CRC:
+        if (byte != d->crc) {
+            d->crc_errors++;
+            d->state = byte == CHIP_LINK_START ? DEC_TYPE : DEC_HUNT;
+            return false;
+        }
+        d->state = DEC_END;
+        return false;
+    case DEC_END:
+        if (byte != CHIP_LINK_END) {
+            d->framing_errors++;
+            d->state = byte == CHIP_LINK_START ? DEC_TYPE : DEC_HUNT;
+            return false;
+        }
+        d->state = DEC_HUNT;
+        d->frames++;
+        return true;
+    default:
+        d->state = DEC_HUNT;
+        return false;
+    }
+}
+
+// ============================================================================
+// Payload fields
+// ============================================================================
+
+bool chip_link_put_field(uint8_t *buf, size_t cap, size_t *off, uint8_t tag, const void *data, size_t len) {
+    if (len > 255 || *off + 2 + len > cap) {
+        return false;
+    }
+    buf[*off] = tag;
+    buf[*off + 1] = (uint8_t)len;
+    if (len > 0) {
+        memcpy(buf + *off + 2, data, len);
+    }
+    *off += 2 + len;
+    return true;
+}
+
+bool chip_link_put_str(uint8_t *buf, size_t cap, size_t *off, uint8_t tag, const char *s) {
+    size_t len = strlen(s);
+    return chip_link_put_field(buf, cap, off, tag, s, len > 255 ? 255 : len);
+}
+
+bool chip_link_put_u32(uint8_t *buf, size_t cap, size_t *off, uint8_t tag, uint32_t v) {
+    uint8_t le[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+    return chip_link_put_field(buf, cap, off, tag, le, sizeof(le));
+}
+
+bool chip_link_next_field(const uint8_t *buf, size_t len, size_t *off, uint8_t *tag, const uint8_t **data,
+                          uint8_t *flen) {
+    if (*off + 2 > len) {
+        return false;
+    }
+    uint8_t n = buf[*off + 1];
+    if (*off + 2 + n > len) {
+        return false;
+    }
+    *tag = buf[*off];
+    *flen = n;
+    *data = buf + *off + 2;
+    *off += 2 + n;
+    return true;
+}
+
+static uint32_t get_u32(const uint8_t *data, uint8_t len) {
+    if (len != 4) {
+        return 0;
+    }
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static void get_str(const uint8_t *data, uint8_t len, char *out, size_t cap) {
+    size_t n = len < cap - 1 ? len : cap - 1;
+    memcpy(out, data, n);
+    out[n] = '\0';
+}
+
+static int32_t to_centi(float v) {
+    return (int32_t)(v * 100.0f + (v < 0 ? -0.5f : 0.5f));
+}
+
+// ============================================================================
+// Messages
+// ============================================================================
+
+size_t chip_link_watch_encode(const chip_link_watch_t *w, uint8_t *buf, size_t cap) {
+    size_t off = 0;
+    bool ok = chip_link_put_str(buf, cap, &off, TAG_SSID, w->ssid) &&
+              chip_link_put_str(buf, cap, &off, TAG_PASS, w->pass) &&
+              chip_link_put_str(buf, cap, &off, TAG_BRIDGE, w->bridge_base) &&
+              chip_link_put_str(buf, cap, &off, TAG_ZONE, w->zone_id) &&
+              chip_link_put_u32(buf, cap, &off, TAG_INTERVAL, w->interval_ms);
+    return ok ? off : 0;
+}
+
+bool chip_link_watch_decode(const uint8_t *buf, size_t len, chip_link_watch_t *w) {
+    memset(w, 0, sizeof(*w));
+    size_t off = 0;
+    uint8_t tag, flen;
+    const uint8_t *data;
+    while (chip_link_next_field(buf, len, &off, &tag, &data, &flen)) {
+        switch (tag) {
+        case TAG_SSID: get_str(data, flen, w->ssid, sizeof(w->ssid)); break;
+        case TAG_PASS: get_str(data, flen, w->pass, sizeof(w->pass)); break;
+        case TAG_BRIDGE: get_str(data, flen, w->bridge_base, sizeof(w->bridge_base)); break;
+        case TAG_ZONE: get_str(data, flen, w->zone_id, sizeof(w->zone_id)); break;
+        case TAG_INTERVAL: w->interval_ms = get_u32(data, flen); break;
+        default: break;  // Unknown tags are skipped (newer sender)
+        }
+    }
+    return off == len && w->ssid[0] && w->bridge_base[0] && w->zone_id[0];
+}
+
+size_t chip_link_now_playing_encode(const chip_link_now_playing_t *np, uint8_t *buf, size_t cap) {
+    size_t off = 0;
+    bool ok = chip_link_put_u32(buf, cap, &off, TAG_SEQ, np->seq) &&
+              chip_link_put_u32(buf, cap, &off, TAG_PLAYING, np->playing ? 1 : 0) &&
+              chip_link_put_u32(buf, cap, &off, TAG_VOLUME, (uint32_t)to_centi(np->volume)) &&
+              chip_link_put_u32(buf, cap, &off, TAG_VOLUME_MIN, (uint32_t)to_centi(np->volume_min)) &&
+              chip_link_put_u32(buf, cap, &off, TAG_VOLUME_MAX, (uint32_t)to_centi(np->volume_max)) &&
+              chip_link_put_u32(buf, cap, &off, TAG_VOLUME_STEP, (uint32_t)to_centi(np->volume_step)) &&
+              chip_link_put_u32(buf, cap, &off, TAG_SEEK, (uint32_t)np->seek_position) &&
+              chip_link_put_u32(buf, cap, &off, TAG_LENGTH, (uint32_t)np->length) &&
+              chip_link_put_str(buf, cap, &off, TAG_LINE1, np->line1) &&
+              chip_link_put_str(buf, cap, &off, TAG_LINE2, np->line2);
+    return ok ? off : 0;
+}
+
+bool chip_link_now_playing_decode(const uint8_t *buf, size_t len, chip_link_now_playing_t *np) {
+    memset(np, 0, sizeof(*np));
+    np->volume_step = 1.0f;
+    size_t off = 0;
+    uint8_t tag, flen;
+    const uint8_t *data;
+    bool has_seq = false;
+    while (chip_link_next_field(buf, len, &off, &tag, &data, &flen)) {
+        switch (tag) {
+        case TAG_SEQ: np->seq = get_u32(data, flen); has_seq = true; break;
+        case TAG_PLAYING: np->playing = get_u32(data, flen) != 0; break;
+        case TAG_VOLUME: np->volume = (int32_t)get_u32(data, flen) / 100.0f; break;
+        case TAG_VOLUME_MIN: np->volume_min = (int32_t)get_u32(data, flen) / 100.0f; break;
+        case TAG_VOLUME_MAX: np->volume_max = (int32_t)get_u32(data, flen) / 100.0f; break;
+        case TAG_VOLUME_STEP: np->volume_step = (int32_t)get_u32(data, flen) / 100.0f; break;
+        case TAG_SEEK: np->seek_position = (int32_t)get_u32(data, flen); break;
+        case TAG_LENGTH: np->length = (int32_t)get_u32(data, flen); break;
+        case TAG_LINE1: get_str(data, flen, np->line1, sizeof(np->line1)); break;
+        case TAG_LINE2: get_str(data, flen, np->line2, sizeof(np->line2)); break;
+        default: break;
+        }
+    }
+    return off == len && has_seq;
+}
+
+uint8_t chip_link_now_playing_wake_reason(const chip_link_now_playing_t *prev, const chip_link_now_playing_t *cur) {
+    uint8_t reason = 0;
+    if (strcmp(prev->line1, cur->line1) != 0 || strcmp(prev->line2, cur->line2) != 0) {
+        reason |= CHIP_LINK_WAKE_TRACK;
+    }
+    if (prev->playing != cur->playing) {
+        reason |= CHIP_LINK_WAKE_PLAYBACK;
+    }
+    return reason;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+// Framed link between the ESP32-S3 and the board's secondary ESP32 (UART, 1 Mbps).
+// Frame: 0x7E | type | len (u16 LE) | payload | CRC-8 (type..payload) | 0x7F.
+// Payloads are sequences of fields: tag (u8) | len (u8) | bytes. Portable, no I/O;
+// both firmwares share this file so the format cannot drift.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHIP_LINK_START 0x7E
+#define CHIP_LINK_END 0x7F
+#define CHIP_LINK_MAX_PAYLOAD 384
+#define CHIP_LINK_OVERHEAD 6
+#define CHIP_LINK_MAX_FRAME (CHIP_LINK_MAX_PAYLOAD + CHIP_LINK_OVERHEAD)
+
+// Commands (S3 -> ESP32)
+#define CHIP_LINK_CMD_WATCH          0x30  // Watch config fields: start polling the bridge
+#define CHIP_LINK_CMD_UNWATCH        0x31  // S3 is awake and owns the network again
+#define CHIP_LINK_CMD_STATE_REQUEST  0x32  // Reply with EVT_NOW_PLAYING (cached)
+#define CHIP_LINK_CMD_PING           0xF0
+
+// Events (ESP32 -> S3)
+#define CHIP_LINK_EVT_NOW_PLAYING    0x40  // Now-playing fields
+#define CHIP_LINK_EVT_WAKE           0x41  // u8 reason; sent alongside the wake line pulse
+#define CHIP_LINK_EVT_PONG           0xF1
+#define CHIP_LINK_EVT_ACK            0xFE  // u8 command type
+#define CHIP_LINK_EVT_ERROR          0xFF  // u8 code
+
+#define CHIP_LINK_WAKE_TRACK    0x01
+#define CHIP_LINK_WAKE_PLAYBACK 0x02
+
+#define CHIP_LINK_ERR_NO_STATE  0x01   // STATE_REQUEST before the first successful poll
+#define CHIP_LINK_ERR_BAD_FRAME 0x02
+
+// ============================================================================
+// Framing
+// ============================================================================
+
+uint8_t chip_link_crc8(const uint8_t *data, size_t len, uint8_t crc);
+
+// Returns frame length, or 0 if the payload is too long or `cap` too small
+size_t chip_link_encode(uint8_t type, const uint8_t *payload, size_t len, uint8_t *out, size_t cap);
+
+typedef struct {
+    int state;
+    uint8_t type;
+    uint16_t len;
+    uint16_t pos;
+    uint8_t crc;
+    uint8_t payload[CHIP_LINK_MAX_PAYLOAD];
+    uint32_t frames;        // Statistics
+    uint32_t crc_errors;
+    uint32_t framing_errors;
+} chip_link_decoder_t;
+
+void chip_link_decoder_init(chip_link_decoder_t *d);
+
+// Feed one received byte. Returns true when a complete, CRC-valid frame is available
+// in d->type / d->payload / d->len (valid until the next call). Noise and broken frames
+// are skipped by hunting for the next start byte.
+bool chip_link_feed(chip_link_decoder_t *d, uint8_t byte);
+
+// ============================================================================
+// Payload fields
+// ============================================================================
+
+bool chip_link_put_field(uint8_t *buf, size_t cap, size_t *off, uint8_t tag, const void *data, size_t len);
+bool chip_link_put_str(uint8_t *buf, size_t cap, size_t *off, uint8_t tag, const char *s);
+bool chip_link_put_u32(uint8_t *buf, size_t cap, size_t *off, uint8_t tag, uint32_t v);
+
+// Iterate fields; returns false at the end or on a truncated field
+bool chip_link_next_field(const uint8_t *buf, size_t len, size_t *off, uint8_t *tag, const uint8_t **data,
+                          uint8_t *flen);
+
+// Bridge watch handed to the secondary chip before the S3 sleeps
+typedef struct {
+    char ssid[33];
+    char pass[65];
+    char bridge_base[128];
+    char zone_id[64];
+    uint32_t interval_ms;
+} chip_link_watch_t;
+
+size_t chip_link_watch_encode(const chip_link_watch_t *w, uint8_t *buf, size_t cap);
+bool chip_link_watch_decode(const uint8_t *buf, size_t len, chip_link_watch_t *w);
+
+// Cached now-playing state. Lines are truncated to fit one field each.
+typedef struct {
+    uint32_t seq;              // Bumped by the secondary on every change
+    bool playing;
+    float volume;
+    float volume_min;
+    float volume_max;
+    float volume_step;
+    int32_t seek_position;
+    int32_t length;
+    char line1[128];
+    char line2[128];
+} chip_link_now_playing_t;
+
+size_t chip_link_now_playing_encode(const chip_link_now_playing_t *np, uint8_t *buf, size_t cap);
+bool chip_link_now_playing_decode(const uint8_t *buf, size_t len, chip_link_now_playing_t *np);
+
+// Worth waking the S3 for: new track or play/pause (not seek or volume drift).
+// Returns a CHIP_LINK_WAKE_* reason, or 0.
+uint8_t chip_link_now_playing_wake_reason(const chip_link_now_playing_t *prev, const chip_link_now_playing_t *cur);
+
+#ifdef __cplusplus
+}
+#endif
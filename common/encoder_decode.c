@@ -0,0 +1,35 @@
+#include "encoder_decode.h"
+
+void encoder_decode_init(encoder_decode_t *d, uint8_t a_level, uint8_t b_level) {
+    d->a_level = a_level;
+    d->b_level = b_level;
+    d->a_debounce = 0;
+    d->b_debounce = 0;
+    d->count = 0;
+}
+
+// Returns 1 when this sample completes a debounced low -> high release
+static int channel_sample(uint8_t level, uint8_t *prev_level, uint8_t *debounce) {
+    int released = 0;
+    if (level == 0) {
+        if (level != *prev_level) {
+            *debounce = 0;
+        } else if (*debounce < ENCODER_DECODE_DEBOUNCE) {  // Saturate: the release increment must not wrap
+            (*debounce)++;
+        }
+    } else {
+        if (level != *prev_level && ++(*debounce) >= ENCODER_DECODE_DEBOUNCE) {
+            released = 1;
+        }
+        *debounce = 0;
+    }
+    *prev_level = level;
+    return released;
+}
+
+int encoder_decode_sample(encoder_decode_t *d, uint8_t a_level, uint8_t b_level) {
+    int delta = channel_sample(a_level, &d->a_level, &d->a_debounce) -
+                channel_sample(b_level, &d->b_level, &d->b_debounce);
+    d->count += delta;
+    return delta;
+}
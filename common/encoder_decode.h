@@ -0,0 +1,31 @@
+#pragma once
+
+// Knob encoder decoding from sampled pin levels (vendor scheme): each channel counts one
+// detent when it returns high after staying low for `debounce` samples; A counts +1,
+// B counts -1. Shared by the main firmware's 3ms poll and the ULP program that keeps
+// counting in deep sleep, so both see the same detents. No libc: builds for the ULP.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ENCODER_DECODE_DEBOUNCE 2  // Samples low before a release counts (6ms at 3ms polling)
+
+typedef struct {
+    uint8_t a_level;
+    uint8_t b_level;
+    uint8_t a_debounce;
+    uint8_t b_debounce;
+    int32_t count;        // Running total (+A, -B)
+} encoder_decode_t;
+
+void encoder_decode_init(encoder_decode_t *d, uint8_t a_level, uint8_t b_level);
+
+// One sample of both pins; returns the detents it produced (-1, 0 or +1)
+int encoder_decode_sample(encoder_decode_t *d, uint8_t a_level, uint8_t b_level);
+
+#ifdef __cplusplus
+}
+#endif
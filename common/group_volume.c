@@ -0,0 +1,88 @@
+#include "group_volume.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void group_volume_init(group_volume_t *g, uint32_t timeout_ms) {
+    memset(g, 0, sizeof(*g));
+    g->timeout_ms = timeout_ms;
+}
+
+static int find_output(const group_volume_t *g, const char *id) {
+    for (int i = 0; i < g->count; i++) {
+        if (strcmp(g->outputs[i].id, id) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void group_volume_update(group_volume_t *g, const group_output_t *polled, int count,
+                         bool has_seq, uint32_t polled_seq, uint64_t now_ms) {
+    if (count > GROUP_VOLUME_MAX_OUTPUTS) count = GROUP_VOLUME_MAX_OUTPUTS;
+
+    volume_sync_t sync[GROUP_VOLUME_MAX_OUTPUTS];
+    for (int i = 0; i < count; i++) {
+        int prev = find_output(g, polled[i].id);
+        if (prev >= 0) {
+            sync[i] = g->sync[prev];
+        } else {
+            volume_sync_init(&sync[i], g->timeout_ms);  // New member
+        }
+    }
+
+    g->count = count;
+    for (int i = 0; i < count; i++) {
+        g->outputs[i] = polled[i];
+        g->sync[i] = sync[i];
+        float tolerance = polled[i].volume_step * 0.5f;
+        g->outputs[i].volume = volume_sync_reconcile(&g->sync[i], polled[i].volume, has_seq, polled_seq,
+                                                     tolerance, now_ms);
+    }
+}
+
+bool group_volume_step(group_volume_t *g, int steps, const char *zone_id, uint32_t seq, uint64_t now_ms,
+                       char *body, size_t body_len) {
+    if (g->count < 1 || steps == 0 || !body || body_len == 0) {
+        return false;
+    }
+
+    float targets[GROUP_VOLUME_MAX_OUTPUTS];
+    bool changed = false;
+    for (int i = 0; i < g->count; i++) {
+        const group_output_t *o = &g->outputs[i];
+        float step = o->volume_step > 0.0f ? o->volume_step : 1.0f;
+        float t = o->volume + steps * step;
+        if (t < o->volume_min) t = o->volume_min;
+        if (t > o->volume_max) t = o->volume_max;
+        targets[i] = t;
+        if (t != o->volume) changed = true;
+    }
+    if (!changed) {
+        return false;  // Every member is pinned at its limit
+    }
+
+    int len = snprintf(body, body_len, "{\"zone_id\":\"%s\",\"action\":\"vol_group\",\"seq\":%lu,\"outputs\":[",
+                       zone_id, (unsigned long)seq);
+    for (int i = 0; i < g->count && len > 0 && (size_t)len < body_len; i++) {
+        len += snprintf(body + len, body_len - len, "%s{\"output_id\":\"%s\",\"value\":%.10g}",
+                        i ? "," : "", g->outputs[i].id, targets[i]);
+    }
+    if (len <= 0 || (size_t)len + 3 > body_len) {
+        body[0] = '\0';
+        return false;  // Too many members for the buffer
+    }
+    snprintf(body + len, body_len - len, "]}");
+
+    for (int i = 0; i < g->count; i++) {
+        g->outputs[i].volume = targets[i];
+        volume_sync_expect(&g->sync[i], seq, targets[i], now_ms);
+    }
+    return true;
+}
+
+void group_volume_command_failed(group_volume_t *g, uint32_t seq) {
+    for (int i = 0; i < g->count; i++) {
+        volume_sync_command_failed(&g->sync[i], seq);
+    }
+}
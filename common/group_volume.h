@@ -0,0 +1,60 @@
+#pragma once
+
+// Volume for grouped zones (Roon groups, LMS sync groups). The bridge lists the member
+// outputs in now_playing; each encoder step moves every member by its own step size, so
+// relative trims between rooms are preserved, and all targets go out in one batched
+// vol_group request. Optimistic state is tracked per output (volume_sync). Portable.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "volume_sync.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GROUP_VOLUME_MAX_OUTPUTS 8
+#define GROUP_VOLUME_ID_LEN 64
+#define GROUP_VOLUME_NAME_LEN 32
+
+// One output as reported by the bridge
+typedef struct {
+    char id[GROUP_VOLUME_ID_LEN];
+    char name[GROUP_VOLUME_NAME_LEN];
+    float volume;
+    float volume_min;
+    float volume_max;
+    float volume_step;
+} group_output_t;
+
+typedef struct {
+    int count;                                       // Members; < 2 means not grouped
+    group_output_t outputs[GROUP_VOLUME_MAX_OUTPUTS];  // Displayed (reconciled) state
+    volume_sync_t sync[GROUP_VOLUME_MAX_OUTPUTS];    // Per-output optimistic state
+    uint32_t timeout_ms;
+} group_volume_t;
+
+void group_volume_init(group_volume_t *g, uint32_t timeout_ms);
+
+static inline bool group_volume_active(const group_volume_t *g) {
+    return g->count > 1;
+}
+
+// Merge a polled member list. Outputs keep their pending state across polls (matched by
+// id); polled volumes that predate our last command are replaced by the optimistic ones.
+void group_volume_update(group_volume_t *g, const group_output_t *polled, int count,
+                         bool has_seq, uint32_t polled_seq, uint64_t now_ms);
+
+// Move every member by `steps` of its own step size (clamped per output) and write the
+// batched control body, tagged with `seq`, into `body`. False if nothing changed.
+bool group_volume_step(group_volume_t *g, int steps, const char *zone_id, uint32_t seq, uint64_t now_ms,
+                       char *body, size_t body_len);
+
+// The batched command wasn't delivered: drop the optimistic state for `seq`
+void group_volume_command_failed(group_volume_t *g, uint32_t seq);
+
+#ifdef __cplusplus
+}
+#endif
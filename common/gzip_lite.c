@@ -0,0 +1,176 @@
+#include "gzip_lite.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HASH_BITS 11
+#define HASH_SIZE (1u << HASH_BITS)
+#define WINDOW 32768u
+#define MIN_MATCH 3
+#define MAX_MATCH 258
+#define MAX_CHAIN 16  // Candidates checked per position (hash chains through `prev`)
+
+static const uint16_t s_len_base[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                        31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t s_len_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                        2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t s_dist_base[30] = {1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+                                         33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+                                         1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t s_dist_extra[30] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                         6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+typedef struct {
+    uint8_t *out;
+    size_t cap;
+    size_t pos;
+    uint32_t bits;
+    int nbits;
+    bool overflow;
+} bit_writer_t;
+
+static void put_bits(bit_writer_t *w, uint32_t value, int n) {
+    w->bits |= value << w->nbits;
+    w->nbits += n;
+    while (w->nbits >= 8) {
+        if (w->pos < w->cap) {
+            w->out[w->pos++] = (uint8_t)w->bits;
+        } else {
+            w->overflow = true;
+        }
+        w->bits >>= 8;
+        w->nbits -= 8;
+    }
+}
+
+// Huffman codes go out most significant bit first
+static void put_code(bit_writer_t *w, uint32_t code, int n) {
+    uint32_t rev = 0;
+    for (int i = 0; i < n; i++) {
+        rev = (rev << 1) | ((code >> i) & 1);
+    }
+    put_bits(w, rev, n);
+}
+
+// Literal/length symbol with the fixed code
+static void put_symbol(bit_writer_t *w, int sym) {
+    if (sym < 144) {
+        put_code(w, 0x30 + sym, 8);
+    } else if (sym < 256) {
+        put_code(w, 0x190 + (sym - 144), 9);
+    } else if (sym < 280) {
+        put_code(w, sym - 256, 7);
+    } else {
+        put_code(w, 0xC0 + (sym - 280), 8);
+    }
+}
+
+static void put_match(bit_writer_t *w, int len, int dist) {
+    int i = 28;
+    while (s_len_base[i] > len) {
+        i--;
+    }
+    put_symbol(w, 257 + i);
+    put_bits(w, len - s_len_base[i], s_len_extra[i]);
+    int d = 29;
+    while (s_dist_base[d] > dist) {
+        d--;
+    }
+    put_code(w, d, 5);
+    put_bits(w, dist - s_dist_base[d], s_dist_extra[d]);
+}
+
+static uint32_t hash3(const uint8_t *p) {
+    return ((p[0] << 10) ^ (p[1] << 5) ^ p[2]) & (HASH_SIZE - 1);
+}
+
+static uint32_t crc32(const uint8_t *p, size_t n) {
+    static const uint32_t nibble[16] = {
+        0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+        0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c,
+    };
+    uint32_t crc = 0xffffffff;
+    for (size_t i = 0; i < n; i++) {
+        crc ^= p[i];
+        crc = (crc >> 4) ^ nibble[crc & 15];
+        crc = (crc >> 4) ^ nibble[crc & 15];
+    }
+    return ~crc;
+}
+
+size_t gzip_lite_compress(const uint8_t *in, size_t n, uint8_t *out, size_t cap) {
+    static const uint8_t header[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+    // Chains store position + 1 in 16 bits; the last indexed position is n - MIN_MATCH,
+    // so 64 KB inputs still fit
+    if (n > 65536 || cap < sizeof(header) + 8) {
+        return 0;
+    }
+    // head[h]: last position + 1 with that hash; prev[i]: previous position + 1 in the chain
+    uint16_t *head = calloc(HASH_SIZE + n, sizeof(uint16_t));
+    if (!head) {
+        return 0;
+    }
+    uint16_t *prev = head + HASH_SIZE;
+
+    memcpy(out, header, sizeof(header));
+    bit_writer_t w = {.out = out, .cap = cap - 8, .pos = sizeof(header)};
+    put_bits(&w, 1, 1);  // BFINAL
+    put_bits(&w, 1, 2);  // BTYPE = fixed Huffman
+
+    size_t i = 0;
+    while (i < n && !w.overflow) {
+        int best_len = 0;
+        size_t best_dist = 0;
+        if (i + MIN_MATCH <= n) {
+            uint32_t h = hash3(in + i);
+            size_t max_len = n - i < MAX_MATCH ? n - i : MAX_MATCH;
+            uint16_t cand = head[h];
+            for (int chain = 0; cand && chain < MAX_CHAIN; chain++) {
+                size_t j = cand - 1;
+                if (i - j > WINDOW) {
+                    break;
+                }
+                size_t len = 0;
+                while (len < max_len && in[j + len] == in[i + len]) {
+                    len++;
+                }
+                if ((int)len > best_len) {
+                    best_len = (int)len;
+                    best_dist = i - j;
+                    if (len == max_len) {
+                        break;
+                    }
+                }
+                cand = prev[j];
+            }
+        }
+        size_t step = best_len >= MIN_MATCH ? (size_t)best_len : 1;
+        if (best_len >= MIN_MATCH) {
+            put_match(&w, best_len, (int)best_dist);
+        } else {
+            put_symbol(&w, in[i]);
+        }
+        // Index every position covered, so later matches can start inside this one
+        for (size_t k = i; k < i + step && k + MIN_MATCH <= n; k++) {
+            uint32_t h = hash3(in + k);
+            prev[k] = head[h];
+            head[h] = (uint16_t)(k + 1);
+        }
+        i += step;
+    }
+    free(head);
+
+    put_symbol(&w, 256);  // End of block
+    put_bits(&w, 0, 7);   // Flush the last byte
+    if (w.overflow) {
+        return 0;
+    }
+    uint32_t crc = crc32(in, n);
+    uint8_t *t = out + w.pos;
+    for (int b = 0; b < 4; b++) {
+        t[b] = (uint8_t)(crc >> (8 * b));
+        t[4 + b] = (uint8_t)(n >> (8 * b));
+    }
+    return w.pos + 8;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+// Small gzip encoder for pre-rendered HTTP bodies: LZ77 over a hash of 3-byte prefixes
+// and the fixed Huffman code of RFC 1951, so there are no tables to build. The setup
+// form (~3 KB) comes out at about half its size (zlib -9 manages ~45%), which helps a
+// phone on a congested setup AP. Inputs up to 64 KB (65536 bytes). Portable, no locking.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bound on the compressed size of n input bytes (fixed-code literals are at most 9 bits)
+#define GZIP_LITE_BOUND(n) ((n) + (n) / 8 + 32)
+
+// Compress in[0..n) into a gzip member. Returns the compressed size, or 0 if it doesn't
+// fit in cap, the input is over 64 KB, or the work table can't be allocated.
+size_t gzip_lite_compress(const uint8_t *in, size_t n, uint8_t *out, size_t cap);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,51 @@
+#include "haptic_sched.h"
+
+#include <string.h>
+
+void haptic_sched_init(haptic_sched_t *hs, uint32_t detent_ms, uint32_t clamp_ms) {
+    memset(hs, 0, sizeof(*hs));
+    hs->detent_ms = detent_ms;
+    hs->clamp_ms = clamp_ms;
+}
+
+void haptic_sched_set_volume(haptic_sched_t *hs, float volume, float volume_min, float volume_max, float volume_step) {
+    hs->volume_known = volume_max > volume_min;
+    hs->volume = volume;
+    hs->volume_min = volume_min;
+    hs->volume_max = volume_max;
+    hs->volume_step = volume_step > 0.0f ? volume_step : 1.0f;
+}
+
+haptic_effect_t haptic_sched_ticks(haptic_sched_t *hs, int delta, bool volume_mode, uint64_t now_ms) {
+    if (delta == 0) {
+        return HAPTIC_NONE;
+    }
+    int dir = delta > 0 ? 1 : -1;
+
+    if (volume_mode && hs->volume_known) {
+        float headroom = dir > 0 ? hs->volume_max - hs->volume : hs->volume - hs->volume_min;
+        if (headroom < hs->volume_step * 0.5f) {
+            if (hs->clamp_dir == dir) {
+                hs->suppressed++;
+                return HAPTIC_NONE;  // Still pushing against the same limit
+            }
+            hs->clamp_dir = dir;
+            hs->busy_until_ms = now_ms + hs->clamp_ms;  // Preempts a running click
+            hs->played++;
+            return HAPTIC_CLAMP;
+        }
+        hs->clamp_dir = 0;
+        float next = hs->volume + (float)delta * hs->volume_step;
+        if (next > hs->volume_max) next = hs->volume_max;
+        if (next < hs->volume_min) next = hs->volume_min;
+        hs->volume = next;
+    }
+
+    if (now_ms < hs->busy_until_ms) {
+        hs->suppressed++;  // Coalesced: the motor is still moving from the last click
+        return HAPTIC_NONE;
+    }
+    hs->busy_until_ms = now_ms + hs->detent_ms;
+    hs->played++;
+    return HAPTIC_DETENT;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+// Haptic detent scheduling: decides, per encoder report, whether to play a detent click,
+// a stronger clamp bump, or nothing. Tracks a predicted volume between authoritative
+// updates so limits are felt immediately, plays one bump per push against a limit, and
+// drops clicks while the previous effect is still running (fast spins coalesce into a
+// steady click train instead of a buzz). Portable; caller provides locking.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    HAPTIC_NONE = 0,
+    HAPTIC_DETENT,   // Light click per effective step
+    HAPTIC_CLAMP,    // Stronger bump at volume min/max
+} haptic_effect_t;
+
+typedef struct {
+    bool volume_known;
+    float volume;              // Predicted, corrected by haptic_sched_set_volume()
+    float volume_min;
+    float volume_max;
+    float volume_step;
+    int clamp_dir;             // Direction already bumped against a limit (0 = none)
+    uint64_t busy_until_ms;    // Current effect still playing
+    uint32_t detent_ms;        // Effect durations (motor busy time)
+    uint32_t clamp_ms;
+    uint32_t played;           // Statistics
+    uint32_t suppressed;
+} haptic_sched_t;
+
+void haptic_sched_init(haptic_sched_t *hs, uint32_t detent_ms, uint32_t clamp_ms);
+
+// Authoritative volume (after each optimistic change and poll)
+void haptic_sched_set_volume(haptic_sched_t *hs, float volume, float volume_min, float volume_max, float volume_step);
+
+// Encoder report of `delta` detents. volume_mode=false (lists, scrubbing): plain clicks.
+haptic_effect_t haptic_sched_ticks(haptic_sched_t *hs, int delta, bool volume_mode, uint64_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
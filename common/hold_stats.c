@@ -0,0 +1,43 @@
+#include "hold_stats.h"
+
+#include <string.h>
+
+void hold_stats_init(hold_stats_t *h) {
+    memset(h, 0, sizeof(*h));
+}
+
+void hold_stats_begin(hold_stats_t *h, uint64_t now_us) {
+    if (h->depth++ == 0) {
+        h->since_us = now_us;
+    }
+}
+
+void hold_stats_end(hold_stats_t *h, uint64_t now_us) {
+    if (h->depth == 0) {
+        return;  // Unbalanced end: ignore rather than wrap
+    }
+    if (--h->depth > 0) {
+        return;
+    }
+    uint64_t held = now_us > h->since_us ? now_us - h->since_us : 0;
+    h->total_us += held;
+    h->window_total_us += held;
+    h->count++;
+    if (held > h->max_us) {
+        h->max_us = held > UINT32_MAX ? UINT32_MAX : (uint32_t)held;
+    }
+}
+
+uint64_t hold_stats_total_us(const hold_stats_t *h, uint64_t now_us) {
+    uint64_t total = h->total_us;
+    if (h->depth > 0 && now_us > h->since_us) {
+        total += now_us - h->since_us;
+    }
+    return total;
+}
+
+void hold_stats_reset_window(hold_stats_t *h) {
+    h->count = 0;
+    h->max_us = 0;
+    h->window_total_us = 0;
+}
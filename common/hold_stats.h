@@ -0,0 +1,36 @@
+#pragma once
+
+// Hold-time statistics for a nestable lock: how often it was taken, for how long in
+// total and at most. Nested begin/end pairs (several tasks in the same kind of work)
+// count as one hold from the first begin to the last end. The total runs since boot;
+// count and max restart with each reporting window. Portable; caller provides locking.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t depth;          // Open begins
+    uint64_t since_us;       // Start of the current hold
+    uint64_t total_us;       // Held time of completed holds since boot
+    uint32_t count;          // Holds completed in this window
+    uint32_t max_us;         // Longest hold completed in this window
+    uint64_t window_total_us;
+} hold_stats_t;
+
+void hold_stats_init(hold_stats_t *h);
+
+void hold_stats_begin(hold_stats_t *h, uint64_t now_us);
+void hold_stats_end(hold_stats_t *h, uint64_t now_us);
+
+// Held time since boot, including a hold still open at now_us
+uint64_t hold_stats_total_us(const hold_stats_t *h, uint64_t now_us);
+
+// Start a new window for count, max and the window total
+void hold_stats_reset_window(hold_stats_t *h);
+
+#ifdef __cplusplus
+}
+#endif
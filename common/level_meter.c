@@ -0,0 +1,158 @@
+#include "level_meter.h"
+
+#include <string.h>
+
+#define LEVEL_METER_VERSION 1
+#define LEVEL_METER_DECAY_PER_POP 24   // Level units removed per stale pop (~0.3s to silence)
+
+static uint32_t read_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void write_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+bool level_meter_parse(const uint8_t *buf, size_t len, level_frame_t *out) {
+    if (!buf || len < LEVEL_METER_HEADER_LEN || memcmp(buf, "RKLM", 4) != 0 || buf[4] != LEVEL_METER_VERSION) {
+        return false;
+    }
+    uint8_t bands = buf[5];
+    if (bands == 0 || bands > LEVEL_METER_MAX_BANDS || len < LEVEL_METER_HEADER_LEN + (size_t)bands) {
+        return false;
+    }
+    out->seq = read_u32(buf + 8);
+    out->sender_ms = read_u32(buf + 12);
+    out->bands = bands;
+    memcpy(out->levels, buf + LEVEL_METER_HEADER_LEN, bands);
+    return true;
+}
+
+size_t level_meter_encode(const level_frame_t *frame, uint8_t *buf, size_t len) {
+    size_t total = LEVEL_METER_HEADER_LEN + frame->bands;
+    if (frame->bands == 0 || frame->bands > LEVEL_METER_MAX_BANDS || len < total) {
+        return 0;
+    }
+    memcpy(buf, "RKLM", 4);
+    buf[4] = LEVEL_METER_VERSION;
+    buf[5] = frame->bands;
+    buf[6] = 0;
+    buf[7] = 0;
+    write_u32(buf + 8, frame->seq);
+    write_u32(buf + 12, frame->sender_ms);
+    memcpy(buf + LEVEL_METER_HEADER_LEN, frame->levels, frame->bands);
+    return total;
+}
+
+void level_jitter_init(level_jitter_t *jb) {
+    memset(jb, 0, sizeof(*jb));
+}
+
+// Wraparound-safe a > b
+static bool seq_after(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) > 0;
+}
+
+void level_jitter_push(level_jitter_t *jb, const level_frame_t *frame, uint64_t now_ms) {
+    if (jb->received && now_ms - jb->last_rx_ms >= LEVEL_METER_STALE_MS) {
+        // Stream restarted (new sender clock and sequence): resync from scratch
+        jb->synced = false;
+        jb->played_any = false;
+        memset(jb->used, 0, sizeof(jb->used));
+    }
+    jb->received++;
+    jb->last_rx_ms = now_ms;
+    if (jb->played_any && !seq_after(frame->seq, jb->last_played_seq)) {
+        jb->dropped_late++;  // Duplicate or arrived after a newer frame was shown
+        return;
+    }
+
+    // Track the smallest sender->local offset: the least-delayed packet defines the clock
+    int64_t offset = (int64_t)now_ms - (int64_t)frame->sender_ms;
+    if (!jb->synced || offset < jb->offset_ms) {
+        jb->offset_ms = offset;
+        jb->synced = true;
+    }
+
+    int slot = -1;
+    int oldest = 0;
+    for (int i = 0; i < LEVEL_METER_JITTER_SLOTS; i++) {
+        if (!jb->used[i]) {
+            slot = i;
+            break;
+        }
+        if (jb->slots[i].seq == frame->seq) {
+            return;  // Duplicate still buffered
+        }
+        if (seq_after(jb->slots[oldest].seq, jb->slots[i].seq)) {
+            oldest = i;
+        }
+    }
+    if (slot < 0) {
+        slot = oldest;  // Full (stalled consumer): overwrite the oldest
+        jb->dropped_overflow++;
+    }
+    jb->slots[slot] = *frame;
+    jb->used[slot] = true;
+}
+
+bool level_jitter_pop(level_jitter_t *jb, uint64_t now_ms, level_frame_t *out) {
+    // Newest frame whose playout time has come; older due frames are skipped
+    int best = -1;
+    for (int i = 0; i < LEVEL_METER_JITTER_SLOTS; i++) {
+        if (!jb->used[i]) continue;
+        int64_t due = (int64_t)jb->slots[i].sender_ms + jb->offset_ms + LEVEL_METER_PLAYOUT_DELAY_MS;
+        if ((int64_t)now_ms < due) continue;
+        if (best < 0 || seq_after(jb->slots[i].seq, jb->slots[best].seq)) {
+            best = i;
+        }
+    }
+
+    if (best >= 0) {
+        uint32_t seq = jb->slots[best].seq;
+        for (int i = 0; i < LEVEL_METER_JITTER_SLOTS; i++) {
+            if (jb->used[i] && !seq_after(jb->slots[i].seq, seq)) {
+                jb->used[i] = false;  // Played or superseded
+            }
+        }
+        jb->current = jb->slots[best];
+        jb->played_any = true;
+        jb->last_played_seq = seq;
+        *out = jb->current;
+        return true;
+    }
+
+    // Stream stalled: let the bars fall instead of freezing
+    if (jb->played_any && now_ms - jb->last_rx_ms >= LEVEL_METER_STALE_MS) {
+        bool changed = false;
+        for (int i = 0; i < jb->current.bands; i++) {
+            uint8_t v = jb->current.levels[i];
+            uint8_t next = v > LEVEL_METER_DECAY_PER_POP ? v - LEVEL_METER_DECAY_PER_POP : 0;
+            if (next != v) {
+                jb->current.levels[i] = next;
+                changed = true;
+            }
+        }
+        if (changed) {
+            *out = jb->current;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool level_jitter_idle(const level_jitter_t *jb, uint64_t now_ms) {
+    if (!jb->played_any) {
+        return true;
+    }
+    if (now_ms - jb->last_rx_ms < LEVEL_METER_STALE_MS) {
+        return false;
+    }
+    for (int i = 0; i < jb->current.bands; i++) {
+        if (jb->current.levels[i]) return false;
+    }
+    return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+// Level meter stream: packet format and jitter buffer for the bridge's UDP level feed.
+// Packets are tiny (16-byte header + one byte per band, ~30 Hz); the jitter buffer plays
+// them out at the sender's pace a couple of frames late, drops late/duplicate packets,
+// and decays to silence when the stream stops. Portable, caller provides locking.
+//
+// Packet (little-endian):
+//   0  'R' 'K' 'L' 'M'   magic
+//   4  u8  version (1)
+//   5  u8  band count (1..LEVEL_METER_MAX_BANDS)
+//   6  u16 reserved
+//   8  u32 sequence number
+//   12 u32 sender timestamp (ms)
+//   16 u8  levels[band count] (0..255)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LEVEL_METER_MAX_BANDS 16
+#define LEVEL_METER_HEADER_LEN 16
+#define LEVEL_METER_JITTER_SLOTS 8
+#define LEVEL_METER_PLAYOUT_DELAY_MS 70   // ~2 frames at 30 Hz
+#define LEVEL_METER_STALE_MS 500          // No packets this long: decay to silence
+
+typedef struct {
+    uint32_t seq;
+    uint32_t sender_ms;
+    uint8_t bands;
+    uint8_t levels[LEVEL_METER_MAX_BANDS];
+} level_frame_t;
+
+typedef struct {
+    level_frame_t slots[LEVEL_METER_JITTER_SLOTS];
+    bool used[LEVEL_METER_JITTER_SLOTS];
+    bool synced;             // Sender clock mapped to local clock
+    int64_t offset_ms;       // local = sender + offset (minimum seen: least-delayed packet)
+    bool played_any;
+    uint32_t last_played_seq;
+    uint64_t last_rx_ms;
+    level_frame_t current;   // Last frame handed out (decays when stale)
+    uint32_t received;       // Statistics
+    uint32_t dropped_late;
+    uint32_t dropped_overflow;
+} level_jitter_t;
+
+// Parse a datagram; false if malformed
+bool level_meter_parse(const uint8_t *buf, size_t len, level_frame_t *out);
+
+// Encode a frame (bridge stand-ins and tests); returns bytes written or 0
+size_t level_meter_encode(const level_frame_t *frame, uint8_t *buf, size_t len);
+
+void level_jitter_init(level_jitter_t *jb);
+void level_jitter_push(level_jitter_t *jb, const level_frame_t *frame, uint64_t now_ms);
+
+// Frame to show at `now_ms`. Returns false when nothing changed since the last call
+// (no frame due and not decaying), so the caller can skip the redraw entirely.
+bool level_jitter_pop(level_jitter_t *jb, uint64_t now_ms, level_frame_t *out);
+
+// True once the stream has stopped and the meter has decayed to silence
+bool level_jitter_idle(const level_jitter_t *jb, uint64_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,39 @@
+#include "marquee_layout.h"
+
+#include <string.h>
+
+int32_t marquee_strip_width(int32_t text_w, int32_t view_w, bool *scrolls) {
+    bool overflow = text_w > view_w;
+    int32_t strip_w = overflow ? text_w + MARQUEE_GAP_PX : text_w;
+    if (strip_w > MARQUEE_MAX_STRIP_W) strip_w = MARQUEE_MAX_STRIP_W;
+    if (strip_w < 0) strip_w = 0;
+    if (scrolls) *scrolls = overflow;
+    return strip_w;
+}
+
+bool marquee_store_text(char dst[MARQUEE_TEXT_MAX], const char *text) {
+    size_t len = strnlen(text, MARQUEE_TEXT_MAX);
+    if (len == MARQUEE_TEXT_MAX) {
+        len = MARQUEE_TEXT_MAX - 1;
+        // Don't leave half a multi-byte character at the end
+        while (len > 0 && ((unsigned char)text[len] & 0xC0) == 0x80) {
+            len--;
+        }
+    }
+    if (strlen(dst) == len && memcmp(dst, text, len) == 0) {
+        return false;
+    }
+    memcpy(dst, text, len);
+    dst[len] = '\0';
+    return true;
+}
+
+int32_t marquee_advance_q8(int32_t offset_q8, uint32_t elapsed_ms, int32_t strip_w, uint32_t *carry) {
+    if (strip_w <= 0) {
+        return 0;
+    }
+    uint64_t scaled = (uint64_t)elapsed_ms * MARQUEE_SPEED_PX_PER_S * 256 + (carry ? *carry : 0);
+    if (carry) *carry = (uint32_t)(scaled % 1000);
+    int64_t strip_q8 = (int64_t)strip_w << 8;
+    return (int32_t)(((int64_t)offset_q8 + (int64_t)(scaled / 1000)) % strip_q8);
+}
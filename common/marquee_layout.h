@@ -0,0 +1,38 @@
+#pragma once
+
+// Layout and timing for the cached-bitmap marquee (ui_marquee.c), kept free of LVGL so it
+// can be tested on the host: how wide the cached strip is, how titles are truncated to
+// the stored length, and how far the strip moves per timer tick. Portable, no locking.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MARQUEE_GAP_PX 40            // Blank space between the end and the repeated start
+#define MARQUEE_SPEED_PX_PER_S 30    // Scroll speed, independent of frame rate
+#define MARQUEE_DEFAULT_PERIOD_MS 33
+#define MARQUEE_MAX_STRIP_W 4096     // Longest text we cache (~100+ chars at the normal font)
+#define MARQUEE_TEXT_MAX 128         // Stored title, including the terminator
+
+// Width of the strip to render for text `text_w` px wide in a `view_w` px viewport: the
+// text alone if it fits (no scrolling), else text plus the gap, clamped to
+// MARQUEE_MAX_STRIP_W. *scrolls is set when the text overflows the viewport.
+int32_t marquee_strip_width(int32_t text_w, int32_t view_w, bool *scrolls);
+
+// Copy text into a MARQUEE_TEXT_MAX buffer, truncated on a UTF-8 character boundary.
+// Returns false if dst already holds that (truncated) text, so the caller can keep its
+// cached strip and scroll position.
+bool marquee_store_text(char dst[MARQUEE_TEXT_MAX], const char *text);
+
+// Scroll offset (1/256 px) after `elapsed_ms` at MARQUEE_SPEED_PX_PER_S, wrapped to the
+// strip width. `carry` keeps the sub-unit remainder between ticks so the speed doesn't
+// depend on the timer period.
+int32_t marquee_advance_q8(int32_t offset_q8, uint32_t elapsed_ms, int32_t strip_w, uint32_t *carry);
+
+#ifdef __cplusplus
+}
+#endif
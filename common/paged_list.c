@@ -0,0 +1,146 @@
+#include "paged_list.h"
+
+#include <string.h>
+
+void paged_list_reset(paged_list_t *list) {
+    uint32_t generation = list->generation + 1;
+    memset(list, 0, sizeof(*list));
+    list->generation = generation;
+    list->total = -1;
+    list->pending_page = -1;
+    for (int i = 0; i < PAGED_LIST_MAX_PAGES; i++) {
+        list->pages[i].page_index = -1;
+    }
+}
+
+void paged_list_set_cursor_mode(paged_list_t *list, bool cursor_mode) {
+    list->cursor_mode = cursor_mode;
+}
+
+const char *paged_list_cursor(const paged_list_t *list, int page) {
+    if (page <= 0 || page >= PAGED_LIST_MAX_CURSOR_PAGES) {
+        return "";
+    }
+    return list->cursors[page];
+}
+
+static paged_list_page_t *find_page(paged_list_t *list, int page_index) {
+    for (int i = 0; i < PAGED_LIST_MAX_PAGES; i++) {
+        if (list->pages[i].page_index == page_index) {
+            return &list->pages[i];
+        }
+    }
+    return NULL;
+}
+
+const paged_list_item_t *paged_list_get(paged_list_t *list, int index) {
+    if (index < 0 || (list->total >= 0 && index >= list->total)) {
+        return NULL;
+    }
+    paged_list_page_t *page = find_page(list, index / PAGED_LIST_PAGE_SIZE);
+    if (!page) {
+        return NULL;
+    }
+    int slot = index % PAGED_LIST_PAGE_SIZE;
+    if (slot >= page->count) {
+        return NULL;
+    }
+    page->last_used = ++list->use_clock;
+    return &page->items[slot];
+}
+
+static bool page_wanted(paged_list_t *list, int page_index) {
+    if (page_index < 0) return false;
+    if (list->total >= 0 && page_index * PAGED_LIST_PAGE_SIZE >= list->total) return false;
+    if (list->cursor_mode && page_index > 0) {
+        // Reachable only once the previous page handed us its cursor
+        if (page_index >= PAGED_LIST_MAX_CURSOR_PAGES || !list->cursors[page_index][0]) return false;
+    }
+    return find_page(list, page_index) == NULL;
+}
+
+int paged_list_next_fetch(paged_list_t *list, int first, int last) {
+    if (list->pending_page >= 0) {
+        return -1;  // One request in flight at a time
+    }
+    if (first < 0) first = 0;
+    if (last < first) last = first;
+
+    // Visible pages first
+    for (int p = first / PAGED_LIST_PAGE_SIZE; p <= last / PAGED_LIST_PAGE_SIZE; p++) {
+        if (page_wanted(list, p)) {
+            list->pending_page = p;
+            return p;
+        }
+    }
+
+    // Then prefetch the neighbour the selection is approaching
+    int next = (last + PAGED_LIST_PREFETCH_ITEMS) / PAGED_LIST_PAGE_SIZE;
+    if (page_wanted(list, next)) {
+        list->pending_page = next;
+        return next;
+    }
+    int prev = (first - PAGED_LIST_PREFETCH_ITEMS) / PAGED_LIST_PAGE_SIZE;
+    if (first - PAGED_LIST_PREFETCH_ITEMS >= 0 && page_wanted(list, prev)) {
+        list->pending_page = prev;
+        return prev;
+    }
+    return -1;
+}
+
+bool paged_list_store(paged_list_t *list, uint32_t generation, int page_index, int total,
+                      const paged_list_item_t *items, int count, const char *next_cursor) {
+    if (generation != list->generation || page_index < 0) {
+        return false;
+    }
+    if (list->pending_page == page_index) {
+        list->pending_page = -1;
+    }
+    if (count > PAGED_LIST_PAGE_SIZE) count = PAGED_LIST_PAGE_SIZE;
+    if (count < 0) count = 0;
+
+    bool has_more = next_cursor && next_cursor[0];
+    if (list->cursor_mode && has_more && page_index + 1 < PAGED_LIST_MAX_CURSOR_PAGES) {
+        strncpy(list->cursors[page_index + 1], next_cursor, PAGED_LIST_CURSOR_LEN - 1);
+        list->cursors[page_index + 1][PAGED_LIST_CURSOR_LEN - 1] = '\0';
+    } else {
+        has_more = false;  // Past the cursor table: the list ends here
+    }
+    if (total < 0) {
+        // Unknown length: end of this page, plus a placeholder row if there's more.
+        // A re-fetched earlier page must not shrink a list later pages already extended.
+        int end = page_index * PAGED_LIST_PAGE_SIZE + count;
+        total = has_more ? end + 1 : end;
+        if (has_more && list->total > total) total = list->total;
+    }
+    list->total = total;
+
+    // Reuse the slot if already cached, otherwise evict the least recently used
+    paged_list_page_t *slot = find_page(list, page_index);
+    if (!slot) {
+        slot = &list->pages[0];
+        for (int i = 0; i < PAGED_LIST_MAX_PAGES; i++) {
+            paged_list_page_t *p = &list->pages[i];
+            if (p->page_index < 0) {
+                slot = p;
+                break;
+            }
+            if (p->last_used < slot->last_used) {
+                slot = p;
+            }
+        }
+    }
+    slot->page_index = page_index;
+    slot->count = count;
+    slot->last_used = ++list->use_clock;
+    if (count > 0) {
+        memcpy(slot->items, items, (size_t)count * sizeof(items[0]));
+    }
+    return true;
+}
+
+void paged_list_fetch_failed(paged_list_t *list, uint32_t generation) {
+    if (generation == list->generation) {
+        list->pending_page = -1;
+    }
+}
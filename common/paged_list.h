@@ -0,0 +1,81 @@
+#pragma once
+
+// Bounded page cache for long remote lists (play queue, browse results).
+// Items are addressed by absolute index; only PAGED_LIST_MAX_PAGES pages are kept (LRU),
+// so memory is fixed no matter how long the list is. Not thread-safe: UI thread only.
+//
+// Offset mode: any page can be fetched directly (page * PAGED_LIST_PAGE_SIZE).
+// Cursor mode: page N+1 is fetched with the cursor returned by page N; cursors are kept
+// even after their page is evicted, so scrolling back never needs a restart.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PAGED_LIST_PAGE_SIZE 20
+#define PAGED_LIST_MAX_PAGES 4
+#define PAGED_LIST_PREFETCH_ITEMS 5   // Fetch the next page when this close to a page edge
+
+#define PAGED_LIST_ID_LEN 48
+#define PAGED_LIST_TEXT_LEN 96
+#define PAGED_LIST_CURSOR_LEN 32
+#define PAGED_LIST_MAX_CURSOR_PAGES 64   // Cursor mode caps lists at 64 pages (1280 items)
+
+#define PAGED_LIST_ITEM_CONTAINER 0x01   // Item opens another list (browse hierarchy)
+
+typedef struct {
+    char id[PAGED_LIST_ID_LEN];
+    char line1[PAGED_LIST_TEXT_LEN];
+    char line2[PAGED_LIST_TEXT_LEN];
+    char image_key[PAGED_LIST_ID_LEN];   // Optional thumbnail key
+    uint8_t flags;
+} paged_list_item_t;
+
+typedef struct {
+    int page_index;       // -1 = empty slot
+    int count;
+    uint32_t last_used;
+    paged_list_item_t items[PAGED_LIST_PAGE_SIZE];
+} paged_list_page_t;
+
+typedef struct {
+    int total;            // -1 until the first page arrives
+    uint32_t generation;  // Bumped by reset; responses for older generations are dropped
+    uint32_t use_clock;
+    int pending_page;     // Page requested and not yet stored (-1 = none)
+    bool cursor_mode;
+    paged_list_page_t pages[PAGED_LIST_MAX_PAGES];
+    char cursors[PAGED_LIST_MAX_CURSOR_PAGES][PAGED_LIST_CURSOR_LEN];  // cursors[n] fetches page n
+} paged_list_t;
+
+// Clear all pages and start a new generation
+void paged_list_reset(paged_list_t *list);
+
+// Switch to cursor paging (call right after reset)
+void paged_list_set_cursor_mode(paged_list_t *list, bool cursor_mode);
+
+// Cursor for fetching `page` in cursor mode ("" for the first page)
+const char *paged_list_cursor(const paged_list_t *list, int page);
+
+// Item at absolute index, or NULL if its page isn't cached (or index out of range)
+const paged_list_item_t *paged_list_get(paged_list_t *list, int index);
+
+// Page to fetch next for a visible window [first, last], including prefetch of the
+// neighbouring page near the edges. Returns -1 if nothing is needed or a fetch is pending.
+int paged_list_next_fetch(paged_list_t *list, int first, int last);
+
+// Store a fetched page. Returns false if it belongs to an older generation.
+// total < 0 means unknown (cursor mode): the list then ends after this page unless
+// next_cursor is non-empty, in which case one placeholder row keeps scrolling alive.
+bool paged_list_store(paged_list_t *list, uint32_t generation, int page_index, int total,
+                      const paged_list_item_t *items, int count, const char *next_cursor);
+
+// Forget the pending request (e.g. fetch failed) so it can be retried
+void paged_list_fetch_failed(paged_list_t *list, uint32_t generation);
+
+#ifdef __cplusplus
+}
+#endif
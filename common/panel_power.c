@@ -0,0 +1,89 @@
+#include "panel_power.h"
+
+#include <string.h>
+
+#define SAMPLE_STEP 2
+
+// Rec. 709 luma of an RGB565 pixel, 0-255
+static inline uint32_t luma565(uint16_t p) {
+    uint32_t r = (p >> 11) & 0x1f;
+    uint32_t g = (p >> 5) & 0x3f;
+    uint32_t b = p & 0x1f;
+    r = (r << 3) | (r >> 2);
+    g = (g << 2) | (g >> 4);
+    b = (b << 3) | (b >> 2);
+    return (54 * r + 183 * g + 19 * b) >> 8;
+}
+
+void panel_power_init(panel_power_t *p, int width, int height) {
+    memset(p, 0, sizeof(*p));
+    const int max = PANEL_POWER_TILE * PANEL_POWER_MAX_TILES;
+    p->width = width < max ? width : max;
+    p->height = height < max ? height : max;
+    p->tiles_x = (p->width + PANEL_POWER_TILE - 1) / PANEL_POWER_TILE;
+    p->tiles_y = (p->height + PANEL_POWER_TILE - 1) / PANEL_POWER_TILE;
+}
+
+void panel_power_add_area(panel_power_t *p, int x, int y, int w, int h, const uint16_t *px) {
+    const int stride = w;
+    int x2 = x + w < p->width ? x + w : p->width;
+    int y2 = y + h < p->height ? y + h : p->height;
+    if (x < 0 || y < 0 || x >= x2 || y >= y2) {
+        return;
+    }
+
+    for (int ty = y / PANEL_POWER_TILE; ty * PANEL_POWER_TILE < y2; ty++) {
+        int tile_y1 = ty * PANEL_POWER_TILE;
+        int tile_y2 = tile_y1 + PANEL_POWER_TILE < p->height ? tile_y1 + PANEL_POWER_TILE : p->height;
+        int iy1 = y > tile_y1 ? y : tile_y1;
+        int iy2 = y2 < tile_y2 ? y2 : tile_y2;
+
+        for (int tx = x / PANEL_POWER_TILE; tx * PANEL_POWER_TILE < x2; tx++) {
+            int tile_x1 = tx * PANEL_POWER_TILE;
+            int tile_x2 = tile_x1 + PANEL_POWER_TILE < p->width ? tile_x1 + PANEL_POWER_TILE : p->width;
+            int ix1 = x > tile_x1 ? x : tile_x1;
+            int ix2 = x2 < tile_x2 ? x2 : tile_x2;
+
+            uint32_t sum = 0;
+            uint32_t samples = 0;
+            for (int row = iy1; row < iy2; row += SAMPLE_STEP) {
+                const uint16_t *line = px + (row - y) * stride;
+                for (int col = ix1; col < ix2; col += SAMPLE_STEP) {
+                    sum += luma565(line[col - x]);
+                    samples++;
+                }
+            }
+
+            uint32_t covered = (uint32_t)(iy2 - iy1) * (uint32_t)(ix2 - ix1);
+            uint32_t area = (uint32_t)(tile_y2 - tile_y1) * (uint32_t)(tile_x2 - tile_x1);
+            uint32_t fresh = sum / samples;
+            uint32_t old = p->luma[ty][tx];
+            p->luma[ty][tx] = (uint8_t)((old * (area - covered) + fresh * covered + area / 2) / area);
+        }
+    }
+}
+
+uint8_t panel_power_apl(const panel_power_t *p) {
+    // Weight by tile area so the clipped tiles on the right and bottom edges count less
+    uint64_t sum = 0;
+    uint64_t area = 0;
+    for (int ty = 0; ty < p->tiles_y; ty++) {
+        int th = p->height - ty * PANEL_POWER_TILE;
+        if (th > PANEL_POWER_TILE) {
+            th = PANEL_POWER_TILE;
+        }
+        for (int tx = 0; tx < p->tiles_x; tx++) {
+            int tw = p->width - tx * PANEL_POWER_TILE;
+            if (tw > PANEL_POWER_TILE) {
+                tw = PANEL_POWER_TILE;
+            }
+            sum += (uint64_t)p->luma[ty][tx] * (uint64_t)(tw * th);
+            area += (uint64_t)(tw * th);
+        }
+    }
+    return area ? (uint8_t)((sum + area / 2) / area) : 0;
+}
+
+uint8_t panel_power_load_pct(const panel_power_t *p, uint8_t brightness) {
+    return (uint8_t)(((uint32_t)panel_power_apl(p) * brightness * 100 + 255 * 255 / 2) / (255 * 255));
+}
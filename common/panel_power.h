@@ -0,0 +1,41 @@
+#pragma once
+
+// Content-based power estimate for an emissive (AMOLED) panel. Each pixel draws roughly
+// in proportion to its luminance, so a coarse map of average luma per tile, updated from
+// the flushed areas, gives the average picture level (APL) of what is on screen. APL
+// scaled by panel brightness is the panel's load relative to a full-white screen at full
+// brightness. Flushes are sampled every other pixel and row. Portable, no locking.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PANEL_POWER_TILE 16
+#define PANEL_POWER_MAX_TILES 24  // Per axis: up to 384 x 384 pixels
+
+typedef struct {
+    uint8_t luma[PANEL_POWER_MAX_TILES][PANEL_POWER_MAX_TILES];  // Average luma per tile, 0-255
+    int width;
+    int height;
+    int tiles_x;
+    int tiles_y;
+} panel_power_t;
+
+// Start with a black screen (all pixels off)
+void panel_power_init(panel_power_t *p, int width, int height);
+
+// Fold in one flushed area of native-endian RGB565 pixels, w x h at (x, y). A tile only
+// partly covered keeps the rest of its old average in proportion.
+void panel_power_add_area(panel_power_t *p, int x, int y, int w, int h, const uint16_t *px);
+
+// Average picture level of the whole screen, 0-255
+uint8_t panel_power_apl(const panel_power_t *p);
+
+// Load relative to full white at full brightness, in percent, at brightness 0-255
+uint8_t panel_power_load_pct(const panel_power_t *p, uint8_t brightness);
+
+#ifdef __cplusplus
+}
+#endif
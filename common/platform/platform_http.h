@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
 
 int platform_http_get(const char *url, char **out, size_t *out_len);
@@ -7,6 +8,11 @@ int platform_http_get_image(const char *url, char **out, size_t *out_len);
 int platform_http_post_json(const char *url, const char *json, char **out, size_t *out_len);
 void platform_http_free(char *p);
 
+// Copy url to out with its host replaced by the address the HTTP client would connect
+// to (mDNS .local names included), for code that opens its own connections. Returns
+// false and copies url unchanged for IP literals and hosts that don't resolve.
+bool platform_http_resolve_url(const char *url, char *out, size_t len);
+
 /**
  * @brief Get the unique knob ID (MAC address based)
  * @param out Buffer to write the knob ID (13 bytes minimum: 12 hex + null)
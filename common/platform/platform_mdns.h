@@ -2,6 +2,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 void platform_mdns_init(const char *hostname);
 bool platform_mdns_discover_base_url(char *out, size_t len);
@@ -9,3 +10,6 @@ bool platform_mdns_discover_base_url(char *out, size_t len);
 // Resolve a .local hostname to IP address via mDNS
 // hostname can be "foo" or "foo.local" - .local suffix is stripped automatically
 bool platform_mdns_resolve_local(const char *hostname, char *ip_out, size_t ip_len);
+
+// Same, also reporting the record's TTL in seconds (ttl_s may be NULL)
+bool platform_mdns_resolve_local_ttl(const char *hostname, char *ip_out, size_t ip_len, uint32_t *ttl_s);
@@ -0,0 +1,15 @@
+#include "platform/platform_memcpy.h"
+
+#include <string.h>
+
+// Host build: plain memcpy. The device build uses idf_app/main/platform_memcpy_idf.c.
+
+void platform_memcpy_init(void) {
+}
+
+void platform_memcpy(void *dst, const void *src, size_t n) {
+    memcpy(dst, src, n);
+}
+
+void platform_memcpy_log_stats(void) {
+}
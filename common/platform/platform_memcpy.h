@@ -0,0 +1,21 @@
+#pragma once
+
+// Large memory copies off the CPU. On the ESP32-S3, copies of PLATFORM_MEMCPY_DMA_MIN
+// bytes or more between aligned buffers go through a GDMA memory-to-memory channel;
+// anything else (small, misaligned or overlapping copies, no channel) falls back to
+// memcpy. The host build always uses memcpy.
+
+#include <stddef.h>
+
+#define PLATFORM_MEMCPY_ALIGN 64          // Address and size alignment for DMA (PSRAM cache line)
+#define PLATFORM_MEMCPY_DMA_MIN (16 * 1024)
+
+// Set up the DMA channel. Copies before this (or if it fails) use the CPU.
+void platform_memcpy_init(void);
+
+// Copy n bytes and return when done. The calling task sleeps during a DMA copy, so other
+// tasks get the CPU.
+void platform_memcpy(void *dst, const void *src, size_t n);
+
+// Log DMA and CPU copies since the previous call, with the CPU time the DMA copies saved
+void platform_memcpy_log_stats(void);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "rk_cfg.h"
+#include "wifi_profiles.h"
 
 #include <stdbool.h>
 
@@ -8,3 +9,7 @@ bool platform_storage_load(rk_cfg_t *out);
 bool platform_storage_save(const rk_cfg_t *in);
 void platform_storage_defaults(rk_cfg_t *out);
 void platform_storage_reset_wifi_only(rk_cfg_t *cfg);
+
+// Stored WiFi networks (separate blob; rk_cfg_t.ssid stays the last provisioned one)
+bool platform_storage_load_wifi_profiles(wifi_profiles_t *out);
+bool platform_storage_save_wifi_profiles(const wifi_profiles_t *in);
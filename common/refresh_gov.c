@@ -0,0 +1,85 @@
+#include "refresh_gov.h"
+
+#include <string.h>
+
+void refresh_gov_init(refresh_gov_t *g, uint64_t now_ms) {
+    memset(g, 0, sizeof(*g));
+    g->level = REFRESH_ACTIVE;  // Boot draws the whole UI
+    g->level_since_ms = now_ms;
+    g->counted_until_ms = now_ms;
+}
+
+uint32_t refresh_gov_period_ms(refresh_level_t level) {
+    switch (level) {
+    case REFRESH_FAST:
+        return REFRESH_FAST_MS;
+    case REFRESH_IDLE:
+        return REFRESH_IDLE_MS;
+    default:
+        return REFRESH_ACTIVE_MS;
+    }
+}
+
+void refresh_gov_note_input(refresh_gov_t *g, uint64_t now_ms) {
+    g->last_input_ms = now_ms;
+    g->has_input = true;
+}
+
+void refresh_gov_note_frame(refresh_gov_t *g, uint64_t now_ms) {
+    g->frames[g->level]++;
+    if (g->level == REFRESH_IDLE) {
+        // A frame on (about) every slow tick: there is more to draw than the idle rate allows
+        bool back_to_back = g->has_frame && now_ms - g->last_frame_ms <= REFRESH_IDLE_MS + REFRESH_IDLE_MS / 2;
+        g->idle_streak = back_to_back ? g->idle_streak + 1 : 1;
+    }
+    g->last_frame_ms = now_ms;
+    g->has_frame = true;
+}
+
+static void set_level(refresh_gov_t *g, refresh_level_t level, uint64_t now_ms) {
+    if (level == g->level) {
+        return;
+    }
+    g->time_ms[g->level] += now_ms - g->counted_until_ms;
+    g->counted_until_ms = now_ms;
+    g->level = level;
+    g->level_since_ms = now_ms;
+    g->idle_streak = 0;
+    g->switches++;
+}
+
+uint32_t refresh_gov_update(refresh_gov_t *g, uint64_t now_ms, bool animating) {
+    refresh_level_t level;
+    if (g->has_input && now_ms - g->last_input_ms < REFRESH_FAST_HOLD_MS) {
+        level = REFRESH_FAST;
+    } else if (animating) {
+        level = REFRESH_ACTIVE;
+    } else if (g->level == REFRESH_IDLE) {
+        level = g->idle_streak >= REFRESH_WAKE_FRAMES ? REFRESH_ACTIVE : REFRESH_IDLE;
+    } else {
+        // Leaving fast or active: settle once frames stop coming
+        uint64_t quiet_since = g->has_frame && g->last_frame_ms > g->level_since_ms ? g->last_frame_ms
+                                                                                   : g->level_since_ms;
+        if (g->level == REFRESH_FAST) {
+            level = REFRESH_ACTIVE;  // Let the last input's redraw land at the normal rate
+        } else {
+            level = now_ms - quiet_since >= REFRESH_IDLE_AFTER_MS ? REFRESH_IDLE : REFRESH_ACTIVE;
+        }
+    }
+    set_level(g, level, now_ms);
+    return refresh_gov_period_ms(g->level);
+}
+
+void refresh_gov_take_stats(refresh_gov_t *g, uint64_t now_ms, uint32_t frames[REFRESH_LEVELS],
+                            uint64_t time_ms[REFRESH_LEVELS], uint32_t *switches) {
+    g->time_ms[g->level] += now_ms - g->counted_until_ms;
+    g->counted_until_ms = now_ms;
+    for (int i = 0; i < REFRESH_LEVELS; i++) {
+        frames[i] = g->frames[i];
+        time_ms[i] = g->time_ms[i];
+        g->frames[i] = 0;
+        g->time_ms[i] = 0;
+    }
+    *switches = g->switches;
+    g->switches = 0;
+}
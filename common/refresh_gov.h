@@ -0,0 +1,64 @@
+#pragma once
+
+// Display refresh-rate governor. Picks LVGL's refresh period from what is happening:
+// fast while the knob or screen is being handled, the normal rate while something
+// animates, and a slow poll of the invalid-area list once the screen is static. A static
+// screen with an occasional change (the 1 Hz progress arc) stays slow; changes landing
+// on every slow tick in a row mean something is animating and bring the normal rate
+// back. Counts frames and time per level. Portable, no locking.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    REFRESH_IDLE,     // Static screen
+    REFRESH_ACTIVE,   // Animations, crossfades, steady redraws
+    REFRESH_FAST,     // Encoder or touch input
+    REFRESH_LEVELS,
+} refresh_level_t;
+
+#define REFRESH_FAST_MS 16          // ~60 fps for arc feedback during a spin
+#define REFRESH_ACTIVE_MS 33        // LVGL's default period
+#define REFRESH_IDLE_MS 200
+#define REFRESH_FAST_HOLD_MS 500    // Stay fast this long after the last input
+#define REFRESH_IDLE_AFTER_MS 500   // Drop to idle after this long without frames
+#define REFRESH_WAKE_FRAMES 3       // Back-to-back idle-tick frames that mean animation
+
+typedef struct {
+    refresh_level_t level;
+    uint64_t level_since_ms;
+    uint64_t last_input_ms;
+    uint64_t last_frame_ms;
+    bool has_input;
+    bool has_frame;
+    int idle_streak;                 // Consecutive frames one idle period apart
+    uint32_t frames[REFRESH_LEVELS]; // Since the last refresh_gov_take_stats
+    uint64_t time_ms[REFRESH_LEVELS];
+    uint64_t counted_until_ms;       // time_ms covers up to here
+    uint32_t switches;
+} refresh_gov_t;
+
+void refresh_gov_init(refresh_gov_t *g, uint64_t now_ms);
+
+void refresh_gov_note_input(refresh_gov_t *g, uint64_t now_ms);
+
+// A frame was flushed to the panel
+void refresh_gov_note_frame(refresh_gov_t *g, uint64_t now_ms);
+
+// Re-evaluate the level. `animating`: LVGL animations or an artwork crossfade running.
+// Returns the refresh period to use.
+uint32_t refresh_gov_update(refresh_gov_t *g, uint64_t now_ms, bool animating);
+
+uint32_t refresh_gov_period_ms(refresh_level_t level);
+
+// Copy the per-level counters (time includes the current level up to now) and reset them
+void refresh_gov_take_stats(refresh_gov_t *g, uint64_t now_ms, uint32_t frames[REFRESH_LEVELS],
+                            uint64_t time_ms[REFRESH_LEVELS], uint32_t *switches);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,142 @@
+#include "resolver_cache.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+void resolver_cache_init(resolver_cache_t *rc) {
+    memset(rc, 0, sizeof(*rc));
+}
+
+bool resolver_is_ip_literal(const char *host) {
+    if (!host || !host[0]) {
+        return false;
+    }
+    if (strchr(host, ':') || host[0] == '[') {
+        return true;  // IPv6
+    }
+    for (const char *p = host; *p; p++) {
+        if (!isdigit((unsigned char)*p) && *p != '.') {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Start and length of the host in url
+static const char *url_host_span(const char *url, size_t *host_len) {
+    const char *host = strstr(url, "://");
+    host = host ? host + 3 : url;
+    if (*host == '[') {
+        *host_len = strcspn(host, "]") + 1;  // IPv6 literal keeps its brackets
+    } else {
+        *host_len = strcspn(host, ":/?#");
+    }
+    return host;
+}
+
+bool resolver_url_host(const char *url, char *host, size_t len) {
+    size_t n;
+    const char *start = url_host_span(url, &n);
+    if (n == 0 || n >= len) {
+        return false;
+    }
+    memcpy(host, start, n);
+    host[n] = '\0';
+    return true;
+}
+
+bool resolver_rewrite_url(const char *url, const char *ip, char *out, size_t len) {
+    size_t n;
+    const char *start = url_host_span(url, &n);
+    int written = snprintf(out, len, "%.*s%s%s", (int)(start - url), url, ip, start + n);
+    return written > 0 && (size_t)written < len;
+}
+
+static resolver_entry_t *find(resolver_cache_t *rc, const char *host) {
+    for (int i = 0; i < RESOLVER_CACHE_SLOTS; i++) {
+        if (rc->entries[i].host[0] && strcmp(rc->entries[i].host, host) == 0) {
+            return &rc->entries[i];
+        }
+    }
+    return NULL;
+}
+
+resolver_lookup_t resolver_cache_lookup(resolver_cache_t *rc, const char *host, char *ip_out, size_t len,
+                                        uint64_t now_ms) {
+    resolver_entry_t *e = find(rc, host);
+    if (!e || !e->ip[0]) {
+        rc->misses++;
+        return RESOLVER_MISS;
+    }
+    e->used_ms = now_ms;
+    snprintf(ip_out, len, "%s", e->ip);
+    if (now_ms - e->resolved_ms < e->ttl_ms) {
+        rc->hits++;
+        return RESOLVER_HIT;
+    }
+    if (e->failures > 0) {
+        rc->fallbacks++;  // Resolver is down: serve the last address, retries run in the background
+        return RESOLVER_HIT;
+    }
+    return RESOLVER_EXPIRED;
+}
+
+bool resolver_cache_store(resolver_cache_t *rc, const char *host, const char *ip, uint32_t ttl_ms,
+                          uint64_t now_ms) {
+    resolver_entry_t *e = find(rc, host);
+    if (!e) {
+        e = &rc->entries[0];
+        for (int i = 0; i < RESOLVER_CACHE_SLOTS; i++) {
+            if (!rc->entries[i].host[0]) {
+                e = &rc->entries[i];
+                break;
+            }
+            if (rc->entries[i].used_ms < e->used_ms) {
+                e = &rc->entries[i];
+            }
+        }
+        memset(e, 0, sizeof(*e));
+        snprintf(e->host, sizeof(e->host), "%s", host);
+        e->used_ms = now_ms;
+    } else if (ip) {
+        rc->refreshes++;
+    }
+
+    if (ip) {
+        bool changed = e->ip[0] && strcmp(e->ip, ip) != 0;
+        snprintf(e->ip, sizeof(e->ip), "%s", ip);
+        e->resolved_ms = now_ms;
+        e->ttl_ms = ttl_ms;
+        e->failures = 0;
+        e->retry_ms = 0;
+        return changed;
+    }
+    rc->failures++;
+    uint32_t backoff = RESOLVER_RETRY_MIN_MS;
+    for (uint32_t i = 0; i < e->failures && backoff < RESOLVER_RETRY_MAX_MS; i++) {
+        backoff *= 2;
+    }
+    if (backoff > RESOLVER_RETRY_MAX_MS) {
+        backoff = RESOLVER_RETRY_MAX_MS;
+    }
+    e->failures++;
+    e->retry_ms = now_ms + backoff;
+    return false;
+}
+
+bool resolver_cache_next_refresh(const resolver_cache_t *rc, uint64_t now_ms, char *host, size_t len) {
+    for (int i = 0; i < RESOLVER_CACHE_SLOTS; i++) {
+        const resolver_entry_t *e = &rc->entries[i];
+        if (!e->host[0] || !e->ip[0] || now_ms - e->used_ms > 2ULL * e->ttl_ms) {
+            continue;
+        }
+        bool due = e->failures > 0 ? now_ms >= e->retry_ms
+                                   : now_ms - e->resolved_ms >= (uint64_t)e->ttl_ms * RESOLVER_REFRESH_PERCENT / 100;
+        if (due) {
+            snprintf(host, len, "%s", e->host);
+            return true;
+        }
+    }
+    return false;
+}
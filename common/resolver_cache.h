@@ -0,0 +1,76 @@
+#pragma once
+
+// Hostname -> IPv4 cache for the HTTP layer. Requests use the cached address, so they
+// don't wait for DNS or mDNS; entries are refreshed in the background before their TTL
+// runs out, and the last known address keeps serving while resolution fails. The
+// resolver itself is the caller's (it blocks), so lookups and stores are split around
+// it. Portable, no locking.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RESOLVER_CACHE_SLOTS 4
+#define RESOLVER_HOST_LEN 64
+#define RESOLVER_IP_LEN 16
+#define RESOLVER_REFRESH_PERCENT 75        // Background refresh once this much of the TTL is used
+#define RESOLVER_RETRY_MIN_MS 5000         // Backoff after a failed resolve, doubling...
+#define RESOLVER_RETRY_MAX_MS 60000        // ...up to this
+
+typedef struct {
+    char host[RESOLVER_HOST_LEN];
+    char ip[RESOLVER_IP_LEN];      // Last address that resolved ("" = never)
+    uint64_t resolved_ms;
+    uint32_t ttl_ms;
+    uint64_t retry_ms;             // After a failure: next attempt not before this
+    uint32_t failures;             // Consecutive
+    uint64_t used_ms;              // Last lookup; idle entries aren't refreshed
+} resolver_entry_t;
+
+typedef struct {
+    resolver_entry_t entries[RESOLVER_CACHE_SLOTS];
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t fallbacks;            // Expired address served because resolution is failing
+    uint32_t refreshes;
+    uint32_t failures;
+} resolver_cache_t;
+
+typedef enum {
+    RESOLVER_HIT,      // ip_out is current (or the last known address while failing)
+    RESOLVER_EXPIRED,  // Idle entry went stale: resolve now; ip_out is the fallback
+    RESOLVER_MISS,     // Nothing cached; resolve now
+} resolver_lookup_t;
+
+void resolver_cache_init(resolver_cache_t *rc);
+
+// True for IPv4/IPv6 literals, which are never resolved
+bool resolver_is_ip_literal(const char *host);
+
+// Host part of an http(s) URL (without port). Returns false if it doesn't fit.
+bool resolver_url_host(const char *url, char *host, size_t len);
+
+// url with its host replaced by ip; returns false if it doesn't fit
+bool resolver_rewrite_url(const char *url, const char *ip, char *out, size_t len);
+
+resolver_lookup_t resolver_cache_lookup(resolver_cache_t *rc, const char *host, char *ip_out, size_t len,
+                                        uint64_t now_ms);
+
+// Record a resolve attempt. ip=NULL means it failed: the last known address is kept and
+// the next attempt backs off. The least recently used entry makes room for a new host.
+// Returns true if the host now has a different address than before.
+bool resolver_cache_store(resolver_cache_t *rc, const char *host, const char *ip, uint32_t ttl_ms,
+                          uint64_t now_ms);
+
+// A host that should be re-resolved in the background now (past RESOLVER_REFRESH_PERCENT
+// of its TTL, or its retry time after a failure). Hosts not looked up for two TTLs are
+// left to expire.
+bool resolver_cache_next_refresh(const resolver_cache_t *rc, uint64_t now_ms, char *host, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,81 @@
+// RGB565 alpha blend kernels for artwork crossfade
+//
+// Each pixel is spread into a 32-bit word as 00000GGGGGG00000RRRRR000000BBBBB so R, G and B
+// have 5+ spare bits above them; one multiply then scales all three channels at once
+// (SIMD within a register). Portable C - no PIE/SSE intrinsics needed.
+
+#include "rgb565_blend.h"
+
+#include <stddef.h>
+
+#define RGB565_SPREAD_MASK 0x07E0F81FU
+
+static inline uint32_t spread(uint16_t p) {
+    return ((uint32_t)p | ((uint32_t)p << 16)) & RGB565_SPREAD_MASK;
+}
+
+static inline uint16_t blend_px(uint16_t from, uint16_t to, uint32_t a, uint32_t inv_a) {
+    // Weights sum to 32, so each channel sum stays below its 5-bit headroom
+    uint32_t x = (spread(from) * inv_a + spread(to) * a) >> 5;
+    x &= RGB565_SPREAD_MASK;
+    return (uint16_t)(x | (x >> 16));
+}
+
+void rgb565_blend_row(uint16_t *dst, const uint16_t *from, const uint16_t *to, int n, int alpha) {
+    if (alpha <= 0) alpha = 0;
+    if (alpha >= RGB565_ALPHA_MAX) alpha = RGB565_ALPHA_MAX;
+    uint32_t a = (uint32_t)alpha;
+    uint32_t inv_a = RGB565_ALPHA_MAX - a;
+
+    // Two pixels per iteration keeps the loop body branch-free for the compiler to schedule
+    int i = 0;
+    for (; i + 1 < n; i += 2) {
+        uint16_t p0 = blend_px(from[i], to[i], a, inv_a);
+        uint16_t p1 = blend_px(from[i + 1], to[i + 1], a, inv_a);
+        dst[i] = p0;
+        dst[i + 1] = p1;
+    }
+    if (i < n) {
+        dst[i] = blend_px(from[i], to[i], a, inv_a);
+    }
+}
+
+// Integer square root (rows are few; no need for a table)
+static int isqrt(int v) {
+    if (v <= 0) return 0;
+    int r = 0;
+    int bit = 1 << 30;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return r;
+}
+
+void rgb565_blend_circle(uint16_t *dst, const uint16_t *from, const uint16_t *to, int w, int h, int alpha) {
+    // Work in doubled coordinates so even sizes get a centre between pixels
+    int d = w < h ? w : h;
+    int cx2 = w - 1;
+    int cy2 = h - 1;
+    int r2 = d;  // radius * 2
+
+    for (int y = 0; y < h; y++) {
+        int dy2 = 2 * y - cy2;
+        int span2 = r2 * r2 - dy2 * dy2;
+        if (span2 < 0) continue;
+        int half2 = isqrt(span2);  // doubled half-width of this chord
+        int x0 = (cx2 - half2 + 1) / 2;
+        int x1 = (cx2 + half2) / 2;
+        if (x0 < 0) x0 = 0;
+        if (x1 > w - 1) x1 = w - 1;
+        if (x1 < x0) continue;
+        size_t off = (size_t)y * w + x0;
+        rgb565_blend_row(dst + off, from + off, to + off, x1 - x0 + 1, alpha);
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Alpha scale for the blend kernels: 0 = all `from`, RGB565_ALPHA_MAX = all `to`
+#define RGB565_ALPHA_MAX 32
+
+// Blend n native-endian RGB565 pixels: dst = from * (1 - a) + to * a, a in [0, RGB565_ALPHA_MAX]
+// dst may alias from or to.
+void rgb565_blend_row(uint16_t *dst, const uint16_t *from, const uint16_t *to, int n, int alpha);
+
+// Blend a w x h frame, touching only pixels inside the inscribed circle (round panel).
+// Pixels outside the circle are left as-is.
+void rgb565_blend_circle(uint16_t *dst, const uint16_t *from, const uint16_t *to, int w, int h, int alpha);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,144 @@
+#include "scan_table.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void scan_table_init(scan_table_t *t) {
+    memset(t, 0, sizeof(*t));
+}
+
+static int find(const scan_table_t *t, const char *ssid) {
+    for (int i = 0; i < t->count; i++) {
+        if (strcmp(t->entries[i].ap.ssid, ssid) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void remove_at(scan_table_t *t, int i) {
+    memmove(&t->entries[i], &t->entries[i + 1], sizeof(t->entries[0]) * (t->count - i - 1));
+    t->count--;
+}
+
+void scan_table_merge(scan_table_t *t, const wifi_scan_ap_t *aps, int n) {
+    t->scans++;
+    for (int i = 0; i < t->count; i++) {
+        t->entries[i].age++;
+    }
+
+    for (int a = 0; a < n; a++) {
+        const wifi_scan_ap_t *ap = &aps[a];
+        if (!ap->ssid[0]) {
+            continue;  // Hidden networks can't be picked from a list
+        }
+        int i = find(t, ap->ssid);
+        if (i >= 0) {
+            // A fresh sighting replaces an old one; within one scan the strongest AP wins
+            if (t->entries[i].age > 0 || ap->rssi > t->entries[i].ap.rssi) {
+                t->entries[i].ap = *ap;
+            }
+            t->entries[i].age = 0;
+            continue;
+        }
+        if (t->count < SCAN_TABLE_MAX) {
+            i = t->count++;
+        } else {
+            // Full: replace the weakest entry if this one is stronger
+            i = 0;
+            for (int j = 1; j < t->count; j++) {
+                if (t->entries[j].ap.rssi < t->entries[i].ap.rssi) {
+                    i = j;
+                }
+            }
+            if (t->entries[i].ap.rssi >= ap->rssi) {
+                continue;
+            }
+        }
+        t->entries[i].ap = *ap;
+        t->entries[i].age = 0;
+    }
+
+    for (int i = t->count - 1; i >= 0; i--) {
+        if (t->entries[i].age > SCAN_TABLE_MAX_AGE) {
+            remove_at(t, i);
+        }
+    }
+
+    // Strongest first (insertion sort; the table is small and mostly sorted already)
+    for (int i = 1; i < t->count; i++) {
+        scan_table_entry_t e = t->entries[i];
+        int j = i;
+        while (j > 0 && t->entries[j - 1].ap.rssi < e.ap.rssi) {
+            t->entries[j] = t->entries[j - 1];
+            j--;
+        }
+        t->entries[j] = e;
+    }
+}
+
+// Append s as a JSON string. <, > and & are escaped too, so the output can't close the
+// surrounding <script>.
+static bool put_json_string(char *buf, size_t len, size_t *off, const char *s) {
+    static const char hex[] = "0123456789abcdef";
+    if (*off + 1 >= len) {
+        return false;
+    }
+    buf[(*off)++] = '"';
+    for (const unsigned char *p = (const unsigned char *)s; *p; p++) {
+        char esc[7];
+        size_t n;
+        if (*p == '"' || *p == '\\') {
+            esc[0] = '\\';
+            esc[1] = (char)*p;
+            n = 2;
+        } else if (*p < 0x20 || *p == '<' || *p == '>' || *p == '&') {
+            memcpy(esc, "\\u00", 4);
+            esc[4] = hex[*p >> 4];
+            esc[5] = hex[*p & 15];
+            n = 6;
+        } else {
+            esc[0] = (char)*p;
+            n = 1;
+        }
+        if (*off + n + 1 >= len) {
+            return false;
+        }
+        memcpy(buf + *off, esc, n);
+        *off += n;
+    }
+    buf[(*off)++] = '"';
+    return true;
+}
+
+int scan_table_render_json(const scan_table_t *t, char *buf, size_t len) {
+    size_t off = 0;
+    if (len < 3) {
+        return -1;
+    }
+    buf[off++] = '[';
+    for (int i = 0; i < t->count; i++) {
+        const wifi_scan_ap_t *ap = &t->entries[i].ap;
+        int w = snprintf(buf + off, len - off, "%s{\"s\":", i ? "," : "");
+        if (w < 0 || (size_t)w >= len - off) {
+            return -1;
+        }
+        off += w;
+        if (!put_json_string(buf, len, &off, ap->ssid)) {
+            return -1;
+        }
+        w = snprintf(buf + off, len - off, ",\"r\":%d,\"a\":%u,\"c\":%u,\"b\":\"%02x%02x%02x%02x%02x%02x\"}",
+                     ap->rssi, ap->auth, ap->channel, ap->bssid[0], ap->bssid[1], ap->bssid[2], ap->bssid[3],
+                     ap->bssid[4], ap->bssid[5]);
+        if (w < 0 || (size_t)w >= len - off) {
+            return -1;
+        }
+        off += w;
+    }
+    if (off + 2 > len) {
+        return -1;
+    }
+    buf[off++] = ']';
+    buf[off] = '\0';
+    return (int)off;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+// Networks seen by recent WiFi scans, for the setup portal's picker. One entry per SSID
+// (the strongest AP), strongest first, so mesh networks show once. Entries missing from
+// a few scans in a row age out. Rendered as a compact JSON array that is safe to embed in
+// a <script> block. Portable, no locking.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "wifi_profiles.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCAN_TABLE_MAX 20
+#define SCAN_TABLE_MAX_AGE 3  // Scans an entry may be missing from before it's dropped
+
+typedef struct {
+    wifi_scan_ap_t ap;
+    uint8_t age;  // Scans since this SSID was last seen
+} scan_table_entry_t;
+
+typedef struct {
+    scan_table_entry_t entries[SCAN_TABLE_MAX];
+    int count;
+    uint32_t scans;
+} scan_table_t;
+
+void scan_table_init(scan_table_t *t);
+
+// Fold in one scan's results
+void scan_table_merge(scan_table_t *t, const wifi_scan_ap_t *aps, int n);
+
+// [{"s":ssid,"r":rssi,"a":auth,"c":channel,"b":"bssid hex"},...]. Returns the length
+// written, or -1 if it doesn't fit.
+int scan_table_render_json(const scan_table_t *t, char *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,85 @@
+#include "seek_scrub.h"
+
+#include <string.h>
+
+// Polled positions within this many seconds of the expected one confirm a seek
+#define SEEK_SCRUB_TOLERANCE 2
+
+void seek_scrub_init(seek_scrub_t *s, uint32_t send_interval_ms, uint32_t hold_timeout_ms) {
+    memset(s, 0, sizeof(*s));
+    s->last_sent = -1;
+    s->send_interval_ms = send_interval_ms;
+    s->hold_timeout_ms = hold_timeout_ms;
+}
+
+bool seek_scrub_begin(seek_scrub_t *s, int position, int length) {
+    if (length <= 0) {
+        return false;
+    }
+    s->active = true;
+    s->holding = false;
+    s->length = length;
+    // Same range as the ticks: the last seekable position is length - 1
+    s->position = position < 0 ? 0 : (position > length - 1 ? length - 1 : position);
+    s->last_sent = s->position;  // Nothing to send until the preview moves
+    return true;
+}
+
+bool seek_scrub_ticks(seek_scrub_t *s, int ticks, uint64_t now_ms) {
+    if (!s->active || ticks == 0) {
+        return false;
+    }
+    // 1% of the track per tick (at least 1s); velocity already scales ticks
+    int step = s->length / 100;
+    if (step < 1) step = 1;
+    int next = s->position + ticks * step;
+    if (next < 0) next = 0;
+    if (next > s->length - 1) next = s->length - 1;
+    s->position = next;
+    return seek_scrub_poll(s, now_ms);
+}
+
+bool seek_scrub_poll(seek_scrub_t *s, uint64_t now_ms) {
+    if (!s->active || s->position == s->last_sent) {
+        return false;
+    }
+    return now_ms - s->last_send_ms >= s->send_interval_ms;
+}
+
+bool seek_scrub_end(seek_scrub_t *s, uint64_t now_ms) {
+    if (!s->active) {
+        return false;
+    }
+    s->active = false;
+    s->holding = true;
+    s->committed = s->position;
+    s->committed_ms = now_ms;
+    return s->position != s->last_sent;
+}
+
+void seek_scrub_sent(seek_scrub_t *s, bool ok, uint64_t now_ms) {
+    s->last_send_ms = now_ms;
+    if (ok) {
+        s->last_sent = s->position;
+    } else if (!s->active) {
+        s->holding = false;  // Final commit failed: the bridge position is the truth
+    }
+}
+
+int seek_scrub_display(seek_scrub_t *s, int polled, bool playing, uint64_t now_ms) {
+    if (s->active) {
+        return s->position;
+    }
+    if (!s->holding) {
+        return polled;
+    }
+    // Interpolate from the committed position until a poll agrees with it
+    uint64_t elapsed_ms = now_ms - s->committed_ms;
+    int expected = s->committed + (playing ? (int)(elapsed_ms / 1000) : 0);
+    int diff = polled > expected ? polled - expected : expected - polled;
+    if (diff <= SEEK_SCRUB_TOLERANCE || elapsed_ms >= s->hold_timeout_ms) {
+        s->holding = false;
+        return polled;
+    }
+    return expected < s->length ? expected : s->length;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// Knob scrubbing state machine: encoder ticks move a local preview position, seek
+// commands are throttled (latest wins, trailing send), and release commits the final
+// position. After the commit, polled positions that predate the seek are ignored and the
+// displayed position advances from the committed value instead. Portable, no locking.
+// Positions are in the bridge's seek_position units (seconds).
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    bool active;              // Scrubbing (preview owns the position)
+    int position;             // Preview position
+    int length;               // Track length (0 = unknown, scrubbing refused)
+    int last_sent;            // Last position sent to the bridge (-1 = none)
+    uint64_t last_send_ms;
+    uint32_t send_interval_ms;
+
+    bool holding;             // Committed, waiting for the bridge to report it
+    int committed;
+    uint64_t committed_ms;
+    uint32_t hold_timeout_ms;
+} seek_scrub_t;
+
+void seek_scrub_init(seek_scrub_t *s, uint32_t send_interval_ms, uint32_t hold_timeout_ms);
+
+// Enter scrub mode at the current position; false if the track has no length
+bool seek_scrub_begin(seek_scrub_t *s, int position, int length);
+
+// Move the preview by encoder ticks. Returns true if a seek should be sent now
+// (to s->position); otherwise the move is coalesced into a later send.
+bool seek_scrub_ticks(seek_scrub_t *s, int ticks, uint64_t now_ms);
+
+// Periodic tick while active: true if a coalesced position is due to be sent
+bool seek_scrub_poll(seek_scrub_t *s, uint64_t now_ms);
+
+// Leave scrub mode. Returns true if the final position still needs sending.
+bool seek_scrub_end(seek_scrub_t *s, uint64_t now_ms);
+
+// Record that s->position was sent (or that the send failed and should not be held)
+void seek_scrub_sent(seek_scrub_t *s, bool ok, uint64_t now_ms);
+
+// Position to display for a polled value
+int seek_scrub_display(seek_scrub_t *s, int polled, bool playing, uint64_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,124 @@
+#include "telemetry.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void telemetry_init(telemetry_t *t, uint32_t sample_interval_ms, uint32_t flush_interval_ms,
+                    uint64_t now_ms) {
+    memset(t, 0, sizeof(*t));
+    t->sample_interval_ms = sample_interval_ms;
+    t->flush_interval_ms = flush_interval_ms;
+    t->last_flush_ms = now_ms;
+}
+
+void telemetry_note_latency(telemetry_t *t, uint32_t ms) {
+    if (ms > UINT16_MAX) {
+        ms = UINT16_MAX;
+    }
+    t->latency_sum_ms += ms;
+    t->latency_count++;
+    if (ms > t->latency_max_ms) {
+        t->latency_max_ms = (uint16_t)ms;
+    }
+}
+
+bool telemetry_sample_due(const telemetry_t *t, uint64_t now_ms) {
+    if (t->count == 0 && !t->has_last_sent) {
+        return true;  // First sample right away so the bridge learns the battery state at boot
+    }
+    return now_ms - t->last_sample_ms >= t->sample_interval_ms;
+}
+
+static bool changed_meaningfully(const telemetry_sample_t *a, const telemetry_sample_t *b) {
+    if (a->charging != b->charging) {
+        return true;
+    }
+    if ((a->battery_level < 0) != (b->battery_level < 0)) {
+        return true;
+    }
+    int delta = a->battery_level - b->battery_level;
+    return delta >= TELEMETRY_BATTERY_DELTA || delta <= -TELEMETRY_BATTERY_DELTA;
+}
+
+bool telemetry_add_sample(telemetry_t *t, const telemetry_sample_t *sample, uint64_t now_ms) {
+    if (t->count == TELEMETRY_MAX_SAMPLES) {
+        memmove(&t->samples[0], &t->samples[1], sizeof(t->samples[0]) * (TELEMETRY_MAX_SAMPLES - 1));
+        t->count--;
+        t->dropped++;
+    }
+    telemetry_sample_t *s = &t->samples[t->count++];
+    *s = *sample;
+    if (t->latency_count > 0) {
+        s->poll_ms_avg = (uint16_t)(t->latency_sum_ms / t->latency_count);
+        s->poll_ms_max = t->latency_max_ms;
+    } else {
+        s->poll_ms_avg = 0;
+        s->poll_ms_max = 0;
+    }
+    t->latency_sum_ms = 0;
+    t->latency_count = 0;
+    t->latency_max_ms = 0;
+    t->last_sample_ms = now_ms;
+
+    bool changed = !t->has_last_sent || changed_meaningfully(s, &t->last_sent);
+    if (changed) {
+        t->urgent = true;
+    }
+    return changed;
+}
+
+bool telemetry_flush_due(const telemetry_t *t, uint64_t now_ms) {
+    if (t->count == 0) {
+        return false;
+    }
+    return t->urgent || now_ms - t->last_flush_ms >= t->flush_interval_ms;
+}
+
+int telemetry_encode(const telemetry_t *t, char *buf, size_t len) {
+    int n = snprintf(buf, len,
+                     "{\"v\":1,\"fields\":[\"uptime_s\",\"battery_level\",\"battery_charging\",\"rssi\","
+                     "\"heap_kb\",\"poll_ms_avg\",\"poll_ms_max\",\"display\",\"apl\",\"panel_load\",\"cpu_boost\"],\"dropped\":%lu,"
+                     "\"samples\":[",
+                     (unsigned long)t->dropped);
+    if (n < 0 || (size_t)n >= len) {
+        return -1;
+    }
+    size_t pos = (size_t)n;
+    for (int i = 0; i < t->count; i++) {
+        const telemetry_sample_t *s = &t->samples[i];
+        n = snprintf(buf + pos, len - pos, "%s[%lu,%d,%d,%d,%u,%u,%u,%u,%u,%u,%u]", i ? "," : "",
+                     (unsigned long)s->uptime_s, s->battery_level, s->charging ? 1 : 0, s->rssi,
+                     s->free_heap_kb, s->poll_ms_avg, s->poll_ms_max, s->display_state,
+                     s->apl, s->panel_load, s->cpu_boost);
+        if (n < 0 || (size_t)n >= len - pos) {
+            return -1;
+        }
+        pos += (size_t)n;
+    }
+    n = snprintf(buf + pos, len - pos, "]}");
+    if (n < 0 || (size_t)n >= len - pos) {
+        return -1;
+    }
+    return (int)(pos + (size_t)n);
+}
+
+void telemetry_flushed(telemetry_t *t, uint64_t now_ms) {
+    if (t->count > 0) {
+        t->last_sent = t->samples[t->count - 1];
+        t->has_last_sent = true;
+    }
+    t->count = 0;
+    t->dropped = 0;
+    t->urgent = false;
+    t->last_flush_ms = now_ms;
+}
+
+void telemetry_flush_failed(telemetry_t *t, uint64_t now_ms) {
+    // The next sample re-raises urgency if the change is still unreported
+    t->urgent = false;
+    t->last_flush_ms = now_ms;
+}
+
+const telemetry_sample_t *telemetry_latest(const telemetry_t *t) {
+    return t->count > 0 ? &t->samples[t->count - 1] : NULL;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+// Device telemetry batching. Samples are buffered locally and sent to the bridge as one
+// compact POST on their own schedule, so now_playing polls carry no device state and the
+// poll URL stays stable per zone. A meaningful change (charging flipped, battery moved a
+// few percent) asks for an early flush. Portable, no locking.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TELEMETRY_MAX_SAMPLES 16
+#define TELEMETRY_BATTERY_DELTA 5   // Percent change that is worth reporting early
+
+typedef struct {
+    uint32_t uptime_s;
+    int8_t battery_level;     // 0-100, -1 unknown
+    bool charging;
+    int8_t rssi;              // dBm, 0 unknown
+    uint16_t free_heap_kb;
+    uint16_t poll_ms_avg;     // Bridge round trip since the previous sample (0 = none)
+    uint16_t poll_ms_max;
+    uint8_t display_state;    // Platform display state (0 = normal)
+    uint8_t apl;              // Average picture level on screen, 0-255 (0 unknown)
+    uint8_t panel_load;       // Panel load, % of full white at full brightness
+    uint8_t cpu_boost;        // % of the sample interval at full CPU speed
+} telemetry_sample_t;
+
+typedef struct {
+    telemetry_sample_t samples[TELEMETRY_MAX_SAMPLES];
+    int count;
+    uint32_t dropped;         // Oldest samples overwritten while the bridge was unreachable
+    telemetry_sample_t last_sent;
+    bool has_last_sent;
+    bool urgent;              // A sample changed meaningfully since the last flush
+    uint32_t sample_interval_ms;
+    uint32_t flush_interval_ms;
+    uint64_t last_sample_ms;
+    uint64_t last_flush_ms;
+    uint32_t latency_sum_ms;  // Poll latency accumulated for the next sample
+    uint32_t latency_count;
+    uint16_t latency_max_ms;
+} telemetry_t;
+
+void telemetry_init(telemetry_t *t, uint32_t sample_interval_ms, uint32_t flush_interval_ms,
+                    uint64_t now_ms);
+
+// Record one bridge round trip; folded into the next sample's avg/max
+void telemetry_note_latency(telemetry_t *t, uint32_t ms);
+
+// True once a sample interval has passed since the last one
+bool telemetry_sample_due(const telemetry_t *t, uint64_t now_ms);
+
+// Buffer a sample (latency fields are filled in here). When full, the oldest sample is
+// dropped. Returns true if it differs meaningfully from what the bridge last received.
+bool telemetry_add_sample(telemetry_t *t, const telemetry_sample_t *sample, uint64_t now_ms);
+
+// True when there are samples and either the flush interval passed or a change is urgent
+bool telemetry_flush_due(const telemetry_t *t, uint64_t now_ms);
+
+// Encode the buffered samples as
+//   {"v":1,"fields":[...],"dropped":N,"samples":[[...],...]}
+// Returns the length written, or -1 if buf is too small.
+int telemetry_encode(const telemetry_t *t, char *buf, size_t len);
+
+// The batch was delivered (or handed to the legacy path): clear it
+void telemetry_flushed(telemetry_t *t, uint64_t now_ms);
+
+// The batch could not be delivered: keep it and try again after the next interval
+void telemetry_flush_failed(telemetry_t *t, uint64_t now_ms);
+
+// Newest buffered sample, or NULL
+const telemetry_sample_t *telemetry_latest(const telemetry_t *t);
+
+#ifdef __cplusplus
+}
+#endif
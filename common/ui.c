@@ -13,11 +13,16 @@
 #include "lvgl.h"
 #include "ui.h"
 #include "bridge_client.h"
+#include "seek_scrub.h"
+#include "ui_browse.h"
+#include "ui_queue.h"
 
 #ifdef ESP_PLATFORM
 #include "esp_log.h"
 #include "battery.h"
+#include "pm_locks.h"
 #include "ui_jpeg.h"  // JPEG decoder helper
+#include "platform/platform_display.h"
 #define UI_TAG "ui"
 #else
 #define UI_TAG "ui"
@@ -37,6 +42,20 @@
 #define COLOR_GREY          lv_color_hex(0x5a5a5a)
 #define COLOR_DARK_GREY     lv_color_hex(0x3c3c3c)
 
+// Text and indicator colours. The low-emission theme trades contrast for fewer lit
+// subpixels, which is what an AMOLED spends its power on.
+#if defined(CONFIG_RK_DARK_THEME)
+#define COLOR_TEXT          lv_color_hex(0xa0a0a0)
+#define COLOR_TEXT_DIM      lv_color_hex(0x6e6e6e)
+#define COLOR_ACCENT        lv_color_hex(0x2f6a96)
+#define COLOR_ACCENT_LIGHT  lv_color_hex(0x4a86b4)
+#else
+#define COLOR_TEXT          lv_color_hex(0xfafafa)
+#define COLOR_TEXT_DIM      lv_color_hex(0xaaaaaa)
+#define COLOR_ACCENT        lv_color_hex(0x5a9fd4)
+#define COLOR_ACCENT_LIGHT  lv_color_hex(0x7bb9e8)
+#endif
+
 struct ui_state {
     char line1[128];
     char line2[128];
@@ -122,8 +141,19 @@ static bool s_network_status_dirty = false;
 static ui_input_cb_t s_input_cb;
 static char s_last_image_key[128] = "";  // Track last loaded artwork
 static float s_last_predicted_volume = -9999.0f;  // Track user's predicted volume for emphasis suppression
+static lv_timer_t *s_battery_timer = NULL;  // Paused while controls are hidden
+static bool s_render_frozen = false;   // Art mode: only artwork and arcs are on screen
+static bool s_frozen_stale = false;    // State arrived while frozen; re-apply on thaw
+
+// Knob scrubbing: hold play/pause and turn the encoder to seek
+#define SCRUB_SEND_INTERVAL_MS 250    // At most one seek command per interval while turning
+#define SCRUB_HOLD_TIMEOUT_MS 5000    // Trust polled position again if the seek never shows up
+static seek_scrub_t s_scrub;
+static lv_timer_t *s_scrub_timer = NULL;   // Trailing send for coalesced ticks
+static bool s_play_long_pressed = false;   // Suppress play/pause click after a scrub
 #ifdef ESP_PLATFORM
 static ui_jpeg_image_t s_artwork_img;  // Decoded RGB565 image for artwork (ESP32)
+static lv_timer_t *s_artwork_fade_timer = NULL;  // Drives ui_artwork_crossfade_step()
 #else
 static char *s_artwork_data = NULL;  // Raw JPEG data for PC simulator
 #endif
@@ -156,6 +186,7 @@ static inline const lv_font_t *font_icon_large(void) { return &lv_font_montserra
 
 // Forward declarations
 static void apply_state(const struct ui_state *state);
+static void apply_arcs(const struct ui_state *state);
 static void build_layout(void);
 static void poll_pending(lv_timer_t *timer);
 static void set_status_dot(bool online);
@@ -163,6 +194,9 @@ static void zone_label_event_cb(lv_event_t *e);
 static void zone_label_long_press_cb(lv_event_t *e);
 static void btn_prev_event_cb(lv_event_t *e);
 static void btn_play_event_cb(lv_event_t *e);
+static void btn_play_pressed_cb(lv_event_t *e);
+static void btn_play_long_press_cb(lv_event_t *e);
+static void btn_play_released_cb(lv_event_t *e);
 static void btn_next_event_cb(lv_event_t *e);
 static void zone_list_item_event_cb(lv_event_t *e);
 static void show_status_message(const char *message);
@@ -205,6 +239,70 @@ static inline int calculate_volume_percentage(float volume, float volume_min, fl
     return vol_pct;
 }
 
+// ============================================================================
+// Track/Artist Titles
+// ============================================================================
+
+// Opt-in cached-bitmap marquee (ui_marquee.c) instead of LVGL's circular-scroll label
+#if defined(CONFIG_RK_CACHED_MARQUEE)
+#define UI_CACHED_MARQUEE 1
+#include "ui_marquee.h"
+#define MARQUEE_PERIOD_CHARGING_MS 33   // ~30fps on USB power
+#define MARQUEE_PERIOD_BATTERY_MS 100   // ~10fps on battery (same speed, bigger steps)
+#else
+#define UI_CACHED_MARQUEE 0
+#endif
+
+static lv_obj_t *create_title(lv_obj_t *parent, const lv_font_t *font, lv_color_t color, const char *text) {
+#if UI_CACHED_MARQUEE
+    lv_obj_t *obj = ui_marquee_create(parent, SCREEN_SIZE - 100, font, color);
+    ui_marquee_set_text(obj, text);
+#else
+    lv_obj_t *obj = lv_label_create(parent);
+    lv_obj_set_width(obj, SCREEN_SIZE - 100);
+    lv_obj_set_style_text_font(obj, font, 0);
+    lv_obj_set_style_text_align(obj, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_text_color(obj, color, 0);
+    lv_label_set_long_mode(obj, LV_LABEL_LONG_SCROLL_CIRCULAR);
+    lv_obj_set_style_anim_time(obj, 25000, LV_PART_MAIN);
+    lv_label_set_text(obj, text);
+#endif
+    return obj;
+}
+
+static void set_title_text(lv_obj_t *obj, const char *text) {
+#if UI_CACHED_MARQUEE
+    ui_marquee_set_text(obj, text);  // No-op (and no redraw) if unchanged
+#else
+    lv_label_set_text(obj, text);
+    lv_obj_invalidate(obj);
+#endif
+}
+
+// Start/stop title scrolling (stopped while controls are hidden)
+static void set_title_scrolling(lv_obj_t *obj, bool scrolling) {
+    if (!obj) return;
+#if UI_CACHED_MARQUEE
+    ui_marquee_set_paused(obj, !scrolling);
+#else
+    // Clip mode removes the label's scroll animation entirely
+    lv_label_set_long_mode(obj, scrolling ? LV_LABEL_LONG_SCROLL_CIRCULAR : LV_LABEL_LONG_CLIP);
+#endif
+}
+
+#ifdef ESP_PLATFORM
+// Lower the marquee frame rate on battery
+static void set_title_power_mode(bool charging) {
+#if UI_CACHED_MARQUEE
+    uint32_t period = charging ? MARQUEE_PERIOD_CHARGING_MS : MARQUEE_PERIOD_BATTERY_MS;
+    if (s_track_label) ui_marquee_set_period(s_track_label, period);
+    if (s_artist_label) ui_marquee_set_period(s_artist_label, period);
+#else
+    (void)charging;
+#endif
+}
+#endif
+
 // ============================================================================
 // UI Initialization
 // ============================================================================
@@ -216,6 +314,7 @@ void ui_init(void) {
     ESP_LOGI(UI_TAG, "Using ESP_NEW_JPEG software decoder for artwork");
 
     build_layout();
+    seek_scrub_init(&s_scrub, SCRUB_SEND_INTERVAL_MS, SCRUB_HOLD_TIMEOUT_MS);
 
     // Poll for state updates every 50ms
     lv_timer_t *poll_timer = lv_timer_create(poll_pending, 50, NULL);
@@ -226,9 +325,9 @@ void ui_init(void) {
     }
 
     // Periodic battery check for percentage drift (charging state changes trigger immediate updates)
-    lv_timer_t *battery_timer = lv_timer_create(battery_poll_timer_cb, 30000, NULL);
-    if (battery_timer) {
-        lv_timer_set_repeat_count(battery_timer, -1);
+    s_battery_timer = lv_timer_create(battery_poll_timer_cb, 30000, NULL);
+    if (s_battery_timer) {
+        lv_timer_set_repeat_count(s_battery_timer, -1);
     } else {
         ESP_LOGE(UI_TAG, "FAILED to create battery poll timer!");
     }
@@ -245,7 +344,7 @@ static void create_styles(void) {
     lv_style_set_bg_color(&style_button_primary, lv_color_hex(0x2c2c2c));  // Dark grey
     lv_style_set_bg_opa(&style_button_primary, LV_OPA_COVER);
     lv_style_set_border_width(&style_button_primary, 3);
-    lv_style_set_border_color(&style_button_primary, lv_color_hex(0x5a9fd4));  // Light blue
+    lv_style_set_border_color(&style_button_primary, COLOR_ACCENT);  // Light blue
     lv_style_set_border_opa(&style_button_primary, LV_OPA_COVER);
     lv_style_set_shadow_width(&style_button_primary, 0);
 
@@ -261,7 +360,7 @@ static void create_styles(void) {
 
     // Button label style
     lv_style_init(&style_button_label);
-    lv_style_set_text_color(&style_button_label, lv_color_hex(0xfafafa));  // Off-white
+    lv_style_set_text_color(&style_button_label, COLOR_TEXT);  // Off-white
 }
 
 // ============================================================================
@@ -329,7 +428,7 @@ static void build_layout(void) {
 
     // Arc colors - dark grey background track, blue indicator
     lv_obj_set_style_arc_color(s_volume_arc, lv_color_hex(0x3a3a3a), LV_PART_MAIN);  // Lighter grey for visibility
-    lv_obj_set_style_arc_color(s_volume_arc, lv_color_hex(0x5a9fd4), LV_PART_INDICATOR);
+    lv_obj_set_style_arc_color(s_volume_arc, COLOR_ACCENT, LV_PART_INDICATOR);
     lv_obj_set_style_arc_opa(s_volume_arc, LV_OPA_COVER, LV_PART_MAIN);
     lv_obj_set_style_arc_opa(s_volume_arc, LV_OPA_COVER, LV_PART_INDICATOR);
 
@@ -350,7 +449,7 @@ static void build_layout(void) {
 
     // Progress arc colors - subtle grey track, lighter blue indicator
     lv_obj_set_style_arc_color(s_progress_arc, lv_color_hex(0x2a2a2a), LV_PART_MAIN);  // Slightly lighter
-    lv_obj_set_style_arc_color(s_progress_arc, lv_color_hex(0x7bb9e8), LV_PART_INDICATOR);
+    lv_obj_set_style_arc_color(s_progress_arc, COLOR_ACCENT_LIGHT, LV_PART_INDICATOR);
     lv_obj_set_style_arc_opa(s_progress_arc, LV_OPA_COVER, LV_PART_MAIN);
     lv_obj_set_style_arc_opa(s_progress_arc, LV_OPA_COVER, LV_PART_INDICATOR);
 
@@ -418,28 +517,14 @@ static void build_layout(void) {
     s_volume_label_large = lv_label_create(now_playing);
     lv_label_set_text(s_volume_label_large, "-- dB");
     lv_obj_set_style_text_font(s_volume_label_large, font_normal(), 0);
-    lv_obj_set_style_text_color(s_volume_label_large, lv_color_hex(0xfafafa), 0);
+    lv_obj_set_style_text_color(s_volume_label_large, COLOR_TEXT, 0);
     lv_obj_set_style_margin_bottom(s_volume_label_large, 4, 0);  // Extra gap below volume
 
     // Artist label - smaller font, secondary text
-    s_artist_label = lv_label_create(now_playing);
-    lv_obj_set_width(s_artist_label, SCREEN_SIZE - 100);
-    lv_obj_set_style_text_font(s_artist_label, font_small(), 0);
-    lv_obj_set_style_text_align(s_artist_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_text_color(s_artist_label, lv_color_hex(0xaaaaaa), 0);
-    lv_label_set_long_mode(s_artist_label, LV_LABEL_LONG_SCROLL_CIRCULAR);
-    lv_obj_set_style_anim_time(s_artist_label, 25000, LV_PART_MAIN);
-    lv_label_set_text(s_artist_label, s_pending.line2);
+    s_artist_label = create_title(now_playing, font_small(), COLOR_TEXT_DIM, s_pending.line2);
 
     // Track label - larger font, primary text
-    s_track_label = lv_label_create(now_playing);
-    lv_obj_set_width(s_track_label, SCREEN_SIZE - 100);
-    lv_obj_set_style_text_font(s_track_label, font_normal(), 0);
-    lv_obj_set_style_text_align(s_track_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_text_color(s_track_label, lv_color_hex(0xfafafa), 0);
-    lv_label_set_long_mode(s_track_label, LV_LABEL_LONG_SCROLL_CIRCULAR);
-    lv_obj_set_style_anim_time(s_track_label, 25000, LV_PART_MAIN);
-    lv_label_set_text(s_track_label, s_pending.line1);
+    s_track_label = create_title(now_playing, font_normal(), COLOR_TEXT, s_pending.line1);
 
     // Controls row - flex row for transport buttons
     lv_obj_t *controls = lv_obj_create(now_playing);
@@ -461,7 +546,7 @@ static void build_layout(void) {
     lv_obj_set_style_bg_color(s_btn_prev, lv_color_hex(0x1a1a1a), LV_STATE_DEFAULT);
     lv_obj_set_style_bg_color(s_btn_prev, lv_color_hex(0x3c3c3c), LV_STATE_PRESSED);
     lv_obj_set_style_border_color(s_btn_prev, COLOR_GREY, LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(s_btn_prev, lv_color_hex(0x5a9fd4), LV_STATE_PRESSED);
+    lv_obj_set_style_border_color(s_btn_prev, COLOR_ACCENT, LV_STATE_PRESSED);
 
     lv_obj_t *prev_label = lv_label_create(s_btn_prev);
 #if !TARGET_PC
@@ -479,10 +564,14 @@ static void build_layout(void) {
     lv_obj_set_size(s_btn_play, 80, 80);
     lv_obj_add_style(s_btn_play, &style_button_primary, 0);
     lv_obj_add_event_cb(s_btn_play, btn_play_event_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_add_event_cb(s_btn_play, btn_play_pressed_cb, LV_EVENT_PRESSED, NULL);
+    lv_obj_add_event_cb(s_btn_play, btn_play_long_press_cb, LV_EVENT_LONG_PRESSED, NULL);
+    lv_obj_add_event_cb(s_btn_play, btn_play_released_cb, LV_EVENT_RELEASED, NULL);
+    lv_obj_add_event_cb(s_btn_play, btn_play_released_cb, LV_EVENT_PRESS_LOST, NULL);
     lv_obj_set_style_bg_color(s_btn_play, lv_color_hex(0x2c2c2c), LV_STATE_DEFAULT);
     lv_obj_set_style_bg_color(s_btn_play, lv_color_hex(0x3c3c3c), LV_STATE_PRESSED);
-    lv_obj_set_style_border_color(s_btn_play, lv_color_hex(0x5a9fd4), LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(s_btn_play, lv_color_hex(0x7bb9e8), LV_STATE_PRESSED);
+    lv_obj_set_style_border_color(s_btn_play, COLOR_ACCENT, LV_STATE_DEFAULT);
+    lv_obj_set_style_border_color(s_btn_play, COLOR_ACCENT_LIGHT, LV_STATE_PRESSED);
 
     s_play_icon = lv_label_create(s_btn_play);
 #if !TARGET_PC
@@ -503,7 +592,7 @@ static void build_layout(void) {
     lv_obj_set_style_bg_color(s_btn_next, lv_color_hex(0x1a1a1a), LV_STATE_DEFAULT);
     lv_obj_set_style_bg_color(s_btn_next, lv_color_hex(0x3c3c3c), LV_STATE_PRESSED);
     lv_obj_set_style_border_color(s_btn_next, COLOR_GREY, LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(s_btn_next, lv_color_hex(0x5a9fd4), LV_STATE_PRESSED);
+    lv_obj_set_style_border_color(s_btn_next, COLOR_ACCENT, LV_STATE_PRESSED);
 
     lv_obj_t *next_label = lv_label_create(s_btn_next);
 #if !TARGET_PC
@@ -525,7 +614,7 @@ static void build_layout(void) {
     lv_obj_set_style_text_color(s_status_bar, lv_color_hex(0x000000), 0);  // Black text
     lv_label_set_long_mode(s_status_bar, LV_LABEL_LONG_DOT);
     // Background styling (hidden by default, shown when message appears)
-    lv_obj_set_style_bg_color(s_status_bar, lv_color_hex(0xfafafa), 0);  // Off-white
+    lv_obj_set_style_bg_color(s_status_bar, COLOR_TEXT, 0);  // Off-white
     lv_obj_set_style_bg_opa(s_status_bar, LV_OPA_TRANSP, 0);  // Hidden initially
     lv_obj_set_style_pad_ver(s_status_bar, 4, 0);
     lv_obj_set_style_pad_hor(s_status_bar, 12, 0);
@@ -567,12 +656,78 @@ static void btn_prev_event_cb(lv_event_t *e) {
 
 static void btn_play_event_cb(lv_event_t *e) {
     (void)e;
+    // Skip click if it came from a scrub release
+    if (s_play_long_pressed) {
+        s_play_long_pressed = false;
+        return;
+    }
     ESP_LOGI(UI_TAG, "btn_play_event_cb triggered, s_input_cb=%p", (void*)s_input_cb);
     if (s_input_cb) {
         s_input_cb(UI_INPUT_PLAY_PAUSE);
     }
 }
 
+// ============================================================================
+// Knob Scrubbing
+// ============================================================================
+
+static void scrub_send(void) {
+    bool ok = bridge_client_seek(s_scrub.position);
+    seek_scrub_sent(&s_scrub, ok, platform_millis());
+}
+
+static void scrub_show_preview(void) {
+    os_mutex_lock(&s_state_lock);
+    s_pending.seek_position = s_scrub.position;
+    s_dirty = true;
+    os_mutex_unlock(&s_state_lock);
+}
+
+static void scrub_timer_cb(lv_timer_t *timer) {
+    (void)timer;
+    if (seek_scrub_poll(&s_scrub, platform_millis())) {
+        scrub_send();
+    }
+}
+
+static void btn_play_pressed_cb(lv_event_t *e) {
+    (void)e;
+    // A scrub that ended without a click (press lost) must not swallow this press's tap
+    s_play_long_pressed = false;
+}
+
+static void btn_play_long_press_cb(lv_event_t *e) {
+    (void)e;
+    os_mutex_lock(&s_state_lock);
+    int position = s_pending.seek_position;
+    int length = s_pending.length;
+    os_mutex_unlock(&s_state_lock);
+    if (!seek_scrub_begin(&s_scrub, position, length)) {
+        return;  // Nothing seekable (radio, idle zone)
+    }
+    s_play_long_pressed = true;
+    ESP_LOGI(UI_TAG, "Scrub start at %d/%d", position, length);
+    lv_obj_set_style_arc_color(s_progress_arc, COLOR_TEXT, LV_PART_INDICATOR);
+    s_scrub_timer = lv_timer_create(scrub_timer_cb, SCRUB_SEND_INTERVAL_MS / 2, NULL);
+}
+
+static void btn_play_released_cb(lv_event_t *e) {
+    (void)e;
+    if (!s_scrub.active) {
+        return;
+    }
+    if (s_scrub_timer) {
+        lv_timer_delete(s_scrub_timer);
+        s_scrub_timer = NULL;
+    }
+    if (seek_scrub_end(&s_scrub, platform_millis())) {
+        scrub_send();  // Final commit
+    }
+    ESP_LOGI(UI_TAG, "Scrub commit at %d", s_scrub.committed);
+    lv_obj_set_style_arc_color(s_progress_arc, COLOR_ACCENT_LIGHT, LV_PART_INDICATOR);
+    scrub_show_preview();
+}
+
 static void btn_next_event_cb(lv_event_t *e) {
     (void)e;
     ESP_LOGI(UI_TAG, "btn_next_event_cb triggered, s_input_cb=%p", (void*)s_input_cb);
@@ -594,24 +749,57 @@ static void zone_list_item_event_cb(lv_event_t *e) {
 // State Management
 // ============================================================================
 
-static void apply_state(const struct ui_state *state) {
-    // Update track/artist labels
-    if (s_track_label && s_artist_label) {
-        lv_label_set_text(s_track_label, state->line1);
-        lv_obj_invalidate(s_track_label);
+static void apply_arcs(const struct ui_state *state) {
+    // Convert to 0-100 scale for arc display using zone's actual min/max
+    int vol_pct = calculate_volume_percentage(state->volume, state->volume_min, state->volume_max);
+    lv_arc_set_value(s_volume_arc, vol_pct);
 
-        lv_label_set_text(s_artist_label, state->line2);
-        lv_obj_invalidate(s_artist_label);
-    } else {
-        ESP_LOGE(UI_TAG, "Label pointers are NULL! track=%p artist=%p", s_track_label, s_artist_label);
+    // Update progress arc based on seek position and track length
+    // lv_arc_set_value() already invalidates on change; while frozen, skip the forced
+    // invalidate so an unchanged arc costs no frame
+    if (s_progress_arc) {
+        int progress_pct = 0;
+        if (state->length > 0) {
+            progress_pct = (state->seek_position * 100) / state->length;
+            if (progress_pct > 100) progress_pct = 100;
+            if (progress_pct < 0) progress_pct = 0;
+        }
+        lv_arc_set_value(s_progress_arc, progress_pct);
+        if (!s_render_frozen) {
+            lv_obj_invalidate(s_progress_arc);
+        }
     }
+}
 
-    // Update volume arc and label, emphasize if volume changed
+static void apply_state(const struct ui_state *state) {
+    // Track volume changes even while frozen so thawing doesn't replay an emphasis
     // Volume is in dB with zone-specific min/max range
     static float last_volume = -9999.0f;  // Sentinel value (unlikely real volume)
     static bool volume_initialized = false;
     float vol_diff = state->volume < last_volume ? last_volume - state->volume : state->volume - last_volume;
-    if (volume_initialized && vol_diff > 0.01f) {
+    bool volume_changed = volume_initialized && vol_diff > 0.01f;
+    volume_initialized = true;
+    last_volume = state->volume;
+
+    apply_arcs(state);
+
+    // Art mode: labels, icons and battery are hidden - don't touch them.
+    // ui_set_controls_visible(true) re-applies the latest state.
+    if (s_render_frozen) {
+        s_frozen_stale = true;
+        return;
+    }
+
+    // Update track/artist labels
+    if (s_track_label && s_artist_label) {
+        set_title_text(s_track_label, state->line1);
+        set_title_text(s_artist_label, state->line2);
+    } else {
+        ESP_LOGE(UI_TAG, "Label pointers are NULL! track=%p artist=%p", s_track_label, s_artist_label);
+    }
+
+    // Emphasize volume label if volume changed
+    if (volume_changed) {
         // Only emphasize if value differs from last user prediction
         // (suppresses redundant emphasis when poll confirms user's change)
         float pred_diff = state->volume < s_last_predicted_volume ? s_last_predicted_volume - state->volume : state->volume - s_last_predicted_volume;
@@ -619,12 +807,6 @@ static void apply_state(const struct ui_state *state) {
             emphasize_volume_label();
         }
     }
-    volume_initialized = true;
-    last_volume = state->volume;
-
-    // Convert to 0-100 scale for arc display using zone's actual min/max
-    int vol_pct = calculate_volume_percentage(state->volume, state->volume_min, state->volume_max);
-    lv_arc_set_value(s_volume_arc, vol_pct);
 
     // Display volume (format matches zone's step precision)
     char vol_text[16];
@@ -632,18 +814,6 @@ static void apply_state(const struct ui_state *state) {
     format_volume_text(vol_text, sizeof(vol_text), state->volume, state->volume_min, state->volume_step);
     lv_label_set_text(s_volume_label_large, vol_text);
 
-    // Update progress arc based on seek position and track length
-    if (s_progress_arc && state->length > 0) {
-        int progress_pct = (state->seek_position * 100) / state->length;
-        if (progress_pct > 100) progress_pct = 100;
-        if (progress_pct < 0) progress_pct = 0;
-        lv_arc_set_value(s_progress_arc, progress_pct);
-        lv_obj_invalidate(s_progress_arc);
-    } else if (s_progress_arc) {
-        lv_arc_set_value(s_progress_arc, 0);
-        lv_obj_invalidate(s_progress_arc);
-    }
-
     // Update play/pause icon
     if (s_play_icon) {
 #if !TARGET_PC
@@ -746,6 +916,10 @@ static void update_battery_display(void) {
         return;
     }
 
+    if (charging != s_last_battery_charging || s_last_battery_level < 0) {
+        set_title_power_mode(charging);
+    }
+
     s_last_battery_level = level;
     s_last_battery_charging = charging;
 
@@ -821,7 +995,7 @@ static void clear_status_message_timer_cb(lv_timer_t *timer) {
 static void reset_volume_emphasis_timer_cb(lv_timer_t *timer) {
     (void)timer;
     if (s_volume_label_large) {
-        lv_obj_set_style_text_color(s_volume_label_large, lv_color_hex(0xfafafa), 0);  // Reset to white
+        lv_obj_set_style_text_color(s_volume_label_large, COLOR_TEXT, 0);  // Reset to white
     }
     s_volume_emphasis_timer = NULL;
 }
@@ -832,7 +1006,7 @@ static void emphasize_volume_label(void) {
     }
 
     // Emphasize with bright blue
-    lv_obj_set_style_text_color(s_volume_label_large, lv_color_hex(0x7bb9e8), 0);
+    lv_obj_set_style_text_color(s_volume_label_large, COLOR_ACCENT_LIGHT, 0);
 
     // Reset/create timer to remove emphasis after 1.5 seconds
     if (s_volume_emphasis_timer) {
@@ -879,7 +1053,7 @@ void ui_show_zone_picker(const char **zone_names, const char **zone_ids, int cou
     lv_obj_t *title = lv_label_create(s_zone_picker_overlay);
     lv_label_set_text(title, "SELECT ZONE");
     lv_obj_set_style_text_font(title, font_normal(), 0);
-    lv_obj_set_style_text_color(title, lv_color_hex(0xfafafa), 0);
+    lv_obj_set_style_text_color(title, COLOR_TEXT, 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 30);
 
     // Create list widget - allows per-item icons
@@ -922,7 +1096,7 @@ void ui_show_zone_picker(const char **zone_names, const char **zone_ids, int cou
 #else
         lv_obj_set_style_text_font(icon_label, font_normal(), 0);
 #endif
-        lv_obj_set_style_text_color(icon_label, lv_color_hex(0xaaaaaa), 0);
+        lv_obj_set_style_text_color(icon_label, COLOR_TEXT_DIM, 0);
 
         // Set icon based on zone type
         const char *zone_id = zone_ids[i];
@@ -950,7 +1124,7 @@ void ui_show_zone_picker(const char **zone_names, const char **zone_ids, int cou
         // Create text label (using text font)
         lv_obj_t *text_label = lv_label_create(btn);
         lv_obj_set_style_text_font(text_label, font_normal(), 0);
-        lv_obj_set_style_text_color(text_label, lv_color_hex(0xfafafa), 0);
+        lv_obj_set_style_text_color(text_label, COLOR_TEXT, 0);
         lv_label_set_text(text_label, zone_names[i]);
 
         // Store index in button user data
@@ -1012,6 +1186,21 @@ void ui_zone_picker_get_selected_id(char *out, size_t len) {
     }
 }
 
+bool ui_zone_picker_selected_point(int *x, int *y) {
+    if (!s_zone_picker_visible || !s_zone_list) {
+        return false;
+    }
+    lv_obj_t *btn = lv_obj_get_child(s_zone_list, s_zone_picker_selected);
+    if (!btn) {
+        return false;
+    }
+    lv_area_t area;
+    lv_obj_get_coords(btn, &area);
+    *x = (area.x1 + area.x2) / 2;
+    *y = (area.y1 + area.y2) / 2;
+    return true;
+}
+
 bool ui_zone_picker_is_current_selection(void) {
     // Returns true if user selected the same zone they started with (no-op)
     return s_zone_picker_selected == s_zone_picker_current;
@@ -1134,7 +1323,18 @@ void ui_dispatch_input(ui_input_event_t input) {
 }
 
 void ui_handle_volume_rotation(int ticks) {
-    if (ui_is_zone_picker_visible()) {
+    if (s_scrub.active) {
+        // Play/pause held: ticks move the preview; seeks are throttled
+        if (seek_scrub_ticks(&s_scrub, ticks, platform_millis())) {
+            scrub_send();
+        }
+        scrub_show_preview();
+    } else if (ui_queue_is_visible()) {
+        // Scroll the queue; ticks carry velocity so long queues are quick to traverse
+        ui_queue_scroll(ticks);
+    } else if (ui_browse_is_visible()) {
+        ui_browse_scroll(ticks);
+    } else if (ui_is_zone_picker_visible()) {
         // Scroll zone picker instead of changing volume
         ui_zone_picker_scroll(ticks > 0 ? 1 : -1);
     } else {
@@ -1143,9 +1343,16 @@ void ui_handle_volume_rotation(int ticks) {
     }
 }
 
+// Snapshot read from the haptics task: a stale answer only picks the wrong click style once
+bool ui_rotation_controls_volume(void) {
+    return !s_scrub.active && !ui_queue_is_visible() && !ui_browse_is_visible() &&
+           !ui_is_zone_picker_visible();
+}
+
 void ui_set_progress(int seek_ms, int length_ms) {
     os_mutex_lock(&s_state_lock);
-    s_pending.seek_position = seek_ms;
+    // While scrubbing or waiting for a committed seek, the local position wins
+    s_pending.seek_position = seek_scrub_display(&s_scrub, seek_ms, s_pending.playing, platform_millis());
     s_pending.length = length_ms;
     s_dirty = true;
     os_mutex_unlock(&s_state_lock);
@@ -1233,6 +1440,45 @@ void ui_test_pattern(void) {
 #endif
 }
 
+#ifdef ESP_PLATFORM
+// Artwork crossfade policy (Kconfig "Artwork" menu)
+#ifndef CONFIG_RK_ARTWORK_CROSSFADE_STEPS
+#define CONFIG_RK_ARTWORK_CROSSFADE_STEPS 8
+#endif
+#define ARTWORK_FADE_PERIOD_MS 33  // ~30fps; each step is one blend + one full-image redraw
+
+static bool artwork_crossfade_allowed(void) {
+#ifndef CONFIG_RK_ARTWORK_CROSSFADE
+    return false;
+#else
+    // Nothing to fade from, or nobody to see it
+    if (!s_artwork_img.dsc.data || lv_obj_has_flag(s_artwork_image, LV_OBJ_FLAG_HIDDEN)) {
+        return false;
+    }
+    if (platform_display_is_sleeping()) {
+        return false;
+    }
+#ifndef CONFIG_RK_ARTWORK_CROSSFADE_ON_BATTERY
+    if (!battery_is_charging()) {
+        return false;
+    }
+#endif
+    return true;
+#endif
+}
+
+static void artwork_fade_timer_cb(lv_timer_t *timer) {
+    pm_work_begin(PM_WORK_ARTWORK);
+    bool done = ui_artwork_crossfade_step();
+    pm_work_end(PM_WORK_ARTWORK);
+    lv_obj_invalidate(s_artwork_image);
+    if (done) {
+        lv_timer_delete(timer);
+        s_artwork_fade_timer = NULL;
+    }
+}
+#endif
+
 void ui_set_artwork(const char *image_key) {
     // Check if image_key changed
     if (!image_key || !image_key[0]) {
@@ -1287,10 +1533,32 @@ void ui_set_artwork(const char *image_key) {
 
     ESP_LOGI(UI_TAG, "Processing raw RGB565 format (%zu bytes)", img_len);
 
+    // Crossfade from the current artwork when policy allows; the displayed buffer is
+    // blended in place, so the image descriptor doesn't change
+    pm_work_begin(PM_WORK_ARTWORK);
+    if (artwork_crossfade_allowed() &&
+        ui_artwork_crossfade_begin((const uint8_t *)img_data, SCREEN_SIZE, SCREEN_SIZE,
+                                   CONFIG_RK_ARTWORK_CROSSFADE_STEPS)) {
+        pm_work_end(PM_WORK_ARTWORK);
+        platform_http_free(img_data);
+        if (!s_artwork_fade_timer) {
+            s_artwork_fade_timer = lv_timer_create(artwork_fade_timer_cb, ARTWORK_FADE_PERIOD_MS, NULL);
+        }
+        if (!s_artwork_fade_timer) {
+            ui_artwork_crossfade_finish();
+            lv_obj_invalidate(s_artwork_image);
+        }
+        strncpy(s_last_image_key, image_key, sizeof(s_last_image_key) - 1);
+        s_last_image_key[sizeof(s_last_image_key) - 1] = '\0';
+        ESP_LOGI(UI_TAG, "Artwork crossfade started (%d steps)", CONFIG_RK_ARTWORK_CROSSFADE_STEPS);
+        return;
+    }
+
     // Copy to global buffer (maintains ownership model)
     ui_jpeg_image_t new_img;
     bool ok = ui_rgb565_from_buffer((const uint8_t *)img_data,
                                     SCREEN_SIZE, SCREEN_SIZE, &new_img);
+    pm_work_end(PM_WORK_ARTWORK);
 
     // HTTP buffer no longer needed after copy
     platform_http_free(img_data);
@@ -1487,6 +1755,19 @@ void ui_set_controls_visible(bool visible) {
         if (s_status_bar) lv_obj_clear_flag(s_status_bar, LV_OBJ_FLAG_HIDDEN);
         // Restore artwork dimming for text contrast
         if (s_artwork_image) lv_obj_set_style_img_opa(s_artwork_image, LV_OPA_40, 0);
+        // Thaw: restart marquee scrolling and battery polling, catch up on skipped state
+        if (s_render_frozen) {
+            s_render_frozen = false;
+            set_title_scrolling(s_track_label, true);
+            set_title_scrolling(s_artist_label, true);
+            if (s_battery_timer) lv_timer_resume(s_battery_timer);
+            if (s_frozen_stale) {
+                s_frozen_stale = false;
+                os_mutex_lock(&s_state_lock);
+                s_dirty = true;
+                os_mutex_unlock(&s_state_lock);
+            }
+        }
         ESP_LOGI(UI_TAG, "Controls shown");
         // Force battery display update after showing controls (GH-86)
         // Without this, hysteresis in update_battery_display() prevents the icon from reappearing
@@ -1506,7 +1787,18 @@ void ui_set_controls_visible(bool visible) {
         if (s_status_bar) lv_obj_add_flag(s_status_bar, LV_OBJ_FLAG_HIDDEN);
         // Make artwork fully visible in art mode
         if (s_artwork_image) lv_obj_set_style_img_opa(s_artwork_image, LV_OPA_COVER, 0);
+        // Freeze: hidden marquee labels still run their scroll animations and the
+        // battery timer only updates a hidden icon - stop both until controls return
+        if (!s_render_frozen) {
+            s_render_frozen = true;
+            set_title_scrolling(s_track_label, false);
+            set_title_scrolling(s_artist_label, false);
+            if (s_battery_timer) lv_timer_pause(s_battery_timer);
+        }
         ESP_LOGI(UI_TAG, "Controls hidden (art mode)");
     }
 }
 
+bool ui_is_render_frozen(void) {
+    return s_render_frozen;
+}
@@ -28,6 +28,7 @@ void ui_set_message(const char *msg);
 void ui_set_input_handler(ui_input_cb_t handler);
 void ui_dispatch_input(ui_input_event_t ev);
 void ui_handle_volume_rotation(int ticks);  // Velocity-sensitive volume control
+bool ui_rotation_controls_volume(void);      // False while rotation scrolls a list or scrubs
 void ui_set_zone_name(const char *zone_name);
 void ui_show_zone_picker(const char **zone_names, const char **zone_ids, int zone_count, int selected_idx);
 void ui_hide_zone_picker(void);
@@ -36,6 +37,7 @@ int ui_zone_picker_get_selected(void);
 void ui_zone_picker_get_selected_id(char *out, size_t len);
 void ui_zone_picker_scroll(int delta);
 bool ui_zone_picker_is_current_selection(void);  // Returns true if selected zone == current zone
+bool ui_zone_picker_selected_point(int *x, int *y);  // Screen centre of the highlighted row (UI thread)
 void ui_set_artwork(const char *image_key);  // Set album artwork (placeholder for now)
 void ui_show_volume_change(float vol, float vol_step);  // Show volume overlay when adjusting
 void ui_test_pattern(void);  // Debug: Show RGB test pattern to verify color format
@@ -52,6 +54,7 @@ void ui_trigger_update(void);  // Called when user taps update notification
 
 // Display state control
 void ui_set_controls_visible(bool visible);  // Show/hide UI controls for art mode
+bool ui_is_render_frozen(void);  // True while controls are hidden (only artwork/arcs can change)
 
 // Network status banner (persistent, doesn't auto-clear)
 void ui_set_network_status(const char *status);  // Show persistent network status (NULL to clear)
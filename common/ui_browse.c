@@ -0,0 +1,378 @@
+// Library browse screen
+
+#include "ui_browse.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lvgl.h"
+#include "browse_model.h"
+#include "bridge_client.h"
+#include "platform/platform_time.h"
+#include "ui.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+#define SCREEN_SIZE 360
+#else
+#define SCREEN_SIZE 240
+#define ESP_LOGI(tag, fmt, ...) printf("[I] " tag ": " fmt "\n", ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) printf("[W] " tag ": " fmt "\n", ##__VA_ARGS__)
+#endif
+#define BROWSE_TAG "ui_browse"
+
+#if !TARGET_PC
+#include "font_manager.h"
+static inline const lv_font_t *font_small(void) { return font_manager_get_small(); }
+static inline const lv_font_t *font_normal(void) { return font_manager_get_normal(); }
+#else
+static inline const lv_font_t *font_small(void) { return &lv_font_montserrat_20; }
+static inline const lv_font_t *font_normal(void) { return &lv_font_montserrat_28; }
+#endif
+
+// Three rows of 64px thumbnails fit the round panel; the middle row is selected
+#define BROWSE_VISIBLE_ROWS 3
+#define BROWSE_ROW_HEIGHT 72
+#define BROWSE_ROW_WIDTH (SCREEN_SIZE - 60)
+#define BROWSE_THUMB_BYTES (BROWSE_THUMB_SIZE * BROWSE_THUMB_SIZE * 2)
+#define BROWSE_THUMB_CACHE 8   // > visible rows, so LRU eviction never hits a shown thumb
+
+typedef struct {
+    lv_obj_t *row;
+    lv_obj_t *thumb;
+    lv_obj_t *title;
+    lv_obj_t *subtitle;
+} browse_row_t;
+
+typedef struct {
+    char key[PAGED_LIST_ID_LEN];
+    uint8_t *pixels;             // RGB565, BROWSE_THUMB_BYTES
+    lv_image_dsc_t dsc;
+    uint32_t last_used;
+} browse_thumb_t;
+
+static lv_obj_t *s_overlay = NULL;
+static lv_obj_t *s_title = NULL;
+static browse_row_t s_rows[BROWSE_VISIBLE_ROWS];
+static browse_model_t *s_model = NULL;   // Allocated while visible (~90KB, lands in PSRAM)
+static browse_level_t *s_level = NULL;   // Level for the current crumb; changes only on navigation
+static uint32_t s_generation_base = 0;   // Survives hide/show so late pages are dropped
+static browse_thumb_t s_thumbs[BROWSE_THUMB_CACHE];
+static uint32_t s_thumb_clock = 0;
+
+// Per-step latency: from a navigation action until the selected row shows real data
+static uint64_t s_step_start_ms = 0;
+static bool s_step_cached = false;
+
+static void start_step(bool cached) {
+    s_step_start_ms = platform_millis();
+    s_step_cached = cached;
+}
+
+static void end_step_if_ready(const paged_list_item_t *selected_item) {
+    if (s_step_start_ms == 0 || !selected_item) return;
+    ESP_LOGI(BROWSE_TAG, "Browse step: %u ms (%s)",
+             (unsigned)(platform_millis() - s_step_start_ms), s_step_cached ? "cached" : "fetched");
+    s_step_start_ms = 0;
+}
+
+// ============================================================================
+// Thumbnails
+// ============================================================================
+
+static browse_thumb_t *thumb_find(const char *key) {
+    for (int i = 0; i < BROWSE_THUMB_CACHE; i++) {
+        if (s_thumbs[i].pixels && strcmp(s_thumbs[i].key, key) == 0) {
+            s_thumbs[i].last_used = ++s_thumb_clock;
+            return &s_thumbs[i];
+        }
+    }
+    return NULL;
+}
+
+static void thumb_cache_clear(void) {
+    for (int i = 0; i < BROWSE_THUMB_CACHE; i++) {
+        free(s_thumbs[i].pixels);
+    }
+    memset(s_thumbs, 0, sizeof(s_thumbs));
+}
+
+// ============================================================================
+// Rows
+// ============================================================================
+
+// Resolve the current crumb's level (counts a level cache hit or miss)
+static bool enter_level(void) {
+    bool cached = false;
+    s_level = browse_model_level(s_model, &cached);
+    return cached;
+}
+
+static int window_first(void) {
+    return browse_model_crumb(s_model)->selected - BROWSE_VISIBLE_ROWS / 2;
+}
+
+static void request_missing_pages(browse_level_t *lvl) {
+    int first = window_first();
+    int page = paged_list_next_fetch(&lvl->list, first, first + BROWSE_VISIBLE_ROWS - 1);
+    if (page >= 0) {
+        bridge_client_request_browse_page(lvl->list.generation, lvl->key,
+                                          paged_list_cursor(&lvl->list, page), page);
+    }
+}
+
+static void bind_rows(void) {
+    browse_level_t *lvl = s_level;
+    if (!lvl || !s_overlay) return;
+
+    lv_label_set_text(s_title, lvl->title[0] ? lvl->title : "Library");
+    int first = window_first();
+    for (int i = 0; i < BROWSE_VISIBLE_ROWS; i++) {
+        browse_row_t *r = &s_rows[i];
+        int index = first + i;
+        bool in_range = index >= 0 && (lvl->list.total < 0 || index < lvl->list.total);
+        if (!in_range) {
+            lv_obj_add_flag(r->row, LV_OBJ_FLAG_HIDDEN);
+            continue;
+        }
+        lv_obj_clear_flag(r->row, LV_OBJ_FLAG_HIDDEN);
+        const paged_list_item_t *item = paged_list_get(&lvl->list, index);
+        lv_label_set_text(r->title, item ? item->line1 : "Loading...");
+        lv_label_set_text(r->subtitle, item ? item->line2 : "");
+        if (i == BROWSE_VISIBLE_ROWS / 2) {
+            end_step_if_ready(item);
+        }
+
+        // Thumbnail: cached, or requested now that the row is visible
+        browse_thumb_t *thumb = (item && item->image_key[0]) ? thumb_find(item->image_key) : NULL;
+        if (thumb) {
+            lv_image_set_src(r->thumb, &thumb->dsc);
+            lv_obj_clear_flag(r->thumb, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(r->thumb, LV_OBJ_FLAG_HIDDEN);
+#ifdef ESP_PLATFORM
+            if (item && item->image_key[0]) {
+                bridge_client_request_browse_thumb(item->image_key);
+            }
+#endif
+        }
+    }
+    request_missing_pages(lvl);
+}
+
+static void activate_selected(void) {
+    browse_level_t *lvl = s_level;
+    if (!lvl) return;
+    int index = browse_model_crumb(s_model)->selected;
+    const paged_list_item_t *item = paged_list_get(&lvl->list, index);
+    if (!item || !item->id[0]) {
+        return;  // Still loading
+    }
+
+    if (item->flags & PAGED_LIST_ITEM_CONTAINER) {
+        char key[PAGED_LIST_ID_LEN];
+        char title[PAGED_LIST_TEXT_LEN];
+        strncpy(key, item->id, sizeof(key) - 1);
+        key[sizeof(key) - 1] = '\0';
+        strncpy(title, item->line1, sizeof(title) - 1);
+        title[sizeof(title) - 1] = '\0';
+        if (browse_model_push(s_model, key, title)) {
+            start_step(enter_level());
+            bind_rows();
+        }
+        return;
+    }
+
+    // Leaf (track/playlist action): play it and return to now playing
+    char key[PAGED_LIST_ID_LEN];
+    strncpy(key, item->id, sizeof(key) - 1);
+    key[sizeof(key) - 1] = '\0';
+    ESP_LOGI(BROWSE_TAG, "Browse play: %s", key);
+    ui_browse_hide();
+    if (!bridge_client_browse_play(key)) {
+        ui_set_message("Play failed");
+    }
+}
+
+static void row_click_cb(lv_event_t *e) {
+    if (!s_model) return;
+    int slot = (int)(intptr_t)lv_event_get_user_data(e);
+    int delta = slot - BROWSE_VISIBLE_ROWS / 2;
+    if (delta != 0) {
+        ui_browse_scroll(delta);  // Tapping a neighbour selects it first
+        return;
+    }
+    activate_selected();
+}
+
+static void create_rows(lv_obj_t *parent) {
+    int top = (SCREEN_SIZE - BROWSE_VISIBLE_ROWS * BROWSE_ROW_HEIGHT) / 2 + 16;
+    for (int i = 0; i < BROWSE_VISIBLE_ROWS; i++) {
+        bool selected = (i == BROWSE_VISIBLE_ROWS / 2);
+        browse_row_t *r = &s_rows[i];
+        r->row = lv_obj_create(parent);
+        lv_obj_set_size(r->row, BROWSE_ROW_WIDTH, BROWSE_ROW_HEIGHT - 4);
+        lv_obj_align(r->row, LV_ALIGN_TOP_MID, 0, top + i * BROWSE_ROW_HEIGHT);
+        lv_obj_set_style_bg_color(r->row, lv_color_hex(selected ? 0x2a2a2a : 0x0a0a0a), 0);
+        lv_obj_set_style_bg_opa(r->row, LV_OPA_COVER, 0);
+        lv_obj_set_style_border_width(r->row, 0, 0);
+        lv_obj_set_style_radius(r->row, 8, 0);
+        lv_obj_set_style_pad_all(r->row, 2, 0);
+        lv_obj_clear_flag(r->row, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_add_event_cb(r->row, row_click_cb, LV_EVENT_CLICKED, (void *)(intptr_t)i);
+
+        r->thumb = lv_image_create(r->row);
+        lv_obj_set_size(r->thumb, BROWSE_THUMB_SIZE, BROWSE_THUMB_SIZE);
+        lv_obj_align(r->thumb, LV_ALIGN_LEFT_MID, 0, 0);
+        lv_obj_add_flag(r->thumb, LV_OBJ_FLAG_HIDDEN);
+
+        int text_x = BROWSE_THUMB_SIZE + 8;
+        r->title = lv_label_create(r->row);
+        lv_obj_set_width(r->title, BROWSE_ROW_WIDTH - text_x - 8);
+        lv_label_set_long_mode(r->title, LV_LABEL_LONG_DOT);
+        lv_obj_set_style_text_font(r->title, font_small(), 0);
+        lv_obj_set_style_text_color(r->title, lv_color_hex(selected ? 0xfafafa : 0xaaaaaa), 0);
+        lv_obj_align(r->title, LV_ALIGN_TOP_LEFT, text_x, 6);
+
+        r->subtitle = lv_label_create(r->row);
+        lv_obj_set_width(r->subtitle, BROWSE_ROW_WIDTH - text_x - 8);
+        lv_label_set_long_mode(r->subtitle, LV_LABEL_LONG_DOT);
+        lv_obj_set_style_text_font(r->subtitle, font_small(), 0);
+        lv_obj_set_style_text_color(r->subtitle, lv_color_hex(0x777777), 0);
+        lv_obj_align(r->subtitle, LV_ALIGN_BOTTOM_LEFT, text_x, -6);
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void ui_browse_show(void) {
+    if (s_overlay) return;
+
+    s_model = calloc(1, sizeof(*s_model));
+    if (!s_model) {
+        ESP_LOGW(BROWSE_TAG, "No memory for browse cache");
+        return;
+    }
+    s_model->next_generation = s_generation_base;
+    browse_model_init(s_model, "Library");
+
+    s_overlay = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(s_overlay, SCREEN_SIZE, SCREEN_SIZE);
+    lv_obj_center(s_overlay);
+    lv_obj_set_style_bg_color(s_overlay, lv_color_hex(0x000000), 0);
+    lv_obj_set_style_bg_opa(s_overlay, LV_OPA_90, 0);
+    lv_obj_set_style_border_width(s_overlay, 0, 0);
+    lv_obj_set_style_radius(s_overlay, 0, 0);
+    lv_obj_set_style_pad_all(s_overlay, 0, 0);
+    lv_obj_clear_flag(s_overlay, LV_OBJ_FLAG_SCROLLABLE);
+
+    s_title = lv_label_create(s_overlay);
+    lv_obj_set_width(s_title, SCREEN_SIZE - 120);
+    lv_label_set_long_mode(s_title, LV_LABEL_LONG_DOT);
+    lv_obj_set_style_text_align(s_title, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_text_font(s_title, font_normal(), 0);
+    lv_obj_set_style_text_color(s_title, lv_color_hex(0xfafafa), 0);
+    lv_obj_align(s_title, LV_ALIGN_TOP_MID, 0, 30);
+
+    create_rows(s_overlay);
+    start_step(enter_level());
+    bind_rows();
+    ESP_LOGI(BROWSE_TAG, "Browse shown");
+}
+
+void ui_browse_hide(void) {
+    if (!s_overlay) return;
+    lv_obj_delete(s_overlay);
+    s_overlay = NULL;
+    s_title = NULL;
+    memset(s_rows, 0, sizeof(s_rows));
+    ESP_LOGI(BROWSE_TAG, "Browse hidden (level cache: %u hits, %u misses)",
+             (unsigned)s_model->hits, (unsigned)s_model->misses);
+    s_generation_base = s_model->next_generation;
+    free(s_model);
+    s_model = NULL;
+    s_level = NULL;
+    thumb_cache_clear();
+}
+
+bool ui_browse_is_visible(void) {
+    return s_overlay != NULL;
+}
+
+void ui_browse_scroll(int delta) {
+    browse_level_t *lvl = s_level;
+    if (!lvl || delta == 0) return;
+    browse_crumb_t *crumb = browse_model_crumb(s_model);
+    int max_index = lvl->list.total > 0 ? lvl->list.total - 1 : 0;
+    int next = crumb->selected + delta;
+    if (next < 0) next = 0;
+    if (next > max_index) next = max_index;
+    if (next == crumb->selected) return;
+    crumb->selected = next;
+    start_step(paged_list_get(&lvl->list, next) != NULL);
+    bind_rows();
+}
+
+bool ui_browse_back(void) {
+    if (!s_overlay) return false;
+    if (!browse_model_pop(s_model)) {
+        ui_browse_hide();
+        return true;
+    }
+    start_step(enter_level());
+    bind_rows();  // Cached level: rows bind from memory with the old selection
+    return true;
+}
+
+void ui_browse_page_loaded(uint32_t generation, int page, int total, const char *title,
+                           const paged_list_item_t *items, int count, const char *next_cursor, bool ok) {
+    if (!s_model) return;
+    browse_level_t *lvl = browse_model_find_generation(s_model, generation);
+    if (!lvl) return;  // Level evicted or from an earlier opening
+    if (!ok) {
+        paged_list_fetch_failed(&lvl->list, generation);
+        ui_set_message("Browse unavailable");
+        return;
+    }
+    paged_list_store(&lvl->list, generation, page, total, items, count, next_cursor);
+    if (page == 0 && title && title[0]) {
+        strncpy(lvl->title, title, sizeof(lvl->title) - 1);
+        lvl->title[sizeof(lvl->title) - 1] = '\0';
+    }
+    if (lvl == s_level) {
+        bind_rows();
+    }
+}
+
+void ui_browse_thumb_loaded(const char *image_key, uint8_t *pixels, size_t len) {
+    if (!s_overlay || !image_key || !pixels || len != BROWSE_THUMB_BYTES || thumb_find(image_key)) {
+        free(pixels);
+        return;
+    }
+    // Evict the least recently bound thumbnail
+    browse_thumb_t *slot = &s_thumbs[0];
+    for (int i = 0; i < BROWSE_THUMB_CACHE; i++) {
+        if (!s_thumbs[i].pixels) {
+            slot = &s_thumbs[i];
+            break;
+        }
+        if (s_thumbs[i].last_used < slot->last_used) slot = &s_thumbs[i];
+    }
+    free(slot->pixels);
+    memset(slot, 0, sizeof(*slot));
+    strncpy(slot->key, image_key, sizeof(slot->key) - 1);
+    slot->pixels = pixels;
+    slot->last_used = ++s_thumb_clock;
+    slot->dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    slot->dsc.header.cf = LV_COLOR_FORMAT_RGB565;
+    slot->dsc.header.w = BROWSE_THUMB_SIZE;
+    slot->dsc.header.h = BROWSE_THUMB_SIZE;
+    slot->dsc.header.stride = BROWSE_THUMB_SIZE * 2;
+    slot->dsc.data = slot->pixels;
+    slot->dsc.data_size = BROWSE_THUMB_BYTES;
+    lv_image_cache_drop(&slot->dsc);
+    bind_rows();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+// Library browse screen (swipe right from now playing): walks the bridge's browse
+// hierarchy with the encoder. Levels are cached (browse_model) so back is instant;
+// pages are cursor-paged with prefetch; 64px thumbnails load only for visible rows.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "paged_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BROWSE_THUMB_SIZE 64
+
+void ui_browse_show(void);
+void ui_browse_hide(void);
+bool ui_browse_is_visible(void);
+void ui_browse_scroll(int delta);   // Encoder ticks
+bool ui_browse_back(void);          // Up one level; closes at the root. False if not visible.
+
+// Deliveries from bridge_client (UI thread)
+void ui_browse_page_loaded(uint32_t generation, int page, int total, const char *title,
+                           const paged_list_item_t *items, int count, const char *next_cursor, bool ok);
+void ui_browse_thumb_loaded(const char *image_key, uint8_t *pixels, size_t len);  // Takes ownership
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,145 @@
+// Grouped-zone volume overlay
+
+#include "ui_group_volume.h"
+
+#include <stdio.h>
+
+#include "lvgl.h"
+
+#ifdef ESP_PLATFORM
+#define SCREEN_SIZE 360
+#else
+#define SCREEN_SIZE 240
+#endif
+
+#if !TARGET_PC
+#include "font_manager.h"
+static inline const lv_font_t *font_small(void) { return font_manager_get_small(); }
+#else
+static inline const lv_font_t *font_small(void) { return &lv_font_montserrat_20; }
+#endif
+
+#define GROUP_OVERLAY_ROWS 4          // More members collapse into a "+N more" line
+#define GROUP_OVERLAY_ROW_HEIGHT 30
+#define GROUP_OVERLAY_WIDTH (SCREEN_SIZE / 2 + 40)
+#define GROUP_OVERLAY_HIDE_MS 2000
+
+typedef struct {
+    lv_obj_t *name;
+    lv_obj_t *value;
+    lv_obj_t *bar;
+} group_row_t;
+
+static lv_obj_t *s_panel = NULL;
+static group_row_t s_rows[GROUP_OVERLAY_ROWS];
+static lv_obj_t *s_more_label = NULL;
+static lv_timer_t *s_hide_timer = NULL;
+
+static void hide_timer_cb(lv_timer_t *timer) {
+    (void)timer;
+    s_hide_timer = NULL;  // One-shot: LVGL deletes it after this callback
+    ui_group_volume_hide();
+}
+
+static void create_panel(void) {
+    s_panel = lv_obj_create(lv_layer_top());
+    lv_obj_set_size(s_panel, GROUP_OVERLAY_WIDTH, LV_SIZE_CONTENT);
+    lv_obj_align(s_panel, LV_ALIGN_BOTTOM_MID, 0, -SCREEN_SIZE / 6);
+    lv_obj_set_style_bg_color(s_panel, lv_color_hex(0x101010), 0);
+    lv_obj_set_style_bg_opa(s_panel, LV_OPA_90, 0);
+    lv_obj_set_style_border_width(s_panel, 0, 0);
+    lv_obj_set_style_radius(s_panel, 12, 0);
+    lv_obj_set_style_pad_all(s_panel, 8, 0);
+    lv_obj_set_flex_flow(s_panel, LV_FLEX_FLOW_COLUMN);
+    lv_obj_clear_flag(s_panel, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+
+    for (int i = 0; i < GROUP_OVERLAY_ROWS; i++) {
+        lv_obj_t *row = lv_obj_create(s_panel);
+        lv_obj_set_size(row, LV_PCT(100), GROUP_OVERLAY_ROW_HEIGHT);
+        lv_obj_set_style_bg_opa(row, LV_OPA_TRANSP, 0);
+        lv_obj_set_style_border_width(row, 0, 0);
+        lv_obj_set_style_pad_all(row, 0, 0);
+        lv_obj_clear_flag(row, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+
+        group_row_t *r = &s_rows[i];
+        r->name = lv_label_create(row);
+        lv_obj_set_width(r->name, GROUP_OVERLAY_WIDTH - 90);
+        lv_label_set_long_mode(r->name, LV_LABEL_LONG_DOT);
+        lv_obj_set_style_text_font(r->name, font_small(), 0);
+        lv_obj_set_style_text_color(r->name, lv_color_hex(0xaaaaaa), 0);
+        lv_obj_align(r->name, LV_ALIGN_TOP_LEFT, 0, 0);
+
+        r->value = lv_label_create(row);
+        lv_obj_set_style_text_font(r->value, font_small(), 0);
+        lv_obj_set_style_text_color(r->value, lv_color_hex(0xfafafa), 0);
+        lv_obj_align(r->value, LV_ALIGN_TOP_RIGHT, 0, 0);
+
+        r->bar = lv_bar_create(row);
+        lv_obj_set_size(r->bar, LV_PCT(100), 3);
+        lv_obj_align(r->bar, LV_ALIGN_BOTTOM_MID, 0, 0);
+        lv_bar_set_range(r->bar, 0, 100);
+        lv_obj_set_style_bg_color(r->bar, lv_color_hex(0x2a2a2a), LV_PART_MAIN);
+        lv_obj_set_style_bg_color(r->bar, lv_color_hex(0x5a9fd4), LV_PART_INDICATOR);
+    }
+
+    s_more_label = lv_label_create(s_panel);
+    lv_obj_set_style_text_font(s_more_label, font_small(), 0);
+    lv_obj_set_style_text_color(s_more_label, lv_color_hex(0x777777), 0);
+}
+
+static void bind(const group_output_t *outputs, int count) {
+    for (int i = 0; i < GROUP_OVERLAY_ROWS; i++) {
+        lv_obj_t *row = lv_obj_get_parent(s_rows[i].name);
+        if (i >= count) {
+            lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+            continue;
+        }
+        const group_output_t *o = &outputs[i];
+        lv_obj_clear_flag(row, LV_OBJ_FLAG_HIDDEN);
+        lv_label_set_text(s_rows[i].name, o->name[0] ? o->name : o->id);
+        char text[16];
+        snprintf(text, sizeof(text), o->volume_step < 1.0f ? "%.1f" : "%.0f", o->volume);
+        lv_label_set_text(s_rows[i].value, text);
+        float range = o->volume_max - o->volume_min;
+        int pct = range > 0.0f ? (int)((o->volume - o->volume_min) * 100.0f / range) : 0;
+        lv_bar_set_value(s_rows[i].bar, pct, LV_ANIM_OFF);
+    }
+    if (count > GROUP_OVERLAY_ROWS) {
+        lv_label_set_text_fmt(s_more_label, "+%d more", count - GROUP_OVERLAY_ROWS);
+        lv_obj_clear_flag(s_more_label, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(s_more_label, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void ui_group_volume_show(const group_output_t *outputs, int count) {
+    if (!outputs || count < 1) return;
+    if (!s_panel) {
+        create_panel();
+    }
+    bind(outputs, count);
+    if (s_hide_timer) {
+        lv_timer_reset(s_hide_timer);
+    } else {
+        s_hide_timer = lv_timer_create(hide_timer_cb, GROUP_OVERLAY_HIDE_MS, NULL);
+        lv_timer_set_repeat_count(s_hide_timer, 1);
+    }
+}
+
+void ui_group_volume_refresh(const group_output_t *outputs, int count) {
+    if (s_panel && outputs && count > 0) {
+        bind(outputs, count);
+    }
+}
+
+void ui_group_volume_hide(void) {
+    if (s_hide_timer) {
+        lv_timer_delete(s_hide_timer);
+        s_hide_timer = NULL;
+    }
+    if (s_panel) {
+        lv_obj_delete(s_panel);
+        s_panel = NULL;
+        s_more_label = NULL;
+    }
+}
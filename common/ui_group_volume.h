@@ -0,0 +1,20 @@
+#pragma once
+
+// Compact per-output volume overlay for grouped zones. Shown while the knob adjusts a
+// group, refreshed by polls while visible, and hidden after a short idle period.
+
+#include <stdbool.h>
+
+#include "group_volume.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void ui_group_volume_show(const group_output_t *outputs, int count);  // Show or refresh
+void ui_group_volume_refresh(const group_output_t *outputs, int count);  // Refresh only if visible
+void ui_group_volume_hide(void);
+
+#ifdef __cplusplus
+}
+#endif
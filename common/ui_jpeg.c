@@ -5,6 +5,9 @@
 #include <stdlib.h>
 #include "esp_log.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "rgb565_blend.h"
+#include "platform/platform_memcpy.h"
 
 static const char *TAG = "UI_RGB565";
 
@@ -16,6 +19,15 @@ static const char *TAG = "UI_RGB565";
 
 static uint8_t *s_artwork_buf = NULL;
 static size_t s_artwork_buf_size = 0;
+static int s_artwork_w = 0;  // Dimensions of the artwork currently in s_artwork_buf
+static int s_artwork_h = 0;
+
+// Crossfade source/target snapshots (PSRAM, allocated on first fade)
+static uint8_t *s_fade_from = NULL;
+static uint8_t *s_fade_to = NULL;
+static int s_fade_step = 0;
+static int s_fade_steps = 0;
+static int64_t s_fade_blend_us = 0;  // Total blend time for the current fade
 
 // Initialize global artwork buffer (call once at startup)
 static void ui_jpeg_buffer_init(void)
@@ -28,7 +40,7 @@ static void ui_jpeg_buffer_init(void)
     s_artwork_buf_size = ARTWORK_MAX_W * ARTWORK_MAX_H * ARTWORK_BPP;
 
     // Try PSRAM first
-    s_artwork_buf = heap_caps_aligned_calloc(16, 1, s_artwork_buf_size,
+    s_artwork_buf = heap_caps_aligned_calloc(PLATFORM_MEMCPY_ALIGN, 1, s_artwork_buf_size,
                                              MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
     if (s_artwork_buf) {
         ESP_LOGI(TAG, "Artwork buffer (%u bytes) allocated in PSRAM", (unsigned)s_artwork_buf_size);
@@ -37,7 +49,7 @@ static void ui_jpeg_buffer_init(void)
 
     // Fallback to internal RAM
     ESP_LOGW(TAG, "PSRAM allocation failed, trying internal RAM");
-    s_artwork_buf = heap_caps_aligned_calloc(16, 1, s_artwork_buf_size,
+    s_artwork_buf = heap_caps_aligned_calloc(PLATFORM_MEMCPY_ALIGN, 1, s_artwork_buf_size,
                                              MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
     if (s_artwork_buf) {
         ESP_LOGI(TAG, "Artwork buffer (%u bytes) allocated in internal RAM", (unsigned)s_artwork_buf_size);
@@ -83,8 +95,13 @@ bool ui_rgb565_from_buffer(const uint8_t *rgb565_data,
         return false;
     }
 
-    // Copy to global buffer (maintains ownership model)
-    memcpy(s_artwork_buf, rgb565_data, data_size);
+    // A direct load supersedes any fade in progress
+    s_fade_steps = 0;
+
+    // Copy to global buffer (maintains ownership model); DMA when the source is aligned
+    platform_memcpy(s_artwork_buf, rgb565_data, data_size);
+    s_artwork_w = width;
+    s_artwork_h = height;
 
     // Fill the LVGL image descriptor (same structure as JPEG decode)
     memset(out_img, 0, sizeof(*out_img));
@@ -100,4 +117,76 @@ bool ui_rgb565_from_buffer(const uint8_t *rgb565_data,
     return true;
 }
 
+static uint8_t *fade_buf_alloc(void)
+{
+    return heap_caps_aligned_calloc(PLATFORM_MEMCPY_ALIGN, 1, s_artwork_buf_size,
+                                    MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+}
+
+bool ui_artwork_crossfade_begin(const uint8_t *rgb565_data, int width, int height, int steps)
+{
+    if (!rgb565_data || !s_artwork_buf || steps < 2) {
+        return false;
+    }
+    if (width != s_artwork_w || height != s_artwork_h) {
+        return false;
+    }
+
+    if (!s_fade_from) s_fade_from = fade_buf_alloc();
+    if (!s_fade_to) s_fade_to = fade_buf_alloc();
+    if (!s_fade_from || !s_fade_to) {
+        ESP_LOGW(TAG, "Crossfade buffers unavailable, skipping fade");
+        return false;
+    }
+
+    // Settle any fade still running so we start from what's on screen
+    ui_artwork_crossfade_finish();
+
+    size_t data_size = (size_t)width * height * 2;
+    platform_memcpy(s_fade_from, s_artwork_buf, data_size);
+    platform_memcpy(s_fade_to, rgb565_data, data_size);
+    s_fade_step = 0;
+    s_fade_steps = steps;
+    s_fade_blend_us = 0;
+    return true;
+}
+
+bool ui_artwork_crossfade_step(void)
+{
+    if (s_fade_steps == 0) {
+        return true;
+    }
+
+    s_fade_step++;
+    if (s_fade_step >= s_fade_steps) {
+        // Final frame: exact copy, including the corners outside the circle
+        platform_memcpy(s_artwork_buf, s_fade_to, (size_t)s_artwork_w * s_artwork_h * 2);
+        ESP_LOGI(TAG, "Crossfade done: %d steps, avg blend %lld us/step",
+                 s_fade_steps, (long long)(s_fade_blend_us / (s_fade_steps - 1)));
+        s_fade_steps = 0;
+        return true;
+    }
+
+    int64_t start = esp_timer_get_time();
+    int alpha = (s_fade_step * RGB565_ALPHA_MAX) / s_fade_steps;
+    rgb565_blend_circle((uint16_t *)s_artwork_buf, (const uint16_t *)s_fade_from,
+                        (const uint16_t *)s_fade_to, s_artwork_w, s_artwork_h, alpha);
+    s_fade_blend_us += esp_timer_get_time() - start;
+    return false;
+}
+
+void ui_artwork_crossfade_finish(void)
+{
+    if (s_fade_steps == 0) {
+        return;
+    }
+    platform_memcpy(s_artwork_buf, s_fade_to, (size_t)s_artwork_w * s_artwork_h * 2);
+    s_fade_steps = 0;
+}
+
+bool ui_artwork_crossfade_active(void)
+{
+    return s_fade_steps != 0;
+}
+
 #endif  // ESP_PLATFORM
@@ -18,4 +18,19 @@ bool ui_rgb565_from_buffer(const uint8_t *rgb565_data,
                            int height,
                            ui_jpeg_image_t *out_img);
 
+// Crossfade from the currently loaded artwork to new RGB565 data.
+// The displayed buffer (the one ui_rgb565_from_buffer filled) is blended in place, so the
+// existing LVGL image descriptor stays valid; the caller just invalidates the image.
+// Returns false if no artwork is loaded or the sizes differ (caller should load directly).
+bool ui_artwork_crossfade_begin(const uint8_t *rgb565_data, int width, int height, int steps);
+
+// Render the next blend step into the displayed buffer. Returns true when the fade is done.
+bool ui_artwork_crossfade_step(void);
+
+// Jump to the final image of an in-progress fade (no-op if none)
+void ui_artwork_crossfade_finish(void);
+
+// True while a fade is in progress
+bool ui_artwork_crossfade_active(void);
+
 #endif  // ESP_PLATFORM
@@ -0,0 +1,138 @@
+// Rim level meter
+
+#include "ui_level_meter.h"
+
+#include <stdio.h>
+
+#include "lvgl.h"
+#include "platform/platform_time.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+#define SCREEN_SIZE 360
+#else
+#define SCREEN_SIZE 240
+#define ESP_LOGI(tag, fmt, ...) printf("[I] " tag ": " fmt "\n", ##__VA_ARGS__)
+#endif
+#define METER_TAG "level_meter"
+
+#define METER_DIAMETER (SCREEN_SIZE - 56)   // Just inside the progress arc
+#define METER_WIDTH 8
+#define METER_STEPS 8                        // Quantization: redraw only on a visible change
+#define METER_GAP_DEG 4
+#define METER_PERIOD_MS 33                   // ~30 Hz, matches the stream
+#define METER_HIDE_AFTER_MS 1000             // Idle (all segments at zero) this long: hide
+
+static lv_obj_t *s_container = NULL;
+static lv_obj_t *s_segments[LEVEL_METER_MAX_BANDS];
+static int8_t s_shown[LEVEL_METER_MAX_BANDS];  // Quantized value on screen (-1 = unset)
+static int s_bands = 0;
+static ui_level_source_t s_source = NULL;
+static lv_timer_t *s_timer = NULL;
+static uint64_t s_silent_since_ms = 0;
+static uint32_t s_frames = 0;
+static uint32_t s_segment_updates = 0;
+
+static void layout_segments(int bands) {
+    int span = 360 / bands;
+    for (int i = 0; i < LEVEL_METER_MAX_BANDS; i++) {
+        lv_obj_t *seg = s_segments[i];
+        if (i >= bands) {
+            lv_obj_add_flag(seg, LV_OBJ_FLAG_HIDDEN);
+            continue;
+        }
+        lv_obj_clear_flag(seg, LV_OBJ_FLAG_HIDDEN);
+        // Segment i covers [i*span, (i+1)*span - gap] clockwise from 12 o'clock
+        lv_arc_set_rotation(seg, 270 + i * span);
+        lv_arc_set_bg_angles(seg, 0, span - METER_GAP_DEG);
+        lv_arc_set_value(seg, 0);
+        s_shown[i] = 0;
+    }
+    s_bands = bands;
+}
+
+static void meter_timer_cb(lv_timer_t *timer) {
+    (void)timer;
+    if (!s_source) return;
+    uint64_t now = platform_millis();
+    level_frame_t frame;
+    if (!s_source(now, &frame)) {
+        if (s_silent_since_ms && now - s_silent_since_ms >= METER_HIDE_AFTER_MS &&
+            !lv_obj_has_flag(s_container, LV_OBJ_FLAG_HIDDEN)) {
+            lv_obj_add_flag(s_container, LV_OBJ_FLAG_HIDDEN);
+            ESP_LOGI(METER_TAG, "Stream idle: %lu frames, %lu segment updates (%.1f/frame)",
+                     (unsigned long)s_frames, (unsigned long)s_segment_updates,
+                     s_frames ? (double)s_segment_updates / s_frames : 0.0);
+        }
+        return;
+    }
+
+    if (frame.bands != s_bands) {
+        layout_segments(frame.bands);
+    }
+    lv_obj_clear_flag(s_container, LV_OBJ_FLAG_HIDDEN);
+    s_frames++;
+
+    bool silent = true;
+    for (int i = 0; i < frame.bands; i++) {
+        int q = (frame.levels[i] * METER_STEPS + 127) / 255;
+        if (q) silent = false;
+        if (q != s_shown[i]) {
+            lv_arc_set_value(s_segments[i], q);  // Invalidates only the changed angle span
+            s_shown[i] = (int8_t)q;
+            s_segment_updates++;
+        }
+    }
+    if (!silent) {
+        s_silent_since_ms = 0;
+    } else if (!s_silent_since_ms) {
+        s_silent_since_ms = now;
+    }
+}
+
+void ui_level_meter_init(ui_level_source_t source) {
+    if (s_container) return;
+    s_source = source;
+
+    s_container = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(s_container, METER_DIAMETER, METER_DIAMETER);
+    lv_obj_center(s_container);
+    lv_obj_set_style_bg_opa(s_container, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(s_container, 0, 0);
+    lv_obj_set_style_pad_all(s_container, 0, 0);
+    lv_obj_clear_flag(s_container, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_flag(s_container, LV_OBJ_FLAG_HIDDEN);
+
+    for (int i = 0; i < LEVEL_METER_MAX_BANDS; i++) {
+        lv_obj_t *seg = lv_arc_create(s_container);
+        lv_obj_set_size(seg, METER_DIAMETER, METER_DIAMETER);
+        lv_obj_center(seg);
+        lv_arc_set_range(seg, 0, METER_STEPS);
+        lv_arc_set_mode(seg, LV_ARC_MODE_NORMAL);
+        lv_obj_remove_flag(seg, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_set_style_arc_width(seg, METER_WIDTH, LV_PART_MAIN);
+        lv_obj_set_style_arc_width(seg, METER_WIDTH, LV_PART_INDICATOR);
+        lv_obj_set_style_arc_rounded(seg, false, LV_PART_MAIN);
+        lv_obj_set_style_arc_rounded(seg, false, LV_PART_INDICATOR);
+        lv_obj_set_style_arc_color(seg, lv_color_hex(0x1a1a1a), LV_PART_MAIN);
+        lv_obj_set_style_arc_color(seg, lv_color_hex(0x5a9fd4), LV_PART_INDICATOR);
+        lv_obj_set_style_bg_opa(seg, LV_OPA_TRANSP, LV_PART_KNOB);
+        lv_obj_set_style_pad_all(seg, 0, LV_PART_KNOB);
+        s_segments[i] = seg;
+    }
+    layout_segments(LEVEL_METER_MAX_BANDS);
+
+    s_timer = lv_timer_create(meter_timer_cb, METER_PERIOD_MS, NULL);
+    lv_timer_pause(s_timer);
+}
+
+void ui_level_meter_set_enabled(bool enabled) {
+    if (!s_timer) return;
+    if (enabled) {
+        lv_timer_resume(s_timer);
+    } else {
+        lv_timer_pause(s_timer);
+        lv_obj_add_flag(s_container, LV_OBJ_FLAG_HIDDEN);
+        s_silent_since_ms = 0;
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+// Rim level meter: one short arc segment per band inside the progress arc. Segments are
+// quantized, and only segments whose level changed are touched, so LVGL invalidates just
+// those slivers of the ring instead of the whole screen.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "level_meter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Frame source (e.g. level_meter_udp_pop): true if `out` holds a new frame to draw
+typedef bool (*ui_level_source_t)(uint64_t now_ms, level_frame_t *out);
+
+void ui_level_meter_init(ui_level_source_t source);
+void ui_level_meter_set_enabled(bool enabled);  // Off: segments hidden, timer paused
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,201 @@
+// Cached-bitmap marquee for long track/artist titles
+//
+// LVGL's LV_LABEL_LONG_SCROLL_CIRCULAR re-runs glyph lookup and rasterization for the whole
+// visible run on every animation frame. Here the text is rasterized once into an A8 strip
+// (text + gap) and an lv_image with LV_IMAGE_ALIGN_TILE shows a moving window of it; each
+// frame is just an offset change and an A8 blit of the viewport.
+
+#include "ui_marquee.h"
+
+#include "marquee_layout.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+static const char *TAG = "marquee";
+#define MARQUEE_LOGW(fmt, ...) ESP_LOGW(TAG, fmt, ##__VA_ARGS__)
+#else
+#include <stdio.h>
+#define MARQUEE_LOGW(fmt, ...) printf("[W] marquee: " fmt "\n", ##__VA_ARGS__)
+#endif
+
+typedef struct {
+    lv_obj_t *image;      // Visible tiled window onto the strip
+    lv_obj_t *canvas;     // Hidden; only used to rasterize into the strip
+    lv_timer_t *timer;
+    lv_draw_buf_t strip;
+    uint8_t *strip_data;
+    size_t strip_size;
+    const lv_font_t *font;
+    lv_color_t color;
+    int32_t width;
+    int32_t strip_w;      // 0 when the text fits (no scrolling)
+    int32_t offset_q8;    // Scroll offset in 1/256 px
+    uint32_t carry;       // Sub-unit remainder of the offset between ticks
+    uint32_t last_tick;
+    bool paused;
+    char text[MARQUEE_TEXT_MAX];
+} marquee_t;
+
+static void *strip_alloc(size_t size) {
+#ifdef ESP_PLATFORM
+    // Strips can be tens of KB; keep them out of internal RAM and LVGL's pool
+    return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#else
+    return malloc(size);
+#endif
+}
+
+static void strip_free(void *p) {
+#ifdef ESP_PLATFORM
+    heap_caps_free(p);
+#else
+    free(p);
+#endif
+}
+
+static void marquee_timer_cb(lv_timer_t *timer) {
+    marquee_t *m = (marquee_t *)lv_timer_get_user_data(timer);
+    uint32_t elapsed = lv_tick_elaps(m->last_tick);
+    m->last_tick = lv_tick_get();
+    if (m->strip_w == 0) {
+        return;
+    }
+
+    m->offset_q8 = marquee_advance_q8(m->offset_q8, elapsed, m->strip_w, &m->carry);
+    lv_image_set_offset_x(m->image, -(m->offset_q8 >> 8));
+}
+
+static void update_timer_state(marquee_t *m) {
+    if (!m->timer) return;
+    if (m->paused || m->strip_w == 0) {
+        lv_timer_pause(m->timer);
+    } else {
+        m->last_tick = lv_tick_get();
+        lv_timer_resume(m->timer);
+    }
+}
+
+static void marquee_delete_cb(lv_event_t *e) {
+    marquee_t *m = (marquee_t *)lv_event_get_user_data(e);
+    if (m->timer) lv_timer_delete(m->timer);
+    if (m->strip_data) strip_free(m->strip_data);
+    free(m);
+}
+
+// Rasterize `m->text` into the A8 strip. Returns the strip width, or 0 on failure.
+static int32_t render_strip(marquee_t *m, int32_t text_w, int32_t h, int32_t strip_w) {
+    uint32_t stride = lv_draw_buf_width_to_stride(strip_w, LV_COLOR_FORMAT_A8);
+    size_t size = (size_t)stride * h;
+    if (size > m->strip_size) {
+        if (m->strip_data) strip_free(m->strip_data);
+        m->strip_data = strip_alloc(size);
+        m->strip_size = m->strip_data ? size : 0;
+        if (!m->strip_data) {
+            MARQUEE_LOGW("strip alloc failed (%u bytes)", (unsigned)size);
+            return 0;
+        }
+    }
+    memset(m->strip_data, 0, size);
+    lv_draw_buf_init(&m->strip, strip_w, h, LV_COLOR_FORMAT_A8, stride, m->strip_data, size);
+
+    lv_canvas_set_draw_buf(m->canvas, &m->strip);
+    lv_layer_t layer;
+    lv_canvas_init_layer(m->canvas, &layer);
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = m->font;
+    dsc.color = lv_color_white();  // A8 coverage; actual color comes from image recolor
+    dsc.text = m->text;
+    lv_area_t area = {0, 0, text_w - 1, h - 1};
+    lv_draw_label(&layer, &dsc, &area);
+    lv_canvas_finish_layer(m->canvas, &layer);
+
+    lv_image_cache_drop(&m->strip);
+    return strip_w;
+}
+
+lv_obj_t *ui_marquee_create(lv_obj_t *parent, int32_t width, const lv_font_t *font, lv_color_t color) {
+    marquee_t *m = calloc(1, sizeof(*m));
+    if (!m) return NULL;
+    m->font = font;
+    m->color = color;
+    m->width = width;
+
+    int32_t h = lv_font_get_line_height(font);
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_set_size(obj, width, h);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(obj, 0, 0);
+    lv_obj_set_style_pad_all(obj, 0, 0);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_user_data(obj, m);
+    lv_obj_add_event_cb(obj, marquee_delete_cb, LV_EVENT_DELETE, m);
+
+    m->canvas = lv_canvas_create(obj);
+    lv_obj_add_flag(m->canvas, LV_OBJ_FLAG_HIDDEN);
+
+    m->image = lv_image_create(obj);
+    lv_obj_set_style_image_recolor(m->image, color, 0);
+    lv_obj_set_style_image_recolor_opa(m->image, LV_OPA_COVER, 0);
+    lv_obj_add_flag(m->image, LV_OBJ_FLAG_HIDDEN);
+
+    m->timer = lv_timer_create(marquee_timer_cb, MARQUEE_DEFAULT_PERIOD_MS, m);
+    update_timer_state(m);
+    return obj;
+}
+
+void ui_marquee_set_text(lv_obj_t *obj, const char *text) {
+    marquee_t *m = obj ? (marquee_t *)lv_obj_get_user_data(obj) : NULL;
+    if (!m || !text) return;
+    if (!marquee_store_text(m->text, text)) {
+        return;  // Same title: keep the cached strip and scroll position
+    }
+
+    m->strip_w = 0;
+    m->offset_q8 = 0;
+    m->carry = 0;
+    lv_obj_add_flag(m->image, LV_OBJ_FLAG_HIDDEN);
+
+    if (m->text[0]) {
+        lv_point_t size;
+        lv_text_get_size(&size, m->text, m->font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+        int32_t h = lv_font_get_line_height(m->font);
+        bool overflow;
+        int32_t strip_w = marquee_strip_width(size.x, m->width, &overflow);
+
+        if (size.x > 0 && render_strip(m, size.x, h, strip_w) > 0) {
+            lv_image_set_src(m->image, &m->strip);
+            lv_image_set_offset_x(m->image, 0);
+            if (overflow) {
+                // Viewport-wide tiled window; the timer slides the offset
+                lv_image_set_inner_align(m->image, LV_IMAGE_ALIGN_TILE);
+                lv_obj_set_size(m->image, m->width, h);
+                lv_obj_align(m->image, LV_ALIGN_LEFT_MID, 0, 0);
+                m->strip_w = strip_w;
+            } else {
+                lv_image_set_inner_align(m->image, LV_IMAGE_ALIGN_DEFAULT);
+                lv_obj_set_size(m->image, strip_w, h);
+                lv_obj_align(m->image, LV_ALIGN_CENTER, 0, 0);
+            }
+            lv_obj_clear_flag(m->image, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    update_timer_state(m);
+}
+
+void ui_marquee_set_period(lv_obj_t *obj, uint32_t period_ms) {
+    marquee_t *m = obj ? (marquee_t *)lv_obj_get_user_data(obj) : NULL;
+    if (!m || !m->timer || period_ms == 0) return;
+    lv_timer_set_period(m->timer, period_ms);
+}
+
+void ui_marquee_set_paused(lv_obj_t *obj, bool paused) {
+    marquee_t *m = obj ? (marquee_t *)lv_obj_get_user_data(obj) : NULL;
+    if (!m || m->paused == paused) return;
+    m->paused = paused;
+    update_timer_state(m);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Cached-bitmap marquee: a single-line text viewport that renders its text once into an
+// A8 strip when the text changes, then scrolls by moving a tiled image over that strip.
+// Text that fits is centered and never animates. Scrolling invalidates only the viewport.
+
+// Create a marquee `width` px wide (height follows the font's line height)
+lv_obj_t *ui_marquee_create(lv_obj_t *parent, int32_t width, const lv_font_t *font, lv_color_t color);
+
+// Set text (re-renders the strip only when the text actually changes)
+void ui_marquee_set_text(lv_obj_t *marquee, const char *text);
+
+// Frame period for scrolling in ms (speed in px/s is unaffected; lower rate = bigger steps)
+void ui_marquee_set_period(lv_obj_t *marquee, uint32_t period_ms);
+
+// Stop/restart the scroll timer (e.g. while hidden)
+void ui_marquee_set_paused(lv_obj_t *marquee, bool paused);
+
+#ifdef __cplusplus
+}
+#endif
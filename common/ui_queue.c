@@ -0,0 +1,226 @@
+// Up-next queue screen (swipe left from now playing)
+
+#include "ui_queue.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lvgl.h"
+#include "bridge_client.h"
+#include "ui.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+#define SCREEN_SIZE 360
+#else
+#define SCREEN_SIZE 240
+#define ESP_LOGI(tag, fmt, ...) printf("[I] " tag ": " fmt "\n", ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) printf("[W] " tag ": " fmt "\n", ##__VA_ARGS__)
+#endif
+#define QUEUE_TAG "ui_queue"
+
+#if !TARGET_PC
+#include "font_manager.h"
+static inline const lv_font_t *font_small(void) { return font_manager_get_small(); }
+static inline const lv_font_t *font_normal(void) { return font_manager_get_normal(); }
+#else
+static inline const lv_font_t *font_small(void) { return &lv_font_montserrat_20; }
+static inline const lv_font_t *font_normal(void) { return &lv_font_montserrat_28; }
+#endif
+
+// Only this many row objects ever exist; the selection stays in the middle row
+#define QUEUE_VISIBLE_ROWS 5
+#define QUEUE_ROW_HEIGHT 48
+#define QUEUE_ROW_WIDTH (SCREEN_SIZE - 80)
+
+typedef struct {
+    lv_obj_t *row;
+    lv_obj_t *title;
+    lv_obj_t *subtitle;
+} queue_row_t;
+
+static lv_obj_t *s_overlay = NULL;
+static lv_obj_t *s_empty_label = NULL;
+static queue_row_t s_rows[QUEUE_VISIBLE_ROWS];
+static paged_list_t *s_list = NULL;       // Allocated while visible only
+static uint32_t s_generation = 0;         // Survives hide/show so late pages are dropped
+static int s_selected = 0;
+
+static int window_first(void) {
+    return s_selected - QUEUE_VISIBLE_ROWS / 2;
+}
+
+static void request_missing_pages(void) {
+    if (!s_list) return;
+    int first = window_first();
+    int page = paged_list_next_fetch(s_list, first, first + QUEUE_VISIBLE_ROWS - 1);
+    if (page >= 0) {
+        bridge_client_request_queue_page(s_list->generation, page);
+    }
+}
+
+// Rebind the fixed row objects to the items around the selection
+static void bind_rows(void) {
+    if (!s_list) return;
+    int first = window_first();
+    for (int i = 0; i < QUEUE_VISIBLE_ROWS; i++) {
+        int index = first + i;
+        queue_row_t *r = &s_rows[i];
+        bool in_range = index >= 0 && (s_list->total < 0 || index < s_list->total);
+        if (!in_range) {
+            lv_obj_add_flag(r->row, LV_OBJ_FLAG_HIDDEN);
+            continue;
+        }
+        lv_obj_clear_flag(r->row, LV_OBJ_FLAG_HIDDEN);
+        const paged_list_item_t *item = paged_list_get(s_list, index);
+        lv_label_set_text(r->title, item ? item->line1 : "Loading...");
+        lv_label_set_text(r->subtitle, item ? item->line2 : "");
+    }
+    if (s_empty_label) {
+        bool empty = s_list->total == 0;
+        if (empty) lv_obj_clear_flag(s_empty_label, LV_OBJ_FLAG_HIDDEN);
+        else lv_obj_add_flag(s_empty_label, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+static void row_click_cb(lv_event_t *e) {
+    if (!s_list) return;
+    int slot = (int)(intptr_t)lv_event_get_user_data(e);
+    int index = window_first() + slot;
+    const paged_list_item_t *item = paged_list_get(s_list, index);
+    if (!item || !item->id[0]) {
+        return;  // Still loading
+    }
+    char id[PAGED_LIST_ID_LEN];
+    strncpy(id, item->id, sizeof(id) - 1);
+    id[sizeof(id) - 1] = '\0';
+    ESP_LOGI(QUEUE_TAG, "Play from queue index %d (id=%s)", index, id);
+    ui_queue_hide();
+    if (!bridge_client_queue_play_from(id)) {
+        ui_set_message("Play from here failed");
+    }
+}
+
+static void create_rows(lv_obj_t *parent) {
+    int top = (SCREEN_SIZE - QUEUE_VISIBLE_ROWS * QUEUE_ROW_HEIGHT) / 2 + 10;
+    for (int i = 0; i < QUEUE_VISIBLE_ROWS; i++) {
+        bool selected = (i == QUEUE_VISIBLE_ROWS / 2);
+        queue_row_t *r = &s_rows[i];
+        r->row = lv_obj_create(parent);
+        lv_obj_set_size(r->row, QUEUE_ROW_WIDTH, QUEUE_ROW_HEIGHT - 4);
+        lv_obj_align(r->row, LV_ALIGN_TOP_MID, 0, top + i * QUEUE_ROW_HEIGHT);
+        lv_obj_set_style_bg_color(r->row, lv_color_hex(selected ? 0x2a2a2a : 0x0a0a0a), 0);
+        lv_obj_set_style_bg_opa(r->row, LV_OPA_COVER, 0);
+        lv_obj_set_style_border_width(r->row, 0, 0);
+        lv_obj_set_style_radius(r->row, 8, 0);
+        lv_obj_set_style_pad_hor(r->row, 10, 0);
+        lv_obj_set_style_pad_ver(r->row, 2, 0);
+        lv_obj_clear_flag(r->row, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_add_event_cb(r->row, row_click_cb, LV_EVENT_CLICKED, (void *)(intptr_t)i);
+
+        r->title = lv_label_create(r->row);
+        lv_obj_set_width(r->title, LV_PCT(100));
+        lv_label_set_long_mode(r->title, LV_LABEL_LONG_DOT);
+        lv_obj_set_style_text_font(r->title, font_small(), 0);
+        lv_obj_set_style_text_color(r->title, lv_color_hex(selected ? 0xfafafa : 0xaaaaaa), 0);
+        lv_obj_align(r->title, LV_ALIGN_TOP_LEFT, 0, 0);
+
+        r->subtitle = lv_label_create(r->row);
+        lv_obj_set_width(r->subtitle, LV_PCT(100));
+        lv_label_set_long_mode(r->subtitle, LV_LABEL_LONG_DOT);
+        lv_obj_set_style_text_font(r->subtitle, font_small(), 0);
+        lv_obj_set_style_text_color(r->subtitle, lv_color_hex(0x777777), 0);
+        lv_obj_align(r->subtitle, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+        // Only the selected row has room to be legible with two lines
+        if (!selected) lv_obj_add_flag(r->subtitle, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void ui_queue_show(void) {
+    if (s_overlay) return;
+
+    s_list = malloc(sizeof(*s_list));
+    if (!s_list) {
+        ESP_LOGW(QUEUE_TAG, "No memory for queue cache");
+        return;
+    }
+    s_list->generation = s_generation;
+    paged_list_reset(s_list);
+    s_generation = s_list->generation;
+    s_selected = 0;
+
+    s_overlay = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(s_overlay, SCREEN_SIZE, SCREEN_SIZE);
+    lv_obj_center(s_overlay);
+    lv_obj_set_style_bg_color(s_overlay, lv_color_hex(0x000000), 0);
+    lv_obj_set_style_bg_opa(s_overlay, LV_OPA_90, 0);
+    lv_obj_set_style_border_width(s_overlay, 0, 0);
+    lv_obj_set_style_radius(s_overlay, 0, 0);
+    lv_obj_set_style_pad_all(s_overlay, 0, 0);
+    lv_obj_clear_flag(s_overlay, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t *title = lv_label_create(s_overlay);
+    lv_label_set_text(title, "UP NEXT");
+    lv_obj_set_style_text_font(title, font_normal(), 0);
+    lv_obj_set_style_text_color(title, lv_color_hex(0xfafafa), 0);
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 30);
+
+    create_rows(s_overlay);
+
+    s_empty_label = lv_label_create(s_overlay);
+    lv_label_set_text(s_empty_label, "Queue is empty");
+    lv_obj_set_style_text_font(s_empty_label, font_small(), 0);
+    lv_obj_set_style_text_color(s_empty_label, lv_color_hex(0xaaaaaa), 0);
+    lv_obj_center(s_empty_label);
+    lv_obj_add_flag(s_empty_label, LV_OBJ_FLAG_HIDDEN);
+
+    bind_rows();
+    request_missing_pages();
+    ESP_LOGI(QUEUE_TAG, "Queue view shown");
+}
+
+void ui_queue_hide(void) {
+    if (!s_overlay) return;
+    lv_obj_delete(s_overlay);
+    s_overlay = NULL;
+    s_empty_label = NULL;
+    memset(s_rows, 0, sizeof(s_rows));
+    free(s_list);
+    s_list = NULL;
+    ESP_LOGI(QUEUE_TAG, "Queue view hidden");
+}
+
+bool ui_queue_is_visible(void) {
+    return s_overlay != NULL;
+}
+
+void ui_queue_scroll(int delta) {
+    if (!s_list || delta == 0) return;
+    int max_index = s_list->total > 0 ? s_list->total - 1 : 0;
+    int next = s_selected + delta;
+    if (next < 0) next = 0;
+    if (next > max_index) next = max_index;
+    if (next == s_selected) return;
+    s_selected = next;
+    bind_rows();
+    request_missing_pages();
+}
+
+void ui_queue_page_loaded(uint32_t generation, int page, int total,
+                          const paged_list_item_t *items, int count, bool ok) {
+    if (!s_list) return;
+    if (!ok) {
+        paged_list_fetch_failed(s_list, generation);
+        ui_set_message("Queue unavailable");
+        return;  // Retried on the next scroll
+    }
+    if (!paged_list_store(s_list, generation, page, total, items, count, NULL)) {
+        return;  // Stale response from a previous opening
+    }
+    if (s_selected > total - 1) {
+        s_selected = total > 0 ? total - 1 : 0;
+    }
+    bind_rows();
+    request_missing_pages();  // Chain the prefetch
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// Up-next queue screen: full-screen overlay listing the zone's play queue.
+// Rows are virtualized (a fixed handful of LVGL objects rebound as the encoder scrolls)
+// and backed by a paged_list page cache, so cost doesn't depend on queue length.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "paged_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void ui_queue_show(void);
+void ui_queue_hide(void);
+bool ui_queue_is_visible(void);
+void ui_queue_scroll(int delta);  // Encoder ticks (sign = direction)
+
+// Page delivery from bridge_client (UI thread). ok=false marks the fetch as failed.
+void ui_queue_page_loaded(uint32_t generation, int page, int total,
+                          const paged_list_item_t *items, int count, bool ok);
+
+#ifdef __cplusplus
+}
+#endif
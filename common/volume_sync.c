@@ -0,0 +1,74 @@
+#include "volume_sync.h"
+
+#include <string.h>
+
+void volume_sync_init(volume_sync_t *vs, uint32_t timeout_ms) {
+    memset(vs, 0, sizeof(*vs));
+    vs->timeout_ms = timeout_ms;
+}
+
+void volume_sync_reset_pending(volume_sync_t *vs) {
+    vs->pending = false;
+}
+
+uint32_t volume_sync_next_seq(volume_sync_t *vs) {
+    if (++vs->last_seq == 0) {
+        vs->last_seq = 1;  // 0 is never sent, so a missing echo can't look current
+    }
+    return vs->last_seq;
+}
+
+uint32_t volume_sync_local_change(volume_sync_t *vs, float value, uint64_t now_ms) {
+    uint32_t seq = volume_sync_next_seq(vs);
+    volume_sync_expect(vs, seq, value, now_ms);
+    return seq;
+}
+
+void volume_sync_expect(volume_sync_t *vs, uint32_t seq, float value, uint64_t now_ms) {
+    vs->pending = true;
+    vs->pending_seq = seq;
+    vs->pending_unseeded = !vs->seeded;
+    vs->pending_value = value;
+    vs->pending_since_ms = now_ms;
+}
+
+void volume_sync_command_failed(volume_sync_t *vs, uint32_t seq) {
+    if (vs->pending && vs->pending_seq == seq) {
+        vs->pending = false;
+    }
+}
+
+static void observe_seq(volume_sync_t *vs, uint32_t polled_seq) {
+    // The echo can be ahead of the counter after a reboot (or a zone this knob last
+    // drove in an earlier boot): continue above it so new commands compare as newer
+    if (!vs->seeded || (int32_t)(polled_seq - vs->last_seq) > 0) {
+        vs->last_seq = polled_seq;
+    }
+    vs->seeded = true;
+}
+
+float volume_sync_reconcile(volume_sync_t *vs, float polled, bool has_seq, uint32_t polled_seq,
+                            float tolerance, uint64_t now_ms) {
+    if (has_seq) {
+        observe_seq(vs, polled_seq);
+    }
+    if (!vs->pending) {
+        return polled;
+    }
+
+    bool caught_up;
+    if (has_seq && !vs->pending_unseeded) {
+        // Wraparound-safe "polled_seq >= pending_seq"
+        caught_up = (int32_t)(polled_seq - vs->pending_seq) >= 0;
+    } else {
+        float diff = polled > vs->pending_value ? polled - vs->pending_value : vs->pending_value - polled;
+        caught_up = diff <= tolerance;
+    }
+
+    if (caught_up || now_ms - vs->pending_since_ms >= vs->timeout_ms) {
+        vs->pending = false;  // Bridge state is authoritative again (even if it clamped us)
+        return polled;
+    }
+    vs->stale_dropped++;
+    return vs->pending_value;
+}
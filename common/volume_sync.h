@@ -0,0 +1,55 @@
+#pragma once
+
+// Reconciles optimistic volume changes with polled now_playing state.
+// Every vol_abs command carries a sequence number; the bridge echoes the last one it
+// applied as "volume_seq". Until the echo catches up, polled volumes are stale and the
+// optimistic value is kept, so the arc never snaps back mid-turn. The bridge remembers
+// the last echo across knob reboots (deep-sleep wake included), so the first echo seen
+// after init seeds the counter and new commands continue above it. Portable, no locking.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t last_seq;          // Last sequence number handed out
+    bool seeded;                // last_seq has caught up with the bridge's echo
+    bool pending;               // A local change hasn't been confirmed yet
+    uint32_t pending_seq;
+    bool pending_unseeded;      // Sent before seeding: its seq can't be compared
+    float pending_value;
+    uint64_t pending_since_ms;  // Time of the latest local change
+    uint32_t timeout_ms;        // Give up waiting and trust the bridge after this
+    uint32_t stale_dropped;     // Statistics: polled volumes ignored
+} volume_sync_t;
+
+void volume_sync_init(volume_sync_t *vs, uint32_t timeout_ms);
+
+// Zone changed: drop the pending prediction but keep the sequence counter
+void volume_sync_reset_pending(volume_sync_t *vs);
+
+// Record an optimistic change; returns the sequence number to send with it
+uint32_t volume_sync_local_change(volume_sync_t *vs, float value, uint64_t now_ms);
+
+// Next sequence number without recording a change (for commands tracked elsewhere,
+// e.g. group_volume, so every volume command shares one increasing sequence)
+uint32_t volume_sync_next_seq(volume_sync_t *vs);
+
+// Record an optimistic change sent with an externally allocated sequence number
+void volume_sync_expect(volume_sync_t *vs, uint32_t seq, float value, uint64_t now_ms);
+
+// The command was not delivered: stop holding the optimistic value
+void volume_sync_command_failed(volume_sync_t *vs, uint32_t seq);
+
+// Volume to display for a polled value. has_seq=false means the bridge doesn't echo
+// sequence numbers; the poll is then trusted once it matches the optimistic value
+// (within tolerance) or the timeout expires.
+float volume_sync_reconcile(volume_sync_t *vs, float polled, bool has_seq, uint32_t polled_seq,
+                            float tolerance, uint64_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,211 @@
+#include "wifi_profiles.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void wifi_profiles_init(wifi_profiles_t *wp) {
+    memset(wp, 0, sizeof(*wp));
+    wp->ver = WIFI_PROFILES_VER;
+}
+
+int wifi_profiles_find(const wifi_profiles_t *wp, const char *ssid) {
+    if (!ssid || !ssid[0]) {
+        return -1;
+    }
+    for (int i = 0; i < wp->count; i++) {
+        if (strcmp(wp->profiles[i].ssid, ssid) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int wifi_profiles_upsert(wifi_profiles_t *wp, const char *ssid, const char *pass) {
+    if (!ssid || !ssid[0]) {
+        return -1;
+    }
+    int i = wifi_profiles_find(wp, ssid);
+    if (i >= 0) {
+        wifi_profile_t *p = &wp->profiles[i];
+        if (strcmp(p->pass, pass ? pass : "") != 0) {
+            snprintf(p->pass, sizeof(p->pass), "%s", pass ? pass : "");
+            p->fail_streak = 0;  // New password deserves a fresh chance
+        }
+        return i;
+    }
+    if (wp->count < WIFI_PROFILES_MAX) {
+        i = wp->count++;
+    } else {
+        i = 0;
+        for (int j = 1; j < wp->count; j++) {
+            if (wp->profiles[j].last_ok_seq < wp->profiles[i].last_ok_seq) {
+                i = j;
+            }
+        }
+    }
+    wifi_profile_t *p = &wp->profiles[i];
+    memset(p, 0, sizeof(*p));
+    snprintf(p->ssid, sizeof(p->ssid), "%s", ssid);
+    snprintf(p->pass, sizeof(p->pass), "%s", pass ? pass : "");
+    return i;
+}
+
+bool wifi_profiles_remove(wifi_profiles_t *wp, const char *ssid) {
+    int i = wifi_profiles_find(wp, ssid);
+    if (i < 0) {
+        return false;
+    }
+    memmove(&wp->profiles[i], &wp->profiles[i + 1], sizeof(wp->profiles[0]) * (wp->count - i - 1));
+    wp->count--;
+    memset(&wp->profiles[wp->count], 0, sizeof(wp->profiles[0]));
+    return true;
+}
+
+static int score_of(const wifi_profiles_t *wp, int idx, const wifi_scan_ap_t *ap) {
+    const wifi_profile_t *p = &wp->profiles[idx];
+    int score = ap->rssi;
+    if (p->last_ok_seq != 0 && p->last_ok_seq == wp->seq) {
+        score += WIFI_PROFILES_RECENT_BONUS_DB;
+    }
+    if (p->channel != 0 && memcmp(p->bssid, ap->bssid, sizeof(p->bssid)) == 0) {
+        score += WIFI_PROFILES_KNOWN_AP_BONUS_DB;
+    }
+    score -= WIFI_PROFILES_FAIL_PENALTY_DB * (p->fail_streak < 3 ? p->fail_streak : 3);
+    return score;
+}
+
+// Insert c into out[0..*n) keeping it sorted by score (stable); drops the worst when full
+static void insert_sorted(wifi_candidate_t *out, int *n, int max_out, const wifi_candidate_t *c) {
+    int pos = *n;
+    while (pos > 0 && out[pos - 1].score < c->score) {
+        pos--;
+    }
+    if (pos >= max_out) {
+        return;
+    }
+    int last = *n < max_out ? *n : max_out - 1;
+    memmove(&out[pos + 1], &out[pos], sizeof(out[0]) * (last - pos));
+    out[pos] = *c;
+    if (*n < max_out) {
+        (*n)++;
+    }
+}
+
+int wifi_profiles_rank(const wifi_profiles_t *wp, const wifi_scan_ap_t *aps, int n_aps, wifi_candidate_t *out,
+                       int max_out) {
+    bool seen[WIFI_PROFILES_MAX] = {false};
+    int unseen = 0;
+    for (int a = 0; a < n_aps; a++) {
+        int idx = wifi_profiles_find(wp, aps[a].ssid);
+        if (idx >= 0) {
+            seen[idx] = true;
+        }
+    }
+    for (int idx = 0; idx < wp->count; idx++) {
+        unseen += !seen[idx];
+    }
+
+    // Scanned APs, keeping room so every unseen network still gets one try
+    int n = 0;
+    int scanned_max = max_out - unseen > 0 ? max_out - unseen : (max_out > 0 ? 1 : 0);
+    for (int a = 0; a < n_aps; a++) {
+        int idx = wifi_profiles_find(wp, aps[a].ssid);
+        if (idx < 0) {
+            continue;
+        }
+        wifi_candidate_t c = {.profile = idx, .channel = aps[a].channel, .rssi = aps[a].rssi};
+        memcpy(c.bssid, aps[a].bssid, sizeof(c.bssid));
+        c.score = score_of(wp, idx, &aps[a]);
+        insert_sorted(out, &n, scanned_max, &c);
+    }
+
+    // Networks the scan didn't see (hidden SSID, or a missed beacon) follow, most
+    // recently successful first
+    int tail = n;
+    for (int idx = 0; idx < wp->count; idx++) {
+        if (seen[idx]) {
+            continue;
+        }
+        uint32_t age = wp->seq - wp->profiles[idx].last_ok_seq;
+        wifi_candidate_t c = {.profile = idx};
+        c.score = -(int)(age < 1000 ? age : 1000) - WIFI_PROFILES_FAIL_PENALTY_DB * wp->profiles[idx].fail_streak;
+        int m = n - tail;
+        insert_sorted(out + tail, &m, max_out - tail, &c);
+        n = tail + m;
+    }
+    return n;
+}
+
+void wifi_profiles_set_hint(wifi_profiles_t *wp, int idx, const uint8_t bssid[6], uint8_t channel) {
+    if (idx < 0 || idx >= wp->count) {
+        return;
+    }
+    memcpy(wp->profiles[idx].bssid, bssid, sizeof(wp->profiles[idx].bssid));
+    wp->profiles[idx].channel = channel;
+}
+
+bool wifi_profiles_quick_candidate(const wifi_profiles_t *wp, int fresh, wifi_candidate_t *out) {
+    int idx = -1;
+    if (fresh >= 0 && fresh < wp->count && wp->profiles[fresh].connects == 0 && wp->profiles[fresh].channel) {
+        idx = fresh;
+    } else {
+        for (int i = 0; i < wp->count; i++) {
+            const wifi_profile_t *p = &wp->profiles[i];
+            if (wp->seq != 0 && p->last_ok_seq == wp->seq && p->channel && p->fail_streak == 0) {
+                idx = i;
+            }
+        }
+    }
+    if (idx < 0) {
+        return false;
+    }
+    memset(out, 0, sizeof(*out));
+    out->profile = idx;
+    memcpy(out->bssid, wp->profiles[idx].bssid, sizeof(out->bssid));
+    out->channel = wp->profiles[idx].channel;
+    return true;
+}
+
+bool wifi_profiles_record_success(wifi_profiles_t *wp, int idx, const uint8_t bssid[6], uint8_t channel,
+                                  uint32_t connect_ms) {
+    if (idx < 0 || idx >= wp->count) {
+        return false;
+    }
+    wifi_profile_t *p = &wp->profiles[idx];
+    bool moved = p->last_ok_seq == 0 || p->last_ok_seq != wp->seq || p->channel != channel ||
+                 memcmp(p->bssid, bssid, sizeof(p->bssid)) != 0;
+
+    memcpy(p->bssid, bssid, sizeof(p->bssid));
+    p->channel = channel;
+    p->fail_streak = 0;
+    p->last_ok_seq = ++wp->seq;
+    p->connects++;
+    // Running average over the last ~8 connects once there are enough of them
+    uint32_t weight = p->connects < 8 ? p->connects : 8;
+    p->connect_ms_avg = (uint32_t)(((uint64_t)p->connect_ms_avg * (weight - 1) + connect_ms) / weight);
+    if (connect_ms > p->connect_ms_max) {
+        p->connect_ms_max = connect_ms;
+    }
+    return moved || p->connects % WIFI_PROFILES_SAVE_EVERY == 0;
+}
+
+void wifi_profiles_record_failure(wifi_profiles_t *wp, int idx) {
+    if (idx < 0 || idx >= wp->count) {
+        return;
+    }
+    wifi_profile_t *p = &wp->profiles[idx];
+    p->failures++;
+    if (p->fail_streak < UINT8_MAX) {
+        p->fail_streak++;
+    }
+}
+
+uint32_t wifi_profiles_backoff_ms(int rounds) {
+    if (rounds < 0) {
+        rounds = 0;
+    }
+    if (rounds >= 6) {
+        return 30000;
+    }
+    return 500u << rounds;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+// Stored WiFi networks and the choice of which one to join. One scan is ranked by signal,
+// how recently each network worked and recent failures; the winner is joined directly
+// on the BSSID/channel the scan saw. Per-network connect times are kept so slow
+// associations show up in the log. Portable, no locking.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WIFI_PROFILES_MAX 4
+#define WIFI_PROFILES_VER 1
+#define WIFI_PROFILES_MAX_CANDIDATES 8    // APs tried per round before backing off
+#define WIFI_PROFILES_RECENT_BONUS_DB 10  // Network that worked last
+#define WIFI_PROFILES_KNOWN_AP_BONUS_DB 3 // BSSID that worked last for its network
+#define WIFI_PROFILES_FAIL_PENALTY_DB 8   // Per consecutive failure, up to 3
+#define WIFI_PROFILES_SAVE_EVERY 8        // Persist stats at least every N connects
+
+typedef struct {
+    char ssid[33];
+    char pass[65];
+    uint8_t bssid[6];          // AP of the last successful connect
+    uint8_t channel;           // 0 = no hint
+    uint8_t fail_streak;       // Consecutive failed attempts
+    uint32_t last_ok_seq;      // wifi_profiles_t.seq at the last success (0 = never)
+    uint32_t connects;
+    uint32_t failures;
+    uint32_t connect_ms_avg;   // Connect start to IP, running average
+    uint32_t connect_ms_max;
+} wifi_profile_t;
+
+typedef struct {
+    uint8_t ver;
+    uint8_t count;
+    uint32_t seq;              // Bumped on every success; orders profiles by recency
+    wifi_profile_t profiles[WIFI_PROFILES_MAX];
+} wifi_profiles_t;
+
+// One scan result, as the platform reports it
+typedef struct {
+    char ssid[33];
+    uint8_t bssid[6];
+    uint8_t channel;
+    int8_t rssi;
+    uint8_t auth;              // Platform auth mode (0 = open)
+} wifi_scan_ap_t;
+
+typedef struct {
+    int profile;               // Index into profiles[]
+    uint8_t bssid[6];
+    uint8_t channel;           // 0 = not seen in the scan: plain SSID connect
+    int8_t rssi;
+    int score;
+} wifi_candidate_t;
+
+void wifi_profiles_init(wifi_profiles_t *wp);
+
+// Index of the profile for ssid, or -1
+int wifi_profiles_find(const wifi_profiles_t *wp, const char *ssid);
+
+// Add ssid or update its password. When full, the least recently successful profile
+// makes room. Returns the index, or -1 for an empty ssid.
+int wifi_profiles_upsert(wifi_profiles_t *wp, const char *ssid, const char *pass);
+
+bool wifi_profiles_remove(wifi_profiles_t *wp, const char *ssid);
+
+// Order the APs worth trying, best first. Every scanned AP of a stored network is a
+// candidate (mesh networks have several). Stored networks the scan didn't see (hidden,
+// or missed) follow with channel 0. Returns the number written to out.
+int wifi_profiles_rank(const wifi_profiles_t *wp, const wifi_scan_ap_t *aps, int n_aps, wifi_candidate_t *out,
+                       int max_out);
+
+// Store a BSSID/channel hint without a connect (e.g. the AP picked in the setup portal)
+void wifi_profiles_set_hint(wifi_profiles_t *wp, int idx, const uint8_t bssid[6], uint8_t channel);
+
+// A candidate worth joining directly, skipping the scan: `fresh` (a just-provisioned
+// profile, or -1) if it has a hint and has never connected, else the most recently
+// successful profile if it has a hint and hasn't failed since
+bool wifi_profiles_quick_candidate(const wifi_profiles_t *wp, int fresh, wifi_candidate_t *out);
+
+// Record a connect attempt. Success stores the BSSID/channel hint and the connect time;
+// it returns true if the profiles should be persisted (hint or preferred network moved,
+// or WIFI_PROFILES_SAVE_EVERY connects since the last save).
+bool wifi_profiles_record_success(wifi_profiles_t *wp, int idx, const uint8_t bssid[6], uint8_t channel,
+                                  uint32_t connect_ms);
+void wifi_profiles_record_failure(wifi_profiles_t *wp, int idx);
+
+// Delay before the next scan round after `rounds` consecutive rounds where nothing
+// connected (500 ms doubling to 30 s)
+uint32_t wifi_profiles_backoff_ms(int rounds);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,263 @@
+#include "zone_list.h"
+
+#include <string.h>
+
+// Copy the JSON string starting at `quote` (which must be '"'); escapes are copied
+// unescaped. Returns the position after the closing quote, or NULL if unterminated.
+static const char *read_string(const char *quote, const char *end, char *out, size_t len) {
+    if (quote >= end || *quote != '"') {
+        return NULL;
+    }
+    size_t n = 0;
+    for (const char *p = quote + 1; p < end && *p; p++) {
+        if (*p == '"') {
+            out[n] = '\0';
+            return p + 1;
+        }
+        if (*p == '\\' && p + 1 < end) {
+            p++;
+        }
+        if (n + 1 < len) {
+            out[n++] = *p;
+        }
+    }
+    return NULL;
+}
+
+// First "key" in [start, end), or NULL
+static const char *find_key(const char *start, const char *end, const char *key) {
+    size_t klen = strlen(key);
+    for (const char *p = start; p && p + klen + 2 <= end; p++) {
+        p = memchr(p, '"', end - p);
+        if (!p || p + klen + 2 > end) {
+            return NULL;
+        }
+        if (memcmp(p + 1, key, klen) == 0 && p[klen + 1] == '"') {
+            return p;
+        }
+    }
+    return NULL;
+}
+
+// Value start for the key found at key_pos (skips the colon and whitespace)
+static const char *value_of(const char *key_pos, const char *end) {
+    const char *p = key_pos ? memchr(key_pos, ':', end - key_pos) : NULL;
+    if (!p) {
+        return NULL;
+    }
+    for (p++; p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'); p++) {
+    }
+    return p < end ? p : NULL;
+}
+
+static bool string_field(const char *start, const char *end, const char *key, char *out, size_t len) {
+    const char *v = value_of(find_key(start, end, key), end);
+    return v && read_string(v, end, out, len) != NULL;
+}
+
+// Matching close for the '[' or '{' at `open`, skipping over strings
+static const char *container_end(const char *open, const char *end) {
+    int depth = 0;
+    for (const char *p = open; p < end && *p; p++) {
+        if (*p == '"') {
+            for (p++; p < end && *p && *p != '"'; p++) {
+                if (*p == '\\' && p + 1 < end) {
+                    p++;
+                }
+            }
+            if (p >= end || !*p) {
+                return NULL;
+            }
+        } else if (*p == '[' || *p == '{') {
+            depth++;
+        } else if (*p == ']' || *p == '}') {
+            if (--depth == 0) {
+                return p;
+            }
+        }
+    }
+    return NULL;
+}
+
+// Bounds of the array value of a top-level-ish key
+static bool array_field(const char *start, const char *end, const char *key, const char **arr,
+                        const char **arr_end) {
+    const char *v = value_of(find_key(start, end, key), end);
+    if (!v || *v != '[') {
+        return false;
+    }
+    *arr = v + 1;
+    *arr_end = container_end(v, end);
+    return *arr_end != NULL;
+}
+
+// Next {"zone_id":..,"zone_name":..[,"ver":..]} object in [p, end). Returns the position
+// after it, or NULL when there are no more; *ok is false if the object is malformed.
+static const char *next_zone(const char *p, const char *end, zone_list_entry_t *e, bool *ok) {
+    const char *id_key = find_key(p, end, "zone_id");
+    *ok = true;
+    if (!id_key) {
+        return NULL;
+    }
+    // Zone objects are flat, so the first '}' outside a string closes this one
+    const char *obj_end = id_key;
+    while (obj_end < end && *obj_end && *obj_end != '}') {
+        if (*obj_end == '"') {
+            for (obj_end++; obj_end < end && *obj_end && *obj_end != '"'; obj_end++) {
+                if (*obj_end == '\\' && obj_end + 1 < end) {
+                    obj_end++;
+                }
+            }
+        }
+        obj_end++;
+    }
+    if (obj_end >= end || *obj_end != '}') {
+        *ok = false;
+        return NULL;
+    }
+    memset(e, 0, sizeof(*e));
+    if (!string_field(id_key, obj_end, "zone_id", e->id, sizeof(e->id)) ||
+        !string_field(id_key, obj_end, "zone_name", e->name, sizeof(e->name))) {
+        *ok = false;
+        return obj_end + 1;
+    }
+    string_field(id_key, obj_end, "ver", e->ver, sizeof(e->ver));  // Optional
+    return obj_end + 1;
+}
+
+void zone_list_clear(zone_list_t *zl) {
+    memset(zl, 0, sizeof(*zl));
+}
+
+int zone_list_find(const zone_list_t *zl, const char *id) {
+    for (int i = 0; i < zl->count; i++) {
+        if (strcmp(zl->zones[i].id, id) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int zone_list_parse_full(zone_list_t *zl, const char *resp) {
+    zone_list_clear(zl);
+    if (!resp) {
+        return 0;
+    }
+    const char *end = resp + strlen(resp);
+    const char *p = resp;
+    const char *arr_end = NULL;
+    if (array_field(resp, end, "zones", &p, &arr_end)) {
+        end = arr_end;
+    }
+    zone_list_entry_t e;
+    bool ok;
+    while (zl->count < ZONE_LIST_MAX && (p = next_zone(p, end, &e, &ok)) != NULL) {
+        if (ok) {
+            zl->zones[zl->count++] = e;
+        }
+    }
+    // Old bridges don't send zones_sha; the list stays "unknown" so the next sync is full
+    const char *doc_end = resp + strlen(resp);
+    const char *sha = value_of(find_key(resp, doc_end, "zones_sha"), doc_end);
+    if (!(sha && read_string(sha, doc_end, zl->sha, sizeof(zl->sha)))) {
+        zl->sha[0] = '\0';
+    }
+    return zl->count;
+}
+
+bool zone_list_is_delta(const char *resp) {
+    if (!resp) {
+        return false;
+    }
+    const char *end = resp + strlen(resp);
+    return find_key(resp, end, "since") && (find_key(resp, end, "changed") || find_key(resp, end, "removed"));
+}
+
+// One pass over a delta; with apply=false it only validates
+static bool walk_delta(zone_list_t *zl, const char *resp, bool apply, zone_list_delta_t *out) {
+    const char *end = resp + strlen(resp);
+    const char *arr, *arr_end;
+    zone_list_entry_t e;
+    bool ok;
+
+    if (array_field(resp, end, "changed", &arr, &arr_end)) {
+        const char *p = arr;
+        while ((p = next_zone(p, arr_end, &e, &ok)) != NULL) {
+            if (!ok) {
+                return false;
+            }
+            if (!apply) {
+                continue;
+            }
+            int i = zone_list_find(zl, e.id);
+            if (i < 0) {
+                if (zl->count < ZONE_LIST_MAX) {
+                    zl->zones[zl->count++] = e;
+                    out->added++;
+                } else {
+                    out->dropped++;
+                }
+            } else if (e.ver[0] && strcmp(zl->zones[i].ver, e.ver) == 0) {
+                out->unchanged++;
+            } else {
+                if (strcmp(zl->zones[i].name, e.name) != 0) {
+                    memcpy(zl->zones[i].name, e.name, sizeof(e.name));
+                    out->renamed++;
+                } else {
+                    out->unchanged++;
+                }
+                memcpy(zl->zones[i].ver, e.ver, sizeof(e.ver));
+            }
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+
+    if (array_field(resp, end, "removed", &arr, &arr_end)) {
+        for (const char *p = arr; p < arr_end;) {
+            if (*p != '"') {
+                p++;
+                continue;
+            }
+            char id[ZONE_LIST_ID_LEN];
+            p = read_string(p, arr_end, id, sizeof(id));
+            if (!p) {
+                return false;
+            }
+            int i = apply ? zone_list_find(zl, id) : -1;
+            if (i >= 0) {
+                // Keep picker order: shift the tail down
+                memmove(&zl->zones[i], &zl->zones[i + 1], sizeof(zl->zones[0]) * (zl->count - i - 1));
+                zl->count--;
+                out->removed++;
+            }
+        }
+    }
+    return true;
+}
+
+bool zone_list_apply_delta(zone_list_t *zl, const char *resp, zone_list_delta_t *out) {
+    zone_list_delta_t local;
+    if (!out) {
+        out = &local;
+    }
+    memset(out, 0, sizeof(*out));
+    if (!resp || !zl->sha[0]) {
+        return false;
+    }
+    const char *end = resp + strlen(resp);
+    char since[ZONE_LIST_SHA_LEN];
+    char sha[ZONE_LIST_SHA_LEN];
+    if (!string_field(resp, end, "since", since, sizeof(since)) ||
+        !string_field(resp, end, "zones_sha", sha, sizeof(sha)) ||
+        strcmp(since, zl->sha) != 0) {
+        return false;
+    }
+    if (!walk_delta(zl, resp, false, out)) {
+        return false;
+    }
+    walk_delta(zl, resp, true, out);
+    memcpy(zl->sha, sha, sizeof(zl->sha));
+    return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+// Zone list kept in sync with the bridge. A full /zones answer replaces the list; a
+// delta answer ("changes since zones_sha X") adds, renames and removes entries in place,
+// so a large Roon install that regroups constantly doesn't rebuild the whole list.
+// Per-zone "ver" hashes let unchanged entries skip the copy. Portable, no locking.
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef ZONE_LIST_MAX
+#define ZONE_LIST_MAX 64
+#endif
+#define ZONE_LIST_ID_LEN 64
+#define ZONE_LIST_NAME_LEN 64
+#define ZONE_LIST_SHA_LEN 9
+
+typedef struct {
+    char id[ZONE_LIST_ID_LEN];
+    char name[ZONE_LIST_NAME_LEN];
+    char ver[ZONE_LIST_SHA_LEN];   // Per-zone hash from the bridge ("" if not sent)
+} zone_list_entry_t;
+
+typedef struct {
+    zone_list_entry_t zones[ZONE_LIST_MAX];
+    int count;
+    char sha[ZONE_LIST_SHA_LEN];   // zones_sha this list matches ("" = unknown)
+} zone_list_t;
+
+typedef struct {
+    int added;
+    int renamed;
+    int removed;
+    int unchanged;
+    int dropped;                   // Adds that didn't fit
+} zone_list_delta_t;
+
+void zone_list_clear(zone_list_t *zl);
+
+// Index of the zone with this id, or -1
+int zone_list_find(const zone_list_t *zl, const char *id);
+
+// Replace the list with every {"zone_id","zone_name"[,"ver"]} object in resp. Picks up a
+// top-level "zones_sha" if the bridge sent one. Returns the number of zones.
+int zone_list_parse_full(zone_list_t *zl, const char *resp);
+
+// True if resp is a delta answer ({"since":..,"changed":[..],"removed":[..]})
+bool zone_list_is_delta(const char *resp);
+
+// Apply a delta answer. Fails without touching the list if it is malformed or its "since"
+// is not the sha this list matches; the caller then falls back to a full fetch.
+bool zone_list_apply_delta(zone_list_t *zl, const char *resp, zone_list_delta_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,335 @@
+// Knob link firmware for the secondary ESP32.
+//
+// Idle until the S3 hands over a bridge watch (CMD_WATCH) before it deep-sleeps. While
+// watching, join WiFi, poll the bridge's now_playing every interval, cache the result and,
+// on a track or play/pause change, pulse the wake line. When the S3 comes back it asks for
+// the cached state (CMD_STATE_REQUEST) and takes the network back (CMD_UNWATCH).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <driver/gpio.h>
+#include <driver/uart.h>
+#include <esp_event.h>
+#include <esp_http_client.h>
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_wifi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <nvs_flash.h>
+
+#include "chip_link.h"
+
+static const char *TAG = "knob_link";
+
+// Pins verified in docs/esp/DUAL_CHIP_ARCHITECTURE.md
+#define LINK_UART_NUM UART_NUM_1
+#define LINK_TX_GPIO 23
+#define LINK_RX_GPIO 18
+#define LINK_BAUD 1000000
+#define LINK_RX_BUF 1024
+
+#define WAKE_PULSE_MS 10
+#define WIFI_CONNECT_TIMEOUT_MS 15000
+#define HTTP_TIMEOUT_MS 4000
+#define RESP_MAX 4096
+
+#define BIT_WATCH     BIT0
+#define BIT_CONNECTED BIT1
+
+static EventGroupHandle_t s_events;
+static SemaphoreHandle_t s_lock;        // Guards s_watch, s_state, s_have_state
+static chip_link_watch_t s_watch;
+static chip_link_now_playing_t s_state;
+static bool s_have_state = false;
+
+// ============================================================================
+// UART link
+// ============================================================================
+
+static void send_frame(uint8_t type, const uint8_t *payload, size_t len) {
+    uint8_t frame[CHIP_LINK_MAX_FRAME];
+    size_t n = chip_link_encode(type, payload, len, frame, sizeof(frame));
+    if (n > 0) {
+        uart_write_bytes(LINK_UART_NUM, frame, n);
+    }
+}
+
+static void send_byte(uint8_t type, uint8_t value) {
+    send_frame(type, &value, 1);
+}
+
+static void send_state(void) {
+    uint8_t payload[CHIP_LINK_MAX_PAYLOAD];
+    size_t len = 0;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (s_have_state) {
+        len = chip_link_now_playing_encode(&s_state, payload, sizeof(payload));
+    }
+    xSemaphoreGive(s_lock);
+    if (len > 0) {
+        send_frame(CHIP_LINK_EVT_NOW_PLAYING, payload, len);
+    } else {
+        send_byte(CHIP_LINK_EVT_ERROR, CHIP_LINK_ERR_NO_STATE);
+    }
+}
+
+static void handle_frame(const chip_link_decoder_t *d) {
+    switch (d->type) {
+    case CHIP_LINK_CMD_PING:
+        send_frame(CHIP_LINK_EVT_PONG, NULL, 0);
+        break;
+    case CHIP_LINK_CMD_WATCH: {
+        chip_link_watch_t w;
+        if (!chip_link_watch_decode(d->payload, d->len, &w)) {
+            send_byte(CHIP_LINK_EVT_ERROR, CHIP_LINK_ERR_BAD_FRAME);
+            break;
+        }
+        if (w.interval_ms < CONFIG_LINK_MIN_POLL_MS) {
+            w.interval_ms = CONFIG_LINK_MIN_POLL_MS;
+        }
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        s_watch = w;
+        xSemaphoreGive(s_lock);
+        send_byte(CHIP_LINK_EVT_ACK, d->type);  // ACK before WiFi work: the S3 is about to sleep
+        xEventGroupSetBits(s_events, BIT_WATCH);
+        ESP_LOGI(TAG, "Watching zone %s every %lu ms", w.zone_id, (unsigned long)w.interval_ms);
+        break;
+    }
+    case CHIP_LINK_CMD_UNWATCH:
+        xEventGroupClearBits(s_events, BIT_WATCH);
+        send_byte(CHIP_LINK_EVT_ACK, d->type);
+        break;
+    case CHIP_LINK_CMD_STATE_REQUEST:
+        send_state();
+        break;
+    default:
+        ESP_LOGD(TAG, "Ignoring frame type 0x%02x", d->type);
+        break;
+    }
+}
+
+static void link_task(void *arg) {
+    (void)arg;
+    static chip_link_decoder_t s_decoder;
+    chip_link_decoder_init(&s_decoder);
+    uint8_t buf[128];
+    while (true) {
+        int n = uart_read_bytes(LINK_UART_NUM, buf, sizeof(buf), portMAX_DELAY);
+        for (int i = 0; i < n; i++) {
+            if (chip_link_feed(&s_decoder, buf[i])) {
+                handle_frame(&s_decoder);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// WiFi
+// ============================================================================
+
+static void wifi_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data) {
+    (void)arg;
+    (void)data;
+    if (base == WIFI_EVENT && id == WIFI_EVENT_STA_DISCONNECTED) {
+        xEventGroupClearBits(s_events, BIT_CONNECTED);
+        if (xEventGroupGetBits(s_events) & BIT_WATCH) {
+            esp_wifi_connect();
+        }
+    } else if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP) {
+        xEventGroupSetBits(s_events, BIT_CONNECTED);
+    }
+}
+
+static bool wifi_up(const chip_link_watch_t *w) {
+    if (xEventGroupGetBits(s_events) & BIT_CONNECTED) {
+        return true;
+    }
+    wifi_config_t cfg = {0};
+    strncpy((char *)cfg.sta.ssid, w->ssid, sizeof(cfg.sta.ssid) - 1);
+    strncpy((char *)cfg.sta.password, w->pass, sizeof(cfg.sta.password) - 1);
+    esp_wifi_set_config(WIFI_IF_STA, &cfg);
+    esp_wifi_start();
+    esp_wifi_set_ps(WIFI_PS_MAX_MODEM);
+    esp_wifi_connect();
+    EventBits_t bits = xEventGroupWaitBits(s_events, BIT_CONNECTED, pdFALSE, pdFALSE,
+                                           pdMS_TO_TICKS(WIFI_CONNECT_TIMEOUT_MS));
+    return (bits & BIT_CONNECTED) != 0;
+}
+
+static void wifi_down(void) {
+    xEventGroupClearBits(s_events, BIT_CONNECTED);
+    esp_wifi_disconnect();
+    esp_wifi_stop();
+}
+
+// ============================================================================
+// Bridge poll
+// ============================================================================
+
+// Same key lookups as the S3's bridge_client (keys are unique in the response)
+static float json_number(const char *resp, const char *key, float fallback) {
+    const char *k = strstr(resp, key);
+    const char *colon = k ? strchr(k, ':') : NULL;
+    return colon ? (float)atof(colon + 1) : fallback;
+}
+
+static void json_string(const char *resp, const char *key, char *out, size_t len) {
+    out[0] = '\0';
+    const char *k = strstr(resp, key);
+    const char *q = k ? strchr(k + strlen(key), '"') : NULL;
+    if (!q) {
+        return;
+    }
+    size_t n = 0;
+    for (const char *p = q + 1; *p && *p != '"' && n + 1 < len; p++) {
+        if (*p == '\\' && p[1]) {
+            p++;  // Keep the escaped character; \uXXXX is rare in titles and left as-is
+        }
+        out[n++] = *p;
+    }
+    out[n] = '\0';
+}
+
+static bool fetch_now_playing(const chip_link_watch_t *w, chip_link_now_playing_t *np) {
+    char url[256];
+    snprintf(url, sizeof(url), "%s/now_playing?zone_id=%s", w->bridge_base, w->zone_id);
+    esp_http_client_config_t cfg = {
+        .url = url,
+        .timeout_ms = HTTP_TIMEOUT_MS,
+    };
+    esp_http_client_handle_t client = esp_http_client_init(&cfg);
+    if (!client) {
+        return false;
+    }
+    char *resp = malloc(RESP_MAX);
+    bool ok = false;
+    if (resp && esp_http_client_open(client, 0) == ESP_OK) {
+        esp_http_client_fetch_headers(client);
+        int total = 0;
+        int n;
+        while (total < RESP_MAX - 1 && (n = esp_http_client_read(client, resp + total, RESP_MAX - 1 - total)) > 0) {
+            total += n;
+        }
+        resp[total] = '\0';
+        ok = esp_http_client_get_status_code(client) == 200 && total > 0 && !strstr(resp, "\"error\"");
+    }
+    if (ok) {
+        json_string(resp, "\"line1\"", np->line1, sizeof(np->line1));
+        json_string(resp, "\"line2\"", np->line2, sizeof(np->line2));
+        np->playing = strstr(resp, "\"is_playing\":true") != NULL;
+        np->volume = json_number(resp, "\"volume\"", 0.0f);
+        np->volume_min = json_number(resp, "\"volume_min\"", 0.0f);
+        np->volume_max = json_number(resp, "\"volume_max\"", 100.0f);
+        np->volume_step = json_number(resp, "\"volume_step\"", 1.0f);
+        np->seek_position = (int32_t)json_number(resp, "\"seek_position\"", 0.0f);
+        np->length = (int32_t)json_number(resp, "\"length\"", 0.0f);
+    }
+    free(resp);
+    esp_http_client_cleanup(client);
+    return ok;
+}
+
+static void pulse_wake(uint8_t reason) {
+    send_byte(CHIP_LINK_EVT_WAKE, reason);
+#if CONFIG_LINK_WAKE_GPIO >= 0
+    gpio_set_level(CONFIG_LINK_WAKE_GPIO, 0);
+    vTaskDelay(pdMS_TO_TICKS(WAKE_PULSE_MS));
+    gpio_set_level(CONFIG_LINK_WAKE_GPIO, 1);
+#endif
+}
+
+static void poll_task(void *arg) {
+    (void)arg;
+    while (true) {
+        xEventGroupWaitBits(s_events, BIT_WATCH, pdFALSE, pdFALSE, portMAX_DELAY);
+
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        chip_link_watch_t w = s_watch;
+        xSemaphoreGive(s_lock);
+
+        if (wifi_up(&w)) {
+            chip_link_now_playing_t np = {0};
+            if (fetch_now_playing(&w, &np)) {
+                xSemaphoreTake(s_lock, portMAX_DELAY);
+                uint8_t reason = s_have_state ? chip_link_now_playing_wake_reason(&s_state, &np) : 0;
+                np.seq = s_state.seq + 1;
+                s_state = np;
+                s_have_state = true;
+                xSemaphoreGive(s_lock);
+                // Only while still watching: an UNWATCH may have raced the fetch
+                if (reason && (xEventGroupGetBits(s_events) & BIT_WATCH)) {
+                    ESP_LOGI(TAG, "Change 0x%02x, waking S3", reason);
+                    pulse_wake(reason);
+                }
+            }
+        }
+
+        // Sleep out the interval, but stop promptly on UNWATCH
+        TickType_t start = xTaskGetTickCount();
+        while (xTaskGetTickCount() - start < pdMS_TO_TICKS(w.interval_ms)) {
+            if (!(xEventGroupGetBits(s_events) & BIT_WATCH)) {
+                break;
+            }
+            vTaskDelay(pdMS_TO_TICKS(100));
+        }
+        if (!(xEventGroupGetBits(s_events) & BIT_WATCH)) {
+            wifi_down();
+            ESP_LOGI(TAG, "Watch released");
+        }
+    }
+}
+
+// ============================================================================
+// Entry
+// ============================================================================
+
+void app_main(void) {
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        err = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(err);
+
+    s_events = xEventGroupCreate();
+    s_lock = xSemaphoreCreateMutex();
+
+#if CONFIG_LINK_WAKE_GPIO >= 0
+    gpio_config_t io = {
+        .pin_bit_mask = 1ULL << CONFIG_LINK_WAKE_GPIO,
+        .mode = GPIO_MODE_OUTPUT,
+    };
+    gpio_config(&io);
+    gpio_set_level(CONFIG_LINK_WAKE_GPIO, 1);  // Idle high; the S3 wakes on low
+#endif
+
+    const uart_config_t uart_cfg = {
+        .baud_rate = LINK_BAUD,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+    ESP_ERROR_CHECK(uart_driver_install(LINK_UART_NUM, LINK_RX_BUF, 0, 0, NULL, 0));
+    ESP_ERROR_CHECK(uart_param_config(LINK_UART_NUM, &uart_cfg));
+    ESP_ERROR_CHECK(uart_set_pin(LINK_UART_NUM, LINK_TX_GPIO, LINK_RX_GPIO, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE));
+
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+    esp_netif_create_default_wifi_sta();
+    wifi_init_config_t wifi_cfg = WIFI_INIT_CONFIG_DEFAULT();
+    ESP_ERROR_CHECK(esp_wifi_init(&wifi_cfg));
+    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
+    esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, wifi_event_handler, NULL);
+    esp_event_handler_register(IP_EVENT, IP_EVENT_STA_GOT_IP, wifi_event_handler, NULL);
+
+    xTaskCreate(link_task, "link", 4096, NULL, 5, NULL);
+    xTaskCreate(poll_task, "poll", 6144, NULL, 3, NULL);
+    ESP_LOGI(TAG, "Knob link ready on UART%d (%d baud)", LINK_UART_NUM, LINK_BAUD);
+}
@@ -2,21 +2,35 @@
 #include "dns_server.h"
 #include "wifi_manager.h"
 #include "platform/platform_storage.h"
+#include "gzip_lite.h"
+#include "scan_table.h"
 #include "ui.h"
 
+#include <stdlib.h>
 #include <string.h>
 #include <esp_log.h>
 #include <esp_http_server.h>
 #include <esp_system.h>
 #include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include <freertos/task.h>
 
 static const char *TAG = "captive_portal";
 
 static httpd_handle_t s_server = NULL;
 
-// Simple HTML form for WiFi configuration
-static const char *HTML_FORM =
+// Networks from the background scans, and the form page rendered with them. The page is
+// rebuilt (and gzipped) when a scan lands, not per request, so serving it is a memcpy.
+static scan_table_t s_scan_table;
+static SemaphoreHandle_t s_page_lock;
+static char *s_page;           // Plain HTML, for clients without gzip
+static size_t s_page_len;
+static uint8_t *s_page_gz;
+static size_t s_page_gz_len;
+
+// HTML form for WiFi configuration. The scanned networks go between HEAD and TAIL as a
+// JSON array; picking one fills in the SSID plus the BSSID/channel for a direct connect.
+static const char *HTML_FORM_HEAD =
     "<!DOCTYPE html>"
     "<html><head>"
     "<meta name='viewport' content='width=device-width,initial-scale=1'>"
@@ -36,12 +50,18 @@ static const char *HTML_FORM =
     ".hint{font-size:12px;color:#666;margin-top:4px;}"
     ".note{background:#1e3a5f;padding:15px;border-radius:10px;max-width:300px;margin-top:20px;font-size:13px;}"
     ".note a{color:#4fc3f7;}"
+    ".net{display:block;width:100%;padding:10px;margin:4px 0;border:1px solid #333;border-radius:5px;background:#0f0f1a;color:#fff;text-align:left;}"
+    ".net.sel{border-color:#4fc3f7;}"
+    ".net span{float:right;color:#888;}"
     "</style></head><body>"
     "<h1>Roon Knob</h1>"
     "<p>WiFi Setup</p>"
     "<form method='GET' action='/configure'>"
     "<label>WiFi Network (SSID)</label>"
-    "<input type='text' name='ssid' required maxlength='32' placeholder='Your WiFi name'>"
+    "<div id='nets'></div>"
+    "<input type='text' id='ssid' name='ssid' required maxlength='32' placeholder='Your WiFi name'>"
+    "<input type='hidden' id='bssid' name='bssid'>"
+    "<input type='hidden' id='ch' name='ch'>"
     "<label>Password</label>"
     "<input type='password' name='pass' maxlength='64' placeholder='WiFi password'>"
     "<input type='submit' value='Connect'>"
@@ -50,6 +70,22 @@ static const char *HTML_FORM =
     "<strong>Note:</strong> To use this with Roon, you'll need to set up the Roon Bridge. "
     "See <a href='https://github.com/muness/roon-knob' target='_blank'>github.com/muness/roon-knob</a> for details."
     "</div>"
+    "<script>var N=";
+
+static const char *HTML_FORM_TAIL =
+    ";(function(){"
+    "var d=document.getElementById('nets'),s=document.getElementById('ssid'),"
+    "b=document.getElementById('bssid'),c=document.getElementById('ch');"
+    "N.forEach(function(n){"
+    "var e=document.createElement('button');e.type='button';e.className='net';"
+    "e.textContent=n.s+(n.a?' \\uD83D\\uDD12':'');"
+    "var r=document.createElement('span');r.textContent=n.r>-60?'\\u2582\\u2584\\u2586\\u2588':n.r>-70?'\\u2582\\u2584\\u2586':n.r>-80?'\\u2582\\u2584':'\\u2582';"
+    "e.appendChild(r);"
+    "e.onclick=function(){s.value=n.s;b.value=n.b;c.value=n.c;"
+    "[].forEach.call(d.children,function(x){x.classList.remove('sel');});e.classList.add('sel');};"
+    "d.appendChild(e);});"
+    "s.oninput=function(){b.value='';c.value='';};"
+    "})();</script>"
     "</body></html>";
 
 static const char *HTML_SUCCESS =
@@ -101,11 +137,16 @@ static bool get_form_field(const char *data, const char *field, char *out, size_
     char search[64];
     snprintf(search, sizeof(search), "%s=", field);
 
-    const char *start = strstr(data, search);
+    // Match whole names only ("ssid" must not find "bssid=")
+    const char *start = data;
+    size_t search_len = strlen(search);
+    while ((start = strstr(start, search)) != NULL && start != data && start[-1] != '&') {
+        start += search_len;
+    }
     if (!start) {
         return false;
     }
-    start += strlen(search);
+    start += search_len;
 
     const char *end = strchr(start, '&');
     size_t len = end ? (size_t)(end - start) : strlen(start);
@@ -130,12 +171,105 @@ static bool get_form_field(const char *data, const char *field, char *out, size_
     return true;
 }
 
+// Render the form with the current scan table and swap it in
+static void render_page(void) {
+    // Runs on the event task, so nothing big goes on the stack. Worst case an SSID is
+    // 32 escaped characters (6 bytes each) plus ~60 bytes of fields.
+    size_t head_len = strlen(HTML_FORM_HEAD);
+    size_t tail_len = strlen(HTML_FORM_TAIL);
+    size_t json_cap = SCAN_TABLE_MAX * 256 + 3;
+    char *page = malloc(head_len + json_cap + tail_len + 1);
+    if (!page) {
+        ESP_LOGW(TAG, "No memory to render the form");
+        return;
+    }
+    memcpy(page, HTML_FORM_HEAD, head_len);
+    int json_len = scan_table_render_json(&s_scan_table, page + head_len, json_cap);
+    if (json_len < 0) {
+        json_len = snprintf(page + head_len, json_cap, "[]");
+    }
+    memcpy(page + head_len + json_len, HTML_FORM_TAIL, tail_len + 1);
+    size_t len = head_len + json_len + tail_len;
+    uint8_t *gz = malloc(GZIP_LITE_BOUND(len));
+    if (!gz) {
+        ESP_LOGW(TAG, "No memory to compress the form");
+        free(page);
+        return;
+    }
+    size_t gz_len = gzip_lite_compress((const uint8_t *)page, len, gz, GZIP_LITE_BOUND(len));
+    if (gz_len == 0) {
+        free(gz);
+        gz = NULL;
+    }
+
+    xSemaphoreTake(s_page_lock, portMAX_DELAY);
+    free(s_page);
+    free(s_page_gz);
+    s_page = page;
+    s_page_len = len;
+    s_page_gz = gz;
+    s_page_gz_len = gz_len;
+    xSemaphoreGive(s_page_lock);
+    ESP_LOGI(TAG, "Form rendered: %d network(s), %u bytes (%u gzipped)", s_scan_table.count, (unsigned)len,
+             (unsigned)gz_len);
+}
+
+static void ensure_page_lock(void) {
+    if (!s_page_lock) {
+        s_page_lock = xSemaphoreCreateMutex();
+    }
+}
+
+void captive_portal_update_scan(const wifi_scan_ap_t *aps, int n) {
+    ensure_page_lock();
+    scan_table_merge(&s_scan_table, aps, n);
+    render_page();
+}
+
+static bool accepts_gzip(httpd_req_t *req) {
+    char enc[64];
+    if (httpd_req_get_hdr_value_str(req, "Accept-Encoding", enc, sizeof(enc)) != ESP_OK) {
+        return false;
+    }
+    return strstr(enc, "gzip") != NULL;
+}
+
 // Handler for GET / - serve the config form
 static esp_err_t root_get_handler(httpd_req_t *req) {
     ESP_LOGI(TAG, "Serving config form");
     httpd_resp_set_type(req, "text/html");
-    httpd_resp_send(req, HTML_FORM, strlen(HTML_FORM));
-    return ESP_OK;
+    xSemaphoreTake(s_page_lock, portMAX_DELAY);
+    esp_err_t err;
+    if (s_page_gz && accepts_gzip(req)) {
+        httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+        err = httpd_resp_send(req, (const char *)s_page_gz, s_page_gz_len);
+    } else if (s_page) {
+        err = httpd_resp_send(req, s_page, s_page_len);
+    } else {
+        // No scan yet: the form without a list
+        httpd_resp_send_chunk(req, HTML_FORM_HEAD, HTTPD_RESP_USE_STRLEN);
+        httpd_resp_send_chunk(req, "[]", 2);
+        httpd_resp_send_chunk(req, HTML_FORM_TAIL, HTTPD_RESP_USE_STRLEN);
+        err = httpd_resp_send_chunk(req, NULL, 0);
+    }
+    xSemaphoreGive(s_page_lock);
+    return err;
+}
+
+// "a0b1c2d3e4f5" -> 6 bytes
+static bool parse_bssid(const char *hex, uint8_t out[6]) {
+    if (strlen(hex) != 12) {
+        return false;
+    }
+    for (int i = 0; i < 6; i++) {
+        char byte[3] = {hex[2 * i], hex[2 * i + 1], 0};
+        char *end;
+        out[i] = (uint8_t)strtol(byte, &end, 16);
+        if (*end) {
+            return false;
+        }
+    }
+    return true;
 }
 
 // Handler for GET /configure - save credentials (GET works better in mobile captive portals)
@@ -183,6 +317,26 @@ static esp_err_t configure_get_handler(httpd_req_t *req) {
 
     bool save_ok = platform_storage_save(&cfg);
 
+    // Add it to the stored networks; an AP picked from the list lets the first connect
+    // after reboot skip the scan
+    wifi_profiles_t profiles;
+    platform_storage_load_wifi_profiles(&profiles);
+    int idx = wifi_profiles_upsert(&profiles, ssid, pass);
+    char bssid_hex[16] = {0};
+    char ch_str[4] = {0};
+    uint8_t bssid[6];
+    if (get_form_field(buf, "bssid", bssid_hex, sizeof(bssid_hex)) && parse_bssid(bssid_hex, bssid) &&
+        get_form_field(buf, "ch", ch_str, sizeof(ch_str))) {
+        int ch = atoi(ch_str);
+        if (ch >= 1 && ch <= 14) {
+            wifi_profiles_set_hint(&profiles, idx, bssid, (uint8_t)ch);
+            ESP_LOGI(TAG, "Picked AP %s on channel %d", bssid_hex, ch);
+        }
+    }
+    if (save_ok && !platform_storage_save_wifi_profiles(&profiles)) {
+        ESP_LOGW(TAG, "Failed to save WiFi profiles (network is re-added from config at boot)");
+    }
+
     // Send HTTP response first (so browser doesn't show error)
     httpd_resp_set_type(req, "text/html");
     httpd_resp_send(req, HTML_SUCCESS, strlen(HTML_SUCCESS));
@@ -264,6 +418,7 @@ void captive_portal_start(void) {
 
     ESP_LOGI(TAG, "Starting captive portal on port %d", config.server_port);
 
+    ensure_page_lock();
     if (httpd_start(&s_server, &config) != ESP_OK) {
         ESP_LOGE(TAG, "Failed to start HTTP server");
         return;
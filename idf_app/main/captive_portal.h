@@ -2,6 +2,8 @@
 
 #include <stdbool.h>
 
+#include "wifi_profiles.h"
+
 // Start the captive portal HTTP server (call when AP mode starts)
 void captive_portal_start(void);
 
@@ -10,3 +12,7 @@ void captive_portal_stop(void);
 
 // Check if captive portal is running
 bool captive_portal_is_running(void);
+
+// Merge a WiFi scan into the network list and re-render the form (safe while stopped;
+// scans from before AP mode fill the list in advance)
+void captive_portal_update_scan(const wifi_scan_ap_t *aps, int n);
@@ -0,0 +1,202 @@
+#include "chip_link_uart.h"
+
+#include <string.h>
+#include <driver/uart.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include "bridge_client.h"
+#include "chip_link.h"
+#include "platform/platform_http.h"
+#include "platform/platform_storage.h"
+#include "ui.h"
+
+static const char *TAG = "chip_link";
+
+#ifndef CONFIG_RK_CHIP_LINK_POLL_MS
+#define CONFIG_RK_CHIP_LINK_POLL_MS 5000
+#endif
+
+// Pins verified in docs/esp/DUAL_CHIP_ARCHITECTURE.md
+#define LINK_UART_NUM UART_NUM_1
+#define LINK_TX_GPIO 38
+#define LINK_RX_GPIO 48
+#define LINK_BAUD 1000000
+#define LINK_RX_BUF 1024
+
+#define LINK_TASK_STACK 4096
+#define LINK_READ_TIMEOUT_MS 20
+#define LINK_PING_INTERVAL_MS 3000
+#define LINK_ALIVE_TIMEOUT_MS (3 * LINK_PING_INTERVAL_MS)  // 3 missed pongs
+#define LINK_ACK_TIMEOUT_MS 200
+
+static SemaphoreHandle_t s_ack_sem = NULL;
+static volatile uint8_t s_ack_wanted = 0;       // Command type handoff is waiting on
+static volatile int64_t s_last_pong_ms = -1;
+static volatile bool s_handover_wanted = false; // Apply the next EVT_NOW_PLAYING to the UI
+
+static int64_t now_ms(void) {
+    return esp_timer_get_time() / 1000;
+}
+
+static bool send_frame(uint8_t type, const uint8_t *payload, size_t len) {
+    uint8_t frame[CHIP_LINK_MAX_FRAME];
+    size_t n = chip_link_encode(type, payload, len, frame, sizeof(frame));
+    if (n == 0) {
+        return false;
+    }
+    return uart_write_bytes(LINK_UART_NUM, frame, n) == (int)n;
+}
+
+static void apply_handover(const uint8_t *payload, size_t len) {
+    chip_link_now_playing_t np;
+    if (!chip_link_now_playing_decode(payload, len, &np)) {
+        ESP_LOGW(TAG, "Bad now-playing handover (%u bytes)", (unsigned)len);
+        return;
+    }
+    // Only fills the gap until the bridge answers; a live poll always wins
+    if (bridge_client_is_bridge_connected()) {
+        return;
+    }
+    ESP_LOGI(TAG, "Handover: '%s' (%s, seq %lu)", np.line1, np.playing ? "playing" : "paused",
+             (unsigned long)np.seq);
+    ui_update(np.line1, np.line2, np.playing, np.volume, np.volume_min, np.volume_max, np.volume_step,
+              np.seek_position, np.length);
+}
+
+static void handle_frame(const chip_link_decoder_t *d) {
+    switch (d->type) {
+    case CHIP_LINK_EVT_PONG:
+        s_last_pong_ms = now_ms();
+        break;
+    case CHIP_LINK_EVT_ACK:
+        s_last_pong_ms = now_ms();
+        if (d->len == 1 && d->payload[0] == s_ack_wanted) {
+            xSemaphoreGive(s_ack_sem);
+        }
+        break;
+    case CHIP_LINK_EVT_NOW_PLAYING:
+        if (s_handover_wanted) {
+            s_handover_wanted = false;
+            apply_handover(d->payload, d->len);
+        }
+        break;
+    case CHIP_LINK_EVT_WAKE:
+        ESP_LOGI(TAG, "Secondary wake event (reason 0x%02x)", d->len ? d->payload[0] : 0);
+        break;
+    case CHIP_LINK_EVT_ERROR:
+        if (d->len >= 1 && d->payload[0] == CHIP_LINK_ERR_NO_STATE) {
+            s_handover_wanted = false;  // Secondary never polled; wait for the bridge
+        }
+        ESP_LOGD(TAG, "Secondary error 0x%02x", d->len ? d->payload[0] : 0);
+        break;
+    default:
+        ESP_LOGD(TAG, "Ignoring frame type 0x%02x", d->type);
+        break;
+    }
+}
+
+static void chip_link_task(void *arg) {
+    (void)arg;
+    static chip_link_decoder_t s_decoder;  // 400 bytes; keep it off the task stack
+    chip_link_decoder_init(&s_decoder);
+    uint8_t buf[128];
+    int64_t last_ping = 0;
+
+    while (true) {
+        int n = uart_read_bytes(LINK_UART_NUM, buf, sizeof(buf), pdMS_TO_TICKS(LINK_READ_TIMEOUT_MS));
+        for (int i = 0; i < n; i++) {
+            if (chip_link_feed(&s_decoder, buf[i])) {
+                handle_frame(&s_decoder);
+            }
+        }
+        int64_t now = now_ms();
+        if (now - last_ping >= LINK_PING_INTERVAL_MS) {
+            last_ping = now;
+            send_frame(CHIP_LINK_CMD_PING, NULL, 0);
+            if (s_decoder.crc_errors || s_decoder.framing_errors) {
+                ESP_LOGW(TAG, "Link errors: %lu crc, %lu framing (%lu frames ok)",
+                         (unsigned long)s_decoder.crc_errors, (unsigned long)s_decoder.framing_errors,
+                         (unsigned long)s_decoder.frames);
+                s_decoder.crc_errors = 0;
+                s_decoder.framing_errors = 0;
+            }
+        }
+    }
+}
+
+void chip_link_uart_start(bool after_deep_sleep) {
+    const uart_config_t cfg = {
+        .baud_rate = LINK_BAUD,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+    esp_err_t err = uart_driver_install(LINK_UART_NUM, LINK_RX_BUF, 0, 0, NULL, 0);
+    if (err == ESP_OK) err = uart_param_config(LINK_UART_NUM, &cfg);
+    if (err == ESP_OK) err = uart_set_pin(LINK_UART_NUM, LINK_TX_GPIO, LINK_RX_GPIO, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "UART setup failed: %s", esp_err_to_name(err));
+        return;
+    }
+    s_ack_sem = xSemaphoreCreateBinary();
+
+    // Ask for the cached state first, then take the network back
+    if (after_deep_sleep) {
+        s_handover_wanted = true;
+        send_frame(CHIP_LINK_CMD_STATE_REQUEST, NULL, 0);
+    }
+    send_frame(CHIP_LINK_CMD_UNWATCH, NULL, 0);
+
+    xTaskCreate(chip_link_task, "chip_link", LINK_TASK_STACK, NULL, 3, NULL);
+    ESP_LOGI(TAG, "Chip link on UART%d (%d baud)", LINK_UART_NUM, LINK_BAUD);
+}
+
+bool chip_link_uart_handoff(void) {
+    if (!s_ack_sem) {
+        return false;
+    }
+    rk_cfg_t cfg;
+    if (!platform_storage_load(&cfg)) {
+        return false;
+    }
+    chip_link_watch_t watch = {0};
+    strncpy(watch.ssid, cfg.ssid, sizeof(watch.ssid) - 1);
+    strncpy(watch.pass, cfg.pass, sizeof(watch.pass) - 1);
+    char bridge_base[sizeof(watch.bridge_base)];
+    if (!bridge_client_get_bridge_url(bridge_base, sizeof(bridge_base)) ||
+        !bridge_client_get_zone_id(watch.zone_id, sizeof(watch.zone_id))) {
+        return false;  // Nothing worth watching yet
+    }
+    // The secondary has no mDNS resolver: hand it the address the S3 last resolved
+    platform_http_resolve_url(bridge_base, watch.bridge_base, sizeof(watch.bridge_base));
+    watch.interval_ms = CONFIG_RK_CHIP_LINK_POLL_MS;
+
+    uint8_t payload[CHIP_LINK_MAX_PAYLOAD];
+    size_t len = chip_link_watch_encode(&watch, payload, sizeof(payload));
+    if (len == 0) {
+        return false;
+    }
+    xSemaphoreTake(s_ack_sem, 0);  // Drop a stale ACK
+    s_ack_wanted = CHIP_LINK_CMD_WATCH;
+    int64_t start = now_ms();
+    bool acked = send_frame(CHIP_LINK_CMD_WATCH, payload, len) &&
+                 xSemaphoreTake(s_ack_sem, pdMS_TO_TICKS(LINK_ACK_TIMEOUT_MS)) == pdTRUE;
+    s_ack_wanted = 0;
+    if (acked) {
+        ESP_LOGI(TAG, "Bridge watch handed to secondary (%lld ms)", now_ms() - start);
+    } else {
+        ESP_LOGW(TAG, "Secondary did not ACK the bridge watch");
+    }
+    return acked;
+}
+
+bool chip_link_uart_is_alive(void) {
+    int64_t last = s_last_pong_ms;
+    return last >= 0 && now_ms() - last < LINK_ALIVE_TIMEOUT_MS;
+}
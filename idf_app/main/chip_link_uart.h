@@ -0,0 +1,19 @@
+#ifndef CHIP_LINK_UART_H
+#define CHIP_LINK_UART_H
+
+#include <stdbool.h>
+
+// UART link to the secondary ESP32 (CONFIG_RK_CHIP_LINK). While the S3 is in deep sleep
+// the secondary polls the bridge; on wake it hands back its cached now-playing state.
+// `after_deep_sleep` requests that state so the first screen isn't blank while WiFi
+// reconnects. Either way the secondary is told to stop polling.
+void chip_link_uart_start(bool after_deep_sleep);
+
+// Before deep sleep: hand the bridge watch (WiFi, bridge, zone) to the secondary.
+// Blocks up to ~200ms for its ACK. Returns false if the secondary didn't answer.
+bool chip_link_uart_handoff(void);
+
+// Secondary answered a recent heartbeat
+bool chip_link_uart_is_alive(void);
+
+#endif // CHIP_LINK_UART_H
@@ -1,13 +1,19 @@
 #include "display_sleep.h"
 #include "captive_portal.h"
+#include "chip_link_uart.h"
+#include "sdkconfig.h"
+#if CONFIG_RK_ULP_ENCODER
+#include "encoder_ulp.h"
+#endif
 #include "platform/platform_display.h"
+#include "platform_display_idf.h"
+#include "pm_locks.h"
 #include "bridge_client.h"
 #include "wifi_manager.h"
 #include "battery.h"
 #include "esp_timer.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_log.h"
-#include "esp_pm.h"
 #include "esp_sleep.h"
 #include "esp_wifi.h"
 #include "driver/ledc.h"
@@ -64,6 +70,7 @@ static display_state_t s_display_state = DISPLAY_STATE_NORMAL;
 static int64_t s_touch_suppress_until_ms = 0;  // Suppress widget touches after wake
 static int64_t s_encoder_suppress_until_ms = 0;  // Suppress encoder after deep sleep wake
 static bool s_woke_from_deep_sleep = false;  // Flag set on boot if woke from deep sleep
+static uint8_t s_brightness = BACKLIGHT_NORMAL;  // Last level set (0 = off)
 
 // Current timeout values (in ms, 0 = disabled)
 static uint32_t s_art_mode_timeout_ms = DEFAULT_ART_MODE_TIMEOUT_MS;
@@ -75,46 +82,22 @@ static uint32_t s_deep_sleep_timeout_ms = DEFAULT_DEEP_SLEEP_TIMEOUT_MS;
 static bool s_wifi_power_save_enabled = false;
 static bool s_cpu_freq_scaling_enabled = false;
 
-#if CONFIG_PM_ENABLE
-static esp_pm_lock_handle_t s_pm_cpu_lock = NULL;
-static bool s_pm_initialized = false;
-
-// Initialize power management (call once during init)
-static void pm_init(void) {
-    if (s_pm_initialized) return;
-
-    // Configure PM: allow scaling between 80MHz (min) and 240MHz (max)
-    esp_pm_config_t pm_config = {
-        .max_freq_mhz = 240,
-        .min_freq_mhz = 80,
-        .light_sleep_enable = false,  // Don't auto-sleep, we control display separately
-    };
-
-    esp_err_t err = esp_pm_configure(&pm_config);
-    if (err != ESP_OK) {
-        ESP_LOGW(TAG, "Failed to configure PM: %s", esp_err_to_name(err));
-        return;
-    }
-
-    // Create a CPU frequency lock - when held, keeps CPU at max freq
-    err = esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "display", &s_pm_cpu_lock);
-    if (err != ESP_OK) {
-        ESP_LOGW(TAG, "Failed to create PM lock: %s", esp_err_to_name(err));
-        return;
-    }
-
-    // Start with lock held (display is awake at boot)
-    esp_pm_lock_acquire(s_pm_cpu_lock);
-
-    s_pm_initialized = true;
-    ESP_LOGI(TAG, "Power management initialized (80-240MHz scaling)");
-}
-#endif
-
-// Set backlight brightness using LEDC PWM
+// Set brightness: through the panel's brightness register (PWM fully on unless off),
+// or the LEDC PWM alone
 void display_set_backlight(uint8_t brightness) {
-    ESP_ERROR_CHECK(ledc_set_duty(LEDC_SPEED_MODE, LEDC_CHANNEL, brightness));
+#if CONFIG_RK_PANEL_BRIGHTNESS
+    platform_display_set_panel_brightness(brightness);
+    uint32_t duty = brightness ? 255 : 0;
+#else
+    uint32_t duty = brightness;
+#endif
+    ESP_ERROR_CHECK(ledc_set_duty(LEDC_SPEED_MODE, LEDC_CHANNEL, duty));
     ESP_ERROR_CHECK(ledc_update_duty(LEDC_SPEED_MODE, LEDC_CHANNEL));
+    s_brightness = brightness;
+}
+
+uint8_t display_get_brightness(void) {
+    return s_brightness;
 }
 
 // Get current display state
@@ -158,6 +141,9 @@ void display_dim(void) {
     LOCK_DISPLAY_STATE();
     if (s_display_state == DISPLAY_STATE_NORMAL || s_display_state == DISPLAY_STATE_ART_MODE) {
         display_set_backlight(BACKLIGHT_DIM);
+#if CONFIG_RK_PANEL_IDLE_MODE
+        platform_display_set_idle_mode(true);
+#endif
         ui_set_controls_visible(false);
         s_display_state = DISPLAY_STATE_DIM;
         entered_dim = true;
@@ -204,14 +190,6 @@ void display_sleep(void) {
             wifi_mgr_set_power_save(true);
         }
 
-        // Release CPU frequency lock to allow scaling down
-#if CONFIG_PM_ENABLE
-        if (s_cpu_freq_scaling_enabled && s_pm_initialized && s_pm_cpu_lock) {
-            esp_pm_lock_release(s_pm_cpu_lock);
-            ESP_LOGI(TAG, "CPU frequency lock released (scaling enabled)");
-        }
-#endif
-
         s_display_state = DISPLAY_STATE_SLEEP;
         ESP_LOGI(TAG, "Display sleeping");
 
@@ -241,19 +219,14 @@ void display_wake(void) {
     sleep_timeout = s_sleep_timeout_ms;
 
     if (s_display_state == DISPLAY_STATE_SLEEP && s_panel_handle != NULL) {
-        // Acquire CPU frequency lock first (need full performance)
-#if CONFIG_PM_ENABLE
-        if (s_cpu_freq_scaling_enabled && s_pm_initialized && s_pm_cpu_lock) {
-            esp_pm_lock_acquire(s_pm_cpu_lock);
-            ESP_LOGI(TAG, "CPU frequency lock acquired (max freq)");
-        }
-#endif
-
         // Disable WiFi power save (need full performance for responsive polling)
         if (s_wifi_power_save_enabled) {
             wifi_mgr_set_power_save(false);
         }
 
+        // Start the now-playing refresh so it overlaps with panel power-up
+        bridge_client_wake_refresh();
+
         // Turn on display panel first
         esp_lcd_panel_disp_on_off(s_panel_handle, true);
 
@@ -269,6 +242,11 @@ void display_wake(void) {
 
     if (s_display_state != DISPLAY_STATE_NORMAL) {
         // Restore full brightness
+#if CONFIG_RK_PANEL_IDLE_MODE
+        if (prev_state == DISPLAY_STATE_DIM || prev_state == DISPLAY_STATE_SLEEP) {
+            platform_display_set_idle_mode(false);  // Sleep is entered from dim still idle
+        }
+#endif
         display_set_backlight(BACKLIGHT_NORMAL);
         // Show controls
         ui_set_controls_visible(true);
@@ -340,6 +318,11 @@ static void enter_deep_sleep(void) {
         esp_lcd_panel_disp_on_off(s_panel_handle, false);
     }
 
+#if CONFIG_RK_CHIP_LINK
+    // Secondary ESP32 keeps watching the bridge while we sleep
+    chip_link_uart_handoff();
+#endif
+
     // Stop WiFi cleanly to reduce wake time on next boot
     esp_wifi_stop();
 
@@ -395,6 +378,27 @@ static void enter_deep_sleep(void) {
     // Encoder pins are pulled HIGH, going LOW on rotation
     uint64_t wake_gpio_mask = (1ULL << ENCODER_GPIO_A) | (1ULL << ENCODER_GPIO_B);
 
+#if CONFIG_RK_CHIP_LINK && CONFIG_RK_CHIP_LINK_WAKE_GPIO >= 0
+    // Secondary pulls the wake line low on a track or play/pause change (board rework:
+    // the UART RX pin, GPIO48, can't wake the S3 from deep sleep)
+    const gpio_num_t link_wake = (gpio_num_t)CONFIG_RK_CHIP_LINK_WAKE_GPIO;
+    if (rtc_gpio_init(link_wake) == ESP_OK &&
+        rtc_gpio_set_direction(link_wake, RTC_GPIO_MODE_INPUT_ONLY) == ESP_OK &&
+        rtc_gpio_pullup_en(link_wake) == ESP_OK) {
+        rtc_gpio_pulldown_dis(link_wake);
+        wake_gpio_mask |= 1ULL << link_wake;
+    } else {
+        ESP_LOGW(TAG, "Chip link wake GPIO %d not RTC-capable, ignoring", CONFIG_RK_CHIP_LINK_WAKE_GPIO);
+    }
+#endif
+
+#if CONFIG_RK_ULP_ENCODER
+    // Count detents from here until the next boot's input init (pins are RTC inputs now)
+    if (!encoder_ulp_start()) {
+        ESP_LOGW(TAG, "ULP encoder counting unavailable; the waking turn will be dropped");
+    }
+#endif
+
     err = esp_sleep_enable_ext1_wakeup(wake_gpio_mask, ESP_EXT1_WAKEUP_ANY_LOW);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to configure wake sources: %s", esp_err_to_name(err));
@@ -542,6 +546,13 @@ void display_activity_detected(void) {
     }
 }
 
+// Wake the UI loop early (it blocks up to UI_LOOP_FROZEN_DELAY_MS while frozen)
+void display_kick_ui_loop(void) {
+    if (s_lvgl_task_handle != NULL) {
+        xTaskNotifyGive(s_lvgl_task_handle);
+    }
+}
+
 // Check if display is sleeping
 bool display_is_sleeping(void) {
     return s_display_state == DISPLAY_STATE_SLEEP;
@@ -658,15 +669,9 @@ void display_update_power_settings(const rk_cfg_t *cfg) {
         wifi_mgr_set_power_save(s_wifi_power_save_enabled);
     }
 
-#if CONFIG_PM_ENABLE
-    // Initialize PM when CPU scaling is first enabled
-    if (cpu_changed && s_cpu_freq_scaling_enabled) {
-        pm_init();
-        // If currently sleeping, release the lock to enable scaling
-        if (s_display_state == DISPLAY_STATE_SLEEP && s_pm_initialized && s_pm_cpu_lock) {
-            esp_pm_lock_release(s_pm_cpu_lock);
-            ESP_LOGI(TAG, "CPU scaling enabled while sleeping - lock released");
-        }
+    // Scaling holds full speed only around render and network bursts (pm_locks.c), so
+    // it applies the same whether the display is awake or asleep
+    if (cpu_changed) {
+        pm_locks_set_scaling(s_cpu_freq_scaling_enabled);
     }
-#endif
 }
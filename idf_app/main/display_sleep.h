@@ -56,12 +56,25 @@ void display_wake(void);
  */
 void display_activity_detected(void);
 
+/**
+ * @brief Wake the UI loop task immediately
+ * The UI loop sleeps longer while rendering is frozen (art mode); input sources
+ * call this so the first event after a quiet period isn't delayed
+ */
+void display_kick_ui_loop(void);
+
 /**
  * @brief Set backlight brightness (0-255)
- * @param brightness PWM duty cycle (0=off, 255=full brightness)
+ * @param brightness Panel brightness register value, or PWM duty cycle without
+ *                   CONFIG_RK_PANEL_BRIGHTNESS (0=off, 255=full brightness)
  */
 void display_set_backlight(uint8_t brightness);
 
+/**
+ * @brief Get the brightness last set with display_set_backlight (0 = off)
+ */
+uint8_t display_get_brightness(void);
+
 /**
  * @brief Check if display is currently sleeping
  * @return true if display is off, false if on or dimmed
@@ -0,0 +1,54 @@
+#include "encoder_ulp.h"
+
+#include <esp_log.h>
+#include <esp_rom_sys.h>
+#include <esp_sleep.h>
+#include <ulp_riscv.h>
+
+#include "ulp_encoder.h"  // Generated: ulp_state, ulp_detents, ulp_samples
+
+static const char *TAG = "encoder_ulp";
+
+#define ENCODER_ULP_PERIOD_US 3000  // Same sampling rate as the main firmware's poll timer
+
+// Must match ulp/encoder_ulp.c
+#define ULP_ENCODER_ARMED   0x454E4301
+#define ULP_ENCODER_RUNNING 0x454E4302
+
+extern const uint8_t ulp_encoder_bin_start[] asm("_binary_ulp_encoder_bin_start");
+extern const uint8_t ulp_encoder_bin_end[] asm("_binary_ulp_encoder_bin_end");
+
+bool encoder_ulp_start(void) {
+    esp_err_t err = ulp_riscv_load_binary(ulp_encoder_bin_start, ulp_encoder_bin_end - ulp_encoder_bin_start);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "ULP load failed: %s", esp_err_to_name(err));
+        return false;
+    }
+    ulp_state = ULP_ENCODER_ARMED;
+    ulp_detents = 0;
+    ulp_samples = 0;
+    ulp_set_wakeup_period(0, ENCODER_ULP_PERIOD_US);
+    err = ulp_riscv_run();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "ULP start failed: %s", esp_err_to_name(err));
+        return false;
+    }
+    return true;
+}
+
+bool encoder_ulp_collect(int *detents) {
+    *detents = 0;
+    if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_UNDEFINED) {
+        return false;  // Cold boot: RTC memory holds no ULP state
+    }
+    ulp_riscv_timer_stop();
+    esp_rom_delay_us(100);  // Let a run in progress finish (a run takes a few us)
+
+    bool running = ulp_state == ULP_ENCODER_RUNNING;
+    if (running) {
+        *detents = (int32_t)ulp_detents;
+        ESP_LOGI(TAG, "ULP counted %d detents over %lu samples", *detents, (unsigned long)ulp_samples);
+    }
+    ulp_state = 0;
+    return running;
+}
@@ -0,0 +1,17 @@
+#ifndef ENCODER_ULP_H
+#define ENCODER_ULP_H
+
+#include <stdbool.h>
+
+// ULP RISC-V encoder counting across deep sleep (CONFIG_RK_ULP_ENCODER).
+
+// Before deep sleep, after the encoder pins are set up as RTC inputs: load and start
+// the ULP program. Returns false if the ULP couldn't be started (sleep still proceeds).
+bool encoder_ulp_start(void);
+
+// Early in boot, before the encoder GPIOs are reconfigured: stop the ULP and return the
+// detents it counted during sleep and boot. Returns false on a cold boot or if the ULP
+// wasn't running.
+bool encoder_ulp_collect(int *detents);
+
+#endif // ENCODER_ULP_H
@@ -0,0 +1,141 @@
+#include "haptics.h"
+
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "haptic_sched.h"
+#include "i2c_bsp.h"
+#include "ui.h"
+
+static const char *TAG = "haptics";
+
+// DRV2605 registers
+#define DRV2605_REG_MODE      0x01
+#define DRV2605_REG_LIBRARY   0x03
+#define DRV2605_REG_WAVESEQ1  0x04
+#define DRV2605_REG_WAVESEQ2  0x05
+#define DRV2605_REG_GO        0x0C
+#define DRV2605_REG_FEEDBACK  0x1A
+
+#define DRV2605_MODE_INTERNAL_TRIGGER 0x00
+#define DRV2605_FEEDBACK_LRA          0x80
+
+// Effect library IDs (ERM library A / LRA library 6 share the numbering)
+#define EFFECT_DETENT  24   // Sharp Tick 1 - 100%
+#define EFFECT_CLAMP   1    // Strong Click - 100%
+#define DETENT_MS 15        // Approximate effect lengths: clicks closer than this coalesce
+#define CLAMP_MS 40
+
+#define HAPTICS_TASK_STACK 2560
+#define HAPTICS_TASK_PRIORITY 10   // Above the UI loop (2) so clicks never wait for a frame
+#define HAPTICS_STATS_EVERY 200
+
+static TaskHandle_t s_task = NULL;
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static int s_pending_delta = 0;          // Detents since the task last ran (guarded by s_mux)
+static int64_t s_pending_since_us = 0;   // Oldest unhandled detent, for latency stats
+static haptic_sched_t s_sched;           // Guarded by s_mux
+static uint8_t s_loaded_effect = 0;      // Effect currently in WAVESEQ1 (task only)
+static int64_t s_latency_max_us = 0;
+static int64_t s_latency_sum_us = 0;
+
+static bool write_reg(uint8_t reg, uint8_t value) {
+    return i2c_write_buff(drv2605_dev_handle, reg, &value, 1) == ESP_OK;
+}
+
+// One I2C write for a repeat of the loaded effect (GO), two when the effect changes
+static void play(uint8_t effect) {
+    if (effect != s_loaded_effect) {
+        if (!write_reg(DRV2605_REG_WAVESEQ1, effect)) {
+            return;
+        }
+        s_loaded_effect = effect;
+    }
+    write_reg(DRV2605_REG_GO, 1);
+}
+
+static void haptics_task(void *arg) {
+    (void)arg;
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        portENTER_CRITICAL(&s_mux);
+        int delta = s_pending_delta;
+        int64_t since_us = s_pending_since_us;
+        s_pending_delta = 0;
+        s_pending_since_us = 0;
+        haptic_effect_t effect = haptic_sched_ticks(&s_sched, delta, ui_rotation_controls_volume(),
+                                                    (uint64_t)(esp_timer_get_time() / 1000));
+        uint32_t played = s_sched.played;
+        uint32_t suppressed = s_sched.suppressed;
+        portEXIT_CRITICAL(&s_mux);
+
+        if (effect == HAPTIC_NONE) {
+            continue;
+        }
+        play(effect == HAPTIC_CLAMP ? EFFECT_CLAMP : EFFECT_DETENT);
+
+        int64_t latency = esp_timer_get_time() - since_us;
+        s_latency_sum_us += latency;
+        if (latency > s_latency_max_us) s_latency_max_us = latency;
+        if (played % HAPTICS_STATS_EVERY == 0) {
+            ESP_LOGI(TAG, "%lu effects (%lu coalesced), detent->GO latency avg %lld us, max %lld us",
+                     (unsigned long)played, (unsigned long)suppressed,
+                     s_latency_sum_us / HAPTICS_STATS_EVERY, s_latency_max_us);
+            s_latency_sum_us = 0;
+            s_latency_max_us = 0;
+        }
+    }
+}
+
+bool haptics_init(void) {
+    haptic_sched_init(&s_sched, DETENT_MS, CLAMP_MS);
+
+    // Out of standby, internal trigger, library and a one-effect sequence
+    bool ok = write_reg(DRV2605_REG_MODE, DRV2605_MODE_INTERNAL_TRIGGER);
+#if CONFIG_RK_HAPTICS_LRA
+    ok = ok && write_reg(DRV2605_REG_FEEDBACK, DRV2605_FEEDBACK_LRA);
+    ok = ok && write_reg(DRV2605_REG_LIBRARY, 6);
+#else
+    ok = ok && write_reg(DRV2605_REG_LIBRARY, 1);
+#endif
+    ok = ok && write_reg(DRV2605_REG_WAVESEQ1, EFFECT_DETENT);
+    ok = ok && write_reg(DRV2605_REG_WAVESEQ2, 0);  // Terminator: GO plays exactly one effect
+    if (!ok) {
+        ESP_LOGW(TAG, "DRV2605 not responding - haptics disabled");
+        return false;
+    }
+    s_loaded_effect = EFFECT_DETENT;
+
+    if (xTaskCreate(haptics_task, "haptics", HAPTICS_TASK_STACK, NULL, HAPTICS_TASK_PRIORITY, &s_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create haptics task");
+        return false;
+    }
+#if CONFIG_RK_HAPTICS_LRA
+    ESP_LOGI(TAG, "Haptics ready (LRA)");
+#else
+    ESP_LOGI(TAG, "Haptics ready (ERM)");
+#endif
+    return true;
+}
+
+void haptics_on_detents(int delta) {
+    if (!s_task || delta == 0) {
+        return;
+    }
+    portENTER_CRITICAL(&s_mux);
+    if (s_pending_delta == 0) {
+        s_pending_since_us = esp_timer_get_time();
+    }
+    s_pending_delta += delta;
+    portEXIT_CRITICAL(&s_mux);
+    xTaskNotifyGive(s_task);
+}
+
+void haptics_set_volume(float volume, float volume_min, float volume_max, float volume_step) {
+    portENTER_CRITICAL(&s_mux);
+    haptic_sched_set_volume(&s_sched, volume, volume_min, volume_max, volume_step);
+    portEXIT_CRITICAL(&s_mux);
+}
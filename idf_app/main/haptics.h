@@ -0,0 +1,15 @@
+#ifndef HAPTICS_H
+#define HAPTICS_H
+
+#include <stdbool.h>
+
+// DRV2605 haptic detents (CONFIG_RK_HAPTICS). Call after i2c_master_Init().
+bool haptics_init(void);
+
+// Encoder poll path: `delta` detents just decoded. Non-blocking; wakes the haptics task.
+void haptics_on_detents(int delta);
+
+// Volume state for clamp prediction (optimistic changes and polls)
+void haptics_set_volume(float volume, float volume_min, float volume_max, float volume_step);
+
+#endif // HAPTICS_H
@@ -0,0 +1,171 @@
+#include "level_meter_udp.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <esp_log.h>
+#include <lwip/sockets.h>
+#include <lwip/netdb.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "bridge_client.h"
+#include "os_mutex.h"
+#include "platform/platform_display.h"
+#include "platform/platform_http.h"
+#include "platform/platform_task.h"
+#include "platform/platform_time.h"
+#include "ui_level_meter.h"
+
+static const char *TAG = "level_meter";
+
+#ifndef CONFIG_RK_LEVEL_METER_PORT
+#define CONFIG_RK_LEVEL_METER_PORT 9330
+#endif
+
+#define LEVEL_RX_TIMEOUT_MS 250
+#define LEVEL_POLICY_INTERVAL_MS 1000
+#define LEVEL_SUBSCRIBE_INTERVAL_MS 5000   // Bridge drops subscribers after ~15s of silence
+#define LEVEL_TASK_STACK 3072
+
+static int s_sock = -1;
+static os_mutex_t s_lock = OS_MUTEX_INITIALIZER;
+static level_jitter_t s_jitter;
+static bool s_wanted = false;
+
+static bool meter_wanted(void) {
+#if CONFIG_RK_LEVEL_METER_ON_BATTERY
+    bool power_ok = true;
+#else
+    bool power_ok = platform_battery_is_charging();
+#endif
+    return power_ok && !platform_display_is_sleeping() && bridge_client_is_bridge_connected();
+}
+
+// Bridge host from "http://host:port"; the level stream uses its own UDP port
+static bool resolve_bridge(struct sockaddr_in *out) {
+    char base[128];
+    char url[128];
+    if (!bridge_client_get_bridge_url(base, sizeof(base))) {
+        return false;
+    }
+    platform_http_resolve_url(base, url, sizeof(url));  // getaddrinfo can't resolve .local
+    const char *host = strstr(url, "://");
+    host = host ? host + 3 : url;
+    char name[64];
+    size_t n = strcspn(host, ":/");
+    if (n == 0 || n >= sizeof(name)) {
+        return false;
+    }
+    memcpy(name, host, n);
+    name[n] = '\0';
+
+    memset(out, 0, sizeof(*out));
+    out->sin_family = AF_INET;
+    out->sin_port = htons(CONFIG_RK_LEVEL_METER_PORT);
+    if (inet_pton(AF_INET, name, &out->sin_addr) == 1) {
+        return true;
+    }
+    struct addrinfo hints = {.ai_family = AF_INET, .ai_socktype = SOCK_DGRAM};
+    struct addrinfo *res = NULL;
+    if (getaddrinfo(name, NULL, &hints, &res) != 0 || !res) {
+        return false;
+    }
+    out->sin_addr = ((struct sockaddr_in *)res->ai_addr)->sin_addr;
+    freeaddrinfo(res);
+    return true;
+}
+
+// "RKLS" + zone_id subscribes (bridge streams to our source address); "RKLU" stops it
+static void send_subscription(bool subscribe) {
+    struct sockaddr_in bridge;
+    if (!resolve_bridge(&bridge)) {
+        return;
+    }
+    char msg[80];
+    size_t len = 4;
+    memcpy(msg, subscribe ? "RKLS" : "RKLU", 4);
+    if (subscribe && bridge_client_get_zone_id(msg + 4, sizeof(msg) - 4)) {
+        len += strlen(msg + 4);
+    }
+    sendto(s_sock, msg, len, 0, (struct sockaddr *)&bridge, sizeof(bridge));
+}
+
+static void set_enabled_cb(void *arg) {
+    ui_level_meter_set_enabled(arg != NULL);
+}
+
+static void level_meter_task(void *arg) {
+    (void)arg;
+    uint8_t buf[LEVEL_METER_HEADER_LEN + LEVEL_METER_MAX_BANDS + 16];
+    uint64_t last_policy = 0;
+    uint64_t last_subscribe = 0;
+
+    while (true) {
+        uint64_t now = platform_millis();
+        if (now - last_policy >= LEVEL_POLICY_INTERVAL_MS) {
+            last_policy = now;
+            bool wanted = meter_wanted();
+            if (wanted != s_wanted) {
+                s_wanted = wanted;
+                ESP_LOGI(TAG, "Level meter %s", wanted ? "on" : "off (battery, sleep or no bridge)");
+                if (!wanted) {
+                    send_subscription(false);
+                }
+                platform_task_post_to_ui(set_enabled_cb, wanted ? (void *)1 : NULL);
+                last_subscribe = 0;
+            }
+            if (s_wanted && now - last_subscribe >= LEVEL_SUBSCRIBE_INTERVAL_MS) {
+                last_subscribe = now;
+                send_subscription(true);
+            }
+        }
+
+        int len = recv(s_sock, buf, sizeof(buf), 0);
+        if (len <= 0) {
+            continue;  // Timeout: re-check policy
+        }
+        level_frame_t frame;
+        if (!s_wanted || !level_meter_parse(buf, (size_t)len, &frame)) {
+            continue;
+        }
+        os_mutex_lock(&s_lock);
+        level_jitter_push(&s_jitter, &frame, platform_millis());
+        os_mutex_unlock(&s_lock);
+    }
+}
+
+bool level_meter_udp_pop(uint64_t now_ms, level_frame_t *out) {
+    os_mutex_lock(&s_lock);
+    bool got = level_jitter_pop(&s_jitter, now_ms, out);
+    os_mutex_unlock(&s_lock);
+    return got;
+}
+
+void level_meter_udp_start(void) {
+    if (s_sock >= 0) {
+        return;
+    }
+    level_jitter_init(&s_jitter);
+
+    s_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s_sock < 0) {
+        ESP_LOGE(TAG, "Failed to create socket: %d", errno);
+        return;
+    }
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(CONFIG_RK_LEVEL_METER_PORT),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    if (bind(s_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        ESP_LOGE(TAG, "Failed to bind socket: %d", errno);
+        close(s_sock);
+        s_sock = -1;
+        return;
+    }
+    struct timeval tv = {.tv_sec = 0, .tv_usec = LEVEL_RX_TIMEOUT_MS * 1000};
+    setsockopt(s_sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    xTaskCreate(level_meter_task, "level_meter", LEVEL_TASK_STACK, NULL, 3, NULL);
+    ESP_LOGI(TAG, "Level meter listening on UDP %d", CONFIG_RK_LEVEL_METER_PORT);
+}
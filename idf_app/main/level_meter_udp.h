@@ -0,0 +1,17 @@
+#ifndef LEVEL_METER_UDP_H
+#define LEVEL_METER_UDP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "level_meter.h"
+
+// Start the level meter receiver (CONFIG_RK_LEVEL_METER). A small task subscribes to the
+// bridge's UDP level stream while the meter is wanted (display awake, and on USB power
+// unless CONFIG_RK_LEVEL_METER_ON_BATTERY) and feeds the jitter buffer.
+void level_meter_udp_start(void);
+
+// ui_level_meter frame source (UI thread)
+bool level_meter_udp_pop(uint64_t now_ms, level_frame_t *out);
+
+#endif // LEVEL_METER_UDP_H
@@ -1,17 +1,23 @@
 #include "app.h"
 #include "battery.h"
+#include "chip_link_uart.h"
 #include "config_server.h"
 #include "display_sleep.h"
 #include "font_manager.h"
+#include "haptics.h"
+#include "level_meter_udp.h"
 #include "ota_update.h"
 #include "platform/platform_http.h"
 #include "platform/platform_input.h"
 #include "platform/platform_mdns.h"
+#include "platform/platform_memcpy.h"
 #include "platform/platform_storage.h"
 #include "platform/platform_time.h"
 #include "platform_display_idf.h"
+#include "pm_locks.h"
 #include "bridge_client.h"
 #include "ui.h"
+#include "ui_level_meter.h"
 #include "ui_network.h"
 #include "wifi_manager.h"
 
@@ -30,6 +36,12 @@ static const char *TAG = "main";
 // UI task stack size (needs headroom for LVGL rendering + gzip decompression)
 #define UI_LOOP_STACK_SIZE 32768
 
+// UI loop pacing: 10ms normally, longer while rendering is frozen (art mode, dim, sleep).
+// Encoder input wakes the loop early via display_kick_ui_loop().
+#define UI_LOOP_DELAY_MS 10
+#define UI_LOOP_FROZEN_DELAY_MS 50
+#define UI_LOOP_STATS_INTERVAL_US (60 * 1000 * 1000)
+
 // UI task handle for display sleep management
 static TaskHandle_t g_ui_task_handle = NULL;
 
@@ -204,28 +216,49 @@ static void ui_loop_task(void *arg) {
     (void)arg;
     ESP_LOGI(TAG, "UI loop task started");
 
-    uint32_t ota_check_counter = 0;
+    int64_t last_ota_check_us = 0;
+    int64_t last_stats_us = esp_timer_get_time();
+    uint32_t last_frame_count = 0;
+    int64_t busy_us = 0;
 
     while (true) {
+        int64_t iter_start_us = esp_timer_get_time();
+
         // Process queued input events from ISR context
         platform_input_process_events();
 
         // Process pending display actions (e.g., swipe gestures)
         platform_display_process_pending();
 
-        // Run LVGL task handler
+        // Run LVGL task handler at the refresh rate the current activity calls for
+        platform_display_govern_refresh();
         ui_loop_iter();
 
-        // Check OTA status periodically (every 500ms = 50 iterations at 10ms)
-        if (++ota_check_counter >= 50) {
-            ota_check_counter = 0;
+        int64_t now_us = esp_timer_get_time();
+        busy_us += now_us - iter_start_us;
+
+        // Check OTA status periodically (every 500ms)
+        if (now_us - last_ota_check_us >= 500 * 1000) {
+            last_ota_check_us = now_us;
             check_ota_status();
         }
 
-        // Check stack usage periodically (every 60 seconds = 6000 iterations at 10ms)
-        static uint32_t stack_check_counter = 0;
-        if (++stack_check_counter >= 6000) {
-            stack_check_counter = 0;
+        // Every 60 seconds: render stats and stack usage
+        if (now_us - last_stats_us >= UI_LOOP_STATS_INTERVAL_US) {
+            uint32_t frames = platform_display_get_frame_count();
+            ESP_LOGI(TAG, "ui_loop: %lu frames, %lu ms busy in last %lus (%s), apl %u, panel load %u%%",
+                     (unsigned long)(frames - last_frame_count), (unsigned long)(busy_us / 1000),
+                     (unsigned long)((now_us - last_stats_us) / 1000000),
+                     ui_is_render_frozen() ? "frozen" : "active", platform_display_get_apl(),
+                     platform_display_get_panel_load());
+            last_frame_count = frames;
+            pm_locks_log_stats();
+            platform_display_log_render_stats();
+            platform_display_log_refresh_stats();
+            platform_memcpy_log_stats();
+            busy_us = 0;
+            last_stats_us = now_us;
+
             UBaseType_t hwm = uxTaskGetStackHighWaterMark(NULL);
             uint32_t free_bytes = hwm * sizeof(StackType_t);
             uint32_t used_bytes = UI_LOOP_STACK_SIZE - free_bytes;
@@ -253,8 +286,14 @@ static void ui_loop_task(void *arg) {
             config_server_stop();
         }
 
-        // Yield to lower priority tasks including IDLE
-        vTaskDelay(pdMS_TO_TICKS(10));
+        // Yield to lower priority tasks including IDLE.
+        // While frozen nothing on screen changes except artwork/arcs, so poll slower;
+        // encoder input cuts the wait short via task notification.
+        if (ui_is_render_frozen()) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(UI_LOOP_FROZEN_DELAY_MS));
+        } else {
+            vTaskDelay(pdMS_TO_TICKS(UI_LOOP_DELAY_MS));
+        }
     }
 }
 
@@ -272,6 +311,12 @@ void app_main(void) {
     }
     ESP_ERROR_CHECK(err);
 
+    // CPU frequency locks, before any task can start rendering or fetching
+    pm_locks_init();
+
+    // DMA channel for artwork-sized copies
+    platform_memcpy_init();
+
     // Initialize display hardware (SPI, LCD panel) BEFORE lv_init
     ESP_LOGI(TAG, "Initializing display hardware...");
     if (!platform_display_init()) {
@@ -285,6 +330,14 @@ void app_main(void) {
         ESP_LOGW(TAG, "Battery monitoring init failed, continuing without it");
     }
 
+#if CONFIG_RK_HAPTICS
+    // Detent clicks (DRV2605 shares the I2C bus brought up by the display init)
+    ESP_LOGI(TAG, "Initializing haptics...");
+    if (!haptics_init()) {
+        ESP_LOGW(TAG, "Haptics init failed, continuing without it");
+    }
+#endif
+
     // Initialize OTA update module
     ESP_LOGI(TAG, "Initializing OTA update module...");
     ota_init();
@@ -310,6 +363,12 @@ void app_main(void) {
     ESP_LOGI(TAG, "Initializing UI...");
     ui_init();
 
+#if CONFIG_RK_LEVEL_METER
+    // Rim level meter (receiver subscribes once the bridge is reachable)
+    ui_level_meter_init(level_meter_udp_pop);
+    level_meter_udp_start();
+#endif
+
     // Initialize input (rotary encoder)
     platform_input_init();
 
@@ -321,6 +380,11 @@ void app_main(void) {
     ESP_LOGI(TAG, "Initializing display sleep management");
     platform_display_init_sleep(g_ui_task_handle);
 
+#if CONFIG_RK_CHIP_LINK
+    // Secondary ESP32: take the network back and pick up its cached now-playing state
+    chip_link_uart_start(display_woke_from_deep_sleep());
+#endif
+
     // Start application logic
     ESP_LOGI(TAG, "Starting app...");
     app_entry();
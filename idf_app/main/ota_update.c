@@ -1,4 +1,5 @@
 #include "ota_update.h"
+#include "platform/platform_http.h"
 #include "platform/platform_storage.h"
 
 #include <string.h>
@@ -16,13 +17,12 @@ static const char *TAG = "ota";
 static ota_info_t s_ota_info = {0};
 static TaskHandle_t s_ota_task = NULL;
 
-// Get bridge base URL from storage
+// Get bridge base URL from storage, with .local hosts resolved (lwIP can't)
 static bool get_bridge_url(char *url, size_t len) {
     rk_cfg_t cfg;
     if (platform_storage_load(&cfg)) {
         if (cfg.bridge_base[0]) {
-            strncpy(url, cfg.bridge_base, len - 1);
-            url[len - 1] = '\0';
+            platform_http_resolve_url(cfg.bridge_base, url, len);
             return true;
         }
     }
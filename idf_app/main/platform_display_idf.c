@@ -2,11 +2,19 @@
 #include "platform/platform_display.h"
 #include "display_sleep.h"
 #include "bridge_client.h"
+#include "ui_browse.h"
+#include "ui_queue.h"
 #include "battery.h"
+#include "hold_stats.h"
+#include "panel_power.h"
+#include "pm_locks.h"
+#include "refresh_gov.h"
+#include "ui_jpeg.h"
 #include "i2c_bsp.h"
 #include "lcd_touch_bsp.h"
 
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 #include <inttypes.h>
 #include "freertos/FreeRTOS.h"
@@ -34,6 +42,8 @@ static int64_t s_touch_start_time = 0;
 static bool s_touch_tracking = false;
 static volatile bool s_pending_art_mode = false;   // Deferred art mode activation
 static volatile bool s_pending_exit_art_mode = false;  // Deferred art mode exit
+static volatile bool s_pending_swipe_left = false;   // Deferred queue open / browse back
+static volatile bool s_pending_swipe_right = false;  // Deferred queue close / browse open
 static uint16_t s_current_rotation = 0;  // Track rotation for swipe direction transform
 
 // Double-tap detection for art mode toggle
@@ -61,6 +71,14 @@ static esp_timer_handle_t s_lvgl_tick_timer = NULL;
 #define PIN_NUM_LCD_RST     ((gpio_num_t)21)
 #define PIN_NUM_BK_LIGHT    ((gpio_num_t)47)
 
+// SH8601 DCS commands not covered by esp_lcd_panel_ops
+#define LCD_CMD_IDMOFF      0x38  // Idle mode off
+#define LCD_CMD_IDMON       0x39  // Idle mode on (8 colours)
+#define LCD_CMD_WRDISBV     0x51  // Display brightness
+#define LCD_CMD_WRCTRLD     0x53  // Control display
+#define LCD_CTRLD_BCTRL     0x20  // Brightness control on
+#define LCD_OPCODE_WRITE_CMD 0x02  // QSPI command phase: opcode in bits 31-24, DCS command in 15-8
+
 // LCD initialization commands for SH8601 (from reference example)
 static const sh8601_lcd_init_cmd_t lcd_init_cmds[] = {
     {0xF0, (uint8_t[]){0x28}, 1, 0},
@@ -269,17 +287,66 @@ static void lvgl_rounder_cb(lv_event_t *e) {
     area->y2 = ((area->y2 >> 1) << 1) + 1;
 }
 
-// Static rotation buffer - sized to handle LVGL's combined flushes when rotation
-// is enabled. Observed max: 54 rows. Using 60 rows with margin.
-// (360 x 60 x 2 = 43200 bytes - fits in internal DMA-capable RAM)
-static uint8_t *s_rotate_buf = NULL;
-#define ROTATE_BUF_ROWS 60
-#define ROTATE_BUF_SIZE (LCD_H_RES * ROTATE_BUF_ROWS * sizeof(uint16_t))
+// Completed frames (last flush of a refresh), for render statistics
+static volatile uint32_t s_frame_count = 0;
+
+// Render time (RENDER_START to RENDER_READY) and panel transfers, for the render log
+static hold_stats_t s_render_stats;
+static uint32_t s_flush_count = 0;          // esp_lcd_panel_draw_bitmap calls this window
+static size_t s_draw_buf_internal = 0;      // Internal DMA RAM held by draw/bounce buffers
+
+// Luma map of what is on screen, for the panel power estimate
+static panel_power_t s_panel_power;
+
+// Refresh governor state (UI loop task only, like the flush callback)
+static refresh_gov_t s_refresh_gov;
+static uint32_t s_refresh_period_ms = 0;
+static volatile bool s_refresh_input = false;  // Set from the encoder and touch paths
+
+#if CONFIG_RK_TEST_API
+// Scripted-run measurements (test API), reset at the start of each run
+static portMUX_TYPE s_perf_mux = portMUX_INITIALIZER_UNLOCKED;
+static hold_stats_t s_perf_render;
+static int64_t s_perf_input_us = 0;  // Injected input not yet on screen (0 = none)
+static uint32_t s_perf_latency_count = 0;
+static uint64_t s_perf_latency_total_us = 0;
+static uint32_t s_perf_latency_max_us = 0;
+
+// Injected touch, in place of the controller while active
+static volatile bool s_inject_active = false;
+static volatile bool s_inject_pressed = false;
+static volatile uint16_t s_inject_x = 0;
+static volatile uint16_t s_inject_y = 0;
+#endif
+
+// Last flush of a refresh: the frame is on its way to the panel
+static void frame_done(void) {
+    s_frame_count++;
+    refresh_gov_note_frame(&s_refresh_gov, esp_timer_get_time() / 1000);
+#if CONFIG_RK_TEST_API
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_perf_mux);
+    if (s_perf_input_us) {
+        uint32_t latency = (uint32_t)(now - s_perf_input_us);
+        s_perf_latency_count++;
+        s_perf_latency_total_us += latency;
+        if (latency > s_perf_latency_max_us) {
+            s_perf_latency_max_us = latency;
+        }
+        s_perf_input_us = 0;
+    }
+    portEXIT_CRITICAL(&s_perf_mux);
+#endif
+}
 
-// Simple 180-degree rotation for RGB565 buffer (reverse pixel order)
-static void rotate180_rgb565_simple(const uint16_t *src, uint16_t *dst, int pixel_count) {
-    for (int i = 0; i < pixel_count; i++) {
-        dst[pixel_count - 1 - i] = src[i];
+#if !CONFIG_RK_PSRAM_FRAMEBUFFER
+// 180-degree rotation of an RGB565 area in place (reverse pixel order), so the rotated
+// band never leaves the DMA buffer
+static void rotate180_rgb565_inplace(uint16_t *px, int pixel_count) {
+    for (int i = 0, j = pixel_count - 1; i < j; i++, j--) {
+        uint16_t t = px[i];
+        px[i] = px[j];
+        px[j] = t;
     }
 }
 
@@ -303,20 +370,8 @@ static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px
 
     // Handle 180-degree rotation (for "upside down" mounting when charging)
     // Note: 90/270 rotation not supported due to poor performance (see DECISION_ROTATION.md)
-    if (rotation == LV_DISPLAY_ROTATION_180 && s_rotate_buf != NULL) {
-        // Safety check: ensure flush area fits in rotation buffer
-        const int max_pixels = LCD_H_RES * ROTATE_BUF_ROWS;
-        if (pixel_count > max_pixels) {
-            ESP_LOGE(TAG, "Flush area too large for rotation buffer: %d > %d pixels (%" PRId32 "x%" PRId32 ")",
-                     pixel_count, max_pixels, src_w, src_h);
-            goto skip_rotation;
-        }
-
-        // Rotate pixels: px_map -> s_rotate_buf (in PSRAM)
-        rotate180_rgb565_simple((const uint16_t *)px_map, (uint16_t *)s_rotate_buf, pixel_count);
-
-        // Copy back to px_map (DMA-capable) for LCD transfer
-        memcpy(px_map, s_rotate_buf, pixel_count * sizeof(uint16_t));
+    if (rotation == LV_DISPLAY_ROTATION_180) {
+        rotate180_rgb565_inplace((uint16_t *)px_map, pixel_count);
 
         // Mirror coordinates around display center
         out_x1 = LCD_H_RES - 1 - area->x2;
@@ -324,7 +379,8 @@ static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px
         out_y1 = LCD_V_RES - 1 - area->y2;
         out_y2 = LCD_V_RES - 1 - area->y1;
     }
-skip_rotation:
+
+    panel_power_add_area(&s_panel_power, out_x1, out_y1, src_w, src_h, (const uint16_t *)px_map);
 
     // Swap bytes for big-endian QSPI display (SH8601 expects big-endian RGB565)
     uint16_t *pixels = (uint16_t *)px_map;
@@ -333,11 +389,128 @@ skip_rotation:
     }
 
     esp_lcd_panel_draw_bitmap(panel_handle, out_x1, out_y1, out_x2 + 1, out_y2 + 1, px_map);
+    s_flush_count++;
+
+    if (lv_display_flush_is_last(disp)) {
+        frame_done();
+    }
 
     // MUST call flush_ready here - the notify callback doesn't work properly with LVGL 9.x
     lv_display_flush_ready(disp);
 }
 
+#else
+// Full-frame mode: LVGL renders only the dirty areas, in place, into a 360x360
+// framebuffer in PSRAM (direct render mode), so the frame is always complete there.
+// The flush copies each area out through two small internal DMA bounce buffers,
+// rotating and byte-swapping on the way. esp_lcd waits for queued colour transfers
+// before sending the next chunk's window commands, so by the time a bounce buffer is
+// refilled the chunk it last held is on the panel.
+#define BOUNCE_BUF_ROWS 16
+#define BOUNCE_BUF_PIXELS (LCD_H_RES * BOUNCE_BUF_ROWS)
+static uint16_t *s_framebuf = NULL;
+static uint16_t *s_bounce_buf[2] = {NULL, NULL};
+static int s_bounce_next = 0;
+
+static void lvgl_flush_direct_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    esp_lcd_panel_handle_t panel_handle = (esp_lcd_panel_handle_t)lv_display_get_user_data(disp);
+    const uint16_t *fb = (const uint16_t *)px_map;  // Whole frame; `area` is the dirty part
+    const bool rotated = lv_display_get_rotation(disp) == LV_DISPLAY_ROTATION_180;
+    const int32_t w = lv_area_get_width(area);
+    const int32_t h = lv_area_get_height(area);
+    const int32_t chunk_rows = (BOUNCE_BUF_PIXELS / w) & ~1;  // Even, for the 2-pixel alignment
+
+    for (int32_t done = 0; done < h; done += chunk_rows) {
+        const int32_t rows = h - done < chunk_rows ? h - done : chunk_rows;
+        uint16_t *buf = s_bounce_buf[s_bounce_next];
+        s_bounce_next ^= 1;
+
+        int32_t out_x1, out_y1;
+        if (rotated) {
+            // Output rows top to bottom are the area's rows bottom to top, mirrored
+            for (int32_t r = 0; r < rows; r++) {
+                const uint16_t *src = fb + (area->y2 - done - r) * LCD_H_RES + area->x1;
+                uint16_t *dst = buf + r * w;
+                for (int32_t i = 0; i < w; i++) {
+                    dst[i] = src[w - 1 - i];
+                }
+            }
+            out_x1 = LCD_H_RES - 1 - area->x2;
+            out_y1 = LCD_V_RES - 1 - area->y2 + done;
+        } else {
+            for (int32_t r = 0; r < rows; r++) {
+                memcpy(buf + r * w, fb + (area->y1 + done + r) * LCD_H_RES + area->x1, w * sizeof(uint16_t));
+            }
+            out_x1 = area->x1;
+            out_y1 = area->y1 + done;
+        }
+
+        panel_power_add_area(&s_panel_power, out_x1, out_y1, w, rows, buf);
+
+        // Swap bytes for big-endian QSPI display (SH8601 expects big-endian RGB565)
+        for (int i = 0; i < w * rows; i++) {
+            buf[i] = (buf[i] >> 8) | (buf[i] << 8);
+        }
+
+        esp_lcd_panel_draw_bitmap(panel_handle, out_x1, out_y1, out_x1 + w, out_y1 + rows, buf);
+        s_flush_count++;
+    }
+
+    if (lv_display_flush_is_last(disp)) {
+        frame_done();
+    }
+
+    // The framebuffer is never on the wire, so LVGL may draw into it again right away
+    lv_display_flush_ready(disp);
+}
+
+static bool alloc_framebuffer(void) {
+    size_t fb_size = LCD_H_RES * LCD_V_RES * sizeof(uint16_t);
+    size_t bounce_size = BOUNCE_BUF_PIXELS * sizeof(uint16_t);
+    s_framebuf = heap_caps_aligned_calloc(64, 1, fb_size, MALLOC_CAP_SPIRAM);
+    s_bounce_buf[0] = heap_caps_malloc(bounce_size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    s_bounce_buf[1] = heap_caps_malloc(bounce_size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    if (!s_framebuf || !s_bounce_buf[0] || !s_bounce_buf[1]) {
+        ESP_LOGE(TAG, "Failed to allocate framebuffer or bounce buffers");
+        return false;
+    }
+    s_draw_buf_internal = 2 * bounce_size;
+    ESP_LOGI(TAG, "Allocated %zu byte framebuffer in PSRAM, 2 x %zu byte bounce buffers", fb_size,
+             bounce_size);
+
+    lv_display_set_buffers(s_display, s_framebuf, NULL, fb_size, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(s_display, lvgl_flush_direct_cb);
+    return true;
+}
+#endif
+
+// Full CPU speed from the start of a render to its last flush (RENDER_START/READY come
+// in pairs, but guard against a missed READY so the lock can't leak)
+static bool s_render_boosted = false;
+
+static void lvgl_render_event_cb(lv_event_t *e) {
+    bool start = lv_event_get_code(e) == LV_EVENT_RENDER_START;
+    if (start && !s_render_boosted) {
+        pm_work_begin(PM_WORK_RENDER);
+        hold_stats_begin(&s_render_stats, esp_timer_get_time());
+#if CONFIG_RK_TEST_API
+        portENTER_CRITICAL(&s_perf_mux);
+        hold_stats_begin(&s_perf_render, esp_timer_get_time());
+        portEXIT_CRITICAL(&s_perf_mux);
+#endif
+        s_render_boosted = true;
+    } else if (!start && s_render_boosted) {
+        hold_stats_end(&s_render_stats, esp_timer_get_time());
+#if CONFIG_RK_TEST_API
+        portENTER_CRITICAL(&s_perf_mux);
+        hold_stats_end(&s_perf_render, esp_timer_get_time());
+        portEXIT_CRITICAL(&s_perf_mux);
+#endif
+        pm_work_end(PM_WORK_RENDER);
+        s_render_boosted = false;
+    }
+}
+
 // LVGL tick timer callback - critical for LVGL to track time
 static void lvgl_tick_timer_cb(void *arg) {
     (void)arg;
@@ -348,8 +521,20 @@ static void lvgl_tick_timer_cb(void *arg) {
 static void lvgl_touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data) {
     (void)indev;
     uint16_t x, y;
+#if CONFIG_RK_TEST_API
+    bool touched;
+    if (s_inject_active) {
+        touched = s_inject_pressed;
+        x = s_inject_x;
+        y = s_inject_y;
+    } else {
+        touched = tpGetCoordinates(&x, &y);
+    }
+#else
+    bool touched = tpGetCoordinates(&x, &y);
+#endif
 
-    if (tpGetCoordinates(&x, &y)) {
+    if (touched) {
         display_state_t state = display_get_state();
         bool was_not_normal = (state != DISPLAY_STATE_NORMAL);
 
@@ -382,6 +567,7 @@ static void lvgl_touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data) {
 
         // Normal touch processing
         display_activity_detected();  // Reset sleep timers
+        platform_display_note_input();
         data->point.x = x;
         data->point.y = y;
         data->state = LV_INDEV_STATE_PRESSED;
@@ -419,6 +605,16 @@ static void lvgl_touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data) {
                     ESP_LOGI(TAG, "Swipe down detected (rotation=%d) - queueing exit art mode", s_current_rotation);
                     s_pending_exit_art_mode = true;  // Defer to avoid LVGL threading issues
                 }
+                // Horizontal swipes move between browse <- now playing -> queue;
+                // which screen they act on is resolved on the UI thread
+                else if (dx < -SWIPE_MIN_DISTANCE && abs(dx) > abs(dy)) {
+                    ESP_LOGI(TAG, "Swipe left detected - queueing");
+                    s_pending_swipe_left = true;
+                }
+                else if (dx > SWIPE_MIN_DISTANCE && abs(dx) > abs(dy)) {
+                    ESP_LOGI(TAG, "Swipe right detected - queueing");
+                    s_pending_swipe_right = true;
+                }
                 // Check for double-tap to enter art mode (#66)
                 // Only if this wasn't a swipe (small movement) and not already in art mode
                 // (any single tap exits art mode, so double-tap is only for entering)
@@ -450,10 +646,17 @@ static void lvgl_touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data) {
     }
 }
 
+// Send a DCS command with the QSPI framing the sh8601 driver uses for its own commands
+static esp_err_t panel_tx_param(uint8_t cmd, const void *param, size_t len) {
+    int lcd_cmd = (LCD_OPCODE_WRITE_CMD << 24) | (cmd << 8);
+    return esp_lcd_panel_io_tx_param(s_io_handle, lcd_cmd, param, len);
+}
+
 bool platform_display_init(void) {
     ESP_LOGI(TAG, "Initializing display hardware");
 
-    // Initialize backlight with PWM at reduced brightness (50%)
+    // Initialize backlight PWM. With panel brightness the PWM stays fully on and the
+    // SH8601 brightness register sets the level instead.
     ledc_timer_config_t ledc_timer = {
         .speed_mode = LEDC_LOW_SPEED_MODE,
         .duty_resolution = LEDC_TIMER_8_BIT,
@@ -468,7 +671,11 @@ bool platform_display_init(void) {
         .speed_mode = LEDC_LOW_SPEED_MODE,
         .channel = LEDC_CHANNEL_0,
         .timer_sel = LEDC_TIMER_0,
+#if CONFIG_RK_PANEL_BRIGHTNESS
+        .duty = 255,
+#else
         .duty = CONFIG_RK_BACKLIGHT_NORMAL,  // Normal brightness from Kconfig
+#endif
         .hpoint = 0
     };
     ESP_ERROR_CHECK(ledc_channel_config(&ledc_channel));
@@ -514,6 +721,11 @@ bool platform_display_init(void) {
     ESP_ERROR_CHECK(esp_lcd_new_panel_sh8601(s_io_handle, &panel_config, &s_panel_handle));
     ESP_ERROR_CHECK(esp_lcd_panel_reset(s_panel_handle));
     ESP_ERROR_CHECK(esp_lcd_panel_init(s_panel_handle));
+#if CONFIG_RK_PANEL_BRIGHTNESS
+    ESP_ERROR_CHECK(panel_tx_param(LCD_CMD_WRCTRLD, (uint8_t[]){LCD_CTRLD_BCTRL}, 1));
+    platform_display_set_panel_brightness(CONFIG_RK_BACKLIGHT_NORMAL);
+#endif
+    panel_power_init(&s_panel_power, LCD_H_RES, LCD_V_RES);
 
     // Initialize I2C bus and touch controller
     ESP_LOGI(TAG, "Initializing I2C bus");
@@ -543,6 +755,12 @@ bool platform_display_register_lvgl_driver(void) {
         return false;
     }
 
+#if CONFIG_RK_PSRAM_FRAMEBUFFER
+    // Full framebuffer in PSRAM; rotation happens in the bounce copy
+    if (!alloc_framebuffer()) {
+        return false;
+    }
+#else
     // Allocate and clear draw buffers in internal RAM (required for SPI DMA)
     // Note: PSRAM cannot be used with SPI LCD DMA transfers
     size_t buf_size = LCD_H_RES * LVGL_BUF_HEIGHT * sizeof(lv_color_t);
@@ -552,23 +770,19 @@ bool platform_display_register_lvgl_driver(void) {
         ESP_LOGE(TAG, "Failed to allocate LVGL draw buffers");
         return false;
     }
+    s_draw_buf_internal = 2 * buf_size;
     ESP_LOGI(TAG, "Allocated %zu bytes for each draw buffer", buf_size);
 
     lv_display_set_buffers(s_display, buf1, buf2, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
     lv_display_set_flush_cb(s_display, lvgl_flush_cb);
+#endif
     lv_display_set_user_data(s_display, s_panel_handle);
-
-    // Allocate rotation buffer in PSRAM (internal RAM is too limited)
-    // We'll copy back to the DMA-capable px_map buffer before sending to LCD
-    s_rotate_buf = heap_caps_malloc(ROTATE_BUF_SIZE, MALLOC_CAP_SPIRAM);
-    if (!s_rotate_buf) {
-        ESP_LOGW(TAG, "Failed to allocate rotation buffer - rotation disabled");
-    } else {
-        ESP_LOGI(TAG, "Allocated %d bytes for rotation buffer in PSRAM", ROTATE_BUF_SIZE);
-    }
+    hold_stats_init(&s_render_stats);
 
     // Register rounder callback for 2-pixel alignment requirement
     lv_display_add_event_cb(s_display, lvgl_rounder_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    lv_display_add_event_cb(s_display, lvgl_render_event_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(s_display, lvgl_render_event_cb, LV_EVENT_RENDER_READY, NULL);
 
     // Register touch input device
     ESP_LOGI(TAG, "Registering LVGL touch input device");
@@ -601,6 +815,8 @@ bool platform_display_register_lvgl_driver(void) {
     // Note: LVGL timer_handler will be called by ui_loop_iter()
     // No separate LVGL task needed since ui_loop handles it
 
+    refresh_gov_init(&s_refresh_gov, esp_timer_get_time() / 1000);
+
     s_lvgl_ready = true;
     ESP_LOGI(TAG, "LVGL display driver and touch input registered successfully");
     return true;
@@ -610,6 +826,172 @@ bool platform_display_is_ready(void) {
     return s_hardware_ready && s_lvgl_ready;
 }
 
+uint32_t platform_display_get_frame_count(void) {
+    return s_frame_count;
+}
+
+void platform_display_note_input(void) {
+    s_refresh_input = true;
+}
+
+void platform_display_govern_refresh(void) {
+#if CONFIG_RK_REFRESH_GOVERNOR
+    if (!s_lvgl_ready) {
+        return;
+    }
+    uint64_t now_ms = esp_timer_get_time() / 1000;
+    if (s_refresh_input) {
+        s_refresh_input = false;
+        refresh_gov_note_input(&s_refresh_gov, now_ms);
+    }
+    bool animating = lv_anim_count_running() > 0 || ui_artwork_crossfade_active();
+    uint32_t period = refresh_gov_update(&s_refresh_gov, now_ms, animating);
+    if (period != s_refresh_period_ms) {
+        // The timer keeps its last run time, so a shorter period fires right away
+        lv_timer_t *refr = lv_display_get_refr_timer(s_display);
+        if (refr) {
+            lv_timer_set_period(refr, period);
+        }
+        s_refresh_period_ms = period;
+    }
+#endif
+}
+
+void platform_display_log_render_stats(void) {
+    hold_stats_t snap = s_render_stats;
+    hold_stats_reset_window(&s_render_stats);
+    uint32_t flushes = s_flush_count;
+    s_flush_count = 0;
+
+    uint32_t avg_us = snap.count ? (uint32_t)(snap.window_total_us / snap.count) : 0;
+    uint32_t flushes10 = snap.count ? flushes * 10 / snap.count : 0;
+#if CONFIG_RK_PSRAM_FRAMEBUFFER
+    const char *mode = "framebuffer";
+#else
+    const char *mode = "partial";
+#endif
+    ESP_LOGI(TAG, "render: %lu frames, avg %lu us, max %lu us, %lu.%lu transfers/frame (%s, %zu bytes internal)",
+             (unsigned long)snap.count, (unsigned long)avg_us, (unsigned long)snap.max_us,
+             (unsigned long)(flushes10 / 10), (unsigned long)(flushes10 % 10), mode, s_draw_buf_internal);
+}
+
+void platform_display_log_refresh_stats(void) {
+#if CONFIG_RK_REFRESH_GOVERNOR
+    static const char *const names[REFRESH_LEVELS] = {"idle", "active", "fast"};
+    uint32_t frames[REFRESH_LEVELS];
+    uint64_t time_ms[REFRESH_LEVELS];
+    uint32_t switches;
+    refresh_gov_take_stats(&s_refresh_gov, esp_timer_get_time() / 1000, frames, time_ms, &switches);
+
+    // Per level: frames per second while at that level, and time spent there
+    char detail[128];
+    int off = 0;
+    for (int i = REFRESH_LEVELS - 1; i >= 0 && off < (int)sizeof(detail); i--) {
+        uint32_t fps10 = time_ms[i] ? (uint32_t)((uint64_t)frames[i] * 10000 / time_ms[i]) : 0;
+        off += snprintf(detail + off, sizeof(detail) - off, "%s%s %lu.%lu fps/%lu.%lus", off ? ", " : "", names[i],
+                        (unsigned long)(fps10 / 10), (unsigned long)(fps10 % 10),
+                        (unsigned long)(time_ms[i] / 1000), (unsigned long)(time_ms[i] / 100 % 10));
+    }
+    ESP_LOGI(TAG, "refresh: %s, %lu switches", detail, (unsigned long)switches);
+#endif
+}
+
+void platform_display_perf_reset(void) {
+#if CONFIG_RK_TEST_API
+    portENTER_CRITICAL(&s_perf_mux);
+    hold_stats_reset_window(&s_perf_render);
+    s_perf_input_us = 0;
+    s_perf_latency_count = 0;
+    s_perf_latency_total_us = 0;
+    s_perf_latency_max_us = 0;
+    portEXIT_CRITICAL(&s_perf_mux);
+#endif
+}
+
+void platform_display_perf_get(platform_display_perf_t *out) {
+    memset(out, 0, sizeof(*out));
+#if CONFIG_RK_TEST_API
+    portENTER_CRITICAL(&s_perf_mux);
+    out->frames = s_perf_render.count;
+    out->frame_avg_us = s_perf_render.count ? (uint32_t)(s_perf_render.window_total_us / s_perf_render.count) : 0;
+    out->frame_max_us = s_perf_render.max_us;
+    out->inputs = s_perf_latency_count;
+    out->latency_avg_us = s_perf_latency_count ? (uint32_t)(s_perf_latency_total_us / s_perf_latency_count) : 0;
+    out->latency_max_us = s_perf_latency_max_us;
+    portEXIT_CRITICAL(&s_perf_mux);
+#endif
+}
+
+void platform_display_perf_mark_input(void) {
+#if CONFIG_RK_TEST_API
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_perf_mux);
+    if (!s_perf_input_us) {
+        s_perf_input_us = now;  // Latency runs from the first input a frame hasn't shown yet
+    }
+    portEXIT_CRITICAL(&s_perf_mux);
+#endif
+}
+
+void platform_display_inject_touch(bool pressed, int16_t x, int16_t y) {
+#if CONFIG_RK_TEST_API
+    // Scenarios use screen coordinates; the controller reports panel coordinates
+    if (s_current_rotation == 180) {
+        x = LCD_H_RES - 1 - x;
+        y = LCD_V_RES - 1 - y;
+    }
+    if (pressed && !s_inject_pressed) {
+        platform_display_perf_mark_input();
+    }
+    s_inject_x = (uint16_t)x;
+    s_inject_y = (uint16_t)y;
+    s_inject_pressed = pressed;
+    s_inject_active = true;
+#else
+    (void)pressed;
+    (void)x;
+    (void)y;
+#endif
+}
+
+void platform_display_inject_end(void) {
+#if CONFIG_RK_TEST_API
+    s_inject_pressed = false;
+    s_inject_active = false;
+#endif
+}
+
+void platform_display_set_panel_brightness(uint8_t level) {
+    if (s_io_handle == NULL) {
+        return;
+    }
+    esp_err_t err = panel_tx_param(LCD_CMD_WRDISBV, &level, 1);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Panel brightness %u failed: %s", level, esp_err_to_name(err));
+    }
+}
+
+void platform_display_set_idle_mode(bool idle) {
+    if (s_io_handle == NULL) {
+        return;
+    }
+    esp_err_t err = panel_tx_param(idle ? LCD_CMD_IDMON : LCD_CMD_IDMOFF, NULL, 0);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Panel idle mode %s failed: %s", idle ? "on" : "off", esp_err_to_name(err));
+    }
+}
+
+uint8_t platform_display_get_apl(void) {
+    return panel_power_apl(&s_panel_power);
+}
+
+uint8_t platform_display_get_panel_load(void) {
+    if (display_is_sleeping()) {
+        return 0;
+    }
+    return panel_power_load_pct(&s_panel_power, display_get_brightness());
+}
+
 void platform_display_init_sleep(TaskHandle_t lvgl_task_handle) {
     if (s_panel_handle == NULL) {
         ESP_LOGW(TAG, "Cannot init display sleep - panel not initialized");
@@ -636,6 +1018,25 @@ void platform_display_process_pending(void) {
             display_wake();  // Returns to normal state with controls visible
         }
     }
+    // Process deferred horizontal swipes (browse / queue screens)
+    bool can_open_list = display_get_state() == DISPLAY_STATE_NORMAL && !ui_is_zone_picker_visible() &&
+                         bridge_client_is_ready_for_art_mode();
+    if (s_pending_swipe_left) {
+        s_pending_swipe_left = false;
+        if (ui_browse_is_visible()) {
+            ui_browse_back();  // Up one level; closes at the root
+        } else if (!ui_queue_is_visible() && can_open_list) {
+            ui_queue_show();
+        }
+    }
+    if (s_pending_swipe_right) {
+        s_pending_swipe_right = false;
+        if (ui_queue_is_visible()) {
+            ui_queue_hide();
+        } else if (!ui_browse_is_visible() && can_open_list) {
+            ui_browse_show();
+        }
+    }
     // Process deferred timer-triggered state changes
     display_process_pending();
 }
@@ -17,6 +17,60 @@ bool platform_display_register_lvgl_driver(void);
 // Check if display is ready for UI operations
 bool platform_display_is_ready(void);
 
+// Number of frames flushed to the panel since boot (wraps at UINT32_MAX)
+uint32_t platform_display_get_frame_count(void);
+
+// Encoder or touch input: the refresh governor goes fast. Safe from any task.
+void platform_display_note_input(void);
+
+// Pick LVGL's refresh period for what is happening now (call from the UI loop,
+// before ui_loop_iter)
+void platform_display_govern_refresh(void);
+
+// Log render time per frame, panel transfers per frame and draw buffer memory since
+// the previous call
+void platform_display_log_render_stats(void);
+
+// Log frames per second and time at each refresh level since the previous call
+void platform_display_log_refresh_stats(void);
+
+// Measurements for scripted runs (test API); all zero unless CONFIG_RK_TEST_API
+typedef struct {
+    uint32_t frames;          // Refreshes rendered
+    uint32_t frame_avg_us;    // RENDER_START to RENDER_READY
+    uint32_t frame_max_us;
+    uint32_t inputs;          // Injected inputs that reached the screen
+    uint32_t latency_avg_us;  // Injected input to the end of the next frame
+    uint32_t latency_max_us;
+} platform_display_perf_t;
+
+// Start a new measurement window
+void platform_display_perf_reset(void);
+
+// Measurements since the last reset
+void platform_display_perf_get(platform_display_perf_t *out);
+
+// Start an input-latency sample (injected encoder detents)
+void platform_display_perf_mark_input(void);
+
+// Replace the touch controller with a scripted touch at screen coordinates until
+// platform_display_inject_end(). Goes through the same read callback, so wake
+// suppression, swipes and double-taps behave as for a finger.
+void platform_display_inject_touch(bool pressed, int16_t x, int16_t y);
+void platform_display_inject_end(void);
+
+// Set the SH8601 brightness register (DCS 0x51), 0-255
+void platform_display_set_panel_brightness(uint8_t level);
+
+// Enter or leave SH8601 idle mode (DCS 0x39/0x38): 8 colours, lower driver power
+void platform_display_set_idle_mode(bool idle);
+
+// Average picture level of what is on screen, 0-255 (see panel_power.h)
+uint8_t platform_display_get_apl(void);
+
+// Panel load relative to full white at full brightness, in percent (0 while asleep)
+uint8_t platform_display_get_panel_load(void);
+
 // Initialize display sleep management (auto-dim and sleep after inactivity)
 // Must be called after UI task is created
 // @param lvgl_task_handle Handle to LVGL/UI task for priority control
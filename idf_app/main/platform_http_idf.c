@@ -1,10 +1,21 @@
 #include "platform/platform_http.h"
+#include "platform/platform_mdns.h"
+#include "platform/platform_memcpy.h"
+#include "pm_locks.h"
+#include "resolver_cache.h"
 
 #include <esp_http_client.h>
 #include <esp_log.h>
 #include <esp_mac.h>
 #include <esp_app_desc.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <lwip/netdb.h>
+#include <lwip/sockets.h>
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -30,26 +41,369 @@ static const char* get_knob_version(void) {
     return app_desc->version;
 }
 
-static int http_perform(const char *url, const char *body, const char *content_type, char **out, size_t *out_len) {
-    ESP_LOGD(TAG, "HTTP %s: %s", body ? "POST" : "GET", url);
+// ============================================================================
+// Host resolution
+// ============================================================================
+// Requests go to a cached address instead of resolving the bridge host every time. A
+// background task re-resolves it before the TTL runs out, so a bridge that changes IP
+// (DHCP) is followed, and the last known address keeps serving while DNS/mDNS fails.
+// .local names go through mDNS, which lwIP's resolver doesn't handle.
+
+#define RESOLVER_DNS_TTL_MS (300 * 1000)      // lwIP doesn't expose the record TTL
+#define RESOLVER_MIN_TTL_MS (10 * 1000)
+#define RESOLVER_TASK_PERIOD_MS 5000
+#define RESOLVER_TASK_STACK 3584
+
+static resolver_cache_t s_resolver;
+static portMUX_TYPE s_resolver_mux = portMUX_INITIALIZER_UNLOCKED;
+static bool s_resolver_task_started;
+
+static uint64_t now_ms(void) {
+    return (uint64_t)(esp_timer_get_time() / 1000);
+}
 
-    // Use native request pattern (more reliable than perform() with event handler)
+static bool resolve_host(const char *host, char *ip, size_t len, uint32_t *ttl_ms) {
+    size_t n = strlen(host);
+    if (n > 6 && strcmp(host + n - 6, ".local") == 0) {
+        uint32_t ttl_s = 0;
+        if (!platform_mdns_resolve_local_ttl(host, ip, len, &ttl_s)) {
+            return false;
+        }
+        *ttl_ms = ttl_s * 1000 > RESOLVER_MIN_TTL_MS ? ttl_s * 1000 : RESOLVER_MIN_TTL_MS;
+        return true;
+    }
+
+    struct addrinfo hints = {
+        .ai_family = AF_INET,
+        .ai_socktype = SOCK_STREAM,
+    };
+    struct addrinfo *res = NULL;
+    if (getaddrinfo(host, NULL, &hints, &res) != 0 || !res) {
+        if (res) {
+            freeaddrinfo(res);
+        }
+        return false;
+    }
+    inet_ntoa_r(((struct sockaddr_in *)res->ai_addr)->sin_addr, ip, len);
+    freeaddrinfo(res);
+    *ttl_ms = RESOLVER_DNS_TTL_MS;
+    return true;
+}
+
+// Resolve outside the lock (it blocks for up to the mDNS query timeout), then record it
+static bool resolve_and_store(const char *host, char *ip, size_t len) {
+    uint32_t ttl_ms = 0;
+    bool ok = resolve_host(host, ip, len, &ttl_ms);
+    taskENTER_CRITICAL(&s_resolver_mux);
+    bool moved = resolver_cache_store(&s_resolver, host, ok ? ip : NULL, ttl_ms, now_ms());
+    taskEXIT_CRITICAL(&s_resolver_mux);
+    if (moved) {
+        ESP_LOGI(TAG, "%s moved to %s", host, ip);
+    } else if (!ok) {
+        ESP_LOGW(TAG, "Resolving %s failed; keeping last known address", host);
+    }
+    return ok;
+}
+
+static void resolver_refresh_task(void *arg) {
+    (void)arg;
+    char host[RESOLVER_HOST_LEN];
+    char ip[RESOLVER_IP_LEN];
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(RESOLVER_TASK_PERIOD_MS));
+        // A refresh is never due again right after its attempt, so this terminates
+        while (true) {
+            taskENTER_CRITICAL(&s_resolver_mux);
+            bool due = resolver_cache_next_refresh(&s_resolver, now_ms(), host, sizeof(host));
+            taskEXIT_CRITICAL(&s_resolver_mux);
+            if (!due) {
+                break;
+            }
+            resolve_and_store(host, ip, sizeof(ip));
+        }
+    }
+}
+
+// Rewrite url to the cached address of its host. Returns false (use url as is) for IP
+// literals, or when the host has never resolved so esp_http_client can report the error.
+static bool resolve_url(const char *url, char *out, size_t len, char *host, size_t host_len) {
+    if (!resolver_url_host(url, host, host_len) || resolver_is_ip_literal(host)) {
+        return false;
+    }
+    char ip[RESOLVER_IP_LEN];
+    taskENTER_CRITICAL(&s_resolver_mux);
+    resolver_lookup_t found = resolver_cache_lookup(&s_resolver, host, ip, sizeof(ip), now_ms());
+    bool start_task = !s_resolver_task_started;
+    s_resolver_task_started = true;
+    taskEXIT_CRITICAL(&s_resolver_mux);
+
+    if (start_task) {
+        xTaskCreate(resolver_refresh_task, "resolver", RESOLVER_TASK_STACK, NULL, 2, NULL);
+    }
+    if (found != RESOLVER_HIT) {
+        char fresh[RESOLVER_IP_LEN];
+        if (resolve_and_store(host, fresh, sizeof(fresh))) {
+            memcpy(ip, fresh, sizeof(ip));
+        } else if (found == RESOLVER_MISS) {
+            return false;
+        }
+    }
+    return resolver_rewrite_url(url, ip, out, len);
+}
+
+// host[:port] of url, for the Host header
+static void url_authority(const char *url, char *out, size_t len) {
+    const char *host = strstr(url, "://");
+    host = host ? host + 3 : url;
+    size_t n = strcspn(host, "/?#");
+    if (n >= len) n = len - 1;
+    memcpy(out, host, n);
+    out[n] = '\0';
+}
+
+// ============================================================================
+// Connection reuse
+// ============================================================================
+// Requests go to one bridge, so a couple of kept-alive clients cover the poll thread and
+// the UI thread's control POSTs. Each slot keeps its connection open between requests and,
+// for https, its TLS session (save_client_session), so a reconnect after the server drops
+// an idle connection resumes instead of doing a full handshake.
+
+#define HTTP_POOL_SLOTS 2
+#define HTTP_STATS_EVERY 100
+
+typedef struct {
+    esp_http_client_handle_t client;
+    char origin[96];        // scheme://host:port the connection belongs to
+    char tls_host[RESOLVER_HOST_LEN];  // SNI/CN name; the client keeps a pointer to this
+    bool busy;
+    bool pooled;            // false: one-shot client, cleaned up after the request
+    bool connected_now;     // HTTP_EVENT_ON_CONNECTED fired during the current open
+    bool kept_open;         // Previous request left the connection open for reuse
+} http_conn_t;
+
+static http_conn_t s_pool[HTTP_POOL_SLOTS];
+static portMUX_TYPE s_pool_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Diagnostics only; updated without a lock from the poll and UI threads
+static struct {
+    uint32_t requests;
+    uint32_t connects;      // New TCP (and TLS) connections
+    uint32_t tls_connects;
+    uint32_t reused;        // Requests served on an already-open connection
+    uint32_t retries;       // Reused connection was stale; reconnected
+    uint32_t connect_ms_sum;
+    uint32_t tls_connect_ms_sum;
+} s_http_stats;
+
+static esp_err_t http_event_handler(esp_http_client_event_t *evt) {
+    http_conn_t *conn = evt->user_data;
+    if (conn && evt->event_id == HTTP_EVENT_ON_CONNECTED) {
+        conn->connected_now = true;
+    }
+    return ESP_OK;
+}
+
+static void url_origin(const char *url, char *out, size_t len) {
+    const char *host = strstr(url, "://");
+    host = host ? host + 3 : url;
+    size_t n = (size_t)(host - url) + strcspn(host, "/?#");
+    if (n >= len) n = len - 1;
+    memcpy(out, url, n);
+    out[n] = '\0';
+}
+
+// tls_host: original hostname when url was rewritten to an address (SNI and certificate CN)
+static http_conn_t *http_acquire(const char *url, esp_http_client_method_t method, int timeout_ms,
+                                 const char *tls_host) {
+    char origin[sizeof(s_pool[0].origin)];
+    url_origin(url, origin, sizeof(origin));
+    if (!tls_host) {
+        tls_host = "";
+    }
+
+    // Prefer an idle slot already connected to this origin under the same name, else
+    // recycle any idle slot
+    http_conn_t *conn = NULL;
+    http_conn_t *stale = NULL;
+    taskENTER_CRITICAL(&s_pool_mux);
+    for (int i = 0; i < HTTP_POOL_SLOTS && !conn; i++) {
+        if (!s_pool[i].busy && s_pool[i].client && strcmp(s_pool[i].origin, origin) == 0 &&
+            strcmp(s_pool[i].tls_host, tls_host) == 0) {
+            conn = &s_pool[i];
+        }
+    }
+    for (int i = 0; i < HTTP_POOL_SLOTS && !conn; i++) {
+        if (!s_pool[i].busy) {
+            conn = &s_pool[i];
+            stale = conn->client ? conn : NULL;
+        }
+    }
+    if (conn) {
+        conn->busy = true;
+    }
+    taskEXIT_CRITICAL(&s_pool_mux);
+
+    if (stale) {
+        esp_http_client_cleanup(stale->client);  // Different origin or host (bridge moved)
+        stale->client = NULL;
+        stale->kept_open = false;
+    }
+    if (!conn) {
+        conn = calloc(1, sizeof(*conn));  // Pool exhausted: one-shot client
+        if (!conn) {
+            return NULL;
+        }
+    } else {
+        conn->pooled = true;
+    }
+
+    if (conn->client) {
+        esp_http_client_set_url(conn->client, url);
+        esp_http_client_set_method(conn->client, method);
+        esp_http_client_set_timeout_ms(conn->client, timeout_ms);
+        return conn;
+    }
+
+    strncpy(conn->tls_host, tls_host, sizeof(conn->tls_host) - 1);
+    conn->tls_host[sizeof(conn->tls_host) - 1] = '\0';
     esp_http_client_config_t config = {
         .url = url,
-        .method = body ? HTTP_METHOD_POST : HTTP_METHOD_GET,
-        .timeout_ms = 3000,
+        .method = method,
+        .timeout_ms = timeout_ms,
+        .event_handler = http_event_handler,
+        .user_data = conn,
+        .common_name = conn->tls_host[0] ? conn->tls_host : NULL,
+#if CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
+        .save_client_session = true,
+#endif
     };
-
-    esp_http_client_handle_t client = esp_http_client_init(&config);
-    if (!client) {
+    conn->client = esp_http_client_init(&config);
+    strncpy(conn->origin, origin, sizeof(conn->origin) - 1);
+    if (!conn->client) {
         ESP_LOGE(TAG, "Failed to init HTTP client");
+        conn->busy = false;
+        if (!conn->pooled) {
+            free(conn);
+        }
+        return NULL;
+    }
+    return conn;
+}
+
+// keep=false after errors or partial reads: the connection can't carry another request
+static void http_release(http_conn_t *conn, bool keep) {
+    if (!conn->pooled) {
+        esp_http_client_close(conn->client);
+        esp_http_client_cleanup(conn->client);
+        free(conn);
+        return;
+    }
+    conn->kept_open = keep && esp_http_client_is_complete_data_received(conn->client);
+    if (!conn->kept_open) {
+        esp_http_client_close(conn->client);
+    }
+    taskENTER_CRITICAL(&s_pool_mux);
+    conn->busy = false;
+    taskEXIT_CRITICAL(&s_pool_mux);
+}
+
+static void http_log_stats(void) {
+    uint32_t plain = s_http_stats.connects - s_http_stats.tls_connects;
+    ESP_LOGI(TAG, "HTTP: %lu requests, %lu reused, %lu retried; connects: %lu plain (avg %lu ms), %lu TLS (avg %lu ms)",
+             (unsigned long)s_http_stats.requests, (unsigned long)s_http_stats.reused,
+             (unsigned long)s_http_stats.retries, (unsigned long)plain,
+             (unsigned long)(plain ? (s_http_stats.connect_ms_sum - s_http_stats.tls_connect_ms_sum) / plain : 0),
+             (unsigned long)s_http_stats.tls_connects,
+             (unsigned long)(s_http_stats.tls_connects ? s_http_stats.tls_connect_ms_sum / s_http_stats.tls_connects : 0));
+}
+
+// Open (reusing the kept-alive connection when there is one), send the body and fetch
+// headers. A reused connection the server has already closed fails here; retry once on
+// a fresh connection. Returns content length, or -1.
+static int http_start(http_conn_t *conn, const char *body) {
+    int body_len = body ? (int)strlen(body) : 0;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        // Only a connection left open by the previous request can be stale; a failed
+        // fresh connect is a real failure and is not retried
+        bool was_open = conn->kept_open;
+        conn->kept_open = false;
+        conn->connected_now = false;
+        // A TLS handshake is the CPU-heavy part of a request; a reused connection
+        // returns at once
+        bool tls = strncmp(conn->origin, "https", 5) == 0;
+        if (tls) {
+            pm_work_begin(PM_WORK_NETWORK);
+        }
+        int64_t start_us = esp_timer_get_time();
+        esp_err_t err = esp_http_client_open(conn->client, body_len);
+        uint32_t open_ms = (uint32_t)((esp_timer_get_time() - start_us) / 1000);
+        if (tls) {
+            pm_work_end(PM_WORK_NETWORK);
+        }
+        bool reused = was_open && !conn->connected_now;
+        if (conn->connected_now) {
+            s_http_stats.connects++;
+            s_http_stats.connect_ms_sum += open_ms;
+            if (tls) {
+                s_http_stats.tls_connects++;
+                s_http_stats.tls_connect_ms_sum += open_ms;
+            }
+        }
+
+        int content_length = -1;
+        bool body_sent = false;
+        if (err == ESP_OK && body) {
+            body_sent = esp_http_client_write(conn->client, body, body_len) >= 0;
+        }
+        if (err == ESP_OK && (!body || body_sent)) {
+            content_length = esp_http_client_fetch_headers(conn->client);
+        }
+        if (content_length >= 0) {
+            if (reused) {
+                s_http_stats.reused++;
+            }
+            if (++s_http_stats.requests % HTTP_STATS_EVERY == 0) {
+                http_log_stats();
+            }
+            return content_length;
+        }
+        esp_http_client_close(conn->client);
+        // A POST whose body went out may have been acted on before the socket dropped
+        // (/control play_pause, next, volume steps): never send it twice
+        if (!reused || body_sent) {
+            ESP_LOGE(TAG, "HTTP request failed: %s", esp_err_to_name(err));
+            return -1;
+        }
+        s_http_stats.retries++;  // Stale kept-alive connection
+    }
+    return -1;
+}
+
+static int http_perform(const char *url, const char *body, const char *content_type, char **out, size_t *out_len) {
+    ESP_LOGD(TAG, "HTTP %s: %s", body ? "POST" : "GET", url);
+
+    // Use native request pattern (more reliable than perform() with event handler)
+    char resolved[400];
+    char host[RESOLVER_HOST_LEN];
+    bool rewritten = resolve_url(url, resolved, sizeof(resolved), host, sizeof(host));
+    http_conn_t *conn = http_acquire(rewritten ? resolved : url, body ? HTTP_METHOD_POST : HTTP_METHOD_GET, 3000,
+                                     rewritten ? host : NULL);
+    if (!conn) {
         return -1;
     }
+    esp_http_client_handle_t client = conn->client;
 
-    // Set headers
+    // Set headers (pooled clients keep headers from the previous request)
+    char authority[96];
+    url_authority(url, authority, sizeof(authority));
+    esp_http_client_set_header(client, "Host", authority);
     esp_http_client_set_header(client, "Accept", "application/json");
+    esp_http_client_delete_header(client, "Accept-Encoding");
     if (body) {
         esp_http_client_set_header(client, "Content-Type", content_type ? content_type : "application/json");
+    } else {
+        esp_http_client_delete_header(client, "Content-Type");
     }
 
     // Set knob identification headers
@@ -58,31 +412,10 @@ static int http_perform(const char *url, const char *body, const char *content_t
     esp_http_client_set_header(client, "X-Knob-Id", knob_id);
     esp_http_client_set_header(client, "X-Knob-Version", get_knob_version());
 
-    // Open connection
-    esp_err_t err = esp_http_client_open(client, body ? strlen(body) : 0);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to open connection: %s", esp_err_to_name(err));
-        esp_http_client_cleanup(client);
-        return -1;
-    }
-
-    // Write POST body if present
-    if (body) {
-        int wlen = esp_http_client_write(client, body, strlen(body));
-        if (wlen < 0) {
-            ESP_LOGE(TAG, "Write failed");
-            esp_http_client_close(client);
-            esp_http_client_cleanup(client);
-            return -1;
-        }
-    }
-
-    // Fetch headers to get content length
-    int content_length = esp_http_client_fetch_headers(client);
+    // Open (or reuse) the connection, write the body and fetch headers
+    int content_length = http_start(conn, body);
     if (content_length < 0) {
-        ESP_LOGE(TAG, "HTTP fetch headers failed");
-        esp_http_client_close(client);
-        esp_http_client_cleanup(client);
+        http_release(conn, false);
         return -1;
     }
 
@@ -93,8 +426,7 @@ static int http_perform(const char *url, const char *body, const char *content_t
     char *buffer = calloc(1, content_length + 1);
     if (!buffer) {
         ESP_LOGE(TAG, "Failed to allocate response buffer");
-        esp_http_client_close(client);
-        esp_http_client_cleanup(client);
+        http_release(conn, false);
         return -1;
     }
 
@@ -103,8 +435,7 @@ static int http_perform(const char *url, const char *body, const char *content_t
     if (data_read < 0) {
         ESP_LOGE(TAG, "Failed to read response");
         free(buffer);
-        esp_http_client_close(client);
-        esp_http_client_cleanup(client);
+        http_release(conn, false);
         return -1;
     }
 
@@ -114,8 +445,7 @@ static int http_perform(const char *url, const char *body, const char *content_t
         *out_len = data_read;
     }
 
-    esp_http_client_close(client);
-    esp_http_client_cleanup(client);
+    http_release(conn, true);
     return 0;
 }
 
@@ -127,6 +457,16 @@ int platform_http_post_json(const char *url, const char *json, char **out, size_
     return http_perform(url, json, "application/json", out, out_len);
 }
 
+bool platform_http_resolve_url(const char *url, char *out, size_t len) {
+    char host[RESOLVER_HOST_LEN];
+    if (resolve_url(url, out, len, host, sizeof(host))) {
+        return true;
+    }
+    strncpy(out, url, len - 1);
+    out[len - 1] = '\0';
+    return false;
+}
+
 void platform_http_free(char *p) {
     free(p);
 }
@@ -174,8 +514,12 @@ static size_t decompress_gzip(char **data, size_t compressed_size) {
                                   (gzip_data[compressed_size - 2] << 16) |
                                   (gzip_data[compressed_size - 1] << 24);
 
-    // Allocate decompression buffer
-    char *decompressed = calloc(1, uncompressed_size);
+    // Allocate decompression buffer, aligned so artwork can be DMA-copied out of it
+    char *decompressed = heap_caps_aligned_calloc(PLATFORM_MEMCPY_ALIGN, 1, uncompressed_size,
+                                                  MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!decompressed) {
+        decompressed = calloc(1, uncompressed_size);
+    }
     if (!decompressed) {
         ESP_LOGE(TAG, "Failed to allocate decompression buffer (%" PRIu32 " bytes)", uncompressed_size);
         return 0;
@@ -223,28 +567,35 @@ static size_t decompress_gzip(char **data, size_t compressed_size) {
 }
 
 int platform_http_get_image(const char *url, char **out, size_t *out_len) {
-    esp_http_client_config_t config = {.url = url, .method = HTTP_METHOD_GET, .timeout_ms = 5000};
-    esp_http_client_handle_t client = esp_http_client_init(&config);
-    if (!client) return -1;
-
+    char resolved[400];
+    char host[RESOLVER_HOST_LEN];
+    bool rewritten = resolve_url(url, resolved, sizeof(resolved), host, sizeof(host));
+    http_conn_t *conn = http_acquire(rewritten ? resolved : url, HTTP_METHOD_GET, 5000, rewritten ? host : NULL);
+    if (!conn) return -1;
+    esp_http_client_handle_t client = conn->client;
+
+    char authority[96];
+    url_authority(url, authority, sizeof(authority));
+    esp_http_client_set_header(client, "Host", authority);
+
+    esp_http_client_delete_header(client, "Accept");
+    esp_http_client_delete_header(client, "Content-Type");
     esp_http_client_set_header(client, "Accept-Encoding", "gzip");
     char knob_id[16];
     get_knob_id(knob_id, sizeof(knob_id));
     esp_http_client_set_header(client, "X-Knob-Id", knob_id);
     esp_http_client_set_header(client, "X-Knob-Version", get_knob_version());
 
-    if (esp_http_client_open(client, 0) != ESP_OK) {
-        esp_http_client_cleanup(client);
+    int content_length = http_start(conn, NULL);
+    if (content_length < 0) {
+        http_release(conn, false);
         return -1;
     }
-
-    int content_length = esp_http_client_fetch_headers(client);
     int status_code = esp_http_client_get_status_code(client);
 
     if (status_code != 200) {
         ESP_LOGE(TAG, "HTTP request failed: status=%d", status_code);
-        esp_http_client_close(client);
-        esp_http_client_cleanup(client);
+        http_release(conn, false);
         return -1;
     }
 
@@ -258,8 +609,7 @@ int platform_http_get_image(const char *url, char **out, size_t *out_len) {
     char *buffer = malloc(buffer_size);
     if (!buffer) {
         ESP_LOGE(TAG, "Failed to allocate initial buffer");
-        esp_http_client_close(client);
-        esp_http_client_cleanup(client);
+        http_release(conn, false);
         return -1;
     }
 
@@ -274,16 +624,14 @@ int platform_http_get_image(const char *url, char **out, size_t *out_len) {
             if (buffer_size > 1024 * 1024) {  // Safety: max 1MB
                 ESP_LOGE(TAG, "Response too large (>1MB)");
                 free(buffer);
-                esp_http_client_close(client);
-                esp_http_client_cleanup(client);
+                http_release(conn, false);
                 return -1;
             }
             char *new_buffer = realloc(buffer, buffer_size);
             if (!new_buffer) {
                 ESP_LOGE(TAG, "Failed to realloc buffer to %zu", buffer_size);
                 free(buffer);
-                esp_http_client_close(client);
-                esp_http_client_cleanup(client);
+                http_release(conn, false);
                 return -1;
             }
             buffer = new_buffer;
@@ -295,8 +643,7 @@ int platform_http_get_image(const char *url, char **out, size_t *out_len) {
         if (read_len < 0) {
             ESP_LOGE(TAG, "Failed to read chunk (attempt %d)", read_attempts);
             free(buffer);
-            esp_http_client_close(client);
-            esp_http_client_cleanup(client);
+            http_release(conn, false);
             return -1;
         }
         if (read_len == 0) {
@@ -305,8 +652,7 @@ int platform_http_get_image(const char *url, char **out, size_t *out_len) {
         total_read += read_len;
     }
 
-    esp_http_client_close(client);
-    esp_http_client_cleanup(client);
+    http_release(conn, true);  // Kept open only if the whole body was read
 
     if (total_read <= 0) {
         ESP_LOGE(TAG, "No data read from response");
@@ -322,7 +668,9 @@ int platform_http_get_image(const char *url, char **out, size_t *out_len) {
 
     size_t final_size = total_read;
     if (is_gzipped) {
+        pm_work_begin(PM_WORK_ARTWORK);
         final_size = decompress_gzip(&buffer, total_read);
+        pm_work_end(PM_WORK_ARTWORK);
         if (final_size == 0) {
             ESP_LOGE(TAG, "Gzip decompression failed");
             free(buffer);
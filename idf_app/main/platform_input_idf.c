@@ -1,6 +1,15 @@
 #include "platform/platform_input.h"
+#include "bridge_client.h"
 #include "ui.h"
 #include "display_sleep.h"
+#include "encoder_decode.h"
+#include "sdkconfig.h"
+#if CONFIG_RK_ULP_ENCODER
+#include "encoder_ulp.h"
+#endif
+#include "haptics.h"
+#include "platform_display_idf.h"
+#include "platform_input_idf.h"
 
 #include "driver/gpio.h"
 #include "esp_log.h"
@@ -36,8 +45,8 @@ static QueueHandle_t s_input_queue = NULL;
 // Rotary Encoder Configuration
 // ============================================================================
 #define ENCODER_POLL_INTERVAL_MS 3      // Poll encoder every 3ms (matching hardware demo)
-#define ENCODER_DEBOUNCE_TICKS   2      // Debounce count
 #define ENCODER_BATCH_INTERVAL_MS 30    // Batch encoder ticks over 30ms window for velocity detection
+#define ENCODER_WAKE_APPLY_WINDOW_MS 20000  // Give up on wake detents if the bridge isn't back by then
 
 
 // ============================================================================
@@ -45,16 +54,15 @@ static QueueHandle_t s_input_queue = NULL;
 // ============================================================================
 static esp_timer_handle_t s_poll_timer = NULL;
 
-// Software encoder state
-typedef struct {
-    uint8_t debounce_a_cnt;
-    uint8_t debounce_b_cnt;
-    uint8_t encoder_a_level;
-    uint8_t encoder_b_level;
-    int count_value;
-} encoder_state_t;
+// Software encoder state (decoding shared with the deep sleep ULP program)
+static encoder_decode_t s_encoder;
 
-static encoder_state_t s_encoder = {0};
+#if CONFIG_RK_ULP_ENCODER
+// Detents turned during deep sleep and boot, held until volume is known (UI thread only)
+static bool s_wake_pending = false;
+static int s_wake_delta = 0;
+static int64_t s_wake_deadline_ms = 0;
+#endif
 
 // ============================================================================
 // Rotary Encoder Implementation (Software Quadrature Decoding)
@@ -84,56 +92,33 @@ static esp_err_t encoder_init(void) {
     ESP_ERROR_CHECK(gpio_config(&io_conf_b));
 
     // Initialize encoder state
-    s_encoder.encoder_a_level = gpio_get_level(ENCODER_GPIO_A);
-    s_encoder.encoder_b_level = gpio_get_level(ENCODER_GPIO_B);
-    s_encoder.count_value = 0;
+    encoder_decode_init(&s_encoder, gpio_get_level(ENCODER_GPIO_A), gpio_get_level(ENCODER_GPIO_B));
 
     ESP_LOGI(TAG, "Rotary encoder initialized successfully");
     return ESP_OK;
 }
 
-// Software quadrature decoder (based on vendor demo code)
-static void process_encoder_channel(uint8_t current_level, uint8_t *prev_level,
-                                    uint8_t *debounce_cnt, int *count_value,
-                                    bool is_increment) {
-    if (current_level == 0) {
-        if (current_level != *prev_level) {
-            *debounce_cnt = 0;
-        } else {
-            (*debounce_cnt)++;
-        }
-    } else {
-        if (current_level != *prev_level && ++(*debounce_cnt) >= ENCODER_DEBOUNCE_TICKS) {
-            *debounce_cnt = 0;
-            *count_value += is_increment ? 1 : -1;
-        } else {
-            *debounce_cnt = 0;
-        }
-    }
-    *prev_level = current_level;
+static void dispatch_detents(int delta) {
+    haptics_on_detents(delta);  // Click now, not when the UI loop gets to the queue
+
+    // Queue the delta - main loop will coalesce multiple deltas
+    // Note: esp_timer callbacks run in task context, not ISR, so use xQueueSend
+    (void)xQueueSend(s_input_queue, &delta, 0);
+    platform_display_note_input();  // Fast refresh for the arc while turning
+    display_kick_ui_loop();  // Don't wait out the frozen-loop delay in art mode
 }
 
 static void encoder_read_and_dispatch(void) {
     static int last_count = 0;
 
-    // Read current levels
-    uint8_t pha_value = gpio_get_level(ENCODER_GPIO_A);
-    uint8_t phb_value = gpio_get_level(ENCODER_GPIO_B);
-
-    // Process both channels (software quadrature decoding)
-    process_encoder_channel(pha_value, &s_encoder.encoder_a_level,
-                           &s_encoder.debounce_a_cnt, &s_encoder.count_value, true);
-    process_encoder_channel(phb_value, &s_encoder.encoder_b_level,
-                           &s_encoder.debounce_b_cnt, &s_encoder.count_value, false);
+    // Software quadrature decoding (based on vendor demo code)
+    encoder_decode_sample(&s_encoder, gpio_get_level(ENCODER_GPIO_A), gpio_get_level(ENCODER_GPIO_B));
 
     // Dispatch immediately on any change (coalescing happens in main loop)
-    int delta = s_encoder.count_value - last_count;
+    int delta = s_encoder.count - last_count;
     if (delta != 0) {
-        last_count = s_encoder.count_value;
-
-        // Queue the delta - main loop will coalesce multiple deltas
-        // Note: esp_timer callbacks run in task context, not ISR, so use xQueueSend
-        (void)xQueueSend(s_input_queue, &delta, 0);
+        last_count = s_encoder.count;
+        dispatch_detents(delta);
     }
 }
 
@@ -182,6 +167,12 @@ void platform_input_init(void) {
 
     esp_err_t err;
 
+#if CONFIG_RK_ULP_ENCODER
+    // Must run before encoder_init(): gpio_config() takes the pins away from the ULP
+    s_wake_pending = encoder_ulp_collect(&s_wake_delta);
+    s_wake_deadline_ms = esp_timer_get_time() / 1000 + ENCODER_WAKE_APPLY_WINDOW_MS;
+#endif
+
     err = encoder_init();
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to initialize encoder: %s", esp_err_to_name(err));
@@ -207,20 +198,53 @@ void platform_input_process_events(void) {
         total_ticks += ticks;
     }
 
+#if CONFIG_RK_ULP_ENCODER
+    if (s_wake_pending) {
+        // After deep sleep: the waking turn and everything since lands as one exact
+        // volume change once the bridge has reported the zone's volume
+        if (total_ticks != 0) {
+            display_activity_detected();
+            s_wake_delta += total_ticks;
+        }
+        if (bridge_client_handle_volume_steps(s_wake_delta)) {
+            ESP_LOGI(TAG, "Applied %d wake detents", s_wake_delta);
+            s_wake_pending = false;
+        } else if (esp_timer_get_time() / 1000 > s_wake_deadline_ms) {
+            ESP_LOGW(TAG, "Dropped %d wake detents (bridge not ready)", s_wake_delta);
+            s_wake_pending = false;
+        }
+        return;
+    }
+#endif
+
     if (total_ticks != 0) {
         display_activity_detected();  // Wake display and reset sleep timers
 
+#if !CONFIG_RK_ULP_ENCODER
         // Suppress encoder events right after deep sleep wake
         // (the encoder tick that woke us shouldn't change volume)
         if (display_is_encoder_suppressed()) {
             return;
         }
+#endif
 
         // Dispatch single volume rotation with coalesced tick count
         ui_handle_volume_rotation(total_ticks);
     }
 }
 
+void platform_input_inject_detents(int delta) {
+#if CONFIG_RK_TEST_API
+    if (!s_input_queue || delta == 0) {
+        return;
+    }
+    platform_display_perf_mark_input();
+    dispatch_detents(delta);
+#else
+    (void)delta;
+#endif
+}
+
 void platform_input_shutdown(void) {
     ESP_LOGI(TAG, "Shutting down platform input");
 
@@ -0,0 +1,8 @@
+#ifndef PLATFORM_INPUT_IDF_H
+#define PLATFORM_INPUT_IDF_H
+
+// Feed encoder detents into the same queue and feedback path as a real turn
+// (CONFIG_RK_TEST_API only; does nothing otherwise)
+void platform_input_inject_detents(int delta);
+
+#endif // PLATFORM_INPUT_IDF_H
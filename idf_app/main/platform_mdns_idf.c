@@ -110,6 +110,10 @@ bool platform_mdns_discover_base_url(char *out, size_t len) {
 }
 
 bool platform_mdns_resolve_local(const char *hostname, char *ip_out, size_t ip_len) {
+    return platform_mdns_resolve_local_ttl(hostname, ip_out, ip_len, NULL);
+}
+
+bool platform_mdns_resolve_local_ttl(const char *hostname, char *ip_out, size_t ip_len, uint32_t *ttl_s) {
     if (!hostname || !ip_out || ip_len < 16) {
         return false;
     }
@@ -123,16 +127,27 @@ bool platform_mdns_resolve_local(const char *hostname, char *ip_out, size_t ip_l
         *suffix = '\0';
     }
 
+    // Generic query (not mdns_query_a) so the record TTL comes back with the address
     ESP_LOGI(TAG, "Resolving mDNS hostname: %s", host);
-    esp_ip4_addr_t addr;
-    addr.addr = 0;
-    esp_err_t err = mdns_query_a(host, 2000, &addr);
-    if (err != ESP_OK || addr.addr == 0) {
+    mdns_result_t *results = NULL;
+    esp_err_t err = mdns_query(host, NULL, NULL, MDNS_TYPE_A, 2000, 1, &results);
+    const mdns_ip_addr_t *a = NULL;
+    for (a = results ? results->addr : NULL; a; a = a->next) {
+        if (a->addr.type == ESP_IPADDR_TYPE_V4 && a->addr.u_addr.ip4.addr != 0) {
+            break;
+        }
+    }
+    if (err != ESP_OK || !a) {
         ESP_LOGW(TAG, "mDNS resolve failed for %s: %s", host, esp_err_to_name(err));
+        mdns_query_results_free(results);
         return false;
     }
 
-    snprintf(ip_out, ip_len, IPSTR, IP2STR(&addr));
-    ESP_LOGI(TAG, "Resolved %s -> %s", host, ip_out);
+    snprintf(ip_out, ip_len, IPSTR, IP2STR(&a->addr.u_addr.ip4));
+    if (ttl_s) {
+        *ttl_s = results->ttl;
+    }
+    ESP_LOGI(TAG, "Resolved %s -> %s (ttl %lus)", host, ip_out, (unsigned long)results->ttl);
+    mdns_query_results_free(results);
     return true;
 }
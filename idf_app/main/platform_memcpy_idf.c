@@ -0,0 +1,146 @@
+#include "platform/platform_memcpy.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <esp_async_memcpy.h>
+#include <esp_attr.h>
+#include <esp_heap_caps.h>
+#include <esp_idf_version.h>
+#include <esp_log.h>
+#include <esp_memory_utils.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+static const char *TAG = "memcpy";
+
+// From IDF 5.2 the driver handles the PSRAM cache around DMA copies; before that, CPU only
+#define DMA_SUPPORTED (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0))
+
+#define DMA_BACKLOG 4               // Copies in flight (one per blocked caller)
+#define CALIBRATE_SIZE (64 * 1024)  // Larger than the data cache, like the copies it models
+
+#if DMA_SUPPORTED
+static async_memcpy_handle_t s_mcp = NULL;
+#endif
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Since the previous log (guarded by s_mux)
+static uint32_t s_dma_count;
+static uint64_t s_dma_bytes;
+static uint32_t s_cpu_count;  // Fallbacks of DMA_MIN bytes or more
+static uint64_t s_cpu_bytes;
+static uint32_t s_cpu_ns_per_kb;  // PSRAM-to-PSRAM memcpy cost, measured at init
+
+static void calibrate(void) {
+    uint8_t *a = heap_caps_aligned_alloc(PLATFORM_MEMCPY_ALIGN, CALIBRATE_SIZE, MALLOC_CAP_SPIRAM);
+    uint8_t *b = heap_caps_aligned_alloc(PLATFORM_MEMCPY_ALIGN, CALIBRATE_SIZE, MALLOC_CAP_SPIRAM);
+    if (a && b) {
+        memset(a, 0x5a, CALIBRATE_SIZE);
+        int64_t start = esp_timer_get_time();
+        memcpy(b, a, CALIBRATE_SIZE);
+        int64_t us = esp_timer_get_time() - start;
+        s_cpu_ns_per_kb = (uint32_t)(us * 1000 / (CALIBRATE_SIZE / 1024));
+    }
+    heap_caps_free(a);
+    heap_caps_free(b);
+}
+
+#if DMA_SUPPORTED
+// Wakes the task waiting in platform_memcpy (cb_args is its semaphore)
+static bool IRAM_ATTR on_copy_done(async_memcpy_handle_t mcp, async_memcpy_event_t *event, void *cb_args) {
+    (void)mcp;
+    (void)event;
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR((SemaphoreHandle_t)cb_args, &woken);
+    return woken == pdTRUE;
+}
+#endif
+
+void platform_memcpy_init(void) {
+    calibrate();
+#if DMA_SUPPORTED
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    config.backlog = DMA_BACKLOG;
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 4, 0)
+    config.dma_burst_size = PLATFORM_MEMCPY_ALIGN;
+#else
+    config.psram_trans_align = PLATFORM_MEMCPY_ALIGN;
+#endif
+    esp_err_t err = esp_async_memcpy_install(&config, &s_mcp);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "No DMA channel for copies, using the CPU: %s", esp_err_to_name(err));
+        s_mcp = NULL;
+        return;
+    }
+    ESP_LOGI(TAG, "DMA copies ready (CPU memcpy %lu ns/KB)", (unsigned long)s_cpu_ns_per_kb);
+#else
+    ESP_LOGI(TAG, "DMA copies need IDF 5.2+, using the CPU");
+#endif
+}
+
+#if DMA_SUPPORTED
+static bool dma_eligible(void *dst, const void *src, size_t n) {
+    if (!s_mcp || n < PLATFORM_MEMCPY_DMA_MIN) {
+        return false;
+    }
+    if (((uintptr_t)dst | (uintptr_t)src | n) & (PLATFORM_MEMCPY_ALIGN - 1)) {
+        return false;
+    }
+    const uint8_t *d = dst;
+    const uint8_t *s = src;
+    if (s < d + n && d < s + n) {
+        return false;  // Overlap
+    }
+    return (esp_ptr_external_ram(dst) || esp_ptr_dma_capable(dst)) &&
+           (esp_ptr_external_ram(src) || esp_ptr_dma_capable(src));
+}
+#endif
+
+static void cpu_copy(void *dst, const void *src, size_t n) {
+    memcpy(dst, src, n);
+    if (n >= PLATFORM_MEMCPY_DMA_MIN) {
+        portENTER_CRITICAL(&s_mux);
+        s_cpu_count++;
+        s_cpu_bytes += n;
+        portEXIT_CRITICAL(&s_mux);
+    }
+}
+
+void platform_memcpy(void *dst, const void *src, size_t n) {
+#if DMA_SUPPORTED
+    if (dma_eligible(dst, src, n)) {
+        StaticSemaphore_t sem_buf;
+        SemaphoreHandle_t sem = xSemaphoreCreateBinaryStatic(&sem_buf);
+        if (esp_async_memcpy(s_mcp, dst, (void *)src, n, on_copy_done, sem) == ESP_OK) {
+            xSemaphoreTake(sem, portMAX_DELAY);
+            portENTER_CRITICAL(&s_mux);
+            s_dma_count++;
+            s_dma_bytes += n;
+            portEXIT_CRITICAL(&s_mux);
+            return;
+        }
+    }
+#endif
+    cpu_copy(dst, src, n);
+}
+
+void platform_memcpy_log_stats(void) {
+    portENTER_CRITICAL(&s_mux);
+    uint32_t dma_count = s_dma_count;
+    uint64_t dma_bytes = s_dma_bytes;
+    uint32_t cpu_count = s_cpu_count;
+    uint64_t cpu_bytes = s_cpu_bytes;
+    s_dma_count = s_cpu_count = 0;
+    s_dma_bytes = s_cpu_bytes = 0;
+    portEXIT_CRITICAL(&s_mux);
+
+    if (dma_count == 0 && cpu_count == 0) {
+        return;
+    }
+    uint64_t saved_us = dma_bytes / 1024 * s_cpu_ns_per_kb / 1000;
+    ESP_LOGI(TAG, "copies: %lu DMA (%lu KB, ~%lu us CPU saved), %lu large on CPU (%lu KB)",
+             (unsigned long)dma_count, (unsigned long)(dma_bytes / 1024), (unsigned long)saved_us,
+             (unsigned long)cpu_count, (unsigned long)(cpu_bytes / 1024));
+}
@@ -12,6 +12,7 @@
 static const char *TAG = "platform_storage";
 static const char *NAMESPACE = "rk_cfg";
 static const char *KEY = "cfg";
+static const char *KEY_WIFI_PROFILES = "wifi_prof";
 
 static void ensure_version(rk_cfg_t *cfg) {
     if (!cfg) {
@@ -183,3 +184,51 @@ void platform_storage_reset_wifi_only(rk_cfg_t *cfg) {
     cfg->pass[0] = '\0';
     platform_storage_save(cfg);
 }
+
+bool platform_storage_load_wifi_profiles(wifi_profiles_t *out) {
+    if (!out) {
+        return false;
+    }
+    wifi_profiles_init(out);
+    nvs_handle_t handle;
+    esp_err_t err = open_ns(&handle, NVS_READONLY);
+    if (err != ESP_OK) {
+        return false;
+    }
+    size_t len = sizeof(*out);
+    err = nvs_get_blob(handle, KEY_WIFI_PROFILES, out, &len);
+    nvs_close(handle);
+    if (err != ESP_OK || len != sizeof(*out) || out->ver != WIFI_PROFILES_VER ||
+        out->count > WIFI_PROFILES_MAX) {
+        if (err == ESP_OK) {
+            ESP_LOGW(TAG, "WiFi profiles blob from another version, starting empty");
+        } else if (err != ESP_ERR_NVS_NOT_FOUND) {
+            ESP_LOGW(TAG, "WiFi profiles read failed: %s", esp_err_to_name(err));
+        }
+        wifi_profiles_init(out);
+        return false;
+    }
+    return true;
+}
+
+bool platform_storage_save_wifi_profiles(const wifi_profiles_t *in) {
+    if (!in) {
+        return false;
+    }
+    nvs_handle_t handle;
+    esp_err_t err = open_ns(&handle, NVS_READWRITE);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "nvs open rw failed: %s", esp_err_to_name(err));
+        return false;
+    }
+    err = nvs_set_blob(handle, KEY_WIFI_PROFILES, in, sizeof(*in));
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "WiFi profiles save failed: %s", esp_err_to_name(err));
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,140 @@
+#include "pm_locks.h"
+
+#include <stdio.h>
+
+#include <esp_log.h>
+#include <esp_pm.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+
+#include "hold_stats.h"
+
+static const char *TAG = "pm_locks";
+
+#define CPU_FREQ_MAX_MHZ 240
+#define CPU_FREQ_MIN_MHZ 80
+
+static const char *const s_names[PM_WORK_COUNT] = {"render", "artwork", "network"};
+
+#if CONFIG_PM_ENABLE
+static esp_pm_lock_handle_t s_locks[PM_WORK_COUNT];
+#endif
+
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static hold_stats_t s_stats[PM_WORK_COUNT];  // Guarded by s_mux
+static hold_stats_t s_any;                   // Any lock held (guarded by s_mux)
+static uint64_t s_window_start_us;           // pm_locks_log_stats window
+static uint64_t s_pct_last_us;               // pm_locks_boost_pct window
+static uint64_t s_pct_last_total_us;
+
+void pm_locks_init(void) {
+    for (int i = 0; i < PM_WORK_COUNT; i++) {
+        hold_stats_init(&s_stats[i]);
+#if CONFIG_PM_ENABLE
+        esp_err_t err = esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, s_names[i], &s_locks[i]);
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to create %s lock: %s", s_names[i], esp_err_to_name(err));
+            s_locks[i] = NULL;
+        }
+#endif
+    }
+    hold_stats_init(&s_any);
+    s_window_start_us = s_pct_last_us = (uint64_t)esp_timer_get_time();
+}
+
+void pm_locks_set_scaling(bool enabled) {
+#if CONFIG_PM_ENABLE
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = CPU_FREQ_MAX_MHZ,
+        .min_freq_mhz = enabled ? CPU_FREQ_MIN_MHZ : CPU_FREQ_MAX_MHZ,
+        .light_sleep_enable = false,  // Don't auto-sleep, we control display separately
+    };
+    esp_err_t err = esp_pm_configure(&pm_config);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to configure PM: %s", esp_err_to_name(err));
+        return;
+    }
+    if (enabled) {
+        ESP_LOGI(TAG, "CPU scaling on: %d MHz, %d MHz while rendering or parsing", CPU_FREQ_MIN_MHZ,
+                 CPU_FREQ_MAX_MHZ);
+    } else {
+        ESP_LOGI(TAG, "CPU scaling off: %d MHz", CPU_FREQ_MAX_MHZ);
+    }
+#else
+    (void)enabled;
+#endif
+}
+
+void pm_work_begin(pm_work_t work) {
+#if CONFIG_PM_ENABLE
+    if (s_locks[work]) {
+        esp_pm_lock_acquire(s_locks[work]);
+    }
+#endif
+    uint64_t now = (uint64_t)esp_timer_get_time();
+    portENTER_CRITICAL(&s_mux);
+    hold_stats_begin(&s_stats[work], now);
+    hold_stats_begin(&s_any, now);
+    portEXIT_CRITICAL(&s_mux);
+}
+
+void pm_work_end(pm_work_t work) {
+    uint64_t now = (uint64_t)esp_timer_get_time();
+    portENTER_CRITICAL(&s_mux);
+    hold_stats_end(&s_stats[work], now);
+    hold_stats_end(&s_any, now);
+    portEXIT_CRITICAL(&s_mux);
+#if CONFIG_PM_ENABLE
+    if (s_locks[work]) {
+        esp_pm_lock_release(s_locks[work]);
+    }
+#endif
+}
+
+uint8_t pm_locks_boost_pct(void) {
+    uint64_t now = (uint64_t)esp_timer_get_time();
+    portENTER_CRITICAL(&s_mux);
+    uint64_t total = hold_stats_total_us(&s_any, now);
+    portEXIT_CRITICAL(&s_mux);
+
+    uint64_t elapsed = now - s_pct_last_us;
+    uint64_t held = total - s_pct_last_total_us;
+    s_pct_last_us = now;
+    s_pct_last_total_us = total;
+    if (elapsed == 0) {
+        return 0;
+    }
+    uint64_t pct = (held * 100 + elapsed / 2) / elapsed;
+    return pct > 100 ? 100 : (uint8_t)pct;
+}
+
+void pm_locks_log_stats(void) {
+    hold_stats_t snap[PM_WORK_COUNT];
+    uint64_t now = (uint64_t)esp_timer_get_time();
+    portENTER_CRITICAL(&s_mux);
+    for (int i = 0; i < PM_WORK_COUNT; i++) {
+        snap[i] = s_stats[i];
+        hold_stats_reset_window(&s_stats[i]);
+    }
+    uint64_t any_us = s_any.window_total_us;
+    hold_stats_reset_window(&s_any);
+    portEXIT_CRITICAL(&s_mux);
+
+    uint64_t window_us = now - s_window_start_us;
+    s_window_start_us = now;
+    if (window_us == 0) {
+        return;
+    }
+
+    // Per kind: holds, average and longest hold
+    char detail[160];
+    int off = 0;
+    for (int i = 0; i < PM_WORK_COUNT && off < (int)sizeof(detail); i++) {
+        uint32_t avg_us = snap[i].count ? (uint32_t)(snap[i].window_total_us / snap[i].count) : 0;
+        off += snprintf(detail + off, sizeof(detail) - off, "%s%s %lu x %lu us (max %lu)", i ? ", " : "",
+                        s_names[i], (unsigned long)snap[i].count, (unsigned long)avg_us,
+                        (unsigned long)snap[i].max_us);
+    }
+    ESP_LOGI(TAG, "CPU boost %lu.%lu%% of %lus: %s", (unsigned long)(any_us * 100 / window_us),
+             (unsigned long)(any_us * 1000 / window_us % 10), (unsigned long)(window_us / 1000000), detail);
+}
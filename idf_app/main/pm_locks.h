@@ -0,0 +1,33 @@
+#ifndef PM_LOCKS_H
+#define PM_LOCKS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// CPU frequency locks scoped to bursts of work. With CPU scaling on, the CPU idles at
+// 80 MHz and runs at 240 MHz only while one of these is held. Hold times are tracked
+// per kind of work either way.
+typedef enum {
+    PM_WORK_RENDER,   // LVGL render and flush
+    PM_WORK_ARTWORK,  // Artwork gunzip, copy and crossfade steps
+    PM_WORK_NETWORK,  // TLS handshakes and JSON parsing
+    PM_WORK_COUNT,
+} pm_work_t;
+
+// Create the locks. Call once, before any other task can begin work.
+void pm_locks_init(void);
+
+// Configure power management: 80-240 MHz with scaling, a fixed 240 MHz without
+void pm_locks_set_scaling(bool enabled);
+
+// Bracket one burst of work. Nests, and may be called from several tasks at once.
+void pm_work_begin(pm_work_t work);
+void pm_work_end(pm_work_t work);
+
+// Percent of the time since the previous call that any lock was held (telemetry)
+uint8_t pm_locks_boost_pct(void);
+
+// Log per-kind hold counts and times since the previous call
+void pm_locks_log_stats(void);
+
+#endif // PM_LOCKS_H
@@ -0,0 +1,360 @@
+// Test API - input injection and scripted performance runs over HTTP
+// Driven by scripts/perf_run.sh. Only built with CONFIG_RK_TEST_API: anyone on the LAN
+// can operate the knob through it, so release builds leave it out.
+
+#include "test_api.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include "display_sleep.h"
+#include "platform/platform_task.h"
+#include "platform_display_idf.h"
+#include "platform_input_idf.h"
+#include "ui.h"
+
+static const char *TAG = "test_api";
+
+#define ZONE_ID_BACK "__back__"
+#define ZONE_ID_SETTINGS "__settings__"
+
+#define SCREEN_CENTER 180
+#define HEADER_Y 75             // Inside the header tap zone that opens the zone picker
+#define WAKE_TAP_Y 340          // Bottom edge, clear of the controls
+#define WAKE_SETTLE_MS 400      // Past the display's touch suppression after a wake
+
+#define TAP_HOLD_MS 80          // Longer than LVGL's input read period
+#define SWIPE_DISTANCE 140      // Well past the 60px swipe threshold
+#define SWIPE_STEPS 5
+#define SWIPE_STEP_MS 30        // 150ms swipe, inside the 500ms limit
+#define PICK_DETENT_MS 80       // Picker scrolls one row per UI loop pass; keep detents apart
+#define PICK_SETTLE_MS 400      // Let the scroll-to-row animation finish before tapping
+#define PICK_MAX_DETENTS 32
+#define QUERY_TIMEOUT_MS 1000
+#define SETTLE_MS 1000          // Let the last step's redraws land inside the window
+
+typedef enum {
+    SWIPE_UP,
+    SWIPE_DOWN,
+    SWIPE_LEFT,
+    SWIPE_RIGHT,
+} swipe_dir_t;
+
+typedef enum {
+    STEP_DETENTS,    // a detents (signed), one every ms
+    STEP_TAP,        // at (a, b)
+    STEP_SWIPE,      // direction a
+    STEP_PICK_ZONE,  // picker open: scroll a (+1/-1) to the next zone and tap it
+    STEP_PICK_BACK,  // picker open: scroll up to Back and tap it
+    STEP_WAIT,       // ms
+} step_kind_t;
+
+typedef struct {
+    step_kind_t kind;
+    int a;
+    int b;
+    int ms;
+} step_t;
+
+typedef struct {
+    const char *name;
+    const step_t *steps;
+    int count;
+} scenario_t;
+
+static const step_t SPIN_VOLUME[] = {
+    {STEP_DETENTS, 20, 0, 30},
+    {STEP_WAIT, 0, 0, 500},
+    {STEP_DETENTS, -20, 0, 30},
+};
+
+static const step_t OPEN_PICKER[] = {
+    {STEP_TAP, SCREEN_CENTER, HEADER_Y, 0},
+    {STEP_WAIT, 0, 0, 800},
+    {STEP_PICK_BACK, 0, 0, 0},
+};
+
+static const step_t SWITCH_ZONE[] = {
+    {STEP_TAP, SCREEN_CENTER, HEADER_Y, 0},
+    {STEP_WAIT, 0, 0, 800},
+    {STEP_PICK_ZONE, 1, 0, 0},
+    {STEP_WAIT, 0, 0, 2500},
+    {STEP_TAP, SCREEN_CENTER, HEADER_Y, 0},
+    {STEP_WAIT, 0, 0, 800},
+    {STEP_PICK_ZONE, -1, 0, 0},
+};
+
+static const step_t ART_MODE[] = {
+    {STEP_SWIPE, SWIPE_UP, 0, 0},
+    {STEP_WAIT, 0, 0, 1500},
+    {STEP_SWIPE, SWIPE_DOWN, 0, 0},
+};
+
+#define SCENARIO(name, steps) {name, steps, sizeof(steps) / sizeof(steps[0])}
+
+static const scenario_t SCENARIOS[] = {
+    SCENARIO("spin_volume", SPIN_VOLUME),
+    SCENARIO("open_picker", OPEN_PICKER),
+    SCENARIO("switch_zone", SWITCH_ZONE),
+    SCENARIO("art_mode", ART_MODE),
+};
+
+#define SCENARIO_COUNT (sizeof(SCENARIOS) / sizeof(SCENARIOS[0]))
+
+// Picker state read on the UI thread. Static so a late answer after a timeout
+// never lands on a stale stack frame.
+typedef struct {
+    bool visible;
+    int x;
+    int y;
+    char id[64];
+} picker_query_t;
+
+static picker_query_t s_query;
+static SemaphoreHandle_t s_query_done = NULL;
+
+static void wait_ms(int ms) {
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+static void tap(int x, int y) {
+    platform_display_inject_touch(true, x, y);
+    wait_ms(TAP_HOLD_MS);
+    platform_display_inject_touch(false, x, y);
+    wait_ms(TAP_HOLD_MS);
+    platform_display_inject_end();
+}
+
+static void swipe(swipe_dir_t dir) {
+    int dx = dir == SWIPE_LEFT ? -1 : dir == SWIPE_RIGHT ? 1 : 0;
+    int dy = dir == SWIPE_UP ? -1 : dir == SWIPE_DOWN ? 1 : 0;
+    int x0 = SCREEN_CENTER - dx * SWIPE_DISTANCE / 2;
+    int y0 = SCREEN_CENTER - dy * SWIPE_DISTANCE / 2;
+    for (int i = 0; i <= SWIPE_STEPS; i++) {
+        int16_t x = x0 + dx * SWIPE_DISTANCE * i / SWIPE_STEPS;
+        int16_t y = y0 + dy * SWIPE_DISTANCE * i / SWIPE_STEPS;
+        platform_display_inject_touch(true, x, y);
+        wait_ms(SWIPE_STEP_MS);
+    }
+    platform_display_inject_touch(false, x0 + dx * SWIPE_DISTANCE, y0 + dy * SWIPE_DISTANCE);
+    wait_ms(TAP_HOLD_MS);
+    platform_display_inject_end();
+}
+
+static void detents(int count, int interval_ms) {
+    int dir = count < 0 ? -1 : 1;
+    for (int i = 0; i < abs(count); i++) {
+        platform_input_inject_detents(dir);
+        wait_ms(interval_ms);
+    }
+}
+
+static void picker_query_ui(void *arg) {
+    (void)arg;
+    s_query.visible = ui_is_zone_picker_visible() && ui_zone_picker_selected_point(&s_query.x, &s_query.y);
+    ui_zone_picker_get_selected_id(s_query.id, sizeof(s_query.id));
+    xSemaphoreGive(s_query_done);
+}
+
+static bool query_picker(void) {
+    xSemaphoreTake(s_query_done, 0);  // Drop a late answer to an earlier query
+    platform_task_post_to_ui(picker_query_ui, NULL);
+    display_kick_ui_loop();
+    if (xSemaphoreTake(s_query_done, pdMS_TO_TICKS(QUERY_TIMEOUT_MS)) != pdTRUE) {
+        ESP_LOGW(TAG, "Picker query timed out");
+        return false;
+    }
+    return s_query.visible;
+}
+
+// Scroll the open picker until the highlighted row is the target, then tap it
+static bool pick(int dir, bool back) {
+    for (int moved = 0; moved <= PICK_MAX_DETENTS; moved++) {
+        if (!query_picker()) {
+            ESP_LOGW(TAG, "Zone picker not open");
+            return false;
+        }
+        bool is_back = strcmp(s_query.id, ZONE_ID_BACK) == 0;
+        bool is_settings = strcmp(s_query.id, ZONE_ID_SETTINGS) == 0;
+        bool found = back ? is_back : (moved > 0 && !is_back && !is_settings);
+        if (found) {
+            wait_ms(PICK_SETTLE_MS);
+            if (!query_picker()) {
+                return false;
+            }
+            tap(s_query.x, s_query.y);
+            return true;
+        }
+        platform_input_inject_detents(back ? -1 : dir);
+        wait_ms(PICK_DETENT_MS);
+    }
+    ESP_LOGW(TAG, "No %s row in the zone picker", back ? "Back" : "other zone");
+    return false;
+}
+
+static bool run_step(const step_t *step) {
+    switch (step->kind) {
+    case STEP_DETENTS:
+        detents(step->a, step->ms);
+        return true;
+    case STEP_TAP:
+        tap(step->a, step->b);
+        return true;
+    case STEP_SWIPE:
+        swipe((swipe_dir_t)step->a);
+        return true;
+    case STEP_PICK_ZONE:
+        return pick(step->a, false);
+    case STEP_PICK_BACK:
+        return pick(0, true);
+    case STEP_WAIT:
+        wait_ms(step->ms);
+        return true;
+    }
+    return false;
+}
+
+// Start from the normal control screen: a dimmed, sleeping or art-mode display
+// takes the first tap as a wake, as it would from a finger
+static void wake_display(void) {
+    if (display_get_state() == DISPLAY_STATE_NORMAL) {
+        return;
+    }
+    tap(SCREEN_CENTER, WAKE_TAP_Y);
+    wait_ms(WAKE_SETTLE_MS);
+}
+
+static void run_scenario(const scenario_t *sc, char *json, size_t len) {
+    wake_display();
+
+    size_t internal_before = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    size_t psram_before = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    platform_display_perf_reset();
+    int64_t start = esp_timer_get_time();
+
+    bool ok = true;
+    for (int i = 0; i < sc->count && ok; i++) {
+        ok = run_step(&sc->steps[i]);
+    }
+    platform_display_inject_end();
+    wait_ms(SETTLE_MS);
+
+    uint32_t duration_ms = (uint32_t)((esp_timer_get_time() - start) / 1000);
+    platform_display_perf_t perf;
+    platform_display_perf_get(&perf);
+    long internal_delta = (long)heap_caps_get_free_size(MALLOC_CAP_INTERNAL) - (long)internal_before;
+    long psram_delta = (long)heap_caps_get_free_size(MALLOC_CAP_SPIRAM) - (long)psram_before;
+
+    snprintf(json, len,
+             "{\"scenario\":\"%s\",\"ok\":%s,\"duration_ms\":%lu,"
+             "\"frames\":%lu,\"frame_avg_us\":%lu,\"frame_max_us\":%lu,"
+             "\"inputs\":%lu,\"latency_avg_us\":%lu,\"latency_max_us\":%lu,"
+             "\"heap_internal_delta\":%ld,\"heap_psram_delta\":%ld,\"heap_internal_min_free\":%lu}\n",
+             sc->name, ok ? "true" : "false", (unsigned long)duration_ms,
+             (unsigned long)perf.frames, (unsigned long)perf.frame_avg_us, (unsigned long)perf.frame_max_us,
+             (unsigned long)perf.inputs, (unsigned long)perf.latency_avg_us, (unsigned long)perf.latency_max_us,
+             internal_delta, psram_delta,
+             (unsigned long)heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL));
+
+    ESP_LOGI(TAG, "%s: %s, %lu frames (avg %lu us), latency avg %lu us", sc->name, ok ? "ok" : "failed",
+             (unsigned long)perf.frames, (unsigned long)perf.frame_avg_us, (unsigned long)perf.latency_avg_us);
+}
+
+static esp_err_t test_run_handler(httpd_req_t *req) {
+    char query[64];
+    char name[32] = "";
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        httpd_query_key_value(query, "name", name, sizeof(name));
+    }
+
+    const scenario_t *sc = NULL;
+    for (size_t i = 0; i < SCENARIO_COUNT; i++) {
+        if (strcmp(SCENARIOS[i].name, name) == 0) {
+            sc = &SCENARIOS[i];
+            break;
+        }
+    }
+    if (!sc) {
+        char msg[128] = "Unknown scenario; available:";
+        for (size_t i = 0; i < SCENARIO_COUNT; i++) {
+            strncat(msg, " ", sizeof(msg) - strlen(msg) - 1);
+            strncat(msg, SCENARIOS[i].name, sizeof(msg) - strlen(msg) - 1);
+        }
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, msg);
+        return ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG, "Running scenario %s", sc->name);
+    char json[384];
+    run_scenario(sc, json, sizeof(json));
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_sendstr(req, json);
+}
+
+static esp_err_t test_input_handler(httpd_req_t *req) {
+    char query[64];
+    char value[16];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Expected ticks=N, tap=X,Y or swipe=DIR");
+        return ESP_FAIL;
+    }
+
+    if (httpd_query_key_value(query, "ticks", value, sizeof(value)) == ESP_OK) {
+        platform_input_inject_detents(atoi(value));
+    } else if (httpd_query_key_value(query, "tap", value, sizeof(value)) == ESP_OK) {
+        int x, y;
+        if (sscanf(value, "%d,%d", &x, &y) != 2) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "tap=X,Y");
+            return ESP_FAIL;
+        }
+        tap(x, y);
+    } else if (httpd_query_key_value(query, "swipe", value, sizeof(value)) == ESP_OK) {
+        static const char *const dirs[] = {"up", "down", "left", "right"};
+        int dir = -1;
+        for (int i = 0; i < 4; i++) {
+            if (strcmp(value, dirs[i]) == 0) {
+                dir = i;
+            }
+        }
+        if (dir < 0) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "swipe=up|down|left|right");
+            return ESP_FAIL;
+        }
+        swipe((swipe_dir_t)dir);
+    } else {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Expected ticks=N, tap=X,Y or swipe=DIR");
+        return ESP_FAIL;
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_sendstr(req, "{\"ok\":true}\n");
+}
+
+void test_api_register(httpd_handle_t server) {
+    if (!s_query_done) {
+        s_query_done = xSemaphoreCreateBinary();
+    }
+
+    httpd_uri_t input = {
+        .uri = "/test/input",
+        .method = HTTP_POST,
+        .handler = test_input_handler,
+    };
+    httpd_register_uri_handler(server, &input);
+
+    httpd_uri_t run = {
+        .uri = "/test/run",
+        .method = HTTP_POST,
+        .handler = test_run_handler,
+    };
+    httpd_register_uri_handler(server, &run);
+
+    ESP_LOGW(TAG, "Test API enabled: /test/input and /test/run accept input from the network");
+}
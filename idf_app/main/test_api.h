@@ -0,0 +1,11 @@
+#ifndef TEST_API_H
+#define TEST_API_H
+
+#include <esp_http_server.h>
+
+// Scripted input and performance runs on the config server (CONFIG_RK_TEST_API only):
+//   POST /test/input?ticks=N | tap=X,Y | swipe=up|down|left|right
+//   POST /test/run?name=<scenario>   -> JSON frame times, input latency, heap deltas
+void test_api_register(httpd_handle_t server);
+
+#endif // TEST_API_H
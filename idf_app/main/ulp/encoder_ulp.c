@@ -0,0 +1,37 @@
+// ULP RISC-V program: keeps decoding the encoder while the main CPUs are in deep sleep
+// and through the next boot, until encoder_ulp_collect() stops the ULP timer. Runs once
+// per timer period (ENCODER_ULP_PERIOD_US) and halts.
+
+#include <stdint.h>
+
+#include "ulp_riscv_gpio.h"
+#include "ulp_riscv_utils.h"
+
+#include "encoder_decode.h"
+
+#define ENCODER_GPIO_A GPIO_NUM_8
+#define ENCODER_GPIO_B GPIO_NUM_7
+
+#define ULP_ENCODER_ARMED   0x454E4301  // Set by the main CPU before sleep
+#define ULP_ENCODER_RUNNING 0x454E4302  // Decoder initialised from the first sample
+
+// Shared with the main CPU (visible there as ulp_<name>)
+volatile uint32_t state = 0;
+volatile int32_t detents = 0;
+volatile uint32_t samples = 0;
+
+static encoder_decode_t s_decoder;
+
+int main(void) {
+    uint8_t a = (uint8_t)ulp_riscv_gpio_get_level(ENCODER_GPIO_A);
+    uint8_t b = (uint8_t)ulp_riscv_gpio_get_level(ENCODER_GPIO_B);
+    if (state == ULP_ENCODER_ARMED) {
+        encoder_decode_init(&s_decoder, a, b);
+        state = ULP_ENCODER_RUNNING;
+    } else if (state == ULP_ENCODER_RUNNING) {
+        encoder_decode_sample(&s_decoder, a, b);
+        detents = s_decoder.count;
+    }
+    samples++;
+    return 0;
+}
@@ -15,9 +15,9 @@
 #include "sdkconfig.h"
 
 #include "platform/platform_storage.h"
+#include "wifi_profiles.h"
 
 static const char *TAG = "wifi_mgr";
-static const uint32_t s_backoff_ms[] = {500, 1000, 2000, 4000, 8000, 16000, 30000};
 static const char *s_last_error = NULL;  // Last disconnect reason for UI display
 
 // Map WiFi disconnect reason to human-readable string and event type
@@ -71,7 +71,11 @@ static const char *get_disconnect_reason_str(uint8_t reason, rk_net_evt_t *out_e
 // AP mode configuration
 #define AP_SSID "roon-knob-setup"
 #define AP_MAX_CONNECTIONS 2
-#define STA_FAIL_THRESHOLD 5  // Switch to AP after this many consecutive STA failures
+#define STA_FAIL_THRESHOLD 5  // Switch to AP after this many consecutive rounds with no connection
+#define SCAN_ACTIVE_MS 80     // Per-channel dwell for the connect scan (IDF default is 120)
+#define SCAN_MAX_APS 16
+#define PORTAL_SCAN_INTERVAL_MS 30000      // Background scans while the setup portal is up...
+#define PORTAL_SCAN_BUSY_INTERVAL_MS 120000 // ...stretched while a phone is joined (scans stall the AP)
 
 static rk_cfg_t s_cfg;
 static bool s_cfg_loaded;
@@ -85,6 +89,26 @@ static bool s_ap_mode;           // true when in AP provisioning mode
 static int s_sta_fail_count;     // consecutive STA connection failures
 static char s_device_hostname[32] = {0};  // cached network hostname
 
+// Stored networks and the current connect round: one scan, then each ranked candidate
+// in turn. The round counts as one failure only when every candidate has failed.
+static wifi_profiles_t s_profiles;
+static wifi_candidate_t s_cands[WIFI_PROFILES_MAX_CANDIDATES];
+static int s_cand_count;
+static int s_cand_idx;
+static int s_active_profile = -1;  // Profile being tried, or connected
+static bool s_scanning;
+static int64_t s_scan_start_us;
+static int64_t s_connect_start_us;
+static uint32_t s_round_scan_ms;
+static bool s_boot_reported;
+static bool s_quick_round;      // Current round is a direct join of a known AP, without a scan
+static bool s_quick_tried;      // Direct join already used since boot / new credentials
+static esp_timer_handle_t s_portal_scan_timer;
+static bool s_portal_scanning;
+static int64_t s_portal_scan_us;
+static wifi_ap_record_t s_scan_recs[SCAN_MAX_APS];
+static wifi_scan_ap_t s_scan_aps[SCAN_MAX_APS];
+
 static void copy_str(char *dst, size_t dst_len, const char *src) {
     if (!dst || dst_len == 0) {
         return;
@@ -204,15 +228,31 @@ static void ensure_cfg_loaded(void) {
     }
     s_cfg = cfg;
     s_cfg_loaded = true;
-}
 
-static esp_err_t apply_wifi_config(void) {
-    if (!s_cfg_loaded) {
-        ensure_cfg_loaded();
+    // rk_cfg_t.ssid is the network provisioned last; it joins the stored profiles, so a
+    // knob provisioned in two rooms remembers both
+    platform_storage_load_wifi_profiles(&s_profiles);
+    wifi_profiles_t before = s_profiles;
+    wifi_profiles_upsert(&s_profiles, s_cfg.ssid, s_cfg.pass);
+    if (memcmp(&before, &s_profiles, sizeof(before)) != 0) {
+        platform_storage_save_wifi_profiles(&s_profiles);
     }
+    ESP_LOGI(TAG, "%d stored WiFi network(s)", s_profiles.count);
+}
+
+// Targeted association: with a BSSID/channel from the scan the driver skips its own
+// all-channel scan and goes straight to that AP
+static esp_err_t apply_wifi_config(const wifi_candidate_t *cand) {
+    const wifi_profile_t *p = &s_profiles.profiles[cand->profile];
     wifi_config_t cfg = {0};
-    copy_str((char *)cfg.sta.ssid, sizeof(cfg.sta.ssid), s_cfg.ssid);
-    copy_str((char *)cfg.sta.password, sizeof(cfg.sta.password), s_cfg.pass);
+    copy_str((char *)cfg.sta.ssid, sizeof(cfg.sta.ssid), p->ssid);
+    copy_str((char *)cfg.sta.password, sizeof(cfg.sta.password), p->pass);
+    if (cand->channel != 0) {
+        memcpy(cfg.sta.bssid, cand->bssid, sizeof(cfg.sta.bssid));
+        cfg.sta.bssid_set = true;
+        cfg.sta.channel = cand->channel;
+    }
+    cfg.sta.scan_method = WIFI_FAST_SCAN;
     cfg.sta.threshold.authmode = WIFI_AUTH_WPA2_PSK;
     cfg.sta.pmf_cfg.capable = true;
     cfg.sta.pmf_cfg.required = false;
@@ -224,9 +264,116 @@ static void reset_backoff(void) {
 }
 
 static void schedule_retry_with_reason(uint8_t reason);
-static void schedule_retry(void);
 static void start_ap_mode(void);
 
+static void connect_now(void);
+
+// Try the current candidate; once they're all used up the round has failed
+static void try_candidate(uint8_t last_reason) {
+    while (s_cand_idx < s_cand_count) {
+        const wifi_candidate_t *cand = &s_cands[s_cand_idx];
+        const wifi_profile_t *p = &s_profiles.profiles[cand->profile];
+        s_active_profile = cand->profile;
+        if (cand->channel != 0) {
+            ESP_LOGI(TAG, "Connecting to WiFi SSID: '%s' (%02x:%02x:%02x:%02x:%02x:%02x ch %d, %d dBm, %d/%d)",
+                     p->ssid, cand->bssid[0], cand->bssid[1], cand->bssid[2], cand->bssid[3], cand->bssid[4],
+                     cand->bssid[5], cand->channel, cand->rssi, s_cand_idx + 1, s_cand_count);
+        } else {
+            ESP_LOGI(TAG, "Connecting to WiFi SSID: '%s' (not in scan, %d/%d)", p->ssid, s_cand_idx + 1,
+                     s_cand_count);
+        }
+        if (apply_wifi_config(cand) != ESP_OK) {
+            ESP_LOGE(TAG, "failed to apply Wi-Fi config");
+            s_cand_idx++;
+            continue;
+        }
+        s_connect_start_us = esp_timer_get_time();
+        esp_err_t err = esp_wifi_connect();
+        if (err == ESP_OK) {
+            return;
+        }
+        ESP_LOGE(TAG, "connect failed: %s", esp_err_to_name(err));
+        s_cand_idx++;
+    }
+    if (s_quick_round) {
+        // The known AP didn't answer (moved rooms?): fall back to a scan right away
+        s_quick_round = false;
+        connect_now();
+        return;
+    }
+    schedule_retry_with_reason(last_reason);
+}
+
+// Rank the scan against the stored networks and start on the best candidate
+static void start_round(int n_aps) {
+    s_quick_round = false;
+    s_cand_count = wifi_profiles_rank(&s_profiles, s_scan_aps, n_aps, s_cands, WIFI_PROFILES_MAX_CANDIDATES);
+    s_cand_idx = 0;
+    ESP_LOGI(TAG, "Scan: %d AP(s) in %lu ms, %d candidate(s)", n_aps, (unsigned long)s_round_scan_ms,
+             s_cand_count);
+    try_candidate(WIFI_REASON_NO_AP_FOUND);
+}
+
+// Copy the finished scan into s_scan_aps; returns the count
+static int read_scan(void) {
+    uint16_t n = SCAN_MAX_APS;
+    if (esp_wifi_scan_get_ap_records(&n, s_scan_recs) != ESP_OK) {
+        n = 0;
+    }
+    for (int i = 0; i < n; i++) {
+        copy_str(s_scan_aps[i].ssid, sizeof(s_scan_aps[i].ssid), (const char *)s_scan_recs[i].ssid);
+        memcpy(s_scan_aps[i].bssid, s_scan_recs[i].bssid, sizeof(s_scan_aps[i].bssid));
+        s_scan_aps[i].channel = s_scan_recs[i].primary;
+        s_scan_aps[i].rssi = s_scan_recs[i].rssi;
+        s_scan_aps[i].auth = (uint8_t)s_scan_recs[i].authmode;
+    }
+    return n;
+}
+
+static void scan_done(void) {
+    s_scanning = false;
+    s_round_scan_ms = (uint32_t)((esp_timer_get_time() - s_scan_start_us) / 1000);
+    int n = read_scan();
+    // Connect scans also fill the setup portal's list, so it has networks to show the
+    // moment AP mode starts
+    captive_portal_update_scan(s_scan_aps, n);
+    start_round(n);
+}
+
+static void portal_scan_done(void) {
+    s_portal_scanning = false;
+    int n = read_scan();
+    ESP_LOGI(TAG, "Portal scan: %d AP(s) in %lu ms", n,
+             (unsigned long)((esp_timer_get_time() - s_portal_scan_us) / 1000));
+    captive_portal_update_scan(s_scan_aps, n);
+}
+
+static void portal_scan_timer_cb(void *arg) {
+    (void)arg;
+    if (!s_ap_mode || s_portal_scanning) {
+        return;
+    }
+    // Leaving the AP's channel for a scan stalls a phone loading the form, so scan less
+    // while one is joined
+    wifi_sta_list_t stas;
+    int64_t since_ms = (esp_timer_get_time() - s_portal_scan_us) / 1000;
+    if (s_portal_scan_us != 0 && esp_wifi_ap_get_sta_list(&stas) == ESP_OK && stas.num > 0 &&
+        since_ms < PORTAL_SCAN_BUSY_INTERVAL_MS) {
+        return;
+    }
+    wifi_scan_config_t scan = {
+        .scan_type = WIFI_SCAN_TYPE_ACTIVE,
+        .scan_time.active = {.min = 0, .max = SCAN_ACTIVE_MS},
+    };
+    s_portal_scan_us = esp_timer_get_time();
+    esp_err_t err = esp_wifi_scan_start(&scan, false);
+    if (err == ESP_OK) {
+        s_portal_scanning = true;
+    } else {
+        ESP_LOGW(TAG, "Portal scan failed: %s", esp_err_to_name(err));
+    }
+}
+
 static void connect_now(void) {
     if (s_ap_mode) {
         return;  // Don't try STA when in AP mode
@@ -234,35 +381,62 @@ static void connect_now(void) {
     if (!s_cfg_loaded) {
         ensure_cfg_loaded();
     }
-    if (s_cfg.ssid[0] == '\0') {
+    if (s_profiles.count == 0) {
         ESP_LOGW(TAG, "SSID empty; starting AP mode for provisioning");
         start_ap_mode();
         return;
     }
+    if (s_scanning) {
+        return;  // Round already starting
+    }
+    if (s_retry_timer) {
+        esp_timer_stop(s_retry_timer);
+    }
+
+    // First attempt after boot: join the known AP directly. The scan
+    // (~1 s) only runs if that fails.
+    wifi_candidate_t quick;
+    if (!s_quick_tried &&
+        wifi_profiles_quick_candidate(&s_profiles, wifi_profiles_find(&s_profiles, s_cfg.ssid), &quick)) {
+        s_quick_tried = true;
+        s_quick_round = true;
+        s_cands[0] = quick;
+        s_cand_count = 1;
+        s_cand_idx = 0;
+        s_round_scan_ms = 0;
+        esp_netif_set_hostname(s_sta_netif, get_device_hostname());
+        rk_net_evt_cb(RK_NET_EVT_CONNECTING, NULL);
+        try_candidate(WIFI_REASON_NO_AP_FOUND);
+        return;
+    }
+    s_quick_tried = true;
+
     // Set hostname before connection (with delay per Arduino pattern)
     const char *hostname = get_device_hostname();
     esp_netif_set_hostname(s_sta_netif, hostname);
     vTaskDelay(pdMS_TO_TICKS(100));  // Delay to let hostname settle
     ESP_LOGI(TAG, "Hostname set before connect: %s", hostname);
 
-    ESP_LOGI(TAG, "Connecting to WiFi SSID: '%s'", s_cfg.ssid);
-    if (s_retry_timer) {
-        esp_timer_stop(s_retry_timer);
-    }
-    if (apply_wifi_config() != ESP_OK) {
-        ESP_LOGE(TAG, "failed to apply Wi-Fi config");
-        schedule_retry();
-        return;
-    }
     rk_net_evt_cb(RK_NET_EVT_CONNECTING, NULL);
+    s_scanning = true;  // Disconnect events from here until SCAN_DONE belong to no attempt
     esp_err_t err = esp_wifi_disconnect();
     if (err != ESP_OK && err != ESP_ERR_WIFI_NOT_STARTED && err != ESP_ERR_WIFI_NOT_INIT) {
         ESP_LOGW(TAG, "disconnect failed: %s", esp_err_to_name(err));
     }
-    err = esp_wifi_connect();
+
+    // One active scan of all channels with a short dwell
+    wifi_scan_config_t scan = {
+        .scan_type = WIFI_SCAN_TYPE_ACTIVE,
+        .scan_time.active = {.min = 0, .max = SCAN_ACTIVE_MS},
+    };
+    s_scan_start_us = esp_timer_get_time();
+    err = esp_wifi_scan_start(&scan, false);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "connect failed: %s", esp_err_to_name(err));
-        schedule_retry();
+        // Still worth trying the stored networks by SSID alone
+        ESP_LOGW(TAG, "scan failed: %s; connecting without it", esp_err_to_name(err));
+        s_scanning = false;
+        s_round_scan_ms = 0;
+        start_round(0);
     }
 }
 
@@ -288,10 +462,8 @@ static void schedule_retry_with_reason(uint8_t reason) {
         return;
     }
 
-    uint32_t delay = s_backoff_ms[s_backoff_idx];
-    if (s_backoff_idx + 1 < (sizeof(s_backoff_ms) / sizeof(s_backoff_ms[0]))) {
-        s_backoff_idx++;
-    }
+    uint32_t delay = wifi_profiles_backoff_ms((int)s_backoff_idx);
+    s_backoff_idx++;
     if (s_retry_timer) {
         esp_timer_stop(s_retry_timer);
         esp_err_t err = esp_timer_start_once(s_retry_timer, delay * 1000);
@@ -306,22 +478,41 @@ static void schedule_retry_with_reason(uint8_t reason) {
     rk_net_evt_cb(evt, s_last_error);
 }
 
-static void schedule_retry(void) {
-    // Called when we don't have a specific reason (e.g., config apply failed)
-    schedule_retry_with_reason(0);
-}
-
 static void wifi_event_handler(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data) {
     (void)arg;
     if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
+        if (s_ap_mode) {
+            return;  // STA side of AP+STA, only used for portal scans
+        }
         reset_backoff();
         s_last_error = NULL;  // Clear last error on new connection attempt
         connect_now();
+    } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_SCAN_DONE) {
+        if (s_scanning) {
+            scan_done();
+        } else if (s_portal_scanning) {
+            portal_scan_done();
+        }
     } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
+        if (s_scanning || s_ap_mode) {
+            return;
+        }
         // Extract disconnect reason from event data
         wifi_event_sta_disconnected_t *disconn = (wifi_event_sta_disconnected_t *)event_data;
         uint8_t reason = disconn ? disconn->reason : 0;
-        schedule_retry_with_reason(reason);
+        if (s_ip[0] != '\0') {
+            // Lost an established link: start a new round (we may have changed rooms)
+            s_ip[0] = '\0';
+            schedule_retry_with_reason(reason);
+            return;
+        }
+        wifi_profiles_record_failure(&s_profiles, s_active_profile);
+        s_cand_idx++;
+        if (s_cand_idx < s_cand_count) {
+            ESP_LOGW(TAG, "WiFi attempt failed: %s (reason %d), trying next candidate",
+                     get_disconnect_reason_str(reason, NULL), reason);
+        }
+        try_candidate(reason);
     }
 }
 
@@ -338,8 +529,31 @@ static void ip_event_handler(void *arg, esp_event_base_t event_base, int32_t eve
     // Debug: Verify hostname persists after connection
     const char *check_hostname = NULL;
     esp_netif_get_hostname(s_sta_netif, &check_hostname);
+    char ssid[33];
+    wifi_mgr_get_ssid(ssid, sizeof(ssid));
     ESP_LOGI(TAG, "Connected to WiFi SSID: '%s', IP: %s, hostname: %s",
-             s_cfg.ssid, s_ip, check_hostname ? check_hostname : "NULL");
+             ssid, s_ip, check_hostname ? check_hostname : "NULL");
+
+    // Connect time (association + DHCP) goes into the profile, along with the AP it
+    // joined as the hint for next time
+    int64_t now_us = esp_timer_get_time();
+    uint32_t connect_ms = (uint32_t)((now_us - s_connect_start_us) / 1000);
+    wifi_ap_record_t ap;
+    if (s_active_profile >= 0 && esp_wifi_sta_get_ap_info(&ap) == ESP_OK) {
+        if (wifi_profiles_record_success(&s_profiles, s_active_profile, ap.bssid, ap.primary, connect_ms)) {
+            platform_storage_save_wifi_profiles(&s_profiles);
+        }
+        const wifi_profile_t *p = &s_profiles.profiles[s_active_profile];
+        ESP_LOGI(TAG, "'%s' connected in %lu ms (avg %lu, max %lu over %lu connects, %lu failed attempts)",
+                 p->ssid, (unsigned long)connect_ms, (unsigned long)p->connect_ms_avg,
+                 (unsigned long)p->connect_ms_max, (unsigned long)p->connects, (unsigned long)p->failures);
+    }
+    if (!s_boot_reported) {
+        s_boot_reported = true;
+        ESP_LOGI(TAG, "Boot to IP: %lu ms (scan %lu ms, connect %lu ms, attempt %d)",
+                 (unsigned long)(now_us / 1000), (unsigned long)s_round_scan_ms, (unsigned long)connect_ms,
+                 s_cand_idx + 1);
+    }
 
     // Re-assert hostname after IP acquisition to force DHCP INFORM
     // Some routers (UniFi) may need this to solidify the hostname
@@ -390,7 +604,11 @@ static void start_ap_mode(void) {
         },
     };
 
-    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_AP));
+    // AP+STA so the background scans for the portal's network list can run.
+    // s_ap_mode goes up first: the STA_START this causes must not start a connect.
+    s_ap_mode = true;
+    s_scanning = false;
+    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_APSTA));
     ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_AP, &ap_config));
     ESP_ERROR_CHECK(esp_wifi_start());
 
@@ -404,12 +622,18 @@ static void start_ap_mode(void) {
         ESP_LOGW(TAG, "AP mode: Could not set TX power: %s", esp_err_to_name(tx_err));
     }
 
-    s_ap_mode = true;
     s_sta_fail_count = 0;
 
     // Start captive portal HTTP server
     captive_portal_start();
 
+    // Refresh the network list now, then periodically
+    s_portal_scan_us = 0;
+    portal_scan_timer_cb(NULL);
+    if (s_portal_scan_timer) {
+        esp_timer_start_periodic(s_portal_scan_timer, PORTAL_SCAN_INTERVAL_MS * 1000ULL);
+    }
+
     // Notify UI that we're in AP mode (IP is always 192.168.4.1 for AP)
     rk_net_evt_cb(RK_NET_EVT_AP_STARTED, "192.168.4.1");
 }
@@ -460,6 +684,12 @@ void wifi_mgr_start(void) {
     };
     ESP_ERROR_CHECK(esp_timer_create(&retry_args, &s_retry_timer));
 
+    const esp_timer_create_args_t portal_scan_args = {
+        .callback = &portal_scan_timer_cb,
+        .name = "wifi_portal_scan",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&portal_scan_args, &s_portal_scan_timer));
+
     ESP_ERROR_CHECK(esp_wifi_start());
 
     // Reduce WiFi TX power for battery operation (11 dBm instead of 20 dBm)
@@ -492,6 +722,9 @@ void wifi_mgr_reconnect(const rk_cfg_t *cfg) {
     if (!platform_storage_save(&s_cfg)) {
         ESP_LOGW(TAG, "failed to persist cfg");
     }
+    if (wifi_profiles_upsert(&s_profiles, s_cfg.ssid, s_cfg.pass) >= 0) {
+        platform_storage_save_wifi_profiles(&s_profiles);
+    }
     reset_backoff();
     s_sta_fail_count = 0;  // Reset failure count for new credentials
 
@@ -544,6 +777,11 @@ void wifi_mgr_get_ssid(char *buf, size_t n) {
     if (!s_cfg_loaded) {
         ensure_cfg_loaded();
     }
+    // The network being tried or joined; before any attempt, the one provisioned last
+    if (s_active_profile >= 0 && s_active_profile < s_profiles.count) {
+        copy_str(buf, n, s_profiles.profiles[s_active_profile].ssid);
+        return;
+    }
     copy_str(buf, n, s_cfg.ssid);
 }
 
@@ -574,10 +812,13 @@ void wifi_mgr_stop(void) {
     esp_event_handler_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, &wifi_event_handler);
     esp_event_handler_unregister(IP_EVENT, IP_EVENT_STA_GOT_IP, &ip_event_handler);
 
-    // Stop retry timer
+    // Stop retry and portal scan timers
     if (s_retry_timer) {
         esp_timer_stop(s_retry_timer);
     }
+    if (s_portal_scan_timer) {
+        esp_timer_stop(s_portal_scan_timer);
+    }
 
     // Stop captive portal if running
     captive_portal_stop();
@@ -590,6 +831,8 @@ void wifi_mgr_stop(void) {
     // Just mark as stopped so we can restart later
     s_started = false;
     s_ap_mode = false;
+    s_scanning = false;
+    s_portal_scanning = false;
     s_sta_fail_count = 0;
     s_ip[0] = '\0';
 
@@ -603,6 +846,11 @@ void wifi_mgr_stop_ap(void) {
 
     ESP_LOGI(TAG, "Stopping AP mode, switching to STA");
 
+    if (s_portal_scan_timer) {
+        esp_timer_stop(s_portal_scan_timer);
+    }
+    s_portal_scanning = false;
+
     // Stop captive portal first
     captive_portal_stop();
 
@@ -636,6 +884,14 @@ void wifi_mgr_set_power_save(bool enable) {
     }
 }
 
+int wifi_mgr_get_rssi(void) {
+    wifi_ap_record_t ap;
+    if (!s_started || s_ap_mode || esp_wifi_sta_get_ap_info(&ap) != ESP_OK) {
+        return 0;
+    }
+    return ap.rssi;
+}
+
 __attribute__((weak)) void rk_net_evt_cb(rk_net_evt_t evt, const char *ip_opt) {
     (void)evt;
     (void)ip_opt;
@@ -30,6 +30,7 @@ const char *wifi_mgr_get_last_error(void);   // get last disconnect reason strin
 int wifi_mgr_get_retry_count(void);          // get current retry attempt count (0 = connected)
 int wifi_mgr_get_retry_max(void);            // get max retries before AP mode
 void wifi_mgr_set_power_save(bool enable);   // enable/disable WiFi modem sleep
+int wifi_mgr_get_rssi(void);                  // current AP signal in dBm, 0 if not connected
 
 // weak callback the UI can override (or register separately)
 void rk_net_evt_cb(rk_net_evt_t evt, const char *ip_opt);
@@ -4,6 +4,10 @@ set -euo pipefail
 cmake -S pc_sim -B build_pc_ci
 cmake --build build_pc_ci
 
+cmake -S tests/host -B build_tests_ci
+cmake --build build_tests_ci
+ctest --test-dir build_tests_ci --output-on-failure
+
 pushd idf_app >/dev/null
 idf.py build
 popd >/dev/null
@@ -15,6 +19,14 @@ if [[ -n "$WARNINGS" ]]; then
   exit 1
 fi
 
+# Platform shims in common/ are the host side; device code lives in idf_app/main/*_idf.c
+WARNINGS=$(rg -n --glob '*.[ch]' '#include ["<](esp_|freertos/)' common/platform || true)
+if [[ -n "$WARNINGS" ]]; then
+  echo "ESP-IDF includes found in common/platform/" >&2
+  echo "$WARNINGS" >&2
+  exit 1
+fi
+
 WARNINGS=$(rg -n --glob '*.[ch]' "SDL_" common || true)
 if [[ -n "$WARNINGS" ]]; then
   echo "SDL_ symbols found in common/" >&2
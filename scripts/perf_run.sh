@@ -0,0 +1,102 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# Scripted performance run against a knob built with CONFIG_RK_TEST_API
+#
+# Usage: ./scripts/perf_run.sh <knob-ip> [--baseline FILE] [--save-baseline] [--threshold PCT] [scenario...]
+#
+# Runs each scenario on the device (default: all), prints its measurements and
+# compares them with the baseline file. Exits 1 if a frame time or input latency
+# grew by more than the threshold (default 20%), a scenario failed, or a scenario
+# now leaks internal heap it didn't before. --save-baseline writes this run as
+# the new baseline instead of comparing.
+#
+# Requires curl and jq.
+
+SCENARIOS_ALL=(spin_volume open_picker switch_zone art_mode)
+BASELINE="perf_baseline.json"
+SAVE=0
+THRESHOLD=20
+TIMING_FLOOR_US=1000   # Ignore growth smaller than this (timer and scheduling noise)
+HEAP_FLOOR=1024        # Bytes of extra heap loss per run that counts as a leak
+
+show_usage() {
+    sed -n '4,14p' "$0" | sed 's/^# \{0,1\}//'
+    exit 1
+}
+
+if [[ $# -lt 1 || "$1" == -* ]]; then
+    show_usage
+fi
+HOST="$1"
+shift
+
+SCENARIOS=()
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --baseline) BASELINE="$2"; shift 2 ;;
+        --save-baseline) SAVE=1; shift ;;
+        --threshold) THRESHOLD="$2"; shift 2 ;;
+        -h|--help) show_usage ;;
+        *) SCENARIOS+=("$1"); shift ;;
+    esac
+done
+if [[ ${#SCENARIOS[@]} -eq 0 ]]; then
+    SCENARIOS=("${SCENARIOS_ALL[@]}")
+fi
+
+for tool in curl jq; do
+    if ! command -v "$tool" >/dev/null; then
+        echo "Error: $tool is required" >&2
+        exit 1
+    fi
+done
+
+RESULTS="[]"
+for name in "${SCENARIOS[@]}"; do
+    echo "Running $name..." >&2
+    if ! result=$(curl -sf -X POST --max-time 60 "http://$HOST/test/run?name=$name"); then
+        echo "Error: $name failed (is CONFIG_RK_TEST_API enabled on $HOST?)" >&2
+        exit 1
+    fi
+    RESULTS=$(jq --argjson r "$result" '. + [$r]' <<<"$RESULTS")
+done
+
+jq -r '["scenario", "ok", "frames", "frame_avg", "frame_max", "inputs", "lat_avg", "lat_max", "heap_int", "heap_psram"],
+       (.[] | [.scenario, .ok, .frames, .frame_avg_us, .frame_max_us, .inputs, .latency_avg_us,
+               .latency_max_us, .heap_internal_delta, .heap_psram_delta])
+       | @tsv' <<<"$RESULTS" |
+    while IFS=$'\t' read -r -a row; do
+        printf '%-12s %-5s %6s %9s %9s %6s %8s %8s %8s %10s\n' "${row[@]}"
+    done
+
+if [[ $SAVE -eq 1 ]]; then
+    jq '.' <<<"$RESULTS" >"$BASELINE"
+    echo "Baseline saved to $BASELINE" >&2
+    exit 0
+fi
+
+if [[ ! -f "$BASELINE" ]]; then
+    echo "No baseline at $BASELINE; rerun with --save-baseline to record one" >&2
+    exit 0
+fi
+
+REGRESSIONS=$(jq -r --slurpfile base "$BASELINE" \
+    --argjson pct "$THRESHOLD" --argjson floor "$TIMING_FLOOR_US" --argjson heap "$HEAP_FLOOR" '
+    .[] as $cur
+    | ($base[0][] | select(.scenario == $cur.scenario)) as $old
+    | (if $cur.ok | not then "\($cur.scenario): scenario failed" else empty end),
+      (["frame_avg_us", "frame_max_us", "latency_avg_us", "latency_max_us"][] as $k
+       | select($cur[$k] > $old[$k] * (1 + $pct / 100) and $cur[$k] - $old[$k] > $floor)
+       | "\($cur.scenario): \($k) \($old[$k]) -> \($cur[$k])"),
+      (select($cur.heap_internal_delta < $old.heap_internal_delta - $heap)
+       | "\($cur.scenario): heap_internal_delta \($old.heap_internal_delta) -> \($cur.heap_internal_delta)")
+    ' <<<"$RESULTS")
+
+if [[ -n "$REGRESSIONS" ]]; then
+    echo "" >&2
+    echo "Regressions against $BASELINE (threshold ${THRESHOLD}%):" >&2
+    echo "$REGRESSIONS" >&2
+    exit 1
+fi
+echo "No regressions against $BASELINE" >&2
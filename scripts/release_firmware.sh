@@ -46,6 +46,12 @@ if ! git -C "$ROOT_DIR" diff --quiet || ! git -C "$ROOT_DIR" diff --cached --qui
     exit 1
 fi
 
+# The test API lets anyone on the network drive the knob; keep it out of releases
+if grep -qE '^CONFIG_RK_TEST_API=y' "$ROOT_DIR/idf_app/sdkconfig.defaults"; then
+    echo "Error: CONFIG_RK_TEST_API is enabled in idf_app/sdkconfig.defaults."
+    exit 1
+fi
+
 # Check if tag already exists
 if git -C "$ROOT_DIR" tag -l "v$NEW_VERSION" | grep -q "v$NEW_VERSION"; then
     echo "Error: Tag v$NEW_VERSION already exists."
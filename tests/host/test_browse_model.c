@@ -0,0 +1,190 @@
+#include "test_util.h"
+#include "browse_model.h"
+
+// Synthetic library: root -> 600 artists -> 12 albums each -> 10 tracks each. The stand-in
+// bridge pages with opaque cursors that need URL encoding ("+/=" included).
+#define ARTISTS 600
+#define ALBUMS 12
+#define TRACKS 10
+
+static int s_fetches;
+
+static int level_size(const char *key) {
+    if (!key[0]) return 1;  // Root: "Library"
+    if (strcmp(key, "library") == 0) return ARTISTS;
+    if (strncmp(key, "artist:", 7) == 0 && !strchr(key + 7, '/')) return ALBUMS;
+    return TRACKS;
+}
+
+// One browse page for `key` starting at the offset encoded in `cursor`
+static void bridge_fetch(browse_level_t *lvl, int page, const char *cursor) {
+    static paged_list_item_t items[PAGED_LIST_PAGE_SIZE];
+    int offset = 0;
+    if (page > 0) {
+        CHECK(sscanf(cursor, "c+%d/=", &offset) == 1);
+        CHECK_EQ(offset, page * PAGED_LIST_PAGE_SIZE);  // Chained from the previous page
+    }
+    int size = level_size(lvl->key);
+    int count = 0;
+    for (int i = offset; i < size && count < PAGED_LIST_PAGE_SIZE; i++, count++) {
+        paged_list_item_t *it = &items[count];
+        memset(it, 0, sizeof(*it));
+        if (!lvl->key[0]) {
+            snprintf(it->id, sizeof(it->id), "library");
+        } else if (strcmp(lvl->key, "library") == 0) {
+            snprintf(it->id, sizeof(it->id), "artist:%d", i);
+        } else {
+            snprintf(it->id, sizeof(it->id), "%.32s/%d", lvl->key, i);
+        }
+        snprintf(it->line1, sizeof(it->line1), "Item %d", i);
+        it->flags = level_size(it->id) > 0 ? PAGED_LIST_ITEM_CONTAINER : 0;
+    }
+    char next[PAGED_LIST_CURSOR_LEN] = "";
+    if (offset + count < size) {
+        snprintf(next, sizeof(next), "c+%d/=", offset + count);
+    }
+    s_fetches++;
+    CHECK(paged_list_store(&lvl->list, lvl->list.generation, page, -1, items, count, next));
+}
+
+// Show the current level with `selected` highlighted, fetching as the UI would
+static browse_level_t *show(browse_model_t *model, int selected, bool *was_cached) {
+    browse_level_t *lvl = browse_model_level(model, was_cached);
+    browse_model_crumb(model)->selected = selected;
+    int page;
+    while ((page = paged_list_next_fetch(&lvl->list, selected, selected)) >= 0) {
+        bridge_fetch(lvl, page, paged_list_cursor(&lvl->list, page));
+    }
+    CHECK(paged_list_get(&lvl->list, selected) != NULL);
+    return lvl;
+}
+
+// Scroll down to `target` one detent at a time (cursor lists can't jump ahead)
+static void scroll_to(browse_model_t *model, int target, bool *was_cached) {
+    show(model, 0, was_cached);
+    for (int sel = 1; sel <= target; sel++) {
+        show(model, sel, NULL);
+    }
+}
+
+static void test_cursor_paging(void) {
+    static browse_model_t model;
+    browse_model_init(&model, "Library");
+    bool cached;
+    s_fetches = 0;
+    show(&model, 0, &cached);
+    CHECK(!cached);
+    CHECK(browse_model_push(&model, "library", "Artists"));
+
+    // Scroll all artists: each page is fetched once with the cursor the previous one
+    // returned, and the placeholder row keeps the list open until the last page
+    browse_level_t *lvl = NULL;
+    s_fetches = 0;
+    for (int sel = 0; sel < ARTISTS; sel++) {
+        lvl = show(&model, sel, NULL);
+        if (sel < ARTISTS - PAGED_LIST_PAGE_SIZE) {
+            CHECK(lvl->list.total > sel + 1);
+        }
+    }
+    CHECK_EQ(s_fetches, ARTISTS / PAGED_LIST_PAGE_SIZE);
+    CHECK_EQ(lvl->list.total, ARTISTS);
+    CHECK(paged_list_get(&lvl->list, ARTISTS) == NULL);
+
+    // Back to the top: evicted pages are refetched from their kept cursors
+    s_fetches = 0;
+    show(&model, 0, NULL);
+    CHECK(s_fetches >= 1 && s_fetches <= 2);
+}
+
+// Prefetch: approaching a page edge requests the next page before it is visible
+static void test_prefetch(void) {
+    static browse_model_t model;
+    browse_model_init(&model, "Library");
+    browse_model_push(&model, "library", "Artists");
+    browse_level_t *lvl = show(&model, 0, NULL);
+    int edge = PAGED_LIST_PAGE_SIZE - PAGED_LIST_PREFETCH_ITEMS;
+    CHECK_EQ(paged_list_next_fetch(&lvl->list, edge - 1, edge - 1), -1);
+    CHECK_EQ(paged_list_next_fetch(&lvl->list, edge, edge), 1);
+    CHECK_STR(paged_list_cursor(&lvl->list, 1), "c+20/=");
+}
+
+static void test_back_navigation_is_instant(void) {
+    static browse_model_t model;
+    browse_model_init(&model, "Library");
+    bool cached;
+    show(&model, 0, &cached);
+    browse_model_push(&model, "library", "Artists");
+    scroll_to(&model, 123, &cached);
+    browse_model_push(&model, "artist:123", "Artist 123");
+    scroll_to(&model, 4, &cached);
+    browse_model_push(&model, "artist:123/4", "Album 4");
+    scroll_to(&model, 7, &cached);
+    CHECK_EQ(model.depth, 4);
+
+    // Back out to the artists: no fetches, and the selection is where it was
+    s_fetches = 0;
+    CHECK(browse_model_pop(&model));
+    show(&model, browse_model_crumb(&model)->selected, &cached);
+    CHECK(cached);
+    CHECK(browse_model_pop(&model));
+    CHECK_EQ(browse_model_crumb(&model)->selected, 123);
+    show(&model, 123, &cached);
+    CHECK(cached);
+    CHECK_EQ(s_fetches, 0);
+    CHECK(browse_model_pop(&model));
+    CHECK(!browse_model_pop(&model));  // Root
+
+    // Visiting more levels than the cache holds evicts the least recently used
+    for (int a = 0; a < BROWSE_LEVEL_CACHE; a++) {
+        char key[32];
+        snprintf(key, sizeof(key), "artist:%d", 200 + a);
+        browse_model_push(&model, key, "Artist");
+        show(&model, 0, &cached);
+        CHECK(!cached);
+        browse_model_pop(&model);
+    }
+    browse_model_push(&model, "library", "Artists");
+    s_fetches = 0;
+    show(&model, 0, &cached);
+    CHECK(!cached);
+    CHECK(s_fetches > 0);
+}
+
+// Responses are routed to their level by generation; a recycled level drops late answers
+static void test_generation_routing(void) {
+    static browse_model_t model;
+    browse_model_init(&model, "Library");
+    browse_level_t *root = browse_model_level(&model, NULL);
+    uint32_t root_gen = root->list.generation;
+    browse_model_push(&model, "library", "Artists");
+    browse_level_t *artists = browse_model_level(&model, NULL);
+    CHECK(artists->list.generation != root_gen);
+    CHECK(browse_model_find_generation(&model, root_gen) == root);
+    CHECK(browse_model_find_generation(&model, artists->list.generation) == artists);
+
+    for (int a = 0; a < BROWSE_LEVEL_CACHE; a++) {
+        char key[32];
+        snprintf(key, sizeof(key), "artist:%d", a);
+        browse_model_push(&model, key, "Artist");
+        browse_model_level(&model, NULL);
+        browse_model_pop(&model);
+    }
+    CHECK(browse_model_find_generation(&model, root_gen) == NULL);
+
+    // Depth limit
+    browse_model_init(&model, "Library");
+    for (int d = 1; d < BROWSE_MAX_DEPTH; d++) {
+        CHECK(browse_model_push(&model, "x", "X"));
+    }
+    CHECK(!browse_model_push(&model, "x", "X"));
+    CHECK(!browse_model_push(&model, "", "X"));
+}
+
+int main(void) {
+    test_cursor_paging();
+    test_prefetch();
+    test_back_navigation_is_instant();
+    test_generation_routing();
+    puts("browse_model: ok");
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include "test_util.h"
+#include "chip_link.h"
+
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+static chip_link_now_playing_t sample_now_playing(uint32_t seq) {
+    chip_link_now_playing_t np = {
+        .seq = seq,
+        .playing = true,
+        .volume = -23.5f,
+        .volume_min = -80,
+        .volume_max = 0,
+        .volume_step = 0.5f,
+        .seek_position = 61,
+        .length = 545,
+    };
+    strcpy(np.line1, "So What");
+    strcpy(np.line2, "Miles Davis");
+    return np;
+}
+
+static void test_field_roundtrip(void) {
+    chip_link_watch_t w = {"Home", "secret", "http://10.0.0.5:8088", "zone-1", 5000}, w2;
+    uint8_t buf[CHIP_LINK_MAX_PAYLOAD];
+    size_t len = chip_link_watch_encode(&w, buf, sizeof(buf));
+    CHECK(len > 0);
+    CHECK(chip_link_watch_decode(buf, len, &w2));
+    CHECK_STR(w2.ssid, "Home");
+    CHECK_STR(w2.pass, "secret");
+    CHECK_STR(w2.bridge_base, "http://10.0.0.5:8088");
+    CHECK_STR(w2.zone_id, "zone-1");
+    CHECK_EQ(w2.interval_ms, 5000);
+
+    chip_link_now_playing_t np = sample_now_playing(42), np2;
+    len = chip_link_now_playing_encode(&np, buf, sizeof(buf));
+    CHECK(len > 0);
+    CHECK(chip_link_now_playing_decode(buf, len, &np2));
+    CHECK_EQ(np2.seq, 42);
+    CHECK(np2.playing);
+    CHECK(np2.volume == -23.5f && np2.volume_step == 0.5f);
+    CHECK_EQ(np2.seek_position, 61);
+    CHECK_EQ(np2.length, 545);
+    CHECK_STR(np2.line1, "So What");
+    CHECK_STR(np2.line2, "Miles Davis");
+
+    // Truncated field
+    size_t off = 0;
+    uint8_t tag, flen;
+    const uint8_t *data;
+    CHECK(chip_link_put_str(buf, sizeof(buf), &off, 1, "abcdef"));
+    CHECK(!chip_link_next_field(buf, off - 1, &(size_t){0}, &tag, &data, &flen));
+    CHECK(!chip_link_put_str(buf, 4, &(size_t){0}, 1, "abcdef"));
+}
+
+static void test_empty_frame(void) {
+    uint8_t frame[16];
+    size_t n = chip_link_encode(CHIP_LINK_CMD_PING, NULL, 0, frame, sizeof(frame));
+    CHECK_EQ(n, CHIP_LINK_OVERHEAD);
+    CHECK_EQ(frame[0], CHIP_LINK_START);
+    CHECK_EQ(frame[n - 1], CHIP_LINK_END);
+
+    chip_link_decoder_t d;
+    chip_link_decoder_init(&d);
+    int complete = 0;
+    for (size_t i = 0; i < n; i++) {
+        complete += chip_link_feed(&d, frame[i]);
+    }
+    CHECK_EQ(complete, 1);
+    CHECK_EQ(d.type, CHIP_LINK_CMD_PING);
+    CHECK_EQ(d.len, 0);
+
+    CHECK_EQ(chip_link_encode(CHIP_LINK_CMD_PING, NULL, 0, frame, CHIP_LINK_OVERHEAD - 1), 0);
+    CHECK_EQ(chip_link_encode(CHIP_LINK_CMD_PING, frame, CHIP_LINK_MAX_PAYLOAD + 1, frame, sizeof(frame)), 0);
+}
+
+// A stream of now-playing frames with line noise between them and every 11th frame
+// corrupted: the decoder resynchronises on the next start byte. Without byte stuffing a
+// corrupted frame can take the one after it down too (a bad CRC byte that happens to be
+// 0x7E looks like a start byte), but nothing further.
+static void test_noisy_stream(void) {
+    enum { FRAMES = 500 };
+    static uint8_t stream[FRAMES * (CHIP_LINK_MAX_FRAME + 8)];
+    size_t used = 0;
+    int corrupted = 0;
+    for (int i = 0; i < FRAMES; i++) {
+        if (i % 7 == 0) {
+            static const uint8_t junk[] = {0x7E, 0x40, 0xFF, 0x01, 0x7E, 0x33, 0x7F};
+            memcpy(stream + used, junk, sizeof(junk));
+            used += sizeof(junk);
+        }
+        chip_link_now_playing_t np = sample_now_playing(i);
+        uint8_t payload[CHIP_LINK_MAX_PAYLOAD];
+        size_t len = chip_link_now_playing_encode(&np, payload, sizeof(payload));
+        size_t n = chip_link_encode(CHIP_LINK_EVT_NOW_PLAYING, payload, len, stream + used, CHIP_LINK_MAX_FRAME);
+        CHECK(n > 0);
+        if (i % 11 == 5) {
+            stream[used + 10] ^= 0x5A;
+            corrupted++;
+        }
+        used += n;
+    }
+
+    chip_link_decoder_t d;
+    chip_link_decoder_init(&d);
+    static bool received[FRAMES];
+    int got = 0;
+    long last = -1;
+    for (size_t i = 0; i < used; i++) {
+        if (!chip_link_feed(&d, stream[i])) continue;
+        CHECK_EQ(d.type, CHIP_LINK_EVT_NOW_PLAYING);
+        chip_link_now_playing_t np;
+        CHECK(chip_link_now_playing_decode(d.payload, d.len, &np));
+        CHECK((long)np.seq > last);
+        CHECK(np.seq % 11 != 5);
+        CHECK_STR(np.line2, "Miles Davis");
+        last = np.seq;
+        received[np.seq] = true;
+        got++;
+    }
+    for (int i = 0; i < FRAMES; i++) {
+        if (i % 11 != 5 && i % 11 != 6) {
+            CHECK(received[i]);
+        }
+    }
+    CHECK(got >= FRAMES - 2 * corrupted);
+    CHECK_EQ(last, FRAMES - 1);
+    CHECK(d.crc_errors > 0);
+}
+
+static void test_wake_reason(void) {
+    chip_link_now_playing_t a = sample_now_playing(1), b = a;
+    b.seek_position += 30;
+    b.volume = -10;
+    CHECK_EQ(chip_link_now_playing_wake_reason(&a, &b), 0);
+    b.playing = false;
+    CHECK_EQ(chip_link_now_playing_wake_reason(&a, &b), CHIP_LINK_WAKE_PLAYBACK);
+    strcpy(b.line1, "Freddie Freeloader");
+    CHECK_EQ(chip_link_now_playing_wake_reason(&a, &b), CHIP_LINK_WAKE_TRACK | CHIP_LINK_WAKE_PLAYBACK);
+}
+
+// The same framing across a real tty (pseudo-terminal pair in raw mode, like the UART
+// driver): frames written in odd-sized chunks, read back in other odd sizes so every
+// frame is split across reads, with one byte corrupted in transit
+static void test_over_pty(void) {
+    int master, slave;
+    CHECK(openpty(&master, &slave, NULL, NULL, NULL) == 0);
+    struct termios tio;
+    CHECK(tcgetattr(slave, &tio) == 0);
+    cfmakeraw(&tio);
+    CHECK(tcsetattr(slave, TCSANOW, &tio) == 0);
+
+    enum { FRAMES = 200, CORRUPT = 77 };
+    static const int write_chunks[] = {1, 7, 64, 3, 200};
+    static const int read_chunks[] = {5, 1, 33, 128, 2};
+    chip_link_decoder_t d;
+    chip_link_decoder_init(&d);
+    int got = 0, w = 0, r = 0;
+    long last = -1;
+
+    for (int i = 0; i < FRAMES; i++) {
+        chip_link_now_playing_t np = sample_now_playing(i);
+        uint8_t payload[CHIP_LINK_MAX_PAYLOAD], frame[CHIP_LINK_MAX_FRAME];
+        size_t len = chip_link_now_playing_encode(&np, payload, sizeof(payload));
+        size_t n = chip_link_encode(CHIP_LINK_EVT_NOW_PLAYING, payload, len, frame, sizeof(frame));
+        CHECK(n > 0);
+        if (i == CORRUPT) {
+            frame[n / 2] ^= 0x10;
+        }
+        for (size_t off = 0; off < n;) {
+            size_t chunk = (size_t)write_chunks[w++ % 5];
+            if (chunk > n - off) chunk = n - off;
+            CHECK(write(master, frame + off, chunk) == (ssize_t)chunk);
+            off += chunk;
+        }
+
+        // Drain what this frame put on the line
+        for (size_t pending = n; pending > 0;) {
+            uint8_t buf[256];
+            size_t want = (size_t)read_chunks[r++ % 5];
+            if (want > pending) want = pending;
+            ssize_t k = read(slave, buf, want);
+            CHECK(k > 0);
+            pending -= (size_t)k;
+            for (ssize_t j = 0; j < k; j++) {
+                if (!chip_link_feed(&d, buf[j])) continue;
+                chip_link_now_playing_t out;
+                CHECK(chip_link_now_playing_decode(d.payload, d.len, &out));
+                CHECK((long)out.seq > last);
+                CHECK_STR(out.line1, "So What");
+                last = out.seq;
+                got++;
+            }
+        }
+    }
+    close(slave);
+    close(master);
+
+    CHECK(got >= FRAMES - 2);  // The corrupted frame, and at most the one after it
+    CHECK_EQ(last, FRAMES - 1);
+    CHECK(d.crc_errors + d.framing_errors >= 1);
+}
+
+int main(void) {
+    test_field_roundtrip();
+    test_empty_frame();
+    test_noisy_stream();
+    test_wake_reason();
+    test_over_pty();
+    puts("chip_link: ok");
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include "test_util.h"
+#include "encoder_decode.h"
+
+#define TRACE_MAX 20000
+
+// Sampled pin levels, both idle high
+typedef struct {
+    uint8_t a[TRACE_MAX];
+    uint8_t b[TRACE_MAX];
+    int len;
+} trace_t;
+
+static void trace_idle(trace_t *t, int samples) {
+    for (int i = 0; i < samples; i++, t->len++) {
+        t->a[t->len] = 1;
+        t->b[t->len] = 1;
+    }
+}
+
+// One detent: the channel for `dir` goes low for `low` samples, with `bounce` one-sample
+// glitches on either edge
+static void trace_detent(trace_t *t, int dir, int low, int bounce) {
+    uint8_t *ch = dir > 0 ? t->a : t->b;
+    uint8_t *other = dir > 0 ? t->b : t->a;
+    int start = t->len;
+    for (int k = 0; k < bounce; k++) {
+        ch[t->len++] = 0;
+        ch[t->len++] = 1;
+    }
+    for (int k = 0; k < low; k++) {
+        ch[t->len++] = 0;
+    }
+    for (int k = 0; k < bounce; k++) {
+        ch[t->len++] = 1;
+        ch[t->len++] = 0;
+    }
+    for (int i = start; i < t->len; i++) {
+        other[i] = 1;
+    }
+    trace_idle(t, 1);
+}
+
+static int decode(const trace_t *t, int from, int to) {
+    encoder_decode_t d;
+    encoder_decode_init(&d, t->a[from], t->b[from]);
+    for (int i = from + 1; i < to; i++) {
+        encoder_decode_sample(&d, t->a[i], t->b[i]);
+    }
+    return d.count;
+}
+
+// 150 detents one way then 50 back at 3ms sampling
+static int turn(int low, int bounce, int gap) {
+    static trace_t t;
+    t.len = 0;
+    trace_idle(&t, 4);
+    for (int k = 0; k < 200; k++) {
+        trace_detent(&t, k < 150 ? 1 : -1, low, bounce);
+        trace_idle(&t, gap);
+    }
+    return decode(&t, 0, t.len);
+}
+
+static void test_detent_trains(void) {
+    CHECK_EQ(turn(10, 0, 10), 100);  // Slow: 30ms per detent
+    CHECK_EQ(turn(ENCODER_DECODE_DEBOUNCE, 0, 2), 100);  // Fastest the debounce allows
+    CHECK_EQ(turn(6, 2, 4), 100);  // Contact bounce on both edges
+    CHECK_EQ(turn(ENCODER_DECODE_DEBOUNCE - 1, 0, 3), 0);  // 3ms glitches are not detents
+}
+
+static void test_single_sample_delta(void) {
+    encoder_decode_t d;
+    encoder_decode_init(&d, 1, 1);
+    CHECK_EQ(encoder_decode_sample(&d, 0, 1), 0);
+    CHECK_EQ(encoder_decode_sample(&d, 0, 0), 0);
+    CHECK_EQ(encoder_decode_sample(&d, 0, 0), 0);
+    CHECK_EQ(encoder_decode_sample(&d, 1, 0), 1);
+    CHECK_EQ(encoder_decode_sample(&d, 1, 1), -1);
+    CHECK_EQ(d.count, 0);
+}
+
+// Long holds must not wrap the debounce counter into a missed detent
+static void test_long_hold(void) {
+    encoder_decode_t d;
+    encoder_decode_init(&d, 1, 1);
+    for (int i = 0; i < 1000; i++) {
+        encoder_decode_sample(&d, 0, 1);
+    }
+    CHECK_EQ(encoder_decode_sample(&d, 1, 1), 1);
+}
+
+// Deep sleep hand-over: the ULP decodes the first half of a turn, the main firmware
+// starts from the pin levels at wake and decodes the rest; no detent is lost or doubled
+static void test_ulp_handover(void) {
+    static trace_t t;
+    t.len = 0;
+    trace_idle(&t, 4);
+    int split = 0;
+    for (int k = 0; k < 20; k++) {
+        if (k == 10) split = t.len + 1;
+        trace_detent(&t, 1, 4, 1);
+        trace_idle(&t, 3);
+    }
+    CHECK_EQ(decode(&t, 0, split) + decode(&t, split, t.len), 20);
+}
+
+int main(void) {
+    test_detent_trains();
+    test_single_sample_delta();
+    test_long_hold();
+    test_ulp_handover();
+    puts("encoder_decode: ok");
+    return 0;
+}
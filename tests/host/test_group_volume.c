@@ -0,0 +1,90 @@
+#include "test_util.h"
+#include "group_volume.h"
+
+#define TIMEOUT_MS 4000
+
+// Stand-in bridge: three members with different ranges and steps. Applies vol_group
+// bodies by parsing them back, like the bridge would.
+static group_output_t s_bridge[3] = {
+    {"o1", "Kitchen", -30, -80, 0, 1},
+    {"o2", "Den", 40, 0, 100, 2},
+    {"o3", "Patio", -10, -64, 0, 0.5f},
+};
+static uint32_t s_applied_seq = 0;
+
+static void bridge_apply(const char *body) {
+    char key[GROUP_VOLUME_ID_LEN + 32];
+    for (int i = 0; i < 3; i++) {
+        snprintf(key, sizeof(key), "\"output_id\":\"%.*s\",\"value\":", GROUP_VOLUME_ID_LEN - 1, s_bridge[i].id);
+        const char *p = strstr(body, key);
+        if (p) {
+            s_bridge[i].volume = (float)atof(p + strlen(key));
+        }
+    }
+    const char *seq = strstr(body, "\"seq\":");
+    CHECK(seq != NULL);
+    s_applied_seq = (uint32_t)atoi(seq + 6);
+}
+
+int main(void) {
+    group_volume_t g;
+    group_volume_init(&g, TIMEOUT_MS);
+    group_volume_update(&g, s_bridge, 3, true, 0, 0);
+    CHECK(group_volume_active(&g));
+
+    // Seven 3-step turns, each applied 180ms after it was sent; polls every 250ms
+    char pending[1024] = "";
+    uint64_t apply_at = 0;
+    uint32_t seq = 0;
+    float shown[3];
+    for (int i = 0; i < 3; i++) {
+        shown[i] = g.outputs[i].volume;
+    }
+    for (uint64_t t = 0; t < 3000; t += 10) {
+        if (t >= 100 && t <= 700 && t % 100 == 0) {
+            CHECK(group_volume_step(&g, 3, "z1", ++seq, t, pending, sizeof(pending)));
+            apply_at = t + 180;
+            for (int i = 0; i < 3; i++) {
+                shown[i] = g.outputs[i].volume;
+            }
+        }
+        if (apply_at && t == apply_at) {
+            bridge_apply(pending);
+            apply_at = 0;
+        }
+        if (t % 250 == 0) {
+            group_volume_update(&g, s_bridge, 3, true, s_applied_seq, t);
+            for (int i = 0; i < 3; i++) {
+                CHECK(g.outputs[i].volume >= shown[i] - 0.01f);  // No snap-back
+                shown[i] = g.outputs[i].volume;
+            }
+        }
+    }
+    // Each member moved by its own step, clamped to its own range
+    CHECK(g.outputs[0].volume == -9);
+    CHECK(g.outputs[1].volume == 82);
+    CHECK(g.outputs[2].volume == 0);
+    CHECK(strstr(pending, "\"action\":\"vol_group\"") != NULL);
+
+    // Membership change keeps the pending state of the remaining outputs
+    char body[1024];
+    group_volume_step(&g, -1, "z1", ++seq, 5000, body, sizeof(body));
+    group_output_t two[2] = {s_bridge[1], s_bridge[0]};
+    group_volume_update(&g, two, 2, true, s_applied_seq, 5100);
+    CHECK_EQ(g.count, 2);
+    CHECK(g.outputs[0].volume == 80);
+    CHECK(g.outputs[1].volume == -10);
+
+    // Failed command: the bridge state is shown again
+    group_volume_command_failed(&g, seq);
+    group_volume_update(&g, two, 2, true, s_applied_seq, 5200);
+    CHECK(g.outputs[0].volume == 82);
+
+    // Every member pinned at its limit: no request
+    group_output_t pinned[2] = {{"a", "A", 0, -80, 0, 1}, {"b", "B", 100, 0, 100, 1}};
+    group_volume_update(&g, pinned, 2, true, s_applied_seq, 6000);
+    CHECK(!group_volume_step(&g, 1, "z1", ++seq, 6000, body, sizeof(body)));
+
+    puts("group_volume: ok");
+    return 0;
+}
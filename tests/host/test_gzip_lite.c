@@ -0,0 +1,223 @@
+#include "test_util.h"
+#include "gzip_lite.h"
+
+#include <stdbool.h>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+// Reference inflater for what gzip_lite emits (RFC 1951 stored and fixed-Huffman blocks,
+// RFC 1952 member), written from the RFCs rather than from the encoder
+
+typedef struct {
+    const uint8_t *in;
+    size_t len;
+    size_t pos;  // In bits
+} bit_reader_t;
+
+static int get_bits(bit_reader_t *r, int n) {
+    int v = 0;
+    for (int i = 0; i < n; i++, r->pos++) {
+        CHECK(r->pos / 8 < r->len);
+        v |= ((r->in[r->pos / 8] >> (r->pos % 8)) & 1) << i;
+    }
+    return v;
+}
+
+// Huffman codes are packed most significant bit first
+static int get_code(bit_reader_t *r, int n) {
+    int v = 0;
+    for (int i = 0; i < n; i++) {
+        v = (v << 1) | get_bits(r, 1);
+    }
+    return v;
+}
+
+static int fixed_litlen(bit_reader_t *r) {
+    int code = get_code(r, 7);
+    if (code <= 0x17) return 256 + code;
+    code = (code << 1) | get_bits(r, 1);
+    if (code >= 0x30 && code <= 0xBF) return code - 0x30;
+    if (code >= 0xC0 && code <= 0xC7) return 280 + code - 0xC0;
+    code = (code << 1) | get_bits(r, 1);
+    CHECK(code >= 0x190 && code <= 0x1FF);
+    return 144 + code - 0x190;
+}
+
+static const int LEN_BASE[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const int LEN_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const int DIST_BASE[30] = {1,    2,    3,    4,    5,    7,    9,    13,    17,    25,
+                                  33,   49,   65,   97,   129,  193,  257,  385,   513,   769,
+                                  1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const int DIST_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+static uint32_t ref_crc32(const uint8_t *p, size_t n) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < n; i++) {
+        crc ^= p[i];
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static size_t ref_gunzip(const uint8_t *gz, size_t len, uint8_t *out, size_t cap) {
+    CHECK(len >= 18);
+    CHECK(gz[0] == 0x1F && gz[1] == 0x8B && gz[2] == 8);
+    CHECK_EQ(gz[3], 0);  // No optional fields
+    bit_reader_t r = {.in = gz, .len = len - 8, .pos = 10 * 8};
+    size_t n = 0;
+    int final;
+    do {
+        final = get_bits(&r, 1);
+        int type = get_bits(&r, 2);
+        if (type == 0) {
+            r.pos = (r.pos + 7) & ~(size_t)7;
+            int stored = get_bits(&r, 16);
+            CHECK_EQ(get_bits(&r, 16), stored ^ 0xFFFF);
+            for (int i = 0; i < stored; i++) {
+                CHECK(n < cap);
+                out[n++] = (uint8_t)get_bits(&r, 8);
+            }
+            continue;
+        }
+        CHECK_EQ(type, 1);  // gzip_lite only uses the fixed code
+        for (;;) {
+            int sym = fixed_litlen(&r);
+            if (sym < 256) {
+                CHECK(n < cap);
+                out[n++] = (uint8_t)sym;
+                continue;
+            }
+            if (sym == 256) break;
+            CHECK(sym <= 285);
+            int length = LEN_BASE[sym - 257] + get_bits(&r, LEN_EXTRA[sym - 257]);
+            int d = get_code(&r, 5);
+            CHECK(d < 30);
+            size_t dist = (size_t)(DIST_BASE[d] + get_bits(&r, DIST_EXTRA[d]));
+            CHECK(dist <= n && dist <= 32768);
+            CHECK(n + (size_t)length <= cap);
+            for (int i = 0; i < length; i++, n++) {
+                out[n] = out[n - dist];
+            }
+        }
+    } while (!final);
+
+    CHECK_EQ((r.pos + 7) / 8, len - 8);  // The trailer follows the last block
+    const uint8_t *t = gz + len - 8;
+    uint32_t crc = t[0] | t[1] << 8 | t[2] << 16 | (uint32_t)t[3] << 24;
+    uint32_t isize = t[4] | t[5] << 8 | t[6] << 16 | (uint32_t)t[7] << 24;
+    CHECK_EQ(crc, ref_crc32(out, n));
+    CHECK_EQ(isize, n);
+    return n;
+}
+
+#define GZ_MAX_INPUT 65536
+
+static uint8_t s_in[GZ_MAX_INPUT];
+static uint8_t s_gz[GZIP_LITE_BOUND(GZ_MAX_INPUT)];
+static uint8_t s_out[GZ_MAX_INPUT];
+static size_t s_total_in, s_total_gz;
+
+static void roundtrip(const uint8_t *in, size_t n) {
+    size_t gz = gzip_lite_compress(in, n, s_gz, GZIP_LITE_BOUND(n));
+    CHECK(gz > 0);
+    CHECK(gz <= GZIP_LITE_BOUND(n));
+    CHECK_EQ(ref_gunzip(s_gz, gz, s_out, sizeof(s_out)), n);
+    CHECK(n == 0 || memcmp(s_out, in, n) == 0);
+#ifdef HAVE_ZLIB
+    z_stream zs = {0};
+    CHECK(inflateInit2(&zs, 16 + MAX_WBITS) == Z_OK);  // gzip wrapper
+    zs.next_in = s_gz;
+    zs.avail_in = (uInt)gz;
+    zs.next_out = s_out;
+    zs.avail_out = sizeof(s_out);
+    CHECK(inflate(&zs, Z_FINISH) == Z_STREAM_END);
+    CHECK_EQ(zs.total_out, n);
+    CHECK(n == 0 || memcmp(s_out, in, n) == 0);
+    inflateEnd(&zs);
+#endif
+    s_total_in += n;
+    s_total_gz += gz;
+}
+
+static uint32_t s_rand = 12345;
+
+static uint32_t next_rand(void) {
+    s_rand = s_rand * 1103515245u + 12345u;
+    return s_rand >> 8;
+}
+
+// ~300 inputs: edge sizes, random bytes, small alphabets, long runs, text with
+// repeats at every distance class up to the 32 KB window, and the 64 KB limit
+static void test_roundtrips(void) {
+    roundtrip(s_in, 0);
+    s_in[0] = 'x';
+    roundtrip(s_in, 1);
+    roundtrip((const uint8_t *)"ab", 2);
+    roundtrip((const uint8_t *)"aaa", 3);
+
+    for (int t = 0; t < 100; t++) {
+        size_t n = next_rand() % 4096;
+        for (size_t i = 0; i < n; i++) s_in[i] = (uint8_t)next_rand();
+        roundtrip(s_in, n);
+    }
+    for (int t = 0; t < 100; t++) {
+        size_t n = next_rand() % 8192;
+        int alphabet = 1 + t % 6;
+        for (size_t i = 0; i < n; i++) s_in[i] = (uint8_t)('a' + next_rand() % alphabet);
+        roundtrip(s_in, n);
+    }
+    for (int t = 0; t < 60; t++) {
+        // A phrase repeated at a chosen distance, with noise between
+        size_t dist = (size_t)1 << (t % 16);
+        size_t n = dist * 2 + 300 < 40000 ? dist * 2 + 300 : 40000;
+        for (size_t i = 0; i < n; i++) s_in[i] = (uint8_t)next_rand();
+        memcpy(s_in + dist, s_in, n - dist < 300 ? n - dist : 300);
+        roundtrip(s_in, n);
+    }
+    for (int t = 0; t < 30; t++) {
+        size_t n = 1000 + next_rand() % 20000;
+        memset(s_in, 'z', n);
+        for (int k = 0; k < t; k++) s_in[next_rand() % n] = (uint8_t)next_rand();
+        roundtrip(s_in, n);
+    }
+
+    // HTML-like text, as the setup form is
+    static const char *words[] = {"<div class=\"row\">", "<input name=\"", "ssid", "\" value=\"", "\">",
+                                  "</div>\n", "<label>", "Bridge URL", "</label>", "  "};
+    size_t n = 0;
+    while (n < 3000) {
+        const char *w = words[next_rand() % 10];
+        size_t l = strlen(w);
+        memcpy(s_in + n, w, l);
+        n += l;
+    }
+    size_t before = s_total_gz;
+    roundtrip(s_in, n);
+    CHECK(s_total_gz - before < n * 6 / 10);
+
+    // Size limit: exactly 64 KB works, one more byte is refused
+    for (size_t i = 0; i < GZ_MAX_INPUT; i++) s_in[i] = (uint8_t)(i * 7 + (i >> 9));
+    roundtrip(s_in, GZ_MAX_INPUT);
+    static uint8_t big[GZ_MAX_INPUT + 1];
+    CHECK_EQ(gzip_lite_compress(big, GZ_MAX_INPUT + 1, s_gz, sizeof(s_gz)), 0);
+}
+
+static void test_small_output_buffer(void) {
+    for (size_t i = 0; i < 1000; i++) s_in[i] = (uint8_t)next_rand();
+    CHECK_EQ(gzip_lite_compress(s_in, 1000, s_gz, 500), 0);
+    CHECK_EQ(gzip_lite_compress(s_in, 1000, s_gz, 17), 0);
+    CHECK(gzip_lite_compress(s_in, 1000, s_gz, GZIP_LITE_BOUND(1000)) > 0);
+}
+
+int main(void) {
+    test_roundtrips();
+    test_small_output_buffer();
+    printf("gzip_lite: %zu -> %zu bytes over all inputs\n", s_total_in, s_total_gz);
+    puts("gzip_lite: ok");
+    return 0;
+}
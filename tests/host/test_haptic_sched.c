@@ -0,0 +1,75 @@
+#include "test_util.h"
+#include "haptic_sched.h"
+
+#define DETENT_MS 15
+#define CLAMP_MS 40
+
+static void test_slow_turn_clicks_every_detent(void) {
+    haptic_sched_t hs;
+    haptic_sched_init(&hs, DETENT_MS, CLAMP_MS);
+    haptic_sched_set_volume(&hs, 50, 0, 100, 1);
+    for (int i = 0; i < 10; i++) {
+        CHECK_EQ(haptic_sched_ticks(&hs, 1, true, 1000 + i * 100), HAPTIC_DETENT);
+    }
+    CHECK_EQ(haptic_sched_ticks(&hs, 0, true, 3000), HAPTIC_NONE);
+}
+
+// 100 detents in 300ms: one click per motor period instead of a buzz
+static void test_fast_spin_coalesces(void) {
+    haptic_sched_t hs;
+    haptic_sched_init(&hs, DETENT_MS, CLAMP_MS);
+    int clicks = 0;
+    uint64_t t = 5000;
+    for (int i = 0; i < 100; i++, t += 3) {
+        if (haptic_sched_ticks(&hs, 1, false, t) != HAPTIC_NONE) clicks++;
+    }
+    CHECK_EQ(clicks, 20);
+    CHECK_EQ(hs.played, 20);
+    CHECK_EQ(hs.suppressed, 80);
+}
+
+static void test_one_bump_per_push_at_limit(void) {
+    haptic_sched_t hs;
+    haptic_sched_init(&hs, DETENT_MS, CLAMP_MS);
+    haptic_sched_set_volume(&hs, 99, 0, 100, 1);
+    uint64_t t = 10000;
+    int detents = 0, clamps = 0;
+    for (int i = 0; i < 10; i++, t += 100) {
+        haptic_effect_t e = haptic_sched_ticks(&hs, 1, true, t);
+        if (e == HAPTIC_DETENT) detents++;
+        if (e == HAPTIC_CLAMP) clamps++;
+    }
+    CHECK_EQ(detents, 1);  // 99 -> 100 is predicted without waiting for the bridge
+    CHECK_EQ(clamps, 1);
+
+    // Backing off re-arms the bump
+    CHECK_EQ(haptic_sched_ticks(&hs, -1, true, t += 100), HAPTIC_DETENT);
+    CHECK_EQ(haptic_sched_ticks(&hs, 1, true, t += 100), HAPTIC_DETENT);
+    CHECK_EQ(haptic_sched_ticks(&hs, 1, true, t += 100), HAPTIC_CLAMP);
+
+    // Lower limit, and a clamp preempts a click still playing
+    haptic_sched_set_volume(&hs, 0, 0, 100, 1);
+    CHECK_EQ(haptic_sched_ticks(&hs, -1, true, t += 1), HAPTIC_CLAMP);
+    CHECK_EQ(haptic_sched_ticks(&hs, -1, true, t += 1), HAPTIC_NONE);
+}
+
+static void test_list_mode_ignores_limits(void) {
+    haptic_sched_t hs;
+    haptic_sched_init(&hs, DETENT_MS, CLAMP_MS);
+    haptic_sched_set_volume(&hs, 100, 0, 100, 1);
+    CHECK_EQ(haptic_sched_ticks(&hs, 1, false, 100), HAPTIC_DETENT);
+    CHECK_EQ(haptic_sched_ticks(&hs, 1, false, 200), HAPTIC_DETENT);
+
+    // Unknown range (no zone yet): plain clicks in volume mode too
+    haptic_sched_init(&hs, DETENT_MS, CLAMP_MS);
+    CHECK_EQ(haptic_sched_ticks(&hs, 1, true, 100), HAPTIC_DETENT);
+}
+
+int main(void) {
+    test_slow_turn_clicks_every_detent();
+    test_fast_spin_coalesces();
+    test_one_bump_per_push_at_limit();
+    test_list_mode_ignores_limits();
+    puts("haptic_sched: ok");
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "test_util.h"
+#include "hold_stats.h"
+
+static void test_single_holds(void) {
+    hold_stats_t h;
+    hold_stats_init(&h);
+    hold_stats_begin(&h, 1000);
+    hold_stats_end(&h, 1500);
+    hold_stats_begin(&h, 2000);
+    hold_stats_end(&h, 4000);
+
+    CHECK_EQ(h.count, 2);
+    CHECK_EQ(h.max_us, 2000);
+    CHECK_EQ(h.total_us, 2500);
+    CHECK_EQ(h.window_total_us, 2500);
+    CHECK_EQ(h.depth, 0);
+}
+
+static void test_nesting_counts_once(void) {
+    hold_stats_t h;
+    hold_stats_init(&h);
+    // Two tasks overlap: 100..400 and 250..700 is one hold of 600 us
+    hold_stats_begin(&h, 100);
+    hold_stats_begin(&h, 250);
+    hold_stats_end(&h, 400);
+    CHECK_EQ(h.count, 0);
+    CHECK_EQ(h.depth, 1);
+    hold_stats_end(&h, 700);
+
+    CHECK_EQ(h.count, 1);
+    CHECK_EQ(h.max_us, 600);
+    CHECK_EQ(h.total_us, 600);
+
+    // Deeper nesting, ended in any order
+    hold_stats_begin(&h, 1000);
+    hold_stats_begin(&h, 1001);
+    hold_stats_begin(&h, 1002);
+    hold_stats_end(&h, 1100);
+    hold_stats_end(&h, 1200);
+    hold_stats_end(&h, 1300);
+    CHECK_EQ(h.count, 2);
+    CHECK_EQ(h.total_us, 900);
+
+    // An unbalanced end is ignored rather than wrapping the depth
+    hold_stats_end(&h, 1400);
+    CHECK_EQ(h.depth, 0);
+    CHECK_EQ(h.count, 2);
+    hold_stats_begin(&h, 2000);
+    hold_stats_end(&h, 2050);
+    CHECK_EQ(h.count, 3);
+    CHECK_EQ(h.total_us, 950);
+}
+
+static void test_window_reset(void) {
+    hold_stats_t h;
+    hold_stats_init(&h);
+    hold_stats_begin(&h, 0);
+    hold_stats_end(&h, 5000);
+    hold_stats_reset_window(&h);
+
+    CHECK_EQ(h.count, 0);
+    CHECK_EQ(h.max_us, 0);
+    CHECK_EQ(h.window_total_us, 0);
+    CHECK_EQ(h.total_us, 5000);  // The total runs since boot
+
+    hold_stats_begin(&h, 10000);
+    hold_stats_end(&h, 10300);
+    CHECK_EQ(h.count, 1);
+    CHECK_EQ(h.max_us, 300);
+    CHECK_EQ(h.window_total_us, 300);
+    CHECK_EQ(h.total_us, 5300);
+
+    // A hold open across the reset lands in the window it ends in
+    hold_stats_begin(&h, 20000);
+    hold_stats_reset_window(&h);
+    hold_stats_end(&h, 20800);
+    CHECK_EQ(h.count, 1);
+    CHECK_EQ(h.max_us, 800);
+    CHECK_EQ(h.window_total_us, 800);
+}
+
+static void test_total_includes_open_hold(void) {
+    hold_stats_t h;
+    hold_stats_init(&h);
+    CHECK_EQ(hold_stats_total_us(&h, 1000), 0);
+
+    hold_stats_begin(&h, 1000);
+    hold_stats_end(&h, 1200);
+    hold_stats_begin(&h, 2000);
+    CHECK_EQ(hold_stats_total_us(&h, 2000), 200);
+    CHECK_EQ(hold_stats_total_us(&h, 2500), 700);
+    hold_stats_begin(&h, 2600);  // Nested: still one open hold from 2000
+    CHECK_EQ(hold_stats_total_us(&h, 3000), 1200);
+    CHECK_EQ(hold_stats_total_us(&h, 1500), 200);  // A stale clock adds nothing
+    hold_stats_end(&h, 3100);
+    hold_stats_end(&h, 3200);
+    CHECK_EQ(hold_stats_total_us(&h, 9999), 1400);
+    CHECK_EQ(h.total_us, 1400);
+}
+
+static void test_long_hold_saturates_max(void) {
+    hold_stats_t h;
+    hold_stats_init(&h);
+    uint64_t hour = 3600ull * 1000000;
+    hold_stats_begin(&h, 0);
+    hold_stats_end(&h, 2 * hour);  // Over UINT32_MAX us
+    CHECK_EQ(h.max_us, UINT32_MAX);
+    CHECK_EQ(h.total_us, 2 * hour);
+}
+
+int main(void) {
+    test_single_holds();
+    test_nesting_counts_once();
+    test_window_reset();
+    test_total_includes_open_hold();
+    test_long_hold_saturates_max();
+    puts("hold_stats: ok");
+    return 0;
+}
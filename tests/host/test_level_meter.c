@@ -0,0 +1,204 @@
+#include "test_util.h"
+#include "level_meter.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+static level_frame_t make_frame(uint32_t seq, uint32_t sender_ms) {
+    level_frame_t f = {.seq = seq, .sender_ms = sender_ms, .bands = LEVEL_METER_MAX_BANDS};
+    for (int b = 0; b < f.bands; b++) {
+        f.levels[b] = (uint8_t)((seq * 7 + b * 13) & 0xFF);
+    }
+    return f;
+}
+
+static void test_wire_format(void) {
+    level_frame_t f = make_frame(0x01020304, 0xA0B0C0D0);
+    uint8_t buf[64];
+    size_t len = level_meter_encode(&f, buf, sizeof(buf));
+    CHECK_EQ(len, LEVEL_METER_HEADER_LEN + LEVEL_METER_MAX_BANDS);
+    CHECK(memcmp(buf, "RKLM", 4) == 0);
+    CHECK_EQ(buf[4], 1);
+    CHECK_EQ(buf[5], LEVEL_METER_MAX_BANDS);
+    CHECK_EQ(buf[8], 0x04);  // Little-endian sequence
+    CHECK_EQ(buf[12], 0xD0);
+
+    level_frame_t out;
+    CHECK(level_meter_parse(buf, len, &out));
+    CHECK_EQ(out.seq, f.seq);
+    CHECK_EQ(out.sender_ms, f.sender_ms);
+    CHECK(memcmp(out.levels, f.levels, f.bands) == 0);
+
+    CHECK(!level_meter_parse(buf, len - 1, &out));  // Truncated levels
+    CHECK(!level_meter_parse(buf, LEVEL_METER_HEADER_LEN - 1, &out));
+    buf[5] = LEVEL_METER_MAX_BANDS + 1;
+    CHECK(!level_meter_parse(buf, sizeof(buf), &out));
+    buf[5] = LEVEL_METER_MAX_BANDS;
+    buf[4] = 2;  // Unknown version
+    CHECK(!level_meter_parse(buf, len, &out));
+    CHECK_EQ(level_meter_encode(&f, buf, len - 1), 0);
+}
+
+// 30 Hz stream with up to 40ms of network jitter, 2% loss and occasional reordering,
+// drawn at 30 Hz: the playout delay absorbs the jitter, frames come out in order and
+// none are repeated or dropped as late
+static void test_jitter_stream(void) {
+    level_jitter_t jb;
+    level_jitter_init(&jb);
+
+    enum { PACKETS = 300 };
+    uint64_t arrive[PACKETS];
+    srand(7);
+    for (int i = 0; i < PACKETS; i++) {
+        arrive[i] = rand() % 50 == 0 ? UINT64_MAX : (uint64_t)i * 33 + 1 + rand() % 40;  // Lost
+    }
+
+    int drawn = 0;
+    uint32_t last_seq = 0;
+    uint64_t next_draw = 0;
+    for (uint64_t t = 0; t < PACKETS * 33 + 500; t++) {
+        for (int i = 0; i < PACKETS; i++) {
+            if (arrive[i] == t) {
+                level_frame_t f = make_frame(1000 + i, i * 33);
+                level_jitter_push(&jb, &f, t);
+            }
+        }
+        if (t >= next_draw) {
+            next_draw += 33;
+            level_frame_t out;
+            if (level_jitter_pop(&jb, t, &out) && t - jb.last_rx_ms < LEVEL_METER_STALE_MS) {
+                CHECK(out.seq > last_seq);
+                last_seq = out.seq;
+                drawn++;
+            }
+        }
+    }
+    CHECK(drawn > PACKETS * 8 / 10);
+    CHECK_EQ(jb.dropped_late, 0);
+    CHECK_EQ(jb.dropped_overflow, 0);
+}
+
+static void test_late_and_duplicate_dropped(void) {
+    level_jitter_t jb;
+    level_jitter_init(&jb);
+    level_frame_t a = make_frame(10, 0);
+    level_frame_t b = make_frame(11, 33);
+    level_frame_t out;
+    level_jitter_push(&jb, &a, 0);
+    level_jitter_push(&jb, &b, 33);
+    CHECK(level_jitter_pop(&jb, 33 + LEVEL_METER_PLAYOUT_DELAY_MS, &out));
+    CHECK_EQ(out.seq, 11);  // Newest due frame; 10 is superseded
+
+    level_jitter_push(&jb, &a, 120);  // Arrives after 11 was shown
+    level_jitter_push(&jb, &b, 121);  // Duplicate
+    CHECK_EQ(jb.dropped_late, 2);
+}
+
+static void test_decay_when_stream_stops(void) {
+    level_jitter_t jb;
+    level_jitter_init(&jb);
+    level_frame_t f = make_frame(1, 0);
+    memset(f.levels, 255, sizeof(f.levels));
+    level_jitter_push(&jb, &f, 0);
+    level_frame_t out;
+    CHECK(level_jitter_pop(&jb, LEVEL_METER_PLAYOUT_DELAY_MS, &out));
+    CHECK(!level_jitter_idle(&jb, 100));
+
+    uint64_t t = LEVEL_METER_STALE_MS;
+    int pops = 0;
+    while (level_jitter_pop(&jb, t, &out)) {
+        t += 33;
+        pops++;
+        CHECK(pops < 20);
+    }
+    CHECK_EQ(out.levels[0], 0);
+    CHECK(level_jitter_idle(&jb, t));
+}
+
+static double seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Real datagrams over loopback, as level_meter_udp.c receives them: a local generator
+// sends a 30 Hz stream with reordered pairs and duplicates, and the receive path (recv,
+// parse, jitter push, pop) must fit well inside one 33ms meter frame. The simulated
+// clock keeps playout deterministic; only the CPU time is measured.
+#define FRAME_MS 33
+#define RX_BUDGET_US 1000  // Per frame; the meter's LVGL redraw gets the rest of the 33ms
+
+static void test_loopback_stream(void) {
+    int rx = socket(AF_INET, SOCK_DGRAM, 0);
+    int tx = socket(AF_INET, SOCK_DGRAM, 0);
+    CHECK(rx >= 0 && tx >= 0);
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    CHECK(bind(rx, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+    socklen_t addr_len = sizeof(addr);
+    CHECK(getsockname(rx, (struct sockaddr *)&addr, &addr_len) == 0);
+
+    enum { PACKETS = 300 };
+    level_jitter_t jb;
+    level_jitter_init(&jb);
+    int received = 0, shown = 0, dups = 0;
+    uint32_t last_seq = 0;
+    double worst_us = 0, total_us = 0;
+
+    for (int i = 0; i < PACKETS; i++) {
+        // Every 10th pair goes out swapped; every 25th packet is sent twice
+        int seq = i;
+        if (i % 10 == 4) seq = i + 1;
+        if (i % 10 == 5) seq = i - 1;
+        uint8_t buf[64];
+        level_frame_t f = make_frame(5000 + seq, (uint32_t)seq * FRAME_MS);
+        size_t len = level_meter_encode(&f, buf, sizeof(buf));
+        CHECK(sendto(tx, buf, len, 0, (struct sockaddr *)&addr, sizeof(addr)) == (ssize_t)len);
+        if (i % 25 == 0) {
+            CHECK(sendto(tx, buf, len, 0, (struct sockaddr *)&addr, sizeof(addr)) == (ssize_t)len);
+            dups++;
+        }
+
+        uint64_t now = (uint64_t)i * FRAME_MS + 10;
+        double t0 = seconds();
+        ssize_t n;
+        while ((n = recv(rx, buf, sizeof(buf), MSG_DONTWAIT)) > 0) {
+            level_frame_t in;
+            CHECK(level_meter_parse(buf, (size_t)n, &in));
+            level_jitter_push(&jb, &in, now);
+            received++;
+        }
+        level_frame_t out;
+        bool changed = level_jitter_pop(&jb, now, &out);
+        double us = (seconds() - t0) * 1e6;
+        total_us += us;
+        if (us > worst_us) worst_us = us;
+        if (changed) {
+            CHECK(out.seq > last_seq);
+            last_seq = out.seq;
+            shown++;
+        }
+    }
+    close(rx);
+    close(tx);
+
+    CHECK_EQ(received, PACKETS + dups);
+    CHECK(shown > PACKETS * 9 / 10);
+    CHECK(jb.dropped_late <= (uint32_t)dups);
+    double avg_us = total_us / PACKETS;
+    printf("level_meter: loopback rx %.1f us/frame avg, %.1f us worst (budget %d us)\n", avg_us, worst_us,
+           RX_BUDGET_US);
+    CHECK(avg_us < RX_BUDGET_US);
+}
+
+int main(void) {
+    test_wire_format();
+    test_jitter_stream();
+    test_late_and_duplicate_dropped();
+    test_decay_when_stream_stops();
+    test_loopback_stream();
+    puts("level_meter: ok");
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "test_util.h"
+#include "marquee_layout.h"
+
+static void test_strip_width(void) {
+    bool scrolls;
+    CHECK_EQ(marquee_strip_width(180, 240, &scrolls), 180);  // Fits: no gap, no scrolling
+    CHECK(!scrolls);
+    CHECK_EQ(marquee_strip_width(240, 240, &scrolls), 240);
+    CHECK(!scrolls);
+    CHECK_EQ(marquee_strip_width(241, 240, &scrolls), 241 + MARQUEE_GAP_PX);
+    CHECK(scrolls);
+    CHECK_EQ(marquee_strip_width(MARQUEE_MAX_STRIP_W - MARQUEE_GAP_PX, 240, &scrolls), MARQUEE_MAX_STRIP_W);
+    CHECK_EQ(marquee_strip_width(9000, 240, &scrolls), MARQUEE_MAX_STRIP_W);
+    CHECK(scrolls);
+    CHECK_EQ(marquee_strip_width(0, 240, NULL), 0);
+}
+
+static void test_text_truncation(void) {
+    char stored[MARQUEE_TEXT_MAX] = "";
+    CHECK(marquee_store_text(stored, "So What"));
+    CHECK(!marquee_store_text(stored, "So What"));
+    CHECK(marquee_store_text(stored, "So Wha"));
+    CHECK(marquee_store_text(stored, ""));
+    CHECK_STR(stored, "");
+
+    // Longer than the buffer: truncated, and the same long title again is not a change
+    char long_title[300];
+    memset(long_title, 'a', sizeof(long_title) - 1);
+    long_title[sizeof(long_title) - 1] = '\0';
+    CHECK(marquee_store_text(stored, long_title));
+    CHECK_EQ(strlen(stored), MARQUEE_TEXT_MAX - 1);
+    CHECK(!marquee_store_text(stored, long_title));
+    long_title[200] = 'b';  // Differs only past the cut
+    CHECK(!marquee_store_text(stored, long_title));
+
+    // A multi-byte character straddling the cut is dropped whole
+    memset(long_title, 'a', sizeof(long_title) - 1);
+    memcpy(long_title + MARQUEE_TEXT_MAX - 2, "\xC3\xA9", 2);  // U+00E9 across bytes 126-127
+    CHECK(marquee_store_text(stored, long_title));
+    CHECK_EQ(strlen(stored), MARQUEE_TEXT_MAX - 2);
+    memset(long_title, 'a', sizeof(long_title) - 1);
+    memcpy(long_title + MARQUEE_TEXT_MAX - 4, "\xE2\x80\x94", 3);  // U+2014 ending at byte 126: fits
+    CHECK(marquee_store_text(stored, long_title));
+    CHECK_EQ(strlen(stored), MARQUEE_TEXT_MAX - 1);
+    CHECK_EQ((unsigned char)stored[MARQUEE_TEXT_MAX - 2], 0x94);
+}
+
+// Distance scrolled in `ms` of timer ticks every `period_ms`, in px
+static double scrolled_px(uint32_t period_ms, uint32_t ms) {
+    int32_t strip_w = MARQUEE_MAX_STRIP_W;
+    int32_t offset = 0;
+    uint32_t carry = 0;
+    int64_t total_q8 = 0;
+    for (uint32_t t = 0; t < ms; t += period_ms) {
+        int32_t next = marquee_advance_q8(offset, period_ms, strip_w, &carry);
+        total_q8 += next >= offset ? next - offset : next + ((int64_t)strip_w << 8) - offset;
+        offset = next;
+    }
+    return total_q8 / 256.0;
+}
+
+// Same speed at every refresh period (the governor lowers it when idle); only the step
+// size changes
+static void test_scroll_period(void) {
+    static const uint32_t periods[] = {MARQUEE_DEFAULT_PERIOD_MS, 50, 66, 100, 7};
+    for (size_t i = 0; i < sizeof(periods) / sizeof(periods[0]); i++) {
+        uint32_t ms = 60000 / periods[i] * periods[i];
+        double expect = ms * MARQUEE_SPEED_PX_PER_S / 1000.0;
+        double got = scrolled_px(periods[i], ms);
+        CHECK(got > expect - 1.0 / 256 && got < expect + 1.0 / 256);
+    }
+
+    // Wraps at the strip width
+    uint32_t carry = 0;
+    int32_t strip_w = 300;
+    int32_t offset = marquee_advance_q8((strip_w << 8) - 256, 100, strip_w, &carry);
+    CHECK(offset < 3 * 256);
+    CHECK_EQ(marquee_advance_q8(1234, 100, 0, &carry), 0);  // Not scrolling
+}
+
+int main(void) {
+    test_strip_width();
+    test_text_truncation();
+    test_scroll_period();
+    puts("marquee_layout: ok");
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "test_util.h"
+#include "paged_list.h"
+
+#define QUEUE_ITEMS 10000
+#define VISIBLE_ROWS 5  // ui_queue.c QUEUE_VISIBLE_ROWS
+
+static int s_fetches;
+
+// Stand-in bridge: serves any page of a QUEUE_ITEMS-long queue immediately
+static void serve(paged_list_t *list, int page) {
+    static paged_list_item_t items[PAGED_LIST_PAGE_SIZE];
+    int count = 0;
+    for (int i = page * PAGED_LIST_PAGE_SIZE; i < QUEUE_ITEMS && count < PAGED_LIST_PAGE_SIZE; i++, count++) {
+        snprintf(items[count].id, sizeof(items[count].id), "q%d", i);
+        snprintf(items[count].line1, sizeof(items[count].line1), "Track %d", i);
+    }
+    s_fetches++;
+    CHECK(paged_list_store(list, list->generation, page, QUEUE_ITEMS, items, count, NULL));
+}
+
+// One UI refresh with the selection centred in the window, as ui_queue.c does
+static void show(paged_list_t *list, int selected) {
+    int first = selected - VISIBLE_ROWS / 2;
+    if (first < 0) first = 0;
+    int page;
+    while ((page = paged_list_next_fetch(list, first, first + VISIBLE_ROWS - 1)) >= 0) {
+        serve(list, page);
+    }
+    for (int i = first; i < first + VISIBLE_ROWS && i < QUEUE_ITEMS; i++) {
+        const paged_list_item_t *item = paged_list_get(list, i);
+        CHECK(item != NULL);
+        char id[16];
+        snprintf(id, sizeof(id), "q%d", i);
+        CHECK_STR(item->id, id);
+    }
+}
+
+static int cached_pages(const paged_list_t *list) {
+    int n = 0;
+    for (int i = 0; i < PAGED_LIST_MAX_PAGES; i++) {
+        if (list->pages[i].page_index >= 0) n++;
+    }
+    return n;
+}
+
+// Scrolling the whole queue fetches each page once, never holds more than
+// PAGED_LIST_MAX_PAGES, and memory doesn't depend on the queue length
+static void test_scroll_whole_queue(void) {
+    static paged_list_t list;
+    paged_list_reset(&list);
+    s_fetches = 0;
+    for (int sel = 0; sel < QUEUE_ITEMS; sel++) {
+        show(&list, sel);
+        CHECK(cached_pages(&list) <= PAGED_LIST_MAX_PAGES);
+    }
+    CHECK_EQ(list.total, QUEUE_ITEMS);
+    CHECK_EQ(s_fetches, QUEUE_ITEMS / PAGED_LIST_PAGE_SIZE);
+    CHECK(sizeof(paged_list_t) < 64 * 1024);
+
+    // Back up over the pages still cached: no fetches
+    s_fetches = 0;
+    for (int sel = QUEUE_ITEMS - 1; sel >= QUEUE_ITEMS - 2 * PAGED_LIST_PAGE_SIZE; sel--) {
+        show(&list, sel);
+    }
+    CHECK_EQ(s_fetches, 0);
+
+    // Jumping to the middle: the visible page plus the neighbour being approached
+    s_fetches = 0;
+    show(&list, QUEUE_ITEMS / 2 + PAGED_LIST_PAGE_SIZE - 3);
+    CHECK_EQ(s_fetches, 2);
+
+    // Past the end
+    CHECK(paged_list_get(&list, QUEUE_ITEMS) == NULL);
+    CHECK(paged_list_get(&list, -1) == NULL);
+}
+
+static void test_lru_eviction(void) {
+    static paged_list_t list;
+    paged_list_reset(&list);
+    for (int p = 0; p < PAGED_LIST_MAX_PAGES; p++) {
+        serve(&list, p * 10);
+    }
+    CHECK(paged_list_get(&list, 0) != NULL);  // Touch page 0: now page 10 is the oldest
+    serve(&list, 100);
+    CHECK(paged_list_get(&list, 0) != NULL);
+    CHECK(paged_list_get(&list, 10 * PAGED_LIST_PAGE_SIZE) == NULL);
+    CHECK(paged_list_get(&list, 20 * PAGED_LIST_PAGE_SIZE) != NULL);
+    CHECK(paged_list_get(&list, 100 * PAGED_LIST_PAGE_SIZE) != NULL);
+    CHECK_EQ(cached_pages(&list), PAGED_LIST_MAX_PAGES);
+}
+
+static void test_pending_and_generation(void) {
+    static paged_list_t list;
+    static paged_list_item_t item;
+    paged_list_reset(&list);
+    uint32_t old_gen = list.generation;
+    CHECK_EQ(paged_list_next_fetch(&list, 0, 4), 0);
+    CHECK_EQ(paged_list_next_fetch(&list, 0, 4), -1);  // One request in flight
+
+    // Failed fetch is retried
+    paged_list_fetch_failed(&list, old_gen);
+    CHECK_EQ(paged_list_next_fetch(&list, 0, 4), 0);
+
+    // The queue changed while the request was out: its answer is dropped
+    paged_list_reset(&list);
+    CHECK(!paged_list_store(&list, old_gen, 0, QUEUE_ITEMS, &item, 1, NULL));
+    CHECK(paged_list_get(&list, 0) == NULL);
+    CHECK_EQ(paged_list_next_fetch(&list, 0, 4), 0);
+}
+
+int main(void) {
+    test_scroll_whole_queue();
+    test_lru_eviction();
+    test_pending_and_generation();
+    puts("paged_list: ok");
+    return 0;
+}
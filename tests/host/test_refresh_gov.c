@@ -0,0 +1,228 @@
+#include "test_util.h"
+#include "refresh_gov.h"
+
+// Replays traces through a model of the UI loop: every LOOP_MS the governor is updated,
+// then LVGL's refresh timer fires if its period has elapsed and draws whatever was
+// invalidated since the last refresh. The same trace is also run at a fixed 33 ms
+// period, as before the governor.
+
+#define LOOP_MS 5
+#define TRACE_MS 60000
+
+typedef struct {
+    bool input;      // Knob detent or touch (also invalidates)
+    bool dirty;      // Something invalidated
+    bool animating;  // LVGL animation or crossfade running
+} trace_ev_t;
+
+typedef void (*trace_fn)(uint64_t t, trace_ev_t *ev);
+
+typedef struct {
+    refresh_gov_t gov;
+    uint64_t last_refr_ms;
+    uint32_t ticks;
+    uint32_t frames;
+    bool dirty;
+    uint64_t dirty_since_ms;
+    bool input_pending;
+    uint64_t input_ms;
+    uint32_t max_latency_ms;        // Invalidation to frame
+    uint32_t max_input_latency_ms;  // Input to its frame
+    uint8_t level[TRACE_MS + 1];    // After the loop iteration at each ms
+} sim_t;
+
+static sim_t s_sim;
+
+static void run(sim_t *s, trace_fn trace, uint64_t end_ms, bool governed) {
+    memset(s, 0, sizeof(*s));
+    refresh_gov_init(&s->gov, 0);
+    uint32_t period = REFRESH_ACTIVE_MS;
+    bool animating = false;
+    bool input = false;
+    for (uint64_t t = 0; t <= end_ms; t++) {
+        trace_ev_t ev = {0};
+        trace(t, &ev);
+        animating = ev.animating;
+        input |= ev.input;
+        if ((ev.dirty || ev.input) && !s->dirty) {
+            s->dirty = true;
+            s->dirty_since_ms = t;
+        }
+        if (ev.input && !s->input_pending) {
+            s->input_pending = true;
+            s->input_ms = t;
+        }
+        if (t % LOOP_MS == 0) {
+            if (input) {
+                refresh_gov_note_input(&s->gov, t);
+                input = false;
+            }
+            if (governed) {
+                period = refresh_gov_update(&s->gov, t, animating);
+            }
+            if (t - s->last_refr_ms >= period) {
+                s->last_refr_ms = t;
+                s->ticks++;
+                if (s->dirty) {
+                    refresh_gov_note_frame(&s->gov, t);
+                    s->frames++;
+                    uint32_t latency = (uint32_t)(t - s->dirty_since_ms);
+                    if (latency > s->max_latency_ms) s->max_latency_ms = latency;
+                    if (s->input_pending && t - s->input_ms > s->max_input_latency_ms) {
+                        s->max_input_latency_ms = (uint32_t)(t - s->input_ms);
+                    }
+                    s->dirty = false;
+                    s->input_pending = false;
+                }
+            }
+        }
+        s->level[t] = (uint8_t)s->gov.level;
+    }
+}
+
+static uint64_t first_at_level(const sim_t *s, refresh_level_t level, uint64_t from, uint64_t to) {
+    for (uint64_t t = from; t <= to; t++) {
+        if (s->level[t] == level) return t;
+    }
+    return UINT64_MAX;
+}
+
+static bool level_throughout(const sim_t *s, refresh_level_t level, uint64_t from, uint64_t to) {
+    for (uint64_t t = from; t <= to; t++) {
+        if (s->level[t] != level) return false;
+    }
+    return true;
+}
+
+// Knob spun for a second, a detent every 40 ms
+static void input_trace(uint64_t t, trace_ev_t *ev) {
+    ev->input = t >= 2000 && t < 3000 && t % 40 == 0;
+}
+
+static void test_input(void) {
+    sim_t *s = &s_sim;
+    run(s, input_trace, 6000, true);
+
+    CHECK(level_throughout(s, REFRESH_IDLE, 600, 1999));  // Nothing drawn after boot
+    CHECK(level_throughout(s, REFRESH_FAST, 2000, 2960 + REFRESH_FAST_HOLD_MS - 1));
+    CHECK(s->max_input_latency_ms <= LOOP_MS);  // The shorter period fires right away
+
+    // Fast is held after the last detent, then the normal rate, then idle once quiet
+    uint64_t active = first_at_level(s, REFRESH_ACTIVE, 2960, 6000);
+    CHECK(active <= 2960 + REFRESH_FAST_HOLD_MS + LOOP_MS);
+    uint64_t idle = first_at_level(s, REFRESH_IDLE, active, 6000);
+    CHECK(idle >= active + REFRESH_IDLE_AFTER_MS);
+    CHECK(idle <= active + REFRESH_IDLE_AFTER_MS + LOOP_MS);
+    CHECK(level_throughout(s, REFRESH_IDLE, idle, 6000));
+
+    uint32_t frames[REFRESH_LEVELS], switches;
+    uint64_t time_ms[REFRESH_LEVELS];
+    refresh_gov_take_stats(&s->gov, 6000, frames, time_ms, &switches);
+    CHECK_EQ(frames[REFRESH_FAST], 25);  // Every detent drawn on its own frame
+    CHECK_EQ(frames[REFRESH_IDLE], 0);
+    CHECK_EQ(time_ms[REFRESH_IDLE] + time_ms[REFRESH_ACTIVE] + time_ms[REFRESH_FAST], 6000);
+    CHECK_EQ(switches, 4);  // Active -> idle -> fast -> active -> idle
+}
+
+// A 600 ms crossfade redrawing every ms while it runs
+static void animation_trace(uint64_t t, trace_ev_t *ev) {
+    ev->animating = t >= 2000 && t < 2600;
+    ev->dirty |= ev->animating;
+}
+
+static void test_animation(void) {
+    sim_t *s = &s_sim;
+    run(s, animation_trace, 5000, true);
+
+    CHECK_EQ(s->level[1999], REFRESH_IDLE);
+    CHECK(level_throughout(s, REFRESH_ACTIVE, 2000, 2599));
+    CHECK(first_at_level(s, REFRESH_IDLE, 2600, 5000) <= 2600 + REFRESH_ACTIVE_MS + REFRESH_IDLE_AFTER_MS + LOOP_MS);
+
+    // Drawn at the normal rate, not faster
+    uint32_t frames[REFRESH_LEVELS], switches;
+    uint64_t time_ms[REFRESH_LEVELS];
+    refresh_gov_take_stats(&s->gov, 5000, frames, time_ms, &switches);
+    CHECK(frames[REFRESH_ACTIVE] >= 600 / (REFRESH_ACTIVE_MS + LOOP_MS));
+    CHECK(frames[REFRESH_ACTIVE] <= 600 / REFRESH_ACTIVE_MS + 2);
+    CHECK_EQ(frames[REFRESH_FAST], 0);
+}
+
+// A marquee runs on its own 33 ms timer: it redraws steadily but isn't an LVGL animation
+static void marquee_trace(uint64_t t, trace_ev_t *ev) {
+    ev->dirty = t >= 2000 && t < 4000 && t % 33 == 0;
+}
+
+static void test_marquee_ramps_up(void) {
+    sim_t *s = &s_sim;
+    run(s, marquee_trace, 6000, true);
+
+    // The first few changes land on idle ticks; REFRESH_WAKE_FRAMES of them back to back
+    // bring the normal rate back on the next update
+    uint64_t active = first_at_level(s, REFRESH_ACTIVE, 2000, 4000);
+    CHECK(active != UINT64_MAX);
+    CHECK(active >= 2000 + (REFRESH_WAKE_FRAMES - 1) * REFRESH_IDLE_MS);
+    CHECK(active <= 2000 + REFRESH_WAKE_FRAMES * REFRESH_IDLE_MS + LOOP_MS);
+    CHECK(level_throughout(s, REFRESH_IDLE, 600, active - 1));
+    CHECK(level_throughout(s, REFRESH_ACTIVE, active, 3999));
+
+    // Once it stops, the screen settles again
+    uint64_t idle = first_at_level(s, REFRESH_IDLE, 4000, 6000);
+    CHECK(idle <= 4000 + REFRESH_ACTIVE_MS + REFRESH_IDLE_AFTER_MS + LOOP_MS);
+
+    uint32_t frames[REFRESH_LEVELS], switches;
+    uint64_t time_ms[REFRESH_LEVELS];
+    refresh_gov_take_stats(&s->gov, 6000, frames, time_ms, &switches);
+    CHECK_EQ(frames[REFRESH_IDLE], REFRESH_WAKE_FRAMES);
+    CHECK(s->max_latency_ms <= REFRESH_IDLE_MS);
+}
+
+// The once-a-second progress arc alone keeps the slow rate
+static void progress_trace(uint64_t t, trace_ev_t *ev) {
+    ev->dirty = t % 1000 == 500;
+}
+
+static void test_progress_stays_idle(void) {
+    sim_t *s = &s_sim;
+    run(s, progress_trace, 10000, true);
+    CHECK(level_throughout(s, REFRESH_IDLE, 1100, 10000));
+    CHECK(s->max_latency_ms <= REFRESH_IDLE_MS);
+}
+
+// A minute of playback: the progress arc every second, a volume spin, a track change
+// with a crossfade and a scrolling title for a few seconds
+static void playback_trace(uint64_t t, trace_ev_t *ev) {
+    progress_trace(t, ev);
+    input_trace(t % 20000, ev);
+    animation_trace(t >= 30000 ? t - 28000 : 0, ev);
+    if (t >= 30600 && t < 36000 && t % 33 == 0) {
+        ev->dirty = true;
+    }
+}
+
+static void test_tick_count_vs_fixed_period(void) {
+    sim_t *s = &s_sim;
+    run(s, playback_trace, TRACE_MS, false);
+    uint32_t fixed_ticks = s->ticks;
+    uint32_t fixed_frames = s->frames;
+    CHECK(fixed_ticks >= TRACE_MS / (REFRESH_ACTIVE_MS + LOOP_MS));
+
+    run(s, playback_trace, TRACE_MS, true);
+    printf("refresh_gov: %u ticks governed vs %u at a fixed %d ms (%u vs %u frames)\n", s->ticks, fixed_ticks,
+           REFRESH_ACTIVE_MS, s->frames, fixed_frames);
+    CHECK(s->ticks * 2 < fixed_ticks);  // Mostly the spins at 16 ms
+    CHECK(s->max_input_latency_ms <= LOOP_MS);
+    CHECK(s->max_latency_ms <= REFRESH_IDLE_MS);
+    // Three one-second spins at 16 ms frames cost more than the fixed rate would have
+    // drawn for them, but nothing else may add frames
+    CHECK(s->frames <= fixed_frames + 3 * 1000 / REFRESH_FAST_MS);
+}
+
+int main(void) {
+    test_input();
+    test_animation();
+    test_marquee_ramps_up();
+    test_progress_stays_idle();
+    test_tick_count_vs_fixed_period();
+    puts("refresh_gov: ok");
+    return 0;
+}
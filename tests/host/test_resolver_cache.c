@@ -0,0 +1,129 @@
+#include "test_util.h"
+#include "resolver_cache.h"
+
+#define TTL_MS 120000
+
+// Stand-in resolver the tests reconfigure (DHCP move, outage)
+static const char *s_ip = "192.168.1.10";
+static bool s_up = true;
+static int s_resolves;
+
+static resolver_cache_t s_rc;
+static uint64_t s_now;
+
+static bool fake_resolve(char *ip, size_t len) {
+    s_resolves++;
+    if (!s_up) return false;
+    snprintf(ip, len, "%s", s_ip);
+    return true;
+}
+
+// Request path, as in platform_http_idf.c resolve_url()
+static bool request_ip(const char *host, char *ip) {
+    resolver_lookup_t r = resolver_cache_lookup(&s_rc, host, ip, RESOLVER_IP_LEN, s_now);
+    if (r == RESOLVER_HIT) return true;
+    char fresh[RESOLVER_IP_LEN];
+    bool ok = fake_resolve(fresh, sizeof(fresh));
+    resolver_cache_store(&s_rc, host, ok ? fresh : NULL, TTL_MS, s_now);
+    if (ok) {
+        strcpy(ip, fresh);
+        return true;
+    }
+    return r == RESOLVER_EXPIRED;  // Fallback address
+}
+
+// Background refresh task
+static void refresh(void) {
+    char host[RESOLVER_HOST_LEN];
+    while (resolver_cache_next_refresh(&s_rc, s_now, host, sizeof(host))) {
+        char fresh[RESOLVER_IP_LEN];
+        bool ok = fake_resolve(fresh, sizeof(fresh));
+        resolver_cache_store(&s_rc, host, ok ? fresh : NULL, TTL_MS, s_now);
+    }
+}
+
+// Poll every 100ms for `seconds`
+static void run(const char *host, int seconds, char *ip) {
+    for (int i = 0; i < seconds * 10; i++) {
+        s_now += 100;
+        CHECK(request_ip(host, ip));
+        refresh();
+    }
+}
+
+static void test_url_helpers(void) {
+    char host[RESOLVER_HOST_LEN], out[256];
+    CHECK(resolver_url_host("http://roon-bridge.local:8088/now_playing?zone_id=x", host, sizeof(host)));
+    CHECK_STR(host, "roon-bridge.local");
+    CHECK(resolver_rewrite_url("http://roon-bridge.local:8088/now_playing?z=1", "10.0.0.5", out, sizeof(out)));
+    CHECK_STR(out, "http://10.0.0.5:8088/now_playing?z=1");
+    CHECK(resolver_rewrite_url("https://bridge.example/a", "10.0.0.5", out, sizeof(out)));
+    CHECK_STR(out, "https://10.0.0.5/a");
+    CHECK(!resolver_rewrite_url("http://h/a", "10.0.0.5", out, 8));
+
+    CHECK(resolver_is_ip_literal("192.168.1.2"));
+    CHECK(resolver_is_ip_literal("[fe80::1]"));
+    CHECK(!resolver_is_ip_literal("bridge.local"));
+    CHECK(!resolver_is_ip_literal("1host"));
+    CHECK(resolver_url_host("http://[fe80::1]:8088/x", host, sizeof(host)));
+    CHECK(resolver_is_ip_literal(host));
+}
+
+static void test_requests_never_wait_after_first(void) {
+    resolver_cache_init(&s_rc);
+    s_now = 1000;
+    char ip[RESOLVER_IP_LEN];
+    run("bridge.local", 100, ip);
+    CHECK_STR(ip, "192.168.1.10");
+    CHECK_EQ(s_rc.misses, 1);
+    CHECK_EQ(s_resolves, 2);  // The miss, then one background refresh at 75% of the TTL
+
+    // DHCP move is picked up by the background refresh, not by a request
+    s_ip = "192.168.1.77";
+    run("bridge.local", 200, ip);
+    CHECK_STR(ip, "192.168.1.77");
+    CHECK_EQ(s_rc.misses, 1);
+}
+
+static void test_outage_serves_last_address(void) {
+    char ip[RESOLVER_IP_LEN];
+    s_up = false;
+    int before = s_resolves;
+    run("bridge.local", 600, ip);  // Every request CHECKs it got an address
+    CHECK_STR(ip, "192.168.1.77");
+    CHECK(s_resolves - before < 20);  // Backoff, not a resolve per request
+    CHECK(s_rc.fallbacks > 0);
+
+    s_up = true;
+    s_ip = "192.168.1.80";
+    run("bridge.local", 70, ip);
+    CHECK_STR(ip, "192.168.1.80");
+}
+
+static void test_idle_and_eviction(void) {
+    int before = s_resolves;
+    for (int i = 0; i < 100; i++) {
+        s_now += 60000;
+        refresh();
+    }
+    CHECK(s_resolves - before <= 3);  // Idle hosts expire instead of being refreshed forever
+
+    char ip[RESOLVER_IP_LEN];
+    for (int i = 0; i < RESOLVER_CACHE_SLOTS + 2; i++) {
+        char host[8];
+        sprintf(host, "h%d", i);
+        s_now++;
+        CHECK(request_ip(host, ip));
+    }
+    CHECK_EQ(resolver_cache_lookup(&s_rc, "h5", ip, sizeof(ip), s_now), RESOLVER_HIT);
+    CHECK_EQ(resolver_cache_lookup(&s_rc, "h0", ip, sizeof(ip), s_now), RESOLVER_MISS);  // Least recently used
+}
+
+int main(void) {
+    test_url_helpers();
+    test_requests_never_wait_after_first();
+    test_outage_serves_last_address();
+    test_idle_and_eviction();
+    puts("resolver_cache: ok");
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "test_util.h"
+#include "scan_table.h"
+
+static wifi_scan_ap_t ap(const char *ssid, int rssi, uint8_t last_bssid_byte) {
+    wifi_scan_ap_t a = {.channel = 6, .rssi = (int8_t)rssi, .auth = 3};
+    snprintf(a.ssid, sizeof(a.ssid), "%s", ssid);
+    memcpy(a.bssid, (const uint8_t[]){0x24, 0x0a, 0xc4, 0x00, 0x00, last_bssid_byte}, 6);
+    return a;
+}
+
+static void test_one_entry_per_ssid(void) {
+    scan_table_t t;
+    scan_table_init(&t);
+    wifi_scan_ap_t scan[] = {
+        ap("mesh", -70, 1), ap("cafe", -60, 2), ap("mesh", -45, 3), ap("mesh", -80, 4), ap("", -30, 5),
+    };
+    scan_table_merge(&t, scan, 5);
+
+    CHECK_EQ(t.count, 2);  // Hidden network skipped, mesh APs folded into one
+    CHECK_STR(t.entries[0].ap.ssid, "mesh");
+    CHECK_EQ(t.entries[0].ap.rssi, -45);
+    CHECK_EQ(t.entries[0].ap.bssid[5], 3);
+    CHECK_STR(t.entries[1].ap.ssid, "cafe");
+
+    // A later, weaker sighting replaces the old one: the phone moved
+    wifi_scan_ap_t later[] = {ap("mesh", -75, 1), ap("cafe", -55, 2)};
+    scan_table_merge(&t, later, 2);
+    CHECK_EQ(t.count, 2);
+    CHECK_STR(t.entries[0].ap.ssid, "cafe");
+    CHECK_EQ(t.entries[1].ap.rssi, -75);
+}
+
+static void test_aging(void) {
+    scan_table_t t;
+    scan_table_init(&t);
+    wifi_scan_ap_t both[] = {ap("home", -50, 1), ap("flaky", -60, 2)};
+    wifi_scan_ap_t home[] = {ap("home", -50, 1)};
+    scan_table_merge(&t, both, 2);
+
+    for (int missed = 1; missed <= SCAN_TABLE_MAX_AGE; missed++) {
+        scan_table_merge(&t, home, 1);
+        CHECK_EQ(t.count, 2);
+        CHECK_EQ(t.entries[1].age, missed);
+    }
+    scan_table_merge(&t, home, 1);
+    CHECK_EQ(t.count, 1);
+    CHECK_STR(t.entries[0].ap.ssid, "home");
+
+    // An empty scan ages everything
+    for (int i = 0; i <= SCAN_TABLE_MAX_AGE; i++) {
+        scan_table_merge(&t, NULL, 0);
+    }
+    CHECK_EQ(t.count, 0);
+    CHECK_EQ(t.scans, 2 + 2 * SCAN_TABLE_MAX_AGE + 1);
+}
+
+static void test_full_table_keeps_strongest(void) {
+    scan_table_t t;
+    scan_table_init(&t);
+    wifi_scan_ap_t scan[SCAN_TABLE_MAX + 10];
+    char name[16];
+    for (int i = 0; i < SCAN_TABLE_MAX + 10; i++) {
+        snprintf(name, sizeof(name), "net%02d", i);
+        scan[i] = ap(name, -90 + i, (uint8_t)i);  // Later ones are stronger
+    }
+    scan_table_merge(&t, scan, SCAN_TABLE_MAX + 10);
+
+    CHECK_EQ(t.count, SCAN_TABLE_MAX);
+    CHECK_STR(t.entries[0].ap.ssid, "net29");
+    CHECK_STR(t.entries[SCAN_TABLE_MAX - 1].ap.ssid, "net10");
+    for (int i = 1; i < t.count; i++) {
+        CHECK(t.entries[i - 1].ap.rssi >= t.entries[i].ap.rssi);
+    }
+
+    // A weaker newcomer doesn't displace anything
+    wifi_scan_ap_t weak = ap("weak", -95, 99);
+    scan_table_merge(&t, &weak, 1);
+    CHECK_EQ(t.count, SCAN_TABLE_MAX);
+    CHECK_EQ(t.entries[SCAN_TABLE_MAX - 1].ap.rssi, -80);
+}
+
+static void test_render_json(void) {
+    scan_table_t t;
+    scan_table_init(&t);
+    wifi_scan_ap_t scan[] = {ap("a\"b\\c", -40, 0xab), ap("</script><b>&", -50, 1), ap("tab\there", -60, 2)};
+    scan[1].auth = 0;
+    scan[1].channel = 11;
+    scan_table_merge(&t, scan, 3);
+
+    char buf[512];
+    int n = scan_table_render_json(&t, buf, sizeof(buf));
+    const char *want = "[{\"s\":\"a\\\"b\\\\c\",\"r\":-40,\"a\":3,\"c\":6,\"b\":\"240ac40000ab\"},"
+                       "{\"s\":\"\\u003c/script\\u003e\\u003cb\\u003e\\u0026\",\"r\":-50,\"a\":0,\"c\":11,"
+                       "\"b\":\"240ac4000001\"},"
+                       "{\"s\":\"tab\\u0009here\",\"r\":-60,\"a\":3,\"c\":6,\"b\":\"240ac4000002\"}]";
+    CHECK_STR(buf, want);
+    CHECK_EQ(n, strlen(want));
+    CHECK(strchr(buf, '<') == NULL);
+
+    // Every buffer shorter than the output fails cleanly and never writes past len
+    for (size_t len = 0; len <= (size_t)n; len++) {
+        char small[512];
+        memset(small, '#', sizeof(small));
+        CHECK_EQ(scan_table_render_json(&t, small, len), -1);
+        CHECK(small[len] == '#');
+    }
+    CHECK_EQ(scan_table_render_json(&t, buf, (size_t)n + 1), n);
+
+    scan_table_init(&t);
+    CHECK_EQ(scan_table_render_json(&t, buf, 3), 2);
+    CHECK_STR(buf, "[]");
+}
+
+int main(void) {
+    test_one_entry_per_ssid();
+    test_aging();
+    test_full_table_keeps_strongest();
+    test_render_json();
+    puts("scan_table: ok");
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "test_util.h"
+#include "seek_scrub.h"
+
+#define SEND_INTERVAL_MS 250
+#define HOLD_TIMEOUT_MS 5000
+#define SECONDS_PER_TICK 3
+
+// Encoder reports (time ms, ticks) from a 2s turn with velocity bursts and a reversal
+static const int TRACE[][2] = {
+    {0, 1},    {60, 1},   {120, 2},  {180, 3},   {240, 3},   {300, 3},   {360, 3},   {420, 2},
+    {480, 1},  {540, 1},  {600, 1},  {900, -1},  {960, -1},  {1020, -2}, {1080, -1}, {1500, 1},
+    {1560, 1}, {1620, 1}, {1680, 1}, {1740, 1},  {1800, 1},  {1860, 1},
+};
+#define TRACE_LEN ((int)(sizeof(TRACE) / sizeof(TRACE[0])))
+
+static int s_sends;
+static uint64_t s_last_send_ms;
+
+static void send(seek_scrub_t *s, uint64_t now_ms) {
+    if (s_sends > 0) {
+        CHECK(now_ms - s_last_send_ms >= SEND_INTERVAL_MS);  // Throttled
+    }
+    s_sends++;
+    s_last_send_ms = now_ms;
+    seek_scrub_sent(s, true, now_ms);
+}
+
+static void test_throttled_scrub(void) {
+    seek_scrub_t s;
+    seek_scrub_init(&s, SEND_INTERVAL_MS, HOLD_TIMEOUT_MS);
+    CHECK(!seek_scrub_begin(&s, 10, 0));  // Unknown length: not seekable
+    CHECK(seek_scrub_begin(&s, 60, 300));
+
+    int expected = 60;
+    int next = 0;
+    s_sends = 0;
+    for (uint64_t t = 0; t <= 2000; t += 5) {
+        while (next < TRACE_LEN && (uint64_t)TRACE[next][0] == t) {
+            expected += TRACE[next][1] * SECONDS_PER_TICK;
+            if (seek_scrub_ticks(&s, TRACE[next][1], t)) {
+                send(&s, t);
+            }
+            next++;
+        }
+        if (t % 125 == 0 && seek_scrub_poll(&s, t)) {
+            send(&s, t);
+        }
+    }
+    CHECK_EQ(s.position, expected);
+    CHECK(s_sends < TRACE_LEN);  // Coalesced
+
+    if (seek_scrub_end(&s, 2000)) {
+        seek_scrub_sent(&s, true, 2000);
+    }
+    CHECK_EQ(s.last_sent, expected);
+
+    // A poll from before the seek is ignored; the position advances from the commit
+    CHECK_EQ(seek_scrub_display(&s, 65, true, 3000), expected + 1);
+    CHECK_EQ(seek_scrub_display(&s, expected + 2, true, 4000), expected + 2);
+    CHECK(!s.holding);
+}
+
+static void test_hold_timeout(void) {
+    seek_scrub_t s;
+    seek_scrub_init(&s, SEND_INTERVAL_MS, HOLD_TIMEOUT_MS);
+    seek_scrub_begin(&s, 10, 300);
+    seek_scrub_ticks(&s, 5, 10000);
+    seek_scrub_sent(&s, true, 10000);
+    seek_scrub_end(&s, 10100);
+    CHECK_EQ(seek_scrub_display(&s, 10, false, 12000), 25);
+    CHECK_EQ(seek_scrub_display(&s, 10, false, 15200), 10);  // Bridge never confirmed
+}
+
+static void test_failed_commit_not_held(void) {
+    seek_scrub_t s;
+    seek_scrub_init(&s, SEND_INTERVAL_MS, HOLD_TIMEOUT_MS);
+    seek_scrub_begin(&s, 10, 300);
+    seek_scrub_ticks(&s, 1, 20000);
+    seek_scrub_sent(&s, true, 20000);
+    seek_scrub_ticks(&s, 1, 20100);
+    CHECK(seek_scrub_end(&s, 20100));
+    seek_scrub_sent(&s, false, 20100);
+    CHECK_EQ(seek_scrub_display(&s, 10, true, 20200), 10);
+}
+
+// Starting at (or past) the end lands on the last seekable position, as ticks do
+static void test_range_at_track_end(void) {
+    seek_scrub_t s;
+    seek_scrub_init(&s, SEND_INTERVAL_MS, HOLD_TIMEOUT_MS);
+    CHECK(!seek_scrub_begin(&s, 10, 0));
+    CHECK(seek_scrub_begin(&s, 300, 300));
+    CHECK_EQ(s.position, 299);
+    CHECK(!seek_scrub_end(&s, 1000));  // Nothing moved: nothing to send
+    CHECK(seek_scrub_begin(&s, 450, 300));
+    CHECK_EQ(s.position, 299);
+    seek_scrub_ticks(&s, 2, 2000);
+    CHECK_EQ(s.position, 299);
+    seek_scrub_ticks(&s, -1, 2000);
+    CHECK_EQ(s.position, 296);
+    CHECK(seek_scrub_begin(&s, -5, 300));
+    CHECK_EQ(s.position, 0);
+}
+
+int main(void) {
+    test_throttled_scrub();
+    test_hold_timeout();
+    test_failed_commit_not_held();
+    test_range_at_track_end();
+    puts("seek_scrub: ok");
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "test_util.h"
+#include "telemetry.h"
+
+#define SAMPLE_MS 60000
+#define FLUSH_MS 900000
+
+static telemetry_sample_t sample(int battery, bool charging) {
+    telemetry_sample_t s = {.battery_level = battery, .charging = charging, .rssi = -60, .free_heap_kb = 180};
+    return s;
+}
+
+static void test_first_sample_and_encoding(void) {
+    telemetry_t t;
+    telemetry_init(&t, SAMPLE_MS, FLUSH_MS, 0);
+    CHECK(telemetry_sample_due(&t, 0));
+    CHECK(telemetry_latest(&t) == NULL);
+
+    telemetry_note_latency(&t, 40);
+    telemetry_note_latency(&t, 80);
+    telemetry_sample_t s = sample(80, false);
+    s.uptime_s = 12;
+    CHECK(telemetry_add_sample(&t, &s, 0));  // Nothing sent yet: urgent
+    CHECK_EQ(telemetry_latest(&t)->poll_ms_avg, 60);
+    CHECK_EQ(telemetry_latest(&t)->poll_ms_max, 80);
+    CHECK(telemetry_flush_due(&t, 0));
+    CHECK(!telemetry_sample_due(&t, SAMPLE_MS - 1));
+
+    char buf[512];
+    int n = telemetry_encode(&t, buf, sizeof(buf));
+    CHECK_EQ(n, (long long)strlen(buf));
+    CHECK_STR(buf, "{\"v\":1,\"fields\":[\"uptime_s\",\"battery_level\",\"battery_charging\",\"rssi\","
+                   "\"heap_kb\",\"poll_ms_avg\",\"poll_ms_max\",\"display\",\"apl\",\"panel_load\",\"cpu_boost\"],"
+                   "\"dropped\":0,\"samples\":[[12,80,0,-60,180,60,80,0,0,0,0]]}");
+    CHECK_EQ(telemetry_encode(&t, buf, (size_t)n), -1);  // No room for the terminator
+
+    telemetry_flushed(&t, 0);
+    CHECK_EQ(t.count, 0);
+    CHECK(!telemetry_flush_due(&t, 0));
+}
+
+// Small battery drift waits for the flush interval; a charging flip or a jump of
+// TELEMETRY_BATTERY_DELTA goes out early
+static void test_flush_schedule(void) {
+    telemetry_t t;
+    telemetry_init(&t, SAMPLE_MS, FLUSH_MS, 0);
+    telemetry_sample_t s = sample(80, false);
+    telemetry_add_sample(&t, &s, 0);
+    telemetry_flushed(&t, 0);
+
+    uint64_t now = 0;
+    for (int i = 1; i < FLUSH_MS / SAMPLE_MS; i++) {
+        now = (uint64_t)i * SAMPLE_MS;
+        CHECK(telemetry_sample_due(&t, now));
+        s = sample(80 - i % 3, false);
+        CHECK(!telemetry_add_sample(&t, &s, now));
+        CHECK(!telemetry_flush_due(&t, now));
+    }
+    now += SAMPLE_MS;
+    telemetry_add_sample(&t, &s, now);
+    CHECK(telemetry_flush_due(&t, now));
+    telemetry_flushed(&t, now);
+
+    now += SAMPLE_MS;
+    s = sample(80, true);
+    CHECK(telemetry_add_sample(&t, &s, now));
+    CHECK(telemetry_flush_due(&t, now));
+
+    // Undelivered: back off until the next interval, and the change stays unreported
+    telemetry_flush_failed(&t, now);
+    CHECK(!telemetry_flush_due(&t, now));
+    now += SAMPLE_MS;
+    CHECK(telemetry_add_sample(&t, &s, now));
+    CHECK(telemetry_flush_due(&t, now));
+    CHECK_EQ(t.count, 2);
+    telemetry_flushed(&t, now);
+
+    now += SAMPLE_MS;
+    s = sample(80 - TELEMETRY_BATTERY_DELTA, true);
+    CHECK(telemetry_add_sample(&t, &s, now));
+}
+
+static void test_overflow_drops_oldest(void) {
+    telemetry_t t;
+    telemetry_init(&t, SAMPLE_MS, FLUSH_MS, 0);
+    uint64_t now = 0;
+    for (int i = 0; i < TELEMETRY_MAX_SAMPLES + 4; i++, now += SAMPLE_MS) {
+        telemetry_sample_t s = sample(74, true);
+        s.uptime_s = i;
+        telemetry_add_sample(&t, &s, now);
+    }
+    CHECK_EQ(t.count, TELEMETRY_MAX_SAMPLES);
+    CHECK_EQ(t.dropped, 4);
+    CHECK_EQ(t.samples[0].uptime_s, 4);
+    CHECK_EQ(telemetry_latest(&t)->uptime_s, TELEMETRY_MAX_SAMPLES + 3);
+
+    // Worst-case field widths still fit bridge_client's 1280-byte request body
+    for (int i = 0; i < t.count; i++) {
+        telemetry_sample_t *s = &t.samples[i];
+        s->uptime_s = 4000000000u;
+        s->battery_level = -1;
+        s->rssi = -128;
+        s->free_heap_kb = s->poll_ms_avg = s->poll_ms_max = 65535;
+        s->display_state = s->apl = s->panel_load = s->cpu_boost = 255;
+    }
+    char buf[1280];
+    CHECK(telemetry_encode(&t, buf, sizeof(buf)) > 0);
+    CHECK(strstr(buf, "\"dropped\":4") != NULL);
+}
+
+int main(void) {
+    test_first_sample_and_encoding();
+    test_flush_schedule();
+    test_overflow_drops_oldest();
+    puts("telemetry: ok");
+    return 0;
+}
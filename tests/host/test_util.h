@@ -0,0 +1,35 @@
+#pragma once
+
+// Minimal checks for the host tests: report the failing expression and exit non-zero
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                                     \
+    do {                                                                                \
+        if (!(cond)) {                                                                  \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                                    \
+        }                                                                               \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                                  \
+    do {                                                                                \
+        long long a_ = (long long)(a);                                                  \
+        long long b_ = (long long)(b);                                                  \
+        if (a_ != b_) {                                                                 \
+            fprintf(stderr, "%s:%d: CHECK_EQ failed: %s == %lld, expected %s == %lld\n", \
+                    __FILE__, __LINE__, #a, a_, #b, b_);                                \
+            exit(1);                                                                    \
+        }                                                                               \
+    } while (0)
+
+#define CHECK_STR(a, b)                                                                 \
+    do {                                                                                \
+        if (strcmp((a), (b)) != 0) {                                                    \
+            fprintf(stderr, "%s:%d: CHECK_STR failed: \"%s\", expected \"%s\"\n",       \
+                    __FILE__, __LINE__, (a), (b));                                      \
+            exit(1);                                                                    \
+        }                                                                               \
+    } while (0)
@@ -0,0 +1,132 @@
+#include "test_util.h"
+#include "volume_sync.h"
+
+#define TIMEOUT_MS 4000
+#define TOLERANCE 0.5f
+
+// Three detents 30ms apart; the bridge applies each command 150ms after it is sent and
+// polls (every 100ms) return the bridge's state 80ms late. The arc must never step back.
+static void test_no_snap_back(bool bridge_echoes_seq) {
+    volume_sync_t vs;
+    volume_sync_init(&vs, TIMEOUT_MS);
+    float bridge = -30, shown = -30;
+    uint32_t bridge_seq = 0;
+    float sent[3];
+    uint32_t sent_seq[3];
+    uint64_t sent_at[3];
+    int n = 0;
+    float poll_volume = 0;
+    uint32_t poll_seq = 0;
+    int64_t poll_due = -1;
+
+    for (uint64_t t = 0; t < 2000; t += 10) {
+        if (t == 100 || t == 130 || t == 160) {
+            shown += 1;
+            sent[n] = shown;
+            sent_at[n] = t;
+            sent_seq[n] = volume_sync_local_change(&vs, shown, t);
+            n++;
+        }
+        for (int i = 0; i < n; i++) {
+            if (sent_at[i] + 150 == t) {
+                bridge = sent[i];
+                bridge_seq = sent_seq[i];
+            }
+        }
+        if (t % 100 == 0 && poll_due < 0) {
+            poll_volume = bridge;
+            poll_seq = bridge_seq;
+            poll_due = (int64_t)t + 80;
+        }
+        if ((int64_t)t == poll_due) {
+            float v = volume_sync_reconcile(&vs, poll_volume, bridge_echoes_seq, poll_seq, TOLERANCE, t);
+            CHECK(v >= shown - 0.01f);
+            shown = v;
+            poll_due = -1;
+        }
+    }
+    CHECK(shown == -27);
+    CHECK(!vs.pending);
+}
+
+// Nothing confirms the change (the zone clamped it): the poll wins after the timeout
+static void test_timeout(void) {
+    volume_sync_t vs;
+    volume_sync_init(&vs, TIMEOUT_MS);
+    volume_sync_local_change(&vs, -27, 0);
+    CHECK(volume_sync_reconcile(&vs, -28, false, 0, TOLERANCE, 1000) == -27);
+    CHECK(volume_sync_reconcile(&vs, -28, false, 0, TOLERANCE, 4100) == -28);
+    CHECK(!vs.pending);
+}
+
+static void test_command_failed(void) {
+    volume_sync_t vs;
+    volume_sync_init(&vs, TIMEOUT_MS);
+    volume_sync_reconcile(&vs, -30, true, 5, TOLERANCE, 0);
+    uint32_t seq = volume_sync_local_change(&vs, -29, 10);
+    volume_sync_command_failed(&vs, seq);
+    CHECK(volume_sync_reconcile(&vs, -30, true, 5, TOLERANCE, 20) == -30);
+}
+
+// After a reboot the bridge still echoes the last seq from before it. New commands must
+// continue above it, or the first one looks confirmed at once and the arc snaps back.
+static void test_seeded_after_reboot(void) {
+    volume_sync_t vs;
+    volume_sync_init(&vs, TIMEOUT_MS);
+    CHECK(volume_sync_reconcile(&vs, -30, true, 812, TOLERANCE, 0) == -30);
+    uint32_t seq = volume_sync_local_change(&vs, -29, 10);
+    CHECK_EQ(seq, 813);
+    CHECK(volume_sync_reconcile(&vs, -30, true, 812, TOLERANCE, 50) == -29);  // Stale
+    CHECK(volume_sync_reconcile(&vs, -29, true, 813, TOLERANCE, 100) == -29);
+    CHECK(!vs.pending);
+}
+
+// A command sent before the first echo can't be compared by seq; values decide
+static void test_change_before_first_echo(void) {
+    volume_sync_t vs;
+    volume_sync_init(&vs, TIMEOUT_MS);
+    volume_sync_local_change(&vs, -29, 0);
+    CHECK(volume_sync_reconcile(&vs, -30, true, 812, TOLERANCE, 50) == -29);
+    CHECK(volume_sync_reconcile(&vs, -29, true, 812, TOLERANCE, 100) == -29);
+    CHECK(!vs.pending);
+    CHECK_EQ(volume_sync_next_seq(&vs), 813);
+}
+
+// A zone change drops the prediction but keeps counting
+static void test_zone_change_keeps_seq(void) {
+    volume_sync_t vs;
+    volume_sync_init(&vs, TIMEOUT_MS);
+    volume_sync_reconcile(&vs, -30, true, 40, TOLERANCE, 0);
+    volume_sync_local_change(&vs, -29, 10);
+    volume_sync_reset_pending(&vs);
+    CHECK(!vs.pending);
+    CHECK_EQ(volume_sync_next_seq(&vs), 42);
+}
+
+static void test_wraparound(void) {
+    volume_sync_t vs;
+    volume_sync_init(&vs, TIMEOUT_MS);
+    volume_sync_reconcile(&vs, 0, true, 0xFFFFFFFDu, TOLERANCE, 0);
+    uint32_t s1 = volume_sync_local_change(&vs, 1, 10);
+    uint32_t s2 = volume_sync_local_change(&vs, 2, 20);
+    CHECK(s1 == 0xFFFFFFFEu);
+    CHECK(s2 == 0xFFFFFFFFu);
+    uint32_t s3 = volume_sync_local_change(&vs, 3, 30);
+    CHECK_EQ(s3, 1);  // 0 is skipped
+    CHECK(volume_sync_reconcile(&vs, 2, true, s2, TOLERANCE, 40) == 3);
+    CHECK(volume_sync_reconcile(&vs, 3, true, s3, TOLERANCE, 50) == 3);
+    CHECK(!vs.pending);
+}
+
+int main(void) {
+    test_no_snap_back(true);
+    test_no_snap_back(false);
+    test_timeout();
+    test_command_failed();
+    test_seeded_after_reboot();
+    test_change_before_first_echo();
+    test_zone_change_keeps_seq();
+    test_wraparound();
+    puts("volume_sync: ok");
+    return 0;
+}
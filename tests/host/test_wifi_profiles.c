@@ -0,0 +1,143 @@
+#include "test_util.h"
+#include "wifi_profiles.h"
+
+static wifi_scan_ap_t ap(const char *ssid, int bssid_byte, int channel, int rssi) {
+    wifi_scan_ap_t a = {.channel = (uint8_t)channel, .rssi = (int8_t)rssi};
+    strcpy(a.ssid, ssid);
+    memset(a.bssid, bssid_byte, sizeof(a.bssid));
+    return a;
+}
+
+static void test_upsert_and_remove(void) {
+    wifi_profiles_t wp;
+    wifi_profiles_init(&wp);
+    CHECK_EQ(wifi_profiles_upsert(&wp, "", NULL), -1);
+    CHECK_EQ(wifi_profiles_upsert(&wp, "studio", "a"), 0);
+    CHECK_EQ(wifi_profiles_upsert(&wp, "room", "b"), 1);
+    CHECK_EQ(wifi_profiles_upsert(&wp, "studio", "new"), 0);
+    CHECK_EQ(wp.count, 2);
+    CHECK_STR(wp.profiles[0].pass, "new");
+
+    // Full: the least recently successful profile makes room
+    uint8_t bssid[6] = {1, 2, 3, 4, 5, 6};
+    wifi_profiles_record_success(&wp, 1, bssid, 6, 500);
+    wifi_profiles_upsert(&wp, "c", "");
+    wifi_profiles_upsert(&wp, "d", "");
+    int e = wifi_profiles_upsert(&wp, "e", "");
+    CHECK_EQ(wp.count, WIFI_PROFILES_MAX);
+    CHECK(e >= 0);
+    CHECK(wifi_profiles_find(&wp, "room") >= 0);
+
+    CHECK(wifi_profiles_remove(&wp, "e"));
+    CHECK(!wifi_profiles_remove(&wp, "e"));
+    CHECK_EQ(wp.count, WIFI_PROFILES_MAX - 1);
+    CHECK_EQ(wifi_profiles_find(&wp, "e"), -1);
+}
+
+static void test_ranking(void) {
+    wifi_profiles_t wp;
+    wifi_profiles_init(&wp);
+    int studio = wifi_profiles_upsert(&wp, "studio", "a");
+    int room = wifi_profiles_upsert(&wp, "room", "b");
+    wifi_candidate_t c[WIFI_PROFILES_MAX_CANDIDATES];
+
+    // Only "room" in range (two APs), plus a neighbour; studio follows as a plain SSID try
+    wifi_scan_ap_t scan1[] = {ap("neighbour", 9, 1, -40), ap("room", 2, 6, -70), ap("room", 3, 11, -55)};
+    CHECK_EQ(wifi_profiles_rank(&wp, scan1, 3, c, WIFI_PROFILES_MAX_CANDIDATES), 3);
+    CHECK_EQ(c[0].profile, room);
+    CHECK_EQ(c[0].channel, 11);
+    CHECK_EQ(c[1].channel, 6);
+    CHECK_EQ(c[2].profile, studio);
+    CHECK_EQ(c[2].channel, 0);
+
+    // The network that worked last wins unless the other is much stronger
+    uint8_t b3[6];
+    memset(b3, 3, sizeof(b3));
+    wifi_profiles_record_success(&wp, room, b3, 11, 900);
+    wifi_scan_ap_t both[] = {ap("studio", 1, 1, -60), ap("room", 3, 11, -65)};
+    wifi_profiles_rank(&wp, both, 2, c, WIFI_PROFILES_MAX_CANDIDATES);
+    CHECK_EQ(c[0].profile, room);
+    wifi_scan_ap_t studio_strong[] = {ap("studio", 1, 1, -45), ap("room", 3, 11, -75)};
+    wifi_profiles_rank(&wp, studio_strong, 2, c, WIFI_PROFILES_MAX_CANDIDATES);
+    CHECK_EQ(c[0].profile, studio);
+
+    // Failures push a network down
+    wifi_profiles_record_failure(&wp, room);
+    wifi_profiles_record_failure(&wp, room);
+    CHECK_EQ(wp.profiles[room].fail_streak, 2);
+    wifi_profiles_rank(&wp, both, 2, c, WIFI_PROFILES_MAX_CANDIDATES);
+    CHECK_EQ(c[0].profile, studio);
+
+    // A mesh with more APs than candidate slots still leaves room for the unseen network
+    wifi_scan_ap_t mesh[12];
+    for (int i = 0; i < 12; i++) {
+        mesh[i] = ap("room", 10 + i, 1, -50 - i);
+    }
+    CHECK_EQ(wifi_profiles_rank(&wp, mesh, 12, c, WIFI_PROFILES_MAX_CANDIDATES), WIFI_PROFILES_MAX_CANDIDATES);
+    CHECK_EQ(c[0].rssi, -50);
+    CHECK_EQ(c[WIFI_PROFILES_MAX_CANDIDATES - 2].rssi, -56);
+    CHECK_EQ(c[WIFI_PROFILES_MAX_CANDIDATES - 1].profile, studio);
+    CHECK_EQ(c[WIFI_PROFILES_MAX_CANDIDATES - 1].channel, 0);
+}
+
+static void test_connect_stats_and_saves(void) {
+    wifi_profiles_t wp;
+    wifi_profiles_init(&wp);
+    int room = wifi_profiles_upsert(&wp, "room", "b");
+    uint8_t b3[6], b4[6];
+    memset(b3, 3, sizeof(b3));
+    memset(b4, 4, sizeof(b4));
+    CHECK(wifi_profiles_record_success(&wp, room, b3, 11, 900));  // New hint
+    CHECK(!wifi_profiles_record_success(&wp, room, b3, 11, 700));  // Same AP: no flash write
+    CHECK_EQ(wp.profiles[room].connect_ms_avg, 800);
+    CHECK_EQ(wp.profiles[room].connect_ms_max, 900);
+    CHECK(wifi_profiles_record_success(&wp, room, b4, 11, 700));  // Roamed
+
+    int saves = 0;
+    for (int i = 0; i < 2 * WIFI_PROFILES_SAVE_EVERY; i++) {
+        saves += wifi_profiles_record_success(&wp, room, b4, 11, 500);
+    }
+    CHECK_EQ(saves, 2);
+}
+
+static void test_quick_candidate(void) {
+    wifi_profiles_t wp;
+    wifi_profiles_init(&wp);
+    wifi_candidate_t c;
+    uint8_t bssid[6] = {1, 2, 3, 4, 5, 6};
+    int home = wifi_profiles_upsert(&wp, "home", "x");
+    int fresh = wifi_profiles_upsert(&wp, "fresh", "y");
+    CHECK(!wifi_profiles_quick_candidate(&wp, fresh, &c));  // No hints yet
+
+    wifi_profiles_record_success(&wp, home, bssid, 6, 800);
+    CHECK(wifi_profiles_quick_candidate(&wp, fresh, &c));
+    CHECK_EQ(c.profile, home);
+    CHECK_EQ(c.channel, 6);
+    CHECK(memcmp(c.bssid, bssid, sizeof(bssid)) == 0);
+
+    // AP picked in the setup portal
+    wifi_profiles_set_hint(&wp, fresh, bssid, 11);
+    CHECK(wifi_profiles_quick_candidate(&wp, fresh, &c));
+    CHECK_EQ(c.profile, fresh);
+    CHECK_EQ(c.channel, 11);
+
+    wifi_profiles_record_failure(&wp, home);
+    CHECK(!wifi_profiles_quick_candidate(&wp, -1, &c));  // Failed since: scan instead
+}
+
+static void test_backoff(void) {
+    static const uint32_t expect[] = {500, 1000, 2000, 4000, 8000, 16000, 30000, 30000, 30000};
+    for (int i = 0; i < (int)(sizeof(expect) / sizeof(expect[0])); i++) {
+        CHECK_EQ(wifi_profiles_backoff_ms(i), expect[i]);
+    }
+}
+
+int main(void) {
+    test_upsert_and_remove();
+    test_ranking();
+    test_connect_stats_and_saves();
+    test_quick_candidate();
+    test_backoff();
+    puts("wifi_profiles: ok");
+    return 0;
+}
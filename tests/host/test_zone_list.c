@@ -0,0 +1,149 @@
+#include "test_util.h"
+#include "zone_list.h"
+
+static void test_full_and_delta(void) {
+    static zone_list_t zl;
+    const char *full = "{\"zones\":[{\"zone_id\":\"a\",\"zone_name\":\"Kitchen\",\"ver\":\"00000001\"},"
+                       "{\"zone_id\":\"b\",\"zone_name\":\"Den \\\"x\\\" }\",\"ver\":\"00000001\"},"
+                       "{\"zone_id\":\"c\",\"zone_name\":\"Office\"}],\"zones_sha\":\"aaaa0001\"}";
+    CHECK_EQ(zone_list_parse_full(&zl, full), 3);
+    CHECK_STR(zl.sha, "aaaa0001");
+    CHECK_STR(zl.zones[1].name, "Den \"x\" }");
+    CHECK_STR(zl.zones[0].ver, "00000001");
+    CHECK(!zone_list_is_delta(full));
+
+    const char *delta = "{\"since\":\"aaaa0001\",\"zones_sha\":\"aaaa0002\",\"changed\":["
+                        "{\"zone_id\":\"b\",\"zone_name\":\"Den\",\"ver\":\"00000002\"},"
+                        "{\"zone_id\":\"d\",\"zone_name\":\"Patio\",\"ver\":\"00000001\"},"
+                        "{\"zone_id\":\"a\",\"zone_name\":\"Kitchen\",\"ver\":\"00000001\"}],\"removed\":[\"c\"]}";
+    zone_list_delta_t d;
+    CHECK(zone_list_is_delta(delta));
+    CHECK(zone_list_apply_delta(&zl, delta, &d));
+    CHECK_EQ(d.added, 1);
+    CHECK_EQ(d.renamed, 1);
+    CHECK_EQ(d.removed, 1);
+    CHECK_EQ(d.unchanged, 1);
+    CHECK_EQ(zl.count, 3);
+    CHECK_STR(zl.zones[0].id, "a");
+    CHECK_STR(zl.zones[1].name, "Den");
+    CHECK_STR(zl.zones[2].id, "d");
+    CHECK_STR(zl.sha, "aaaa0002");
+    CHECK_EQ(zone_list_find(&zl, "c"), -1);
+
+    // Stale "since": the caller refetches in full
+    CHECK(!zone_list_apply_delta(&zl, delta, &d));
+
+    // Malformed delta (an entry without a name) leaves the list untouched
+    const char *bad = "{\"since\":\"aaaa0002\",\"zones_sha\":\"aaaa0003\",\"changed\":["
+                      "{\"zone_id\":\"q\",\"zone_name\":\"Q\"},{\"zone_id\":\"r\"}],\"removed\":[\"a\"]}";
+    CHECK(!zone_list_apply_delta(&zl, bad, &d));
+    CHECK_EQ(zl.count, 3);
+    CHECK_EQ(zone_list_find(&zl, "q"), -1);
+    CHECK_EQ(zone_list_find(&zl, "a"), 0);
+    CHECK_STR(zl.sha, "aaaa0002");
+
+    // Older bridges send a bare array and no sha: deltas never apply
+    const char *legacy = "[{\"zone_id\":\"x\",\"zone_name\":\"X\"},{\"zone_id\":\"y\",\"zone_name\":\"Y\"}]";
+    CHECK_EQ(zone_list_parse_full(&zl, legacy), 2);
+    CHECK_STR(zl.sha, "");
+    CHECK(!zone_list_apply_delta(&zl, delta, &d));
+}
+
+static void test_adds_beyond_capacity_dropped(void) {
+    static zone_list_t zl;
+    static char buf[ZONE_LIST_MAX * 80 + 256];
+    int n = sprintf(buf, "{\"zones\":[");
+    for (int i = 0; i < ZONE_LIST_MAX; i++) {
+        n += sprintf(buf + n, "%s{\"zone_id\":\"z%d\",\"zone_name\":\"Zone %d\"}", i ? "," : "", i, i);
+    }
+    sprintf(buf + n, "],\"zones_sha\":\"00000001\"}");
+    CHECK_EQ(zone_list_parse_full(&zl, buf), ZONE_LIST_MAX);
+
+    const char *delta = "{\"since\":\"00000001\",\"zones_sha\":\"00000002\",\"changed\":["
+                        "{\"zone_id\":\"new\",\"zone_name\":\"New\"}],\"removed\":[]}";
+    zone_list_delta_t d;
+    CHECK(zone_list_apply_delta(&zl, delta, &d));
+    CHECK_EQ(d.dropped, 1);
+    CHECK_EQ(zl.count, ZONE_LIST_MAX);
+}
+
+// Random regroup/rename/add/remove churn: applying each delta gives the same list as
+// parsing the full answer the bridge would have sent instead
+#define CHURN_ZONES 48
+
+static char s_names[CHURN_ZONES][40];
+static unsigned s_vers[CHURN_ZONES];
+static bool s_alive[CHURN_ZONES];
+
+static int zone_json(char *buf, int i) {
+    return sprintf(buf, "{\"zone_id\":\"1601%012d\",\"zone_name\":\"%s\",\"ver\":\"%08x\"}", i, s_names[i], s_vers[i]);
+}
+
+static void full_answer(char *buf, unsigned sha) {
+    int n = sprintf(buf, "{\"zones\":[");
+    bool first = true;
+    for (int i = 0; i < CHURN_ZONES; i++) {
+        if (!s_alive[i]) continue;
+        if (!first) buf[n++] = ',';
+        n += zone_json(buf + n, i);
+        first = false;
+    }
+    sprintf(buf + n, "],\"zones_sha\":\"%08x\"}", sha);
+}
+
+static void test_churn_matches_full(void) {
+    static zone_list_t zl, expect;
+    static char full[16384], delta[4096], changed[2048], removed[512];
+    srand(7);
+    for (int i = 0; i < CHURN_ZONES; i++) {
+        sprintf(s_names[i], "Zone %02d Living Room", i);
+        s_vers[i] = 1;
+        s_alive[i] = true;
+    }
+    unsigned sha = 1;
+    full_answer(full, sha);
+    CHECK_EQ(zone_list_parse_full(&zl, full), CHURN_ZONES);
+
+    for (int ev = 0; ev < 500; ev++) {
+        int cn = 0, rn = 0;
+        int i = rand() % CHURN_ZONES;
+        int r = rand() % 10;
+        if (r < 6 && s_alive[i]) {
+            s_vers[i]++;
+            sprintf(s_names[i], "Zone %02d %s", i, (s_vers[i] & 1) ? "Living Room" : "Living Room + Den");
+            cn += zone_json(changed + cn, i);
+        } else if (r < 8 && s_alive[i]) {
+            s_alive[i] = false;
+            rn += sprintf(removed + rn, "\"1601%012d\"", i);
+        } else if (!s_alive[i]) {
+            s_alive[i] = true;
+            s_vers[i]++;
+            cn += zone_json(changed + cn, i);
+        }
+        changed[cn] = removed[rn] = '\0';
+        sprintf(delta, "{\"since\":\"%08x\",\"zones_sha\":\"%08x\",\"changed\":[%s],\"removed\":[%s]}", sha, sha + 1,
+                changed, removed);
+        sha++;
+
+        zone_list_delta_t d;
+        CHECK(zone_list_apply_delta(&zl, delta, &d));
+        full_answer(full, sha);
+        zone_list_parse_full(&expect, full);
+        CHECK_EQ(zl.count, expect.count);
+        CHECK_STR(zl.sha, expect.sha);
+        for (int k = 0; k < expect.count; k++) {
+            int j = zone_list_find(&zl, expect.zones[k].id);
+            CHECK(j >= 0);
+            CHECK_STR(zl.zones[j].name, expect.zones[k].name);
+            CHECK_STR(zl.zones[j].ver, expect.zones[k].ver);
+        }
+    }
+}
+
+int main(void) {
+    test_full_and_delta();
+    test_adds_beyond_capacity_dropped();
+    test_churn_matches_full();
+    puts("zone_list: ok");
+    return 0;
+}